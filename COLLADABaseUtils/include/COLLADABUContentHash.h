@@ -0,0 +1,91 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADABaseUtils.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADABU_CONTENTHASH_H__
+#define __COLLADABU_CONTENTHASH_H__
+
+#include "COLLADABUPrerequisites.h"
+
+
+namespace COLLADABU
+{
+    /** A 128 bit hash of the content of an object, used to find objects with identical content.
+    A default constructed hash is zero, which means that no hash has been calculated.*/
+    struct ContentHash
+    {
+        unsigned long long high;
+        unsigned long long low;
+
+        ContentHash() : high(0), low(0) {}
+        ContentHash( unsigned long long _high, unsigned long long _low ) : high(_high), low(_low) {}
+
+        /** Returns true, if the hash is zero, i.e. it has not been calculated.*/
+        bool isZero() const { return high == 0 && low == 0; }
+
+        bool operator==( const ContentHash& other ) const { return high == other.high && low == other.low; }
+        bool operator!=( const ContentHash& other ) const { return !(*this == other); }
+        bool operator<( const ContentHash& other ) const { return high < other.high || (high == other.high && low < other.low); }
+
+        /** Returns the hash as string of 32 hexadecimal digits.*/
+        String toString() const;
+    };
+
+
+    /** Calculates a ContentHash over data passed in arbitrary pieces. The hash only depends on the
+    concatenation of the data, not on how it has been split into pieces. The hash function is
+    MurmurHash3 (x64, 128 bit), which is fast but not cryptographic.*/
+    class ContentHasher
+    {
+    private:
+        static const size_t BLOCK_SIZE = 16;
+
+        /** The state of the hash.*/
+        unsigned long long mH1;
+        unsigned long long mH2;
+
+        /** The bytes passed to update(), that do not fill a whole block yet.*/
+        unsigned char mTail[BLOCK_SIZE];
+
+        /** The number of valid bytes in mTail.*/
+        size_t mTailLength;
+
+        /** The number of bytes passed to update() since the last reset().*/
+        unsigned long long mLength;
+
+    public:
+
+        /** Constructor. */
+        ContentHasher();
+
+        /** Discards all data passed so far.*/
+        void reset();
+
+        /** Appends @a length bytes starting at @a data to the hashed data.*/
+        void update( const void* data, size_t length );
+
+        /** Appends the bytes of @a value to the hashed data.*/
+        template<class T>
+        void updateValue( const T& value ) { update( &value, sizeof(T) ); }
+
+        /** Appends @a hash to the hashed data, to combine hashes.*/
+        void updateHash( const ContentHash& hash ) { updateValue( hash.high ); updateValue( hash.low ); }
+
+        /** Returns the hash of all data passed since the last reset(). More data can be appended
+        afterwards.*/
+        ContentHash getHash() const;
+
+    private:
+        /** Mixes the block of BLOCK_SIZE bytes at @a block into the state.*/
+        void processBlock( const unsigned char* block );
+    };
+
+} // namespace COLLADABU
+
+#endif // __COLLADABU_CONTENTHASH_H__
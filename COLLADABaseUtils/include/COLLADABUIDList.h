@@ -13,30 +13,42 @@
 
 #include "COLLADABUPrerequisites.h"
 #include "COLLADABUUtils.h"
-
-#include <set>
+#include "COLLADABUhash_map.h"
 
 
 namespace COLLADABU
 {
-    /** A class to generate and store unique and valid ids.*/
+    /** A class to generate and store unique and valid ids.
+    Ids are stored in a hash set. For each converted id that needed a number suffix, the last
+    suffix used is remembered, such that adding the same id many times is amortized O(1).*/
 	class IDList 	
     {
     private:
-        typedef std::set<String> IDSet;
+        typedef hash_set<String> IDSet;
+
+        /** Maps converted ids to the last number suffix used to make them unique.*/
+        typedef hash_map<String, size_t> NumberSuffixMap;
 
         typedef String (*StringConversionFunction)(const String&);
 
     private:
-        /** Conversion function used to convert added Values*/
+        /** Conversion function used to convert added Values. If it is null, Utils::checkID() is used
+        without copying ids that are valid already.*/
         StringConversionFunction mConversionFunction;
 
         /** A map that stores ids that are already managed by this instance of IDList.*/
         IDSet mIdSet;
 
+        /** The last number suffix used for each converted id. Since ids are never removed, all
+        smaller suffixes are still taken and the search for a free one continues after it.*/
+        NumberSuffixMap mLastNumberSuffixes;
+
     public:
-        /** Constructor*/
-        IDList(StringConversionFunction conversionFunction = Utils::checkID);
+        /** Constructor. Added ids are converted by Utils::checkID().*/
+        IDList();
+
+        /** Constructor. Added ids are converted by @a conversionFunction.*/
+        IDList(StringConversionFunction conversionFunction);
 
         /** Destructor*/
         virtual ~IDList() {}
@@ -50,7 +50,30 @@ namespace COLLADABU
 		@return The checked string
 		*/
 		static WideString checkNCName ( const WideString &ncName );
-//		static UTF8String checkNCName ( const UTF8String &ncName ){return UTF8String();};
+
+		/** Checks for a valid xs:NCName, like checkNCName(const WideString&), but works directly on the
+		UTF-8 encoded string @a ncName. Every character that is not allowed is replaced by a single '_',
+		as is every byte that is not part of a valid UTF-8 sequence.
+		@param ncName The UTF-8 encoded string to convert to a valid xs:NCName.
+		@return The checked string*/
+		static String checkNCName ( const String &ncName );
+
+		/** Same as checkNCName(const String&), but does not allocate memory if @a ncName is already a
+		valid xs:NCName.
+		@param ncName The UTF-8 encoded string to convert to a valid xs:NCName.
+		@param buffer Receives the checked string, if @a ncName is not valid. Pass the same buffer
+		to multiple calls to reuse its memory.
+		@return @a ncName, if it is valid, @a buffer otherwise.*/
+		static const String& checkNCName ( const String &ncName, String& buffer );
+
+		/** Converts all @a count UTF-8 encoded strings starting at @a ncNames in place to valid
+		xs:NCNames, as checkNCName(const String&) does. Only invalid names are modified.
+		@return The number of names that have been modified.*/
+		static size_t checkNCNames ( String* ncNames, size_t count );
+
+		/** Returns true, if the UTF-8 encoded string @a ncName is a valid xs:NCName, i.e. if
+		checkNCName() would return it unchanged.*/
+		static bool isNCName ( const String &ncName );
 
 		/** Checks for a valid xs:ID.
 		1. replaces all not allowed characters
@@ -60,7 +83,11 @@ namespace COLLADABU
 		*/
         static WideString checkID ( const WideString &id );
 
-//		static UTF8String checkID ( const UTF8String &id ){return UTF8String();};
+		/** Checks for a valid xs:ID, like checkID(const WideString&), but works directly on the UTF-8
+		encoded string @a id.
+		@param id The UTF-8 encoded string to convert to a valid xs:ID.
+		@return The checked string*/
+		static String checkID ( const String &id );
 
 		/** Checks if @a c is name start character according to http://www.w3.org/TR/xml11/#NT-NameStartChar */
 		static bool isNameStartChar ( wchar_t c );
@@ -68,6 +95,12 @@ namespace COLLADABU
 		/** Checks if @a c is name character according to http://www.w3.org/TR/xml11/#NT-NameChar */
 		static bool isNameChar ( wchar_t c );
 
+		/** Checks if @a c is an xs:NCName start character, i.e. a name start character but ':'.*/
+		static bool isNCNameStartChar ( wchar_t c );
+
+		/** Checks if @a c is an xs:NCName character, i.e. a name character but ':'.*/
+		static bool isNCNameChar ( wchar_t c );
+
         /** Checks if @a c is an upper ASCII character*/
         static bool isUpperAsciiChar ( char c )
         {
@@ -64,6 +64,10 @@ namespace COLLADABU
         */
         static bool equalsIgnoreCase ( const String& s1, const String& s2 );
 
+		/** Returns true, if @a ncName is a valid xs:NCName as produced by checkNCName(), i.e. if it
+		begins with an ASCII letter and contains only ASCII letters, digits, '.', '-' and '_'.*/
+		static bool isNCName ( const String &ncName );
+
 		/** Checks for a valid xs:NCName.
 		1. replaces all not allowed characters
 		2. forces that the string begins with a letter or an _
@@ -72,6 +76,14 @@ namespace COLLADABU
 		*/
 		static String checkNCName ( const String &ncName );
 
+		/** Same as checkNCName(const String&), but does not copy @a ncName if it is already a valid
+		xs:NCName.
+		@param ncName The string to convert to a valid xs:NCName.
+		@param buffer Receives the checked string, if @a ncName is not valid. Pass the same buffer
+		to multiple calls to reuse its memory.
+		@return @a ncName, if it is valid, @a buffer otherwise.*/
+		static const String& checkNCName ( const String &ncName, String& buffer );
+
 		/** Checks for a valid xs:ID.
 		1. replaces all not allowed characters
 		2. forces that the string begins with a letter or an _
@@ -80,6 +92,10 @@ namespace COLLADABU
 		*/
         static String checkID ( const String &id );
 
+		/** Same as checkID(const String&), but does not copy @a id if it is already a valid xs:ID.
+		@see checkNCName(const String&, String&)*/
+		static const String& checkID ( const String &id, String& buffer );
+
 
         /** Checks if @a c is an upper ASCII character*/
         static bool isUpperAsciiChar ( char c )
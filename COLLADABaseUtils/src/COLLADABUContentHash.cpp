@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADABaseUtils.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADABUStableHeaders.h"
+#include "COLLADABUContentHash.h"
+
+#include <string.h>
+
+
+namespace COLLADABU
+{
+    // The constants of MurmurHash3_x64_128
+    static const unsigned long long C1 = 0x87c37b91114253d5ULL;
+    static const unsigned long long C2 = 0x4cf5ad432745937fULL;
+
+    //--------------------------------
+    static inline unsigned long long rotateLeft( unsigned long long x, int r )
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    //--------------------------------
+    static inline unsigned long long finalMix( unsigned long long k )
+    {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    //--------------------------------
+    // Reads 8 bytes in little endian order, independent of alignment and platform.
+    static inline unsigned long long readBlock( const unsigned char* p )
+    {
+        unsigned long long value = 0;
+        for ( int i = 7; i >= 0; --i )
+            value = (value << 8) | p[i];
+        return value;
+    }
+
+    //--------------------------------
+    String ContentHash::toString() const
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+        char buffer[33];
+        for ( int i = 0; i < 16; ++i )
+        {
+            buffer[i] = hexDigits[(high >> (60 - 4*i)) & 0xf];
+            buffer[16 + i] = hexDigits[(low >> (60 - 4*i)) & 0xf];
+        }
+        buffer[32] = 0;
+        return String( buffer );
+    }
+
+    //--------------------------------
+    ContentHasher::ContentHasher()
+    {
+        reset();
+    }
+
+    //--------------------------------
+    void ContentHasher::reset()
+    {
+        mH1 = 0;
+        mH2 = 0;
+        mTailLength = 0;
+        mLength = 0;
+    }
+
+    //--------------------------------
+    void ContentHasher::processBlock( const unsigned char* block )
+    {
+        unsigned long long k1 = readBlock( block );
+        unsigned long long k2 = readBlock( block + 8 );
+
+        k1 *= C1; k1 = rotateLeft( k1, 31 ); k1 *= C2; mH1 ^= k1;
+        mH1 = rotateLeft( mH1, 27 ); mH1 += mH2; mH1 = mH1 * 5 + 0x52dce729;
+
+        k2 *= C2; k2 = rotateLeft( k2, 33 ); k2 *= C1; mH2 ^= k2;
+        mH2 = rotateLeft( mH2, 31 ); mH2 += mH1; mH2 = mH2 * 5 + 0x38495ab5;
+    }
+
+    //--------------------------------
+    void ContentHasher::update( const void* data, size_t length )
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        mLength += length;
+
+        // complete the block started by the previous call
+        if ( mTailLength > 0 )
+        {
+            size_t missing = BLOCK_SIZE - mTailLength;
+            if ( length < missing )
+            {
+                memcpy( mTail + mTailLength, bytes, length );
+                mTailLength += length;
+                return;
+            }
+            memcpy( mTail + mTailLength, bytes, missing );
+            processBlock( mTail );
+            bytes += missing;
+            length -= missing;
+            mTailLength = 0;
+        }
+
+        for ( ; length >= BLOCK_SIZE; bytes += BLOCK_SIZE, length -= BLOCK_SIZE )
+            processBlock( bytes );
+
+        memcpy( mTail, bytes, length );
+        mTailLength = length;
+    }
+
+    //--------------------------------
+    ContentHash ContentHasher::getHash() const
+    {
+        unsigned long long h1 = mH1;
+        unsigned long long h2 = mH2;
+
+        // the remaining bytes, as the tail handling of MurmurHash3_x64_128
+        unsigned char tail[BLOCK_SIZE];
+        memset( tail, 0, BLOCK_SIZE );
+        memcpy( tail, mTail, mTailLength );
+        if ( mTailLength > 8 )
+        {
+            unsigned long long k2 = readBlock( tail + 8 );
+            k2 *= C2; k2 = rotateLeft( k2, 33 ); k2 *= C1; h2 ^= k2;
+        }
+        if ( mTailLength > 0 )
+        {
+            unsigned long long k1 = readBlock( tail );
+            k1 *= C1; k1 = rotateLeft( k1, 31 ); k1 *= C2; h1 ^= k1;
+        }
+
+        h1 ^= mLength;
+        h2 ^= mLength;
+
+        h1 += h2;
+        h2 += h1;
+
+        h1 = finalMix( h1 );
+        h2 = finalMix( h2 );
+
+        h1 += h2;
+        h2 += h1;
+
+        return ContentHash( h1, h2 );
+    }
+
+} // namespace COLLADABU
@@ -13,6 +13,27 @@
 
 namespace COLLADABU
 {
+    //-------------------------------------
+    // Appends the decimal representation of @a number to @a str, without a stringstream.
+    static void appendNumber ( String& str, size_t number )
+    {
+        char buffer[32];
+        char* end = buffer + sizeof(buffer);
+        char* p = end;
+        do
+        {
+            *--p = (char)( '0' + number % 10 );
+            number /= 10;
+        }
+        while ( number != 0 );
+        str.append ( p, end - p );
+    }
+
+    //-------------------------------------
+    IDList::IDList()
+        : mConversionFunction(0)
+    {}
+
     //-------------------------------------
     IDList::IDList(StringConversionFunction conversionFunction ) 
         : mConversionFunction(conversionFunction)
@@ -24,14 +45,13 @@ namespace COLLADABU
         bool returnConverted  /*= true*/,
         bool alwaysAddNumberSuffix /*= false*/ )
     {
-        String newIdChecked = mConversionFunction( newId );
+        String buffer;
+        const String& newIdChecked = mConversionFunction ? ( buffer = mConversionFunction( newId ) ) : Utils::checkID( newId, buffer );
 
-        IDSet::iterator it = mIdSet.find ( newIdChecked );
         if ( !alwaysAddNumberSuffix )
         {
-            if ( it == mIdSet.end() )
+            if ( mIdSet.insert ( newIdChecked ).second )
             {
-                mIdSet.insert ( newIdChecked );
                 return returnConverted ? newIdChecked : newId;
             }
             else if ( !returnConverted )
@@ -40,18 +60,30 @@ namespace COLLADABU
             }
         }
 
-        String idCandidate;
-        size_t numberSuffix = 0;
+        // continue after the last suffix used for this id. Smaller ones are all taken, since ids
+        // are never removed. Ids added explicitly, e.g. "id_3", are skipped by the loop.
+        size_t& numberSuffix = mLastNumberSuffixes[newIdChecked];
+
+        String idCandidate = newIdChecked;
+        idCandidate.append ( 1, '_' );
+        size_t baseLength = idCandidate.length();
         do
         {
             ++numberSuffix;
-            idCandidate = newIdChecked + "_" + Utils::toString ( numberSuffix );
+            idCandidate.resize ( baseLength );
+            appendNumber ( idCandidate, numberSuffix );
         }
-        while ( mIdSet.find ( idCandidate ) != mIdSet.end() );
+        while ( !mIdSet.insert ( idCandidate ).second );
 
-        mIdSet.insert ( idCandidate );
+        if ( returnConverted )
+        {
+            return idCandidate;
+        }
 
-        return returnConverted ? idCandidate : newId + "_" + Utils::toString ( numberSuffix );
+        String result = newId;
+        result.append ( 1, '_' );
+        appendNumber ( result, numberSuffix );
+        return result;
     }
 
     //-------------------------------------
@@ -23,6 +23,127 @@
 namespace COLLADABU
 {
 
+	//--------------------------------
+	// Checks if the unicode code point @a c is a name start character. Used for UTF-8 strings, since
+	// wchar_t cannot hold all code points on every platform.
+	static inline bool isNameStartCodePoint( unsigned int c )
+	{
+		return		( c == ':' ) 
+				||	( c >= 'A' && c <= 'Z' )
+				||  ( c == '_' )
+				||  ( c >= 'a' && c <= 'z' )
+				||  ( c >= 0xC0 && c <= 0xD6 ) 
+				||	( c >= 0xD8 && c <= 0xF6 )
+				||	( c >= 0xF8 && c <= 0x2FF )
+				||	( c >= 0x370 && c <= 0x37D )
+				||	( c >= 0x37F && c <= 0x1FFF )
+				||	( c >= 0x200C && c <= 0x200D )
+				||	( c >= 0x2070 && c <= 0x218F )
+				||	( c >= 0x2C00 && c <= 0x2FEF )
+				||	( c >= 0x3001 && c <= 0xD7FF )
+				||	( c >= 0xF900 && c <= 0xFDCF )
+				||	( c >= 0xFDF0 && c <= 0xFFFD )
+				||	( c >= 0x10000 && c <= 0xEFFFF);
+	}
+
+	//--------------------------------
+	// Checks if the unicode code point @a c is a name character.
+	static inline bool isNameCodePoint( unsigned int c )
+	{
+		return	isNameStartCodePoint( c )	
+			||	( c == '-' ) 
+			||  ( c == '.' )
+			||  ( c >= '0' && c <= '9' )
+			||  ( c == 0xB7 )
+			||  ( c >= 0x0300 && c <= 0x036F ) 
+			||	( c >= 0x203F && c <= 0x2040 );
+	}
+
+	//--------------------------------
+	// Checks if the unicode code point @a c is allowed at position @a pos of an xs:NCName.
+	static inline bool isNCNameCodePoint( unsigned int c, size_t pos )
+	{
+		if ( c == ':' )
+			return false;
+		return pos == 0 ? isNameStartCodePoint( c ) : isNameCodePoint( c );
+	}
+
+	//--------------------------------
+	// Decodes the UTF-8 encoded character at @a p, of which at most @a available bytes may be read.
+	// Returns the number of bytes of the character and stores its code point in @a codePoint, or
+	// returns 0, if the bytes are not a valid UTF-8 sequence.
+	static inline size_t decodeUTF8Char( const unsigned char* p, size_t available, unsigned int& codePoint )
+	{
+		unsigned char first = p[0];
+		if ( first < 0x80 )
+		{
+			codePoint = first;
+			return 1;
+		}
+
+		size_t length;
+		unsigned int minimum;
+		if ( (first & 0xE0) == 0xC0 )
+		{
+			length = 2;
+			codePoint = first & 0x1F;
+			minimum = 0x80;
+		}
+		else if ( (first & 0xF0) == 0xE0 )
+		{
+			length = 3;
+			codePoint = first & 0x0F;
+			minimum = 0x800;
+		}
+		else if ( (first & 0xF8) == 0xF0 )
+		{
+			length = 4;
+			codePoint = first & 0x07;
+			minimum = 0x10000;
+		}
+		else
+		{
+			return 0;
+		}
+
+		if ( available < length )
+			return 0;
+
+		for ( size_t i = 1; i < length; ++i )
+		{
+			if ( (p[i] & 0xC0) != 0x80 )
+				return 0;
+			codePoint = (codePoint << 6) | (p[i] & 0x3F);
+		}
+
+		// reject overlong encodings, surrogates and values beyond the unicode range
+		if ( codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF) )
+			return 0;
+
+		return length;
+	}
+
+	//--------------------------------
+	// Returns the byte position of the first character of the UTF-8 encoded string @a ncName that is
+	// not allowed in an xs:NCName, or String::npos, if @a ncName is a valid xs:NCName.
+	static size_t findInvalidNCNameChar( const String& ncName )
+	{
+		size_t length = ncName.length();
+		if ( length == 0 )
+			return 0;
+
+		const unsigned char* characters = (const unsigned char*)ncName.c_str();
+		size_t pos = 0;
+		while ( pos < length )
+		{
+			unsigned int codePoint;
+			size_t charLength = decodeUTF8Char( characters + pos, length - pos, codePoint );
+			if ( charLength == 0 || !isNCNameCodePoint( codePoint, pos ) )
+				return pos;
+			pos += charLength;
+		}
+		return String::npos;
+	}
 
     //---------------------------------
     WideString StringUtils::checkNCName ( const WideString &ncName )
@@ -33,7 +154,7 @@ namespace COLLADABU
         // check if first character is an alpha character
         const wchar_t& firstCharacter = ncName[0];
 
-        if ( isNameStartChar(( firstCharacter ) ) )
+        if ( isNCNameStartChar(( firstCharacter ) ) )
             result.append ( 1, firstCharacter );
         else
             result.append ( 1, '_' );
@@ -43,7 +164,7 @@ namespace COLLADABU
         {
             const wchar_t& character = ncName[i];
 
-            if ( isNameChar ( character ) )
+            if ( isNCNameChar ( character ) )
                 result.append ( 1, character );
             else
                 result.append ( 1, '_' );
@@ -58,6 +179,81 @@ namespace COLLADABU
         return checkNCName ( id );
     }
 
+	//---------------------------------
+	String StringUtils::checkNCName ( const String &ncName )
+	{
+		String buffer;
+		return checkNCName ( ncName, buffer );
+	}
+
+	//---------------------------------
+	const String& StringUtils::checkNCName ( const String &ncName, String& buffer )
+	{
+		size_t pos = findInvalidNCNameChar ( ncName );
+		if ( pos == String::npos )
+			return ncName;
+
+		size_t length = ncName.length();
+		if ( length == 0 )
+		{
+			buffer.assign ( 1, '_' );
+			return buffer;
+		}
+
+		// copy the valid part and replace the invalid characters in the rest
+		buffer.reserve ( length );
+		buffer.assign ( ncName, 0, pos );
+
+		const unsigned char* characters = (const unsigned char*)ncName.c_str();
+		while ( pos < length )
+		{
+			unsigned int codePoint;
+			size_t charLength = decodeUTF8Char( characters + pos, length - pos, codePoint );
+			if ( charLength != 0 && isNCNameCodePoint( codePoint, pos ) )
+			{
+				buffer.append ( ncName, pos, charLength );
+			}
+			else
+			{
+				buffer.append ( 1, '_' );
+				if ( charLength == 0 )
+					charLength = 1;
+			}
+			pos += charLength;
+		}
+		return buffer;
+	}
+
+	//---------------------------------
+	size_t StringUtils::checkNCNames ( String* ncNames, size_t count )
+	{
+		size_t modifiedCount = 0;
+		String buffer;
+		for ( size_t i = 0; i < count; ++i )
+		{
+			String& ncName = ncNames[i];
+			if ( &checkNCName ( ncName, buffer ) != &ncName )
+			{
+				// the old name becomes the buffer for the next invalid name
+				ncName.swap ( buffer );
+				++modifiedCount;
+			}
+		}
+		return modifiedCount;
+	}
+
+	//---------------------------------
+	bool StringUtils::isNCName ( const String &ncName )
+	{
+		return findInvalidNCNameChar ( ncName ) == String::npos;
+	}
+
+	//---------------------------------
+	String StringUtils::checkID ( const String &id )
+	{
+		return checkNCName ( id );
+	}
+
     //---------------------------------
     String StringUtils::translateToXML ( const String &srcString )
     {
@@ -202,35 +398,26 @@ namespace COLLADABU
 	//--------------------------------
 	bool StringUtils::isNameStartChar( wchar_t c )
 	{
-		return		( c == ':' ) 
-				||	( c >= 'A' && c <= 'Z' )
-				||  ( c == '_' )
-				||  ( c >= 'a' && c <= 'z' )
-				||  ( c >= 0xC0 && c <= 0xD6 ) 
-				||	( c >= 0xD8 && c <= 0xF6 )
-				||	( c >= 0xF8 && c <= 0x2FF )
-				||	( c >= 0x370 && c <= 0x37D )
-				||	( c >= 0x37F && c <= 0x1FFF )
-				||	( c >= 0x200C && c <= 0x200D )
-				||	( c >= 0x2070 && c <= 0x218F )
-				||	( c >= 0x2C00 && c <= 0x2FEF )
-				||	( c >= 0x3001 && c <= 0xD7FF )
-				||	( c >= 0xF900 && c <= 0xFDCF )
-				||	( c >= 0xFDF0 && c <= 0xFFFD )
-				||	( c >= 0x10000 && c <= 0xEFFFF);
+		return isNameStartCodePoint( (unsigned int)c );
 	}
 
 
 	//--------------------------------
 	bool StringUtils::isNameChar( wchar_t c )
 	{
-		return	isNameStartChar( c )	
-			||	( c == '-' ) 
-			||  ( c == '.' )
-			||  ( c >= '0' && c <= '9' )
-			||  ( c == 0xB7 )
-			||  ( c >= 0x0300 && c <= 0x036F ) 
-			||	( c >= 0x203F && c <= 0x2040 );
+		return isNameCodePoint( (unsigned int)c );
+	}
+
+	//--------------------------------
+	bool StringUtils::isNCNameStartChar( wchar_t c )
+	{
+		return ( c != ':' ) && isNameStartChar( c );
+	}
+
+	//--------------------------------
+	bool StringUtils::isNCNameChar( wchar_t c )
+	{
+		return ( c != ':' ) && isNameChar( c );
 	}
 
 	//--------------------------------
@@ -43,10 +43,38 @@ namespace COLLADABU
 
 
 
+    //---------------------------------
+    bool Utils::isNCName ( const String &ncName )
+    {
+        size_t length = ncName.length();
+        if ( length == 0 || !isAsciiAlphaChar ( ncName[0] ) )
+            return false;
+
+        const char* characters = ncName.c_str();
+        for ( size_t i = 1; i < length; ++i )
+        {
+            if ( !isIDChar ( characters[i] ) )
+                return false;
+        }
+        return true;
+    }
+
     //---------------------------------
     String Utils::checkNCName ( const String &ncName )
     {
-        String result;
+        String buffer;
+        return checkNCName ( ncName, buffer );
+    }
+
+    //---------------------------------
+    const String& Utils::checkNCName ( const String &ncName, String& buffer )
+    {
+        // Most names are valid already. Return them without building a new string.
+        if ( isNCName ( ncName ) )
+            return ncName;
+
+        String& result = buffer;
+        result.clear();
         result.reserve ( ncName.length() );
 
         // check if first character is an alpha character
@@ -77,6 +105,12 @@ namespace COLLADABU
         return checkNCName ( id );
     }
 
+    //---------------------------------
+    const String& Utils::checkID ( const String &id, String& buffer )
+    {
+        return checkNCName ( id, buffer );
+    }
+
     //---------------------------------
     String Utils::translateToXML ( const String &srcString )
     {
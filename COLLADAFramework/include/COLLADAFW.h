@@ -60,6 +60,7 @@
 #include "COLLADAFWLookat.h"
 #include "COLLADAFWMaterial.h"
 #include "COLLADAFWMatrix.h"
+#include "COLLADAFWMemoryArena.h"
 #include "COLLADAFWMesh.h"
 #include "COLLADAFWMeshPrimitive.h"
 #include "COLLADAFWMeshPrimitiveWithFaceVertexCount.h"
@@ -68,9 +69,11 @@
 #include "COLLADAFWMotionProfile.h"
 #include "COLLADAFWNode.h"
 #include "COLLADAFWObject.h"
+#include "COLLADAFWPackedSkinInfluences.h"
 #include "COLLADAFWParam.h"
 #include "COLLADAFWPointerArray.h"
 #include "COLLADAFWPolygons.h"
+#include "COLLADAFWRecordingWriter.h"
 #include "COLLADAFWRoot.h"
 #include "COLLADAFWRotate.h"
 #include "COLLADAFWSampler.h"
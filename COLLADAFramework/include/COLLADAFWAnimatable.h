@@ -13,6 +13,7 @@
 
 #include "COLLADAFWPrerequisites.h"
 #include "COLLADAFWUniqueId.h"
+#include "COLLADAFWMemoryArena.h"
 
 
 namespace COLLADAFW
@@ -26,6 +27,7 @@ namespace COLLADAFW
 		/** The uniqueId of the AnimationList that animates the object.*/
 		UniqueId mAnimationList;
 	public:
+		COLLADAFW_ARENA_ALLOCATED
 
         /** Constructor. */
 		Animatable(){}
@@ -0,0 +1,312 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADAFW_CACHEFORMAT_H__
+#define __COLLADAFW_CACHEFORMAT_H__
+
+#include "COLLADAFWPrerequisites.h"
+
+#include <vector>
+#include <string.h>
+
+
+namespace COLLADAFW
+{
+
+	/** The binary format of the load cache, written by CacheWriter and read by CacheLoader.
+	A cache file consists of a Header followed by records. Each record starts with its RecordType and
+	the size of its contents, both stored as 64 bit values. Scalars are stored as 64 bit integers or
+	doubles, strings as their length followed by their characters and arrays of primitive types as their
+	element count and element size followed by their elements. Strings and arrays are padded to a
+	multiple of ALIGNMENT bytes, such that the elements of an array can be used in place, if the file
+	is mapped into memory. All values are stored in the byte order of the machine that wrote the file.
+	Files written on a machine with another byte order are rejected using Header::byteOrderMark.*/
+	namespace CacheFormat
+	{
+		/** The version of the format. Must be increased with every change of the format or of the
+		serialized objects.*/
+		const unsigned int VERSION = 1;
+
+		/** The first bytes of every cache file.*/
+		const char MAGIC[8] = { 'C', 'O', 'L', 'F', 'W', 'C', 'A', 0 };
+
+		/** Written as native unsigned int, to detect files written with another byte order.*/
+		const unsigned int BYTE_ORDER_MARK = 0x01020304;
+
+		/** The alignment of all values, strings and arrays within a cache file.*/
+		const size_t ALIGNMENT = 8;
+
+		/** The types of the records in a cache file. Each record holds the object passed to the
+		corresponding IWriter method. Formulas and kinematics scenes are only cached if they are empty, i.e. their
+		records have no contents.*/
+		enum RecordType
+		{
+			RECORD_GLOBAL_ASSET = 1,
+			RECORD_SCENE,
+			RECORD_VISUAL_SCENE,
+			RECORD_LIBRARY_NODES,
+			RECORD_GEOMETRY,
+			RECORD_MATERIAL,
+			RECORD_EFFECT,
+			RECORD_CAMERA,
+			RECORD_IMAGE,
+			RECORD_LIGHT,
+			RECORD_ANIMATION,
+			RECORD_ANIMATION_LIST,
+			RECORD_SKIN_CONTROLLER_DATA,
+			RECORD_CONTROLLER,
+			RECORD_FORMULAS,
+			RECORD_KINEMATICS_SCENE
+		};
+
+		/** The header at the beginning of every cache file. Its size is a multiple of ALIGNMENT.*/
+		struct Header
+		{
+			/** Must be equal to MAGIC.*/
+			char magic[8];
+
+			/** Must be equal to VERSION.*/
+			unsigned int version;
+
+			/** Must be equal to BYTE_ORDER_MARK.*/
+			unsigned int byteOrderMark;
+
+			/** The hash of the document and the loader configuration the file has been written for.*/
+			unsigned long long keyHigh;
+			unsigned long long keyLow;
+
+			/** The hash of the records, to detect truncated or corrupted files.*/
+			unsigned long long dataHashHigh;
+			unsigned long long dataHashLow;
+
+			/** The number of records following the header.*/
+			unsigned long long recordCount;
+
+			/** The size of all records in bytes.*/
+			unsigned long long dataSize;
+		};
+
+		/** Returns the number of padding bytes required after @a size bytes.*/
+		inline size_t getPadding( size_t size )
+		{
+			return (ALIGNMENT - size % ALIGNMENT) % ALIGNMENT;
+		}
+
+		/** Appends values, strings, arrays and records to a memory buffer.*/
+		class OutputStream
+		{
+		private:
+			/** The buffer the data is appended to.*/
+			std::vector<char>& mData;
+
+		public:
+			/** Constructor.
+			@param data The buffer the data is appended to.*/
+			OutputStream( std::vector<char>& data ) : mData(data) {}
+
+			void writeUInt64( unsigned long long value ) { append( &value, sizeof(value) ); }
+
+			void writeInt64( long long value ) { append( &value, sizeof(value) ); }
+
+			void writeDouble( double value ) { append( &value, sizeof(value) ); }
+
+			void writeBool( bool value ) { writeUInt64( value ? 1 : 0 ); }
+
+			void writeString( const String& value ) { writeBytes( value.data(), value.size() ); }
+
+			/** Writes @a length followed by @a length bytes starting at @a data.*/
+			void writeBytes( const void* data, size_t length )
+			{
+				writeUInt64( length );
+				appendPadded( data, length );
+			}
+
+			/** Writes the @a count elements of type T starting at @a data.*/
+			template<class T>
+			void writeArray( const T* data, size_t count )
+			{
+				writeUInt64( count );
+				writeUInt64( sizeof(T) );
+				appendPadded( data, count * sizeof(T) );
+			}
+
+			/** Starts a record of type @a recordType.
+			@return The position to pass to endRecord().*/
+			size_t beginRecord( RecordType recordType )
+			{
+				writeUInt64( recordType );
+				size_t sizePosition = mData.size();
+				writeUInt64( 0 );
+				return sizePosition;
+			}
+
+			/** Finishes the record started by the beginRecord() call that returned @a sizePosition.*/
+			void endRecord( size_t sizePosition )
+			{
+				unsigned long long size = mData.size() - sizePosition - sizeof(unsigned long long);
+				memcpy( &mData[sizePosition], &size, sizeof(size) );
+			}
+
+		private:
+			void append( const void* data, size_t length )
+			{
+				if ( length > 0 )
+					mData.insert( mData.end(), (const char*)data, (const char*)data + length );
+			}
+
+			void appendPadded( const void* data, size_t length )
+			{
+				append( data, length );
+				mData.resize( mData.size() + getPadding( length ) );
+			}
+		};
+
+		/** Reads values, strings, arrays and records from a memory buffer written by an OutputStream.
+		Reading beyond the end of the buffer or reading an array with an unexpected element size makes
+		the stream invalid. Afterwards, all reads return zero values.*/
+		class InputStream
+		{
+		private:
+			/** The next byte to read.*/
+			char* mPosition;
+
+			/** The end of the buffer.*/
+			char* mEnd;
+
+			/** False, if a read failed.*/
+			bool mValid;
+
+		public:
+			/** Constructor.
+			@param data The buffer to read. Must be aligned to ALIGNMENT.
+			@param length The length of the buffer in bytes.*/
+			InputStream( char* data, size_t length ) : mPosition(data), mEnd(data + length), mValid(true) {}
+
+			/** Returns false, if a read failed.*/
+			bool isValid() const { return mValid; }
+
+			/** Returns true, if all data has been read.*/
+			bool isAtEnd() const { return mPosition == mEnd; }
+
+			/** Returns the next byte to read.*/
+			char* getPosition() const { return mPosition; }
+
+			unsigned long long readUInt64()
+			{
+				unsigned long long value = 0;
+				read( &value, sizeof(value) );
+				return value;
+			}
+
+			long long readInt64()
+			{
+				long long value = 0;
+				read( &value, sizeof(value) );
+				return value;
+			}
+
+			double readDouble()
+			{
+				double value = 0;
+				read( &value, sizeof(value) );
+				return value;
+			}
+
+			bool readBool() { return readUInt64() != 0; }
+
+			/** Reads the number of the elements that follow. Each of them occupies at least 8 bytes, which
+			limits the count to the remaining size of the buffer.*/
+			size_t readCount()
+			{
+				unsigned long long count = readUInt64();
+				if ( count > (size_t)(mEnd - mPosition) / sizeof(unsigned long long) )
+				{
+					invalidate();
+					return 0;
+				}
+				return (size_t)count;
+			}
+
+			String readString()
+			{
+				size_t length = 0;
+				const char* data = readBytes( length );
+				return data ? String( data, length ) : String();
+			}
+
+			/** Reads bytes written by OutputStream::writeBytes().
+			@param length Receives the number of bytes.
+			@return The first byte, null if there are no bytes or if the read failed.*/
+			const char* readBytes( size_t& length )
+			{
+				length = (size_t)readUInt64();
+				return (const char*)skipPadded( length );
+			}
+
+			/** Reads an array written by OutputStream::writeArray().
+			@param count Receives the number of elements.
+			@return The first element, null if there are no elements or if the read failed.*/
+			template<class T>
+			T* readArray( size_t& count )
+			{
+				unsigned long long elementCount = readUInt64();
+				unsigned long long elementSize = readUInt64();
+				count = 0;
+				if ( !mValid || elementSize != sizeof(T) || elementCount > (size_t)(mEnd - mPosition) / sizeof(T) )
+				{
+					invalidate();
+					return 0;
+				}
+				count = (size_t)elementCount;
+				return (T*)skipPadded( count * sizeof(T) );
+			}
+
+			/** Skips @a length bytes and the following padding.
+			@return The first skipped byte, null if nothing has been skipped or if the read failed.*/
+			char* skipPadded( size_t length )
+			{
+				if ( !mValid )
+					return 0;
+				size_t paddedLength = length + getPadding( length );
+				if ( paddedLength < length || paddedLength > (size_t)(mEnd - mPosition) )
+				{
+					invalidate();
+					return 0;
+				}
+				char* data = mPosition;
+				mPosition += paddedLength;
+				return length ? data : 0;
+			}
+
+			/** Makes the stream invalid.*/
+			void invalidate()
+			{
+				mValid = false;
+				mPosition = mEnd;
+			}
+
+		private:
+			void read( void* value, size_t length )
+			{
+				if ( (size_t)(mEnd - mPosition) < length )
+				{
+					invalidate();
+					return;
+				}
+				memcpy( value, mPosition, length );
+				mPosition += length;
+			}
+		};
+
+	} // namespace CacheFormat
+
+} // namespace COLLADAFW
+
+#endif // __COLLADAFW_CACHEFORMAT_H__
@@ -0,0 +1,130 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADAFW_CACHELOADER_H__
+#define __COLLADAFW_CACHELOADER_H__
+
+#include "COLLADAFWPrerequisites.h"
+#include "COLLADAFWILoader.h"
+
+#include "COLLADABUContentHash.h"
+#include "COLLADABUPlatform.h"
+
+
+namespace COLLADAFW
+{
+
+	/** Loader that replays documents from a persistent cache of binary files (see CacheFormat), instead
+	of parsing them. The cache file of a document is named after the hash of the document content and the
+	configuration key, i.e. changed documents are never replayed from stale cache files.
+	On a cache hit, the cache file is mapped into memory and the records are deserialized and passed to
+	the writer, in the order the original loader passed them to the CacheWriter. The large arrays (vertex
+	data, indices, animation keys, skin weights) of the passed objects point into the mapping, instead of
+	being copied. The mapping is private (copy on write), i.e. writers may change the values in place, but
+	must not resize these arrays. The mapping is kept until the next load or the destruction of the cache
+	loader. Writers that take the ownership of the objects must not use them beyond that point.
+	On a cache miss, the document is loaded by the fallback loader, with a CacheWriter in between, that
+	writes the cache file if all objects of the document could be serialized.
+	Callbacks the fallback loader calls besides the writer methods, like extra data handlers, are not
+	called on a cache hit. Settings of the fallback loader that change the loaded objects must be
+	reflected in the configuration key, see setConfigurationKey().*/
+	class CacheLoader : public ILoader
+	{
+	private:
+		/** The loader used on a cache miss.*/
+		ILoader* mFallbackLoader;
+
+		/** The directory the cache files are stored in.*/
+		String mCacheDirectory;
+
+		/** Hashed together with the document, to distinguish different loader configurations.*/
+		String mConfigurationKey;
+
+		/** True, if the last load has been replayed from a cache file.*/
+		bool mCacheHit;
+
+		/** The mapped cache file of the last cache hit.*/
+		char* mMapping;
+
+		/** The size of mMapping in bytes.*/
+		size_t mMappingSize;
+
+		/** True, if mMapping is a memory mapped file, false if it has been allocated with malloc.*/
+		bool mMappingIsFile;
+
+#if defined(COLLADABU_OS_WIN)
+		/** The handle of the file mapping, if mMappingIsFile.*/
+		void* mFileMapping;
+#endif
+
+	public:
+
+        /** Constructor.
+		@param fallbackLoader The loader used to load documents that are not cached yet.
+		@param cacheDirectory The directory the cache files are read from and written to. It must exist.*/
+		CacheLoader( ILoader* fallbackLoader, const String& cacheDirectory );
+
+        /** Destructor. Releases the mapping of the last cache hit.*/
+		virtual ~CacheLoader();
+
+		/** Sets a key that identifies the configuration of the fallback loader and the writers, e.g. the
+		loaded object types or the version of the application. Cache files written with another key are
+		not replayed.*/
+		void setConfigurationKey( const String& configurationKey ) { mConfigurationKey = configurationKey; }
+
+		/** Returns true, if the last load has been replayed from a cache file.*/
+		bool wasCacheHit() const { return mCacheHit; }
+
+		/** Returns the name of the cache file of the document with the key @a key.*/
+		String getCacheFileName( const COLLADABU::ContentHash& key ) const;
+
+		/** Calculates the key of the document content @a buffer of @a length bytes, loaded from @a uri,
+		as stored in the header of its cache file. The uri is part of the key, since the loaded objects
+		contain it, e.g. in the file info and in relative image uris.*/
+		COLLADABU::ContentHash calculateKey( const String& uri, const char* buffer, size_t length ) const;
+
+		/** Loads the document @a fileName, from its cache file if it exists and is valid, using the
+		fallback loader otherwise.
+		@return True, if loading succeeded, false otherwise.*/
+		virtual bool loadDocument( const String& fileName, IWriter* writer );
+
+		/** Loads the document in @a buffer, from its cache file if it exists and is valid, using the
+		fallback loader otherwise.
+		@return True, if loading succeeded, false otherwise.*/
+		virtual bool loadDocument( const String& uri, const char* buffer, int length, IWriter* writer );
+
+	private:
+
+        /** Disable default copy ctor. */
+		CacheLoader( const CacheLoader& pre );
+
+        /** Disable default assignment operator. */
+		const CacheLoader& operator= ( const CacheLoader& pre );
+
+		/** Calculates the key of the document @a fileName, reading it in blocks.
+		@return False, if the file could not be read.*/
+		bool calculateFileKey( const String& fileName, COLLADABU::ContentHash& key ) const;
+
+		/** Replays the cache file with the key @a key to @a writer, if it exists and is valid.
+		@param success Receives the result of the writer calls.
+		@return False, if there is no valid cache file.*/
+		bool replayCacheFile( const COLLADABU::ContentHash& key, IWriter* writer, bool& success );
+
+		/** Maps the cache file @a fileName into memory.*/
+		bool mapFile( const String& fileName );
+
+		/** Releases the mapping of the last cache hit.*/
+		void releaseMapping();
+
+	};
+
+} // namespace COLLADAFW
+
+#endif // __COLLADAFW_CACHELOADER_H__
@@ -0,0 +1,134 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADAFW_CACHEWRITER_H__
+#define __COLLADAFW_CACHEWRITER_H__
+
+#include "COLLADAFWPrerequisites.h"
+#include "COLLADAFWIWriter.h"
+
+#include "COLLADABUContentHash.h"
+
+#include <vector>
+
+
+namespace COLLADAFW
+{
+
+	/** Writer that serializes the objects of a load into the binary cache format (see CacheFormat), to
+	replay them later on using a CacheLoader, without parsing the document again. Each object is
+	serialized and then passed on to an optional target writer, i.e. a document can be loaded and
+	cached in one pass.
+	Meshes, animation curves, skin controller data, controllers, the scene graph, materials, effects,
+	cameras, lights, images and the embedded data of images are serialized. If the load contains other
+	objects (formulas, kinematics models, geometries that are not meshes) or is canceled, the writer becomes
+	uncacheable, i.e. writeCacheFile() fails. Meshes are never streamed.*/
+	class CacheWriter : public IWriter
+	{
+	private:
+		/** The writer the objects are passed on to. Might be null.*/
+		IWriter* mTargetWriter;
+
+		/** The serialized records.*/
+		std::vector<char> mData;
+
+		/** The number of records in mData.*/
+		size_t mRecordCount;
+
+		/** False, if the load contains objects that cannot be serialized or has been canceled.*/
+		bool mCacheable;
+
+		/** True, if finish() has been called.*/
+		bool mFinished;
+
+		/** The embedded data of the image currently loaded.*/
+		std::vector<unsigned char> mImageData;
+
+		/** True, if the target writer wants to receive the embedded data of the current image.*/
+		bool mTargetWantsImageData;
+
+	public:
+
+        /** Constructor.
+		@param targetWriter The writer the objects are passed on to, after they have been serialized.
+		Might be null.*/
+		CacheWriter( IWriter* targetWriter = 0 );
+
+        /** Destructor. */
+		virtual ~CacheWriter();
+
+		/** Returns true, if a load has been finished and all its objects could be serialized.*/
+		bool isCacheable() const { return mFinished && mCacheable; }
+
+		/** Writes the serialized objects to the cache file @a fileName. The file is written to a temporary
+		file first and renamed afterwards, such that concurrent readers never see a partially written file.
+		@param key The hash of the document and the loader configuration, see CacheLoader.
+		@return False, if the load is not cacheable or the file could not be written.*/
+		bool writeCacheFile( const String& fileName, const COLLADABU::ContentHash& key ) const;
+
+		virtual void cancel( const String& errorMessage );
+
+		virtual void start();
+
+		virtual void finish();
+
+		virtual bool takesObjectOwnership() const;
+
+		virtual bool writeGlobalAsset( const FileInfo* asset );
+
+		virtual bool writeScene( const Scene* scene );
+
+		virtual bool writeVisualScene( const VisualScene* visualScene );
+
+		virtual bool writeLibraryNodes( const LibraryNodes* libraryNodes );
+
+		virtual bool writeGeometry( const Geometry* geometry );
+
+		virtual bool writeMaterial( const Material* material );
+
+		virtual bool writeEffect( const Effect* effect );
+
+		virtual bool writeCamera( const Camera* camera );
+
+		virtual bool writeImage( const Image* image );
+
+		virtual bool startImageData( const Image* image );
+
+		virtual bool writeImageData( const Image* image, const unsigned char* data, size_t length );
+
+		virtual bool finishImageData( const Image* image );
+
+		virtual bool writeLight( const Light* light );
+
+		virtual bool writeAnimation( const Animation* animation );
+
+		virtual bool writeAnimationList( const AnimationList* animationList );
+
+		virtual bool writeSkinControllerData( const SkinControllerData* skinControllerData );
+
+		virtual bool writeController( const Controller* controller );
+
+		virtual bool writeFormulas( const Formulas* formulas );
+
+		virtual bool writeKinematicsScene( const KinematicsScene* kinematicsScene );
+
+	private:
+
+        /** Disable default copy ctor. */
+		CacheWriter( const CacheWriter& pre );
+
+        /** Disable default assignment operator. */
+		const CacheWriter& operator= ( const CacheWriter& pre );
+
+	};
+
+} // namespace COLLADAFW
+
+#endif // __COLLADAFW_CACHEWRITER_H__
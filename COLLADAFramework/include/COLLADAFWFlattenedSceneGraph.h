@@ -0,0 +1,192 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADAFW_FLATTENEDSCENEGRAPH_H__
+#define __COLLADAFW_FLATTENEDSCENEGRAPH_H__
+
+#include "COLLADAFWPrerequisites.h"
+#include "COLLADAFWNode.h"
+#include "COLLADAFWUniqueId.h"
+
+#include "Math/COLLADABUMathMatrix4.h"
+
+#include <vector>
+#include <map>
+
+
+namespace COLLADAFW
+{
+	class VisualScene;
+	class LibraryNodes;
+
+	/** Holds the nodes of a scene graph in breadth first order, together with their local and world
+	matrices. Each entry is one occurrence of a node in the scene graph, i.e. nodes instantiated by
+	instance nodes are expanded and get one entry per instantiation. The children of an entry are
+	stored contiguously, after all entries of the level of their parent. The attributes of the entries
+	are stored in separate arrays, indexed by the entry index.
+	The local matrix of an entry is the one calculated by Node::getTransformationMatrix(), its world
+	matrix is the world matrix of its parent multiplied by its local matrix. All matrices are calculated
+	by build(). If the transformations of nodes change, e.g. while playing animations, mark the nodes
+	using invalidate() and call update() to recalculate only the matrices that depend on them.
+	The nodes must not be deleted or modified structurally while the scene graph is used.*/
+	class FlattenedSceneGraph
+	{
+	public:
+
+		/** The parent index of the entries of the root nodes.*/
+		static const size_t NO_PARENT = (size_t)-1;
+
+		/** The minimum number of entries a loop over the entries must process, to be split among
+		threads. Smaller loops, e.g. the upper levels of a hierarchy, are processed serially, since
+		opening a parallel region costs more than calculating a few matrices.*/
+		static const ptrdiff_t MIN_PARALLEL_ENTRY_COUNT = 256;
+
+	private:
+
+		typedef std::map<UniqueId, const Node*> UniqueIdNodeMap;
+		typedef std::vector<COLLADABU::Math::Matrix4> MatrixList;
+		typedef std::vector<size_t> IndexList;
+		typedef std::vector< std::pair<const Node*, size_t> > NodeIndexList;
+
+		/** The nodes of the library nodes, instance nodes can refer to, by their unique ids.*/
+		UniqueIdNodeMap mLibraryNodes;
+
+		/** The nodes of the scene graph, instance nodes can refer to, by their unique ids.*/
+		UniqueIdNodeMap mSceneNodes;
+
+		/** The node and the index of each entry, sorted by the nodes.*/
+		NodeIndexList mNodeIndices;
+
+		/** The node of each entry.*/
+		std::vector<const Node*> mNodes;
+
+		/** The index of the parent entry of each entry, NO_PARENT for root nodes.*/
+		IndexList mParentIndices;
+
+		/** The index of the first child of each entry.*/
+		IndexList mFirstChildIndices;
+
+		/** The number of children of each entry.*/
+		IndexList mChildCounts;
+
+		/** The index of the first entry of each level and, as last element, the number of entries.*/
+		IndexList mLevelOffsets;
+
+		/** The local matrix of each entry.*/
+		MatrixList mLocalMatrices;
+
+		/** The world matrix of each entry.*/
+		MatrixList mWorldMatrices;
+
+		/** Non zero for entries whose node has been invalidated since the last update.*/
+		std::vector<char> mDirtyFlags;
+
+		/** The number of entries with a dirty flag set.*/
+		size_t mDirtyCount;
+
+	public:
+
+		/** Constructor.*/
+		FlattenedSceneGraph();
+
+		/** Destructor.*/
+		virtual ~FlattenedSceneGraph();
+
+		/** Makes the nodes in @a libraryNodes, including their child nodes, available to instance nodes.
+		Must be called before build() for all library nodes the scene graph instantiates nodes from.*/
+		void addLibraryNodes( const LibraryNodes* libraryNodes );
+
+		/** Builds the scene graph of the root nodes of @a visualScene and calculates all matrices.
+		Instance nodes are expanded, if they refer to a node of @a visualScene or of the library nodes
+		added before. Instance nodes that refer to unknown nodes or to one of their own ancestors are
+		ignored.*/
+		void build( const VisualScene* visualScene );
+
+		/** Builds the scene graph of @a rootNodes and calculates all matrices. See build().*/
+		void build( const NodePointerArray& rootNodes );
+
+		/** Returns the number of entries.*/
+		size_t getEntryCount() const { return mNodes.size(); }
+
+		/** Returns the number of levels, i.e. the depth of the deepest entry plus one.*/
+		size_t getLevelCount() const { return mLevelOffsets.empty() ? 0 : mLevelOffsets.size() - 1; }
+
+		/** Returns the index of the first entry of level @a level. The entries of the level end at the
+		first entry of the next level.*/
+		size_t getLevelOffset( size_t level ) const { return mLevelOffsets[level]; }
+
+		/** Returns the node of entry @a index.*/
+		const Node* getNode( size_t index ) const { return mNodes[index]; }
+
+		/** Returns the index of the parent entry of entry @a index, NO_PARENT if it is a root node.*/
+		size_t getParentIndex( size_t index ) const { return mParentIndices[index]; }
+
+		/** Returns the index of the first child of entry @a index.*/
+		size_t getFirstChildIndex( size_t index ) const { return mFirstChildIndices[index]; }
+
+		/** Returns the number of children of entry @a index.*/
+		size_t getChildCount( size_t index ) const { return mChildCounts[index]; }
+
+		/** Returns the local matrix of entry @a index.*/
+		const COLLADABU::Math::Matrix4& getLocalMatrix( size_t index ) const { return mLocalMatrices[index]; }
+
+		/** Returns the world matrix of entry @a index.*/
+		const COLLADABU::Math::Matrix4& getWorldMatrix( size_t index ) const { return mWorldMatrices[index]; }
+
+		/** Returns the local matrices of all entries.*/
+		const COLLADABU::Math::Matrix4* getLocalMatrices() const { return mLocalMatrices.empty() ? 0 : &mLocalMatrices[0]; }
+
+		/** Returns the world matrices of all entries.*/
+		const COLLADABU::Math::Matrix4* getWorldMatrices() const { return mWorldMatrices.empty() ? 0 : &mWorldMatrices[0]; }
+
+		/** Marks the local matrix of entry @a index as changed. The matrices are recalculated by update().*/
+		void invalidate( size_t index );
+
+		/** Marks the local matrices of all entries of @a node as changed. The matrices are recalculated by
+		update().
+		@return The number of entries of @a node.*/
+		size_t invalidate( const Node* node );
+
+		/** Returns true, if entries have been invalidated since the last update.*/
+		bool needsUpdate() const { return mDirtyCount > 0; }
+
+		/** Recalculates the local matrices of all invalidated entries and the world matrices of them and
+		their descendants.*/
+		void update();
+
+	private:
+
+		/** Disable default copy ctor. */
+		FlattenedSceneGraph( const FlattenedSceneGraph& pre );
+
+		/** Disable default assignment operator. */
+		const FlattenedSceneGraph& operator= ( const FlattenedSceneGraph& pre );
+
+		/** Adds @a nodes and all their descendants to @a instantiableNodes.*/
+		static void addInstantiableNodes( const NodePointerArray& nodes, UniqueIdNodeMap& instantiableNodes );
+
+		/** Returns the node with unique id @a uniqueId, instance nodes can refer to, null if there is none.*/
+		const Node* findInstantiableNode( const UniqueId& uniqueId ) const;
+
+		/** Returns true, if @a node is the node of entry @a index or of one of its ancestors.*/
+		bool isAncestorOrSelf( const Node* node, size_t index ) const;
+
+		/** Appends an entry for @a node with parent entry @a parentIndex.*/
+		void appendEntry( const Node* node, size_t parentIndex );
+
+		/** Calculates the world matrices of all entries. If @a dirtyOnly is true, only the matrices of
+		entries with a dirty flag set and of their descendants are recalculated.*/
+		void calculateWorldMatrices( bool dirtyOnly );
+
+	};
+
+} // namespace COLLADAFW
+
+#endif // __COLLADAFW_FLATTENEDSCENEGRAPH_H__
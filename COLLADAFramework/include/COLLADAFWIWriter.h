@@ -20,6 +20,8 @@ namespace COLLADAFW
     class Scene;
 	class VisualScene;
 	class Geometry;
+	class Mesh;
+	class MeshPrimitive;
 	class LibraryNodes;
 	class Material;
 	class Effect;
@@ -57,6 +59,13 @@ namespace COLLADAFW
 		/** This is the method called. The writer hast to prepare to receive data.*/
 		virtual void start()=0;
 
+		/** If this method returns true, the loader passes the ownership of the objects passed to the write*() 
+		methods to the writer, i.e. the objects remain valid after the call and the writer has to delete them
+		using FW_DELETE. The objects must not be deleted before finish() has been called, since the loader
+		might still refer to them. Streamed meshes and the data passed to writeImageData() are not affected.
+		@return The default implementation returns false, i.e. the objects are deleted by the loader.*/
+		virtual bool takesObjectOwnership() const { return false; }
+
 		/** This method is called after the last write* method. No other methods will be called after this.*/
 		virtual void finish()=0;
 
@@ -81,6 +90,34 @@ namespace COLLADAFW
 		@return The writer should return true, if writing succeeded, false otherwise.*/
 		virtual bool writeGeometry ( const Geometry* geometry ) = 0;
 
+		/** This method is called, before the first data of @a mesh is loaded. If the writer returns true, the
+		mesh is streamed, i.e. instead of passing the entire mesh to writeGeometry(), the vertex data is
+		passed to writeMeshVertexData() as soon as it has been parsed and each mesh primitive is passed to
+		writeMeshPrimitive() as soon as it has been completed. Data that has been passed to the writer is
+		released by the loader. finishMeshStream() is called after the last primitive of @a mesh and
+		writeGeometry() is not called for @a mesh.
+		@return The writer should return true, if it wants to receive the mesh streamed. The default
+		implementation returns false, i.e. the mesh is passed to writeGeometry().*/
+		virtual bool startMeshStream( const Mesh* mesh ) { return false; }
+
+		/** Passes the vertex data of @a mesh, that has been loaded since the last call, to the writer. The vertex
+		data of a streamed mesh is the concatenation of the data passed in all calls. The data is only valid
+		during this call.
+		@return The writer should return true, if writing succeeded, false otherwise.*/
+		virtual bool writeMeshVertexData( const Mesh* mesh ) { return true; }
+
+		/** Passes the completed mesh primitive @a meshPrimitive of @a mesh to the writer. The indices of
+		@a meshPrimitive refer to the concatenation of all vertex data passed to writeMeshVertexData() so far.
+		A large primitive might be passed in multiple parts, each of them being a primitive of its own. The
+		primitive is only valid during this call.
+		@return The writer should return true, if writing succeeded, false otherwise.*/
+		virtual bool writeMeshPrimitive( const Mesh* mesh, const MeshPrimitive* meshPrimitive ) { return true; }
+
+		/** This method is called after the last primitive of the streamed @a mesh has been passed to 
+		writeMeshPrimitive().
+		@return The writer should return true, if writing succeeded, false otherwise.*/
+		virtual bool finishMeshStream( const Mesh* mesh ) { return true; }
+
 		/** When this method is called, the writer must write the material.
 		@return The writer should return true, if writing succeeded, false otherwise.*/
 		virtual bool writeMaterial( const Material* material ) = 0;
@@ -97,6 +134,23 @@ namespace COLLADAFW
 		@return The writer should return true, if writing succeeded, false otherwise.*/
 		virtual bool writeImage( const Image* image ) = 0;
 
+		/** This method is called, before the data embedded in @a image is loaded. Embedded data is never
+		stored in the image. Instead it is passed to writeImageData() in chunks as it is decoded, followed
+		by a call of finishImageData(). All of these calls happen before writeImage() is called for @a image.
+		@return The writer should return true, if it wants to receive the embedded data. The default
+		implementation returns false, i.e. the embedded data is skipped.*/
+		virtual bool startImageData( const Image* image ) { return false; }
+
+		/** Passes the next @a length bytes of the data embedded in @a image to the writer. The data is only
+		valid during this call.
+		@return The writer should return true, if writing succeeded, false otherwise.*/
+		virtual bool writeImageData( const Image* image, const unsigned char* data, size_t length ) { return true; }
+
+		/** This method is called after the last chunk of the data embedded in @a image has been passed to
+		writeImageData().
+		@return The writer should return true, if writing succeeded, false otherwise.*/
+		virtual bool finishImageData( const Image* image ) { return true; }
+
 		/** When this method is called, the writer must write the light.
 		@return The writer should return true, if writing succeeded, false otherwise.*/
 		virtual bool writeLight( const Light* light ) = 0;
@@ -13,6 +13,7 @@
 
 #include "COLLADAFWPrerequisites.h"
 #include "COLLADAFWTypes.h"
+#include "COLLADAFWMemoryArena.h"
 
 
 namespace COLLADAFW
@@ -28,6 +29,8 @@ namespace COLLADAFW
         size_t mInitialIndex;
 
     public:
+        COLLADAFW_ARENA_ALLOCATED
+
         IndexList ()
             : mName ("")
 			, mIndices ( UIntValuesArray::OWNER )
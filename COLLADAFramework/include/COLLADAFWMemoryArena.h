@@ -0,0 +1,166 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADAFW_MEMORYARENA_H__
+#define __COLLADAFW_MEMORYARENA_H__
+
+#include "COLLADAFWPrerequisites.h"
+
+#include <stddef.h>
+#include <vector>
+#include <utility>
+
+
+namespace COLLADAFW
+{
+
+	/** Monotonic memory arena. Memory is taken from large chunks and is only given back to the system
+	when the arena is released or destroyed. Deallocating a single block does not free its memory.
+
+	Framework objects (all classes derived from Object or Animatable and IndexList) are allocated
+	through allocateObject(), which takes the memory from the current arena, if one has been set with
+	setCurrent(), and from the heap otherwise. This allows a loader to allocate all objects of a
+	document from one arena and to release them in one go at the end of the load.
+	Objects taken from the heap do not carry any additional data. When an object is deleted, it is
+	looked up in the chunks of the current arena to decide, whether it has to be given back to the heap.
+	Hence an object allocated from an arena must be deleted by the thread the arena is current for,
+	while it is current, or not at all. All objects allocated from an arena must have been deleted, or
+	must no longer be used, when the arena is released. In particular, a writer that keeps objects it
+	receives, or clones of them, beyond the end of the load must not be used with an arena.
+	The arena is not thread safe. The current arena is set per thread, such that loads running
+	concurrently on different threads do not allocate their objects from each other's arena.*/
+	class MemoryArena
+	{
+	private:
+
+		/** A chunk of memory and its size.*/
+		typedef std::pair<char*, size_t> Chunk;
+
+		/** List of chunks, sorted by their addresses.*/
+		typedef std::vector<Chunk> ChunkList;
+
+	public:
+
+		/** The default size of the chunks, the memory is taken from.*/
+		static const size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+	private:
+
+		/** The size of new chunks.*/
+		size_t mChunkSize;
+
+		/** All chunks of the arena, sorted by their addresses.*/
+		ChunkList mChunks;
+
+		/** The first unused byte in the chunk memory is currently taken from.*/
+		char* mCurrentPosition;
+
+		/** The first byte after the chunk memory is currently taken from.*/
+		char* mCurrentEnd;
+
+		/** The number of bytes handed out since the last release.*/
+		size_t mAllocatedBytes;
+
+		/** The number of bytes reserved from the system in chunks.*/
+		size_t mReservedBytes;
+
+	public:
+
+		/** Constructor.
+		@param chunkSize The size of the chunks, the memory is taken from. Allocations larger than a
+		quarter of the chunk size get a chunk of their own.*/
+		MemoryArena( size_t chunkSize = DEFAULT_CHUNK_SIZE );
+
+		/** Destructor. Releases all memory.*/
+		virtual ~MemoryArena();
+
+		/** Returns @a size bytes, aligned for any fundamental type.*/
+		void* allocate( size_t size );
+
+		/** Returns true, if @a memory has been taken from this arena and the arena has not been released
+		since.*/
+		bool contains( const void* memory ) const;
+
+		/** Gives all memory back to the system. All memory previously returned by allocate() becomes
+		invalid.*/
+		void release();
+
+		/** Returns the number of bytes handed out since the last release.*/
+		size_t getAllocatedBytes() const { return mAllocatedBytes; }
+
+		/** Returns the number of bytes reserved from the system.*/
+		size_t getReservedBytes() const { return mReservedBytes; }
+
+		/** Returns the arena framework objects are currently allocated from by the calling thread. Might 
+		be null.*/
+		static MemoryArena* getCurrent();
+
+		/** Sets the arena framework objects are allocated from by the calling thread. If @a arena is null,
+		framework objects are allocated from the heap.
+		@return The previously set arena.*/
+		static MemoryArena* setCurrent( MemoryArena* arena );
+
+		/** Allocates memory for a framework object from the current arena of the calling thread, or from
+		the heap, if no arena is set. Throws std::bad_alloc, if the memory could not be allocated.*/
+		static void* allocateObject( size_t size );
+
+		/** Deallocates memory returned by allocateObject(). Memory that has been taken from the current
+		arena of the calling thread is left to the arena, all other memory is given back to the heap.*/
+		static void deallocateObject( void* object );
+
+	private:
+
+		/** Allocates a new chunk of @a size bytes and returns its first byte.
+		@param makeCurrent If true, following allocations are taken from the new chunk.*/
+		char* addChunk( size_t size, bool makeCurrent );
+
+		/** Disable default copy ctor. */
+		MemoryArena( const MemoryArena& pre );
+
+		/** Disable default assignment operator. */
+		const MemoryArena& operator= ( const MemoryArena& pre );
+
+	};
+
+
+	/** Sets @a arena as the current arena for the life time of the object and restores the previous
+	one on destruction.*/
+	class MemoryArenaScope
+	{
+	private:
+		/** The arena that was current before this scope has been entered.*/
+		MemoryArena* mPreviousArena;
+
+	public:
+		/** Constructor. */
+		MemoryArenaScope( MemoryArena* arena ) : mPreviousArena( MemoryArena::setCurrent(arena) ) {}
+
+		/** Destructor. */
+		~MemoryArenaScope() { MemoryArena::setCurrent(mPreviousArena); }
+
+	private:
+		/** Disable default copy ctor. */
+		MemoryArenaScope( const MemoryArenaScope& pre );
+
+		/** Disable default assignment operator. */
+		const MemoryArenaScope& operator= ( const MemoryArenaScope& pre );
+	};
+
+} // namespace COLLADAFW
+
+
+/** Declares the operators new and delete of a framework class, such that its instances are allocated
+through COLLADAFW::MemoryArena::allocateObject().*/
+#define COLLADAFW_ARENA_ALLOCATED \
+	static void* operator new( size_t size ) { return COLLADAFW::MemoryArena::allocateObject(size); } \
+	static void operator delete( void* object ) { COLLADAFW::MemoryArena::deallocateObject(object); }
+
+
+#endif // __COLLADAFW_MEMORYARENA_H__
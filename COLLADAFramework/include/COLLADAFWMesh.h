@@ -17,6 +17,7 @@
 #include "COLLADAFWMeshPrimitive.h"
 
 #include "COLLADABUUtils.h"
+#include "COLLADABUContentHash.h"
 
 
 namespace COLLADAFW
@@ -91,6 +92,17 @@ namespace COLLADAFW
         */
         MeshPrimitiveArray mMeshPrimitives;
 
+        /**
+        * Hash of the vertex data and the mesh primitives. Zero, if it has not been calculated.
+        */
+        COLLADABU::ContentHash mContentHash;
+
+        /**
+        * The unique id of the first mesh loaded before with the same content hash. Invalid, if
+        * there is no such mesh or the content hash has not been calculated.
+        */
+        UniqueId mDuplicateOf;
+
     public:
 
         /** Constructor. */
@@ -341,6 +353,27 @@ namespace COLLADAFW
          */
         const size_t getFacesCount () const;
 
+        /**
+        * Returns the hash of the vertex data and the mesh primitives. Meshes with identical
+        * vertex data and primitives have the same hash, independent of their ids and of the
+        * chunks they have been streamed in. The ids of the sources and the names of the input sets are
+        * not part of the hash. Zero, if the hash has not been calculated.
+        */
+        const COLLADABU::ContentHash& getContentHash () const { return mContentHash; }
+
+        /** Sets the hash of the vertex data and the mesh primitives. */
+        void setContentHash ( const COLLADABU::ContentHash& contentHash ) { mContentHash = contentHash; }
+
+        /**
+        * Returns the unique id of the first mesh passed to the writer before, that has the same
+        * content hash, or an invalid unique id if there is none. A writer can refer to the
+        * already written mesh instead of writing this one again.
+        */
+        const UniqueId& getDuplicateOf () const { return mDuplicateOf; }
+
+        /** Sets the unique id of the first mesh with the same content hash. */
+        void setDuplicateOf ( const UniqueId& duplicateOf ) { mDuplicateOf = duplicateOf; }
+
     };
 }
 
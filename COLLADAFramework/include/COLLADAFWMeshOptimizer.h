@@ -0,0 +1,141 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADAFW_MESHOPTIMIZER_H__
+#define __COLLADAFW_MESHOPTIMIZER_H__
+
+#include "COLLADAFWPrerequisites.h"
+
+
+namespace COLLADAFW
+{
+	class Mesh;
+	class MeshPrimitive;
+
+	/** Reorders the data of a loaded mesh to render it faster, without changing its appearance.
+	Writers can call optimize() on a mesh passed to them, before they convert it.
+	Two optimizations are available:
+	- Vertex cache optimization reorders the triangles of each triangles primitive, such that
+	  vertices are reused while they are still in the post transform cache of the GPU (Tom Forsyth,
+	  "Linear-Speed Vertex Cache Optimisation"). A vertex is the combination of all indices of a
+	  corner of a triangle.
+	- Vertex fetch optimization reorders the positions, normals, tangents and binormals of the mesh
+	  in the order they are first referenced by the primitives, for linear memory access. This
+	  changes the indices of the positions, i.e. it must not be used on meshes whose positions are
+	  referenced by other objects, like the influences of a skin controller or morph targets.
+	The primitives are optimized in parallel, if the framework is built with OpenMP.*/
+	class MeshOptimizer
+	{
+	public:
+
+		/** The optimizations to perform.*/
+		enum OptimizationFlags
+		{
+			OPTIMIZE_VERTEX_CACHE = 1<<0,	//!< Reorder the triangles of each triangles primitive
+			OPTIMIZE_VERTEX_FETCH = 1<<1	//!< Reorder the vertex data in the order of first use
+		};
+
+		/** The default size of the FIFO cache simulated to calculate the statistics.*/
+		static const size_t DEFAULT_STATISTICS_CACHE_SIZE = 16;
+
+		/** Statistics of the vertex cache efficiency of triangles primitives.*/
+		struct Statistics
+		{
+			/** The number of triangles.*/
+			size_t triangleCount;
+
+			/** The number of distinct vertices.*/
+			size_t vertexCount;
+
+			/** The number of vertices that have to be transformed, i.e. that are not in the simulated cache.*/
+			size_t cacheMissCount;
+
+			Statistics() : triangleCount(0), vertexCount(0), cacheMissCount(0) {}
+
+			/** Returns the average cache miss ratio, i.e. the transformed vertices per triangle. Lower is
+			better, the optimum is about 0.5 for large regular meshes.*/
+			double getACMR() const { return triangleCount ? (double)cacheMissCount / (double)triangleCount : 0; }
+
+			/** Returns the average transformed vertex ratio, i.e. the transformed vertices per distinct
+			vertex. The optimum is 1.*/
+			double getATVR() const { return vertexCount ? (double)cacheMissCount / (double)vertexCount : 0; }
+
+			Statistics& operator+=( const Statistics& other )
+			{
+				triangleCount += other.triangleCount;
+				vertexCount += other.vertexCount;
+				cacheMissCount += other.cacheMissCount;
+				return *this;
+			}
+		};
+
+	private:
+
+		/** A combination of OptimizationFlags.*/
+		int mOptimizationFlags;
+
+		/** The size of the FIFO cache simulated to calculate the statistics.*/
+		size_t mStatisticsCacheSize;
+
+		/** The statistics of all triangles primitives passed to optimize() before they were optimized.*/
+		Statistics mStatisticsBefore;
+
+		/** The statistics of all triangles primitives passed to optimize() after they were optimized.*/
+		Statistics mStatisticsAfter;
+
+	public:
+
+		/** Constructor.
+		@param optimizationFlags A combination of OptimizationFlags.*/
+		MeshOptimizer( int optimizationFlags = OPTIMIZE_VERTEX_CACHE );
+
+		/** Destructor. */
+		virtual ~MeshOptimizer();
+
+		/** Sets the size of the FIFO cache simulated to calculate the statistics.*/
+		void setStatisticsCacheSize( size_t statisticsCacheSize ) { mStatisticsCacheSize = statisticsCacheSize; }
+
+		/** Performs the optimizations on @a mesh and adds the statistics of its triangles primitives
+		to the statistics returned by getStatisticsBefore() and getStatisticsAfter().
+		@return False, if the mesh could not be optimized, because its indices are out of range.*/
+		bool optimize( Mesh* mesh );
+
+		/** Returns the statistics of all meshes passed to optimize(), before they were optimized.*/
+		const Statistics& getStatisticsBefore() const { return mStatisticsBefore; }
+
+		/** Returns the statistics of all meshes passed to optimize(), after they were optimized.*/
+		const Statistics& getStatisticsAfter() const { return mStatisticsAfter; }
+
+		/** Calculates the statistics of the triangles primitive @a triangles, using a FIFO cache with
+		@a cacheSize entries. Other primitives types are ignored.*/
+		static Statistics calculateStatistics( const MeshPrimitive* triangles, size_t cacheSize = DEFAULT_STATISTICS_CACHE_SIZE );
+
+		/** Reorders the triangles of the triangles primitive @a triangles to improve the vertex cache
+		efficiency. Other primitives types are ignored.*/
+		static void optimizeVertexCache( MeshPrimitive* triangles );
+
+		/** Reorders the positions, normals, tangents and binormals of @a mesh in the order they are first
+		referenced and adjusts the indices of all primitives accordingly.
+		@return False, if an index is out of range. The mesh is not changed in that case.*/
+		static bool optimizeVertexFetch( Mesh* mesh );
+
+	private:
+
+		/** Disable default copy ctor. */
+		MeshOptimizer( const MeshOptimizer& pre );
+
+		/** Disable default assignment operator. */
+		const MeshOptimizer& operator= ( const MeshOptimizer& pre );
+
+	};
+
+} // namespace COLLADAFW
+
+#endif // __COLLADAFW_MESHOPTIMIZER_H__
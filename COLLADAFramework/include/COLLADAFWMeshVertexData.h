@@ -59,11 +59,7 @@ namespace COLLADAFW
         /** Destructor. */
         virtual ~MeshVertexData()
         {
-            for ( size_t i=0; i<mInputInfosArray.getCount(); ++i )
-            {
-                delete mInputInfosArray [i];
-            }
-            mInputInfosArray.releaseMemory ();
+            clearInputInfos ();
         }
 
         /**
@@ -74,6 +70,16 @@ namespace COLLADAFW
 		/** Returns the InputInfosArray.*/
 		const InputInfosArray& getInputInfosArray() const { return mInputInfosArray; }
 
+        /** Removes all the additional informations about the input elements. */
+        void clearInputInfos ()
+        {
+            for ( size_t i=0; i<mInputInfosArray.getCount(); ++i )
+            {
+                delete mInputInfosArray [i];
+            }
+            mInputInfosArray.releaseMemory ();
+        }
+
         /**
         * Appends the values in the array on the list of values and stores the information
         * of the current input.
@@ -114,6 +120,22 @@ namespace COLLADAFW
             mInputInfosArray.append ( info );
         }
 
+        /**
+        * Stores the information of an input whose values are already in the list of values.
+        * @param const String& name The name of the input.
+        * @param const size_t stride The data stride.
+        * @param const size_t length The number of values of the input.
+        */
+        void appendInputInfos ( const String& name, const size_t stride, const size_t length )
+        {
+            InputInfos* info = new InputInfos();
+            info->mLength = length;
+            info->mName = name;
+            info->mStride = stride;
+
+            mInputInfosArray.append ( info );
+        }
+
         /** The stride at the specified index. */
         String getName ( size_t index ) const
         {
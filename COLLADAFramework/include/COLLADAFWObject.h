@@ -13,6 +13,7 @@ http://www.opensource.org/licenses/mit-license.php
 
 #include "COLLADAFWPrerequisites.h"
 #include "COLLADAFWUniqueId.h"
+#include "COLLADAFWMemoryArena.h"
 
 
 namespace COLLADAFW
@@ -23,6 +24,8 @@ namespace COLLADAFW
 	class Object
 	{
 	public:
+		COLLADAFW_ARENA_ALLOCATED
+
 		virtual ~Object(){};
 
 		/** Returns the class id of the object.*/
@@ -0,0 +1,202 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADAFW_PACKEDSKININFLUENCES_H__
+#define __COLLADAFW_PACKEDSKININFLUENCES_H__
+
+#include "COLLADAFWPrerequisites.h"
+#include "COLLADAFWTypes.h"
+#include "COLLADAFWArrayPrimitiveType.h"
+
+
+namespace COLLADAFW
+{
+	class SkinControllerData;
+
+	/** Holds the influences of a skin controller in a fixed stride layout, i.e. exactly
+	getInfluencesPerVertex() joint indices and weights per vertex. The i'th vertex uses the joint
+	indices and weights starting at i * getInfluencesPerVertex(). Unused slots are padded with joint
+	index 0 and weight 0. This is the layout expected by GPU skinning pipelines.
+	The data can be created from the variable length representation used by SkinControllerData
+	(joints per vertex, joint indices and weight indices into a shared weight array) using pack().*/
+	class PackedSkinInfluences
+	{
+	public:
+
+		/** The format the weights are stored in.*/
+		enum WeightFormat
+		{
+			WEIGHT_FORMAT_FLOAT,	//!< Weights are stored as floats, see getFloatWeights()
+			WEIGHT_FORMAT_UNORM16,	//!< Weights are quantized to [0, 65535], see getUnorm16Weights()
+			WEIGHT_FORMAT_UNORM8	//!< Weights are quantized to [0, 255], see getUnorm8Weights()
+		};
+
+		/** The maximum number of influences per vertex that can be packed.*/
+		static const size_t MAX_INFLUENCES_PER_VERTEX = 16;
+
+		/** Options to control the packing.*/
+		struct Options
+		{
+			/** The number of influences stored per vertex. If a vertex has more influences, only the
+			influences with the largest weights are kept. Must be in [1, MAX_INFLUENCES_PER_VERTEX].*/
+			size_t influencesPerVertex;
+
+			/** Influences with a weight smaller or equal to this value are discarded.*/
+			double minimumWeight;
+
+			/** If true, the weights of each vertex are scaled to sum up to one after pruning.
+			Quantized weights are adjusted to sum up to exactly the maximum quantized value.*/
+			bool renormalize;
+
+			/** The format the weights are stored in.*/
+			WeightFormat weightFormat;
+
+			/** Initializes the options with 4 influences per vertex, float weights and renormalization.*/
+			Options()
+				: influencesPerVertex(4)
+				, minimumWeight(0)
+				, renormalize(true)
+				, weightFormat(WEIGHT_FORMAT_FLOAT)
+			{}
+		};
+
+		typedef ArrayPrimitiveType<unsigned short> UShortValuesArray;
+		typedef ArrayPrimitiveType<unsigned char> UCharValuesArray;
+
+	private:
+
+		/** The number of vertices.*/
+		size_t mVertexCount;
+
+		/** The number of influences stored per vertex.*/
+		size_t mInfluencesPerVertex;
+
+		/** The format the weights are stored in.*/
+		WeightFormat mWeightFormat;
+
+		/** The joint indices, mInfluencesPerVertex per vertex.*/
+		UShortValuesArray mJointIndices;
+
+		/** The weights, if mWeightFormat is WEIGHT_FORMAT_FLOAT.*/
+		FloatArray mFloatWeights;
+
+		/** The weights, if mWeightFormat is WEIGHT_FORMAT_UNORM16.*/
+		UShortValuesArray mUnorm16Weights;
+
+		/** The weights, if mWeightFormat is WEIGHT_FORMAT_UNORM8.*/
+		UCharValuesArray mUnorm8Weights;
+
+		/** The number of influences that have been discarded during the last pack(), because a
+		vertex had more than mInfluencesPerVertex influences or because of the minimum weight.*/
+		size_t mDiscardedInfluencesCount;
+
+	public:
+
+		/** Constructor. */
+		PackedSkinInfluences();
+
+		/** Destructor. */
+		virtual ~PackedSkinInfluences();
+
+		/** Packs the influences of @a skinControllerData according to @a options. Previously packed
+		data is released.
+		Influences that reference the bind shape (joint index -1) are dropped.
+		@return True on success, false if the options or the skin data are invalid, or if the skin
+		controller uses more joints than can be addressed by 16 bit joint indices.*/
+		bool pack( const SkinControllerData& skinControllerData, const Options& options = Options() );
+
+		/** Packs influences given in the variable length representation used by SkinControllerData.
+		This overload allows exporters to pack their data without creating a SkinControllerData.
+		@param jointsPerVertex The number of influences of each vertex.
+		@param vertexCount The number of elements in @a jointsPerVertex.
+		@param jointIndices The joint index of each influence.
+		@param weightIndices The index into @a weights of each influence.
+		@param influencesCount The number of elements in @a jointIndices and in @a weightIndices. Must
+		not be less than the sum of @a jointsPerVertex.
+		@param weights The shared weights array.
+		@param weightsCount The number of elements in @a weights.
+		@param jointsCount The number of joints of the skin controller.
+		@param options The options that control the packing.
+		@return True on success, false otherwise, e.g. if the influences of the vertices exceed
+		@a influencesCount.*/
+		bool pack( const unsigned int* jointsPerVertex,
+			       size_t vertexCount,
+			       const int* jointIndices,
+			       const unsigned int* weightIndices,
+			       size_t influencesCount,
+			       const float* weights,
+			       size_t weightsCount,
+			       size_t jointsCount,
+			       const Options& options = Options() );
+
+		/** @see pack(const unsigned int*, size_t, const int*, const unsigned int*, size_t, const float*, size_t, size_t, const Options&)*/
+		bool pack( const unsigned int* jointsPerVertex,
+			       size_t vertexCount,
+			       const int* jointIndices,
+			       const unsigned int* weightIndices,
+			       size_t influencesCount,
+			       const double* weights,
+			       size_t weightsCount,
+			       size_t jointsCount,
+			       const Options& options = Options() );
+
+		/** Releases all packed data.*/
+		void clear();
+
+		/** Returns the number of vertices.*/
+		size_t getVertexCount() const { return mVertexCount; }
+
+		/** Returns the number of influences stored per vertex, i.e. the stride of the joint indices
+		and weights arrays.*/
+		size_t getInfluencesPerVertex() const { return mInfluencesPerVertex; }
+
+		/** Returns the format the weights are stored in.*/
+		WeightFormat getWeightFormat() const { return mWeightFormat; }
+
+		/** Returns the joint indices, getInfluencesPerVertex() per vertex.*/
+		const UShortValuesArray& getJointIndices() const { return mJointIndices; }
+
+		/** Returns the weights, if the weight format is WEIGHT_FORMAT_FLOAT.*/
+		const FloatArray& getFloatWeights() const { return mFloatWeights; }
+
+		/** Returns the weights, if the weight format is WEIGHT_FORMAT_UNORM16.*/
+		const UShortValuesArray& getUnorm16Weights() const { return mUnorm16Weights; }
+
+		/** Returns the weights, if the weight format is WEIGHT_FORMAT_UNORM8.*/
+		const UCharValuesArray& getUnorm8Weights() const { return mUnorm8Weights; }
+
+		/** Returns the number of influences that have been discarded by the last pack().*/
+		size_t getDiscardedInfluencesCount() const { return mDiscardedInfluencesCount; }
+
+	private:
+
+		/** Packs the influences. Used by the public pack() methods.*/
+		template<class WeightType>
+		bool packInfluences( const unsigned int* jointsPerVertex,
+			                 size_t vertexCount,
+			                 const int* jointIndices,
+			                 const unsigned int* weightIndices,
+			                 size_t influencesCount,
+			                 const WeightType* weights,
+			                 size_t weightsCount,
+			                 size_t jointsCount,
+			                 const Options& options );
+
+		/** Disable default copy ctor. */
+		PackedSkinInfluences( const PackedSkinInfluences& pre );
+
+		/** Disable default assignment operator. */
+		const PackedSkinInfluences& operator= ( const PackedSkinInfluences& pre );
+
+	};
+
+} // namespace COLLADAFW
+
+#endif // __COLLADAFW_PACKEDSKININFLUENCES_H__
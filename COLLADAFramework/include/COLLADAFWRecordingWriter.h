@@ -0,0 +1,184 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADAFW_RECORDINGWRITER_H__
+#define __COLLADAFW_RECORDINGWRITER_H__
+
+#include "COLLADAFWPrerequisites.h"
+#include "COLLADAFWIWriter.h"
+
+#include <vector>
+#include <map>
+
+
+namespace COLLADAFW
+{
+
+	/** Writer that records the objects of a load, to pass them to other writers later on, without
+	loading the document again. This allows writers, that need multiple passes over a document, to
+	pay the costs of parsing it only once.
+	The recording writer takes the ownership of all objects passed to it (see takesObjectOwnership()),
+	i.e. the recorded objects are the objects created by the loader. They are deleted when the recording
+	writer is destroyed or cleared. The data embedded in images is copied. Meshes are not streamed.*/
+	class RecordingWriter : public IWriter
+	{
+	public:
+		/** Flags of the object types that can be replayed.*/
+		enum ObjectFlags
+		{
+			NO_FLAG = 0,
+			GLOBAL_ASSET_FLAG = 1 << 0,
+			SCENE_FLAG = 1 << 1,
+			VISUAL_SCENE_FLAG = 1 << 2,
+			LIBRARY_NODES_FLAG = 1 << 3,
+			GEOMETRY_FLAG = 1 << 4,
+			MATERIAL_FLAG = 1 << 5,
+			EFFECT_FLAG = 1 << 6,
+			CAMERA_FLAG = 1 << 7,
+			IMAGE_FLAG = 1 << 8,
+			LIGHT_FLAG = 1 << 9,
+			ANIMATION_FLAG = 1 << 10,
+			ANIMATION_LIST_FLAG = 1 << 11,
+			SKIN_CONTROLLER_DATA_FLAG = 1 << 12,
+			CONTROLLER_FLAG = 1 << 13,
+			FORMULAS_FLAG = 1 << 14,
+			KINEMATICS_SCENE_FLAG = 1 << 15,
+
+			ALL_OBJECTS_MASK = (1 << 16) - 1
+		};
+
+	private:
+		/** The data embedded in an image.*/
+		typedef std::vector<unsigned char> ImageData;
+
+		/** A recorded object.*/
+		struct Record
+		{
+			/** The type of the object, one of ObjectFlags.*/
+			ObjectFlags objectType;
+
+			/** The object. Its type depends on objectType.*/
+			const void* object;
+
+			/** The embedded data of an image, if it has been passed to the writer, null otherwise.*/
+			ImageData* imageData;
+		};
+
+		typedef std::vector<Record> RecordList;
+
+		typedef std::map<const Image*, ImageData*> ImageImageDataMap;
+
+	private:
+		/** The recorded objects, in the order they have been passed to the writer.*/
+		RecordList mRecords;
+
+		/** The embedded data of the images, that have not been written yet.*/
+		ImageImageDataMap mPendingImageData;
+
+		/** True, if cancel() has been called during the recording.*/
+		bool mCanceled;
+
+		/** The error message passed to cancel().*/
+		String mErrorMessage;
+
+		/** True, if the recording has been finished.*/
+		bool mFinished;
+
+	public:
+
+        /** Constructor. */
+		RecordingWriter();
+
+        /** Destructor. Deletes all recorded objects. */
+		virtual ~RecordingWriter();
+
+		/** Deletes all recorded objects, to be able to record another load.*/
+		void clear();
+
+		/** Returns true, if a load has been recorded completely, i.e. finish() has been called.*/
+		bool isFinished() const { return mFinished; }
+
+		/** Returns true, if the recorded load has been canceled.*/
+		bool isCanceled() const { return mCanceled; }
+
+		/** Passes the recorded objects of the types in @a objectFlags to @a writer, in the order they have
+		been recorded. As the loader does, start() is called before the first object and finish() after the
+		last one. If the recorded load has been canceled, cancel() is called before finish(). The objects
+		remain owned by the recording writer, i.e. @a writer must not keep them beyond its destruction.
+		@param objectFlags Combination of ObjectFlags.
+		@return False, if the recording is not finished or if @a writer failed to write an object.*/
+		bool replay( IWriter* writer, int objectFlags = ALL_OBJECTS_MASK ) const;
+
+		virtual void cancel( const String& errorMessage );
+
+		virtual void start();
+
+		virtual void finish();
+
+		virtual bool takesObjectOwnership() const { return true; }
+
+		virtual bool writeGlobalAsset( const FileInfo* asset );
+
+		virtual bool writeScene( const Scene* scene );
+
+		virtual bool writeVisualScene( const VisualScene* visualScene );
+
+		virtual bool writeLibraryNodes( const LibraryNodes* libraryNodes );
+
+		virtual bool writeGeometry( const Geometry* geometry );
+
+		virtual bool writeMaterial( const Material* material );
+
+		virtual bool writeEffect( const Effect* effect );
+
+		virtual bool writeCamera( const Camera* camera );
+
+		virtual bool writeImage( const Image* image );
+
+		virtual bool startImageData( const Image* image );
+
+		virtual bool writeImageData( const Image* image, const unsigned char* data, size_t length );
+
+		virtual bool writeLight( const Light* light );
+
+		virtual bool writeAnimation( const Animation* animation );
+
+		virtual bool writeAnimationList( const AnimationList* animationList );
+
+		virtual bool writeSkinControllerData( const SkinControllerData* skinControllerData );
+
+		virtual bool writeController( const Controller* controller );
+
+		virtual bool writeFormulas( const Formulas* formulas );
+
+		virtual bool writeKinematicsScene( const KinematicsScene* kinematicsScene );
+
+	private:
+
+        /** Disable default copy ctor. */
+		RecordingWriter( const RecordingWriter& pre );
+
+        /** Disable default assignment operator. */
+		const RecordingWriter& operator= ( const RecordingWriter& pre );
+
+		/** Appends @a object to the recorded objects.*/
+		void record( ObjectFlags objectType, const void* object, ImageData* imageData = 0 );
+
+		/** Deletes the object of @a record.*/
+		static void deleteObject( const Record& record );
+
+		/** Passes the object of @a record to @a writer.*/
+		static bool replayObject( const Record& record, IWriter* writer );
+
+	};
+
+} // namespace COLLADAFW
+
+#endif // __COLLADAFW_RECORDINGWRITER_H__
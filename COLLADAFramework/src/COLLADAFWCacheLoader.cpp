@@ -0,0 +1,1126 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADAFWStableHeaders.h"
+#include "COLLADAFWCacheLoader.h"
+#include "COLLADAFWCacheWriter.h"
+#include "COLLADAFWCacheFormat.h"
+#include "COLLADAFWIWriter.h"
+#include "COLLADAFWFileInfo.h"
+#include "COLLADAFWScene.h"
+#include "COLLADAFWVisualScene.h"
+#include "COLLADAFWLibraryNodes.h"
+#include "COLLADAFWNode.h"
+#include "COLLADAFWInstanceGeometry.h"
+#include "COLLADAFWInstanceController.h"
+#include "COLLADAFWInstanceNode.h"
+#include "COLLADAFWInstanceCamera.h"
+#include "COLLADAFWInstanceLight.h"
+#include "COLLADAFWInstanceVisualScene.h"
+#include "COLLADAFWTransformation.h"
+#include "COLLADAFWMatrix.h"
+#include "COLLADAFWTranslate.h"
+#include "COLLADAFWRotate.h"
+#include "COLLADAFWScale.h"
+#include "COLLADAFWLookat.h"
+#include "COLLADAFWSkew.h"
+#include "COLLADAFWGeometry.h"
+#include "COLLADAFWMesh.h"
+#include "COLLADAFWLines.h"
+#include "COLLADAFWLinestrips.h"
+#include "COLLADAFWTriangles.h"
+#include "COLLADAFWTristrips.h"
+#include "COLLADAFWTrifans.h"
+#include "COLLADAFWPolygons.h"
+#include "COLLADAFWPolylist.h"
+#include "COLLADAFWMaterial.h"
+#include "COLLADAFWEffect.h"
+#include "COLLADAFWEffectCommon.h"
+#include "COLLADAFWCamera.h"
+#include "COLLADAFWImage.h"
+#include "COLLADAFWLight.h"
+#include "COLLADAFWAnimationCurve.h"
+#include "COLLADAFWAnimationList.h"
+#include "COLLADAFWSkinControllerData.h"
+#include "COLLADAFWSkinController.h"
+#include "COLLADAFWMorphController.h"
+#include "COLLADAFWFormulas.h"
+#include "COLLADAFWKinematicsScene.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(COLLADABU_OS_WIN)
+#	include <windows.h>
+#else
+#	include <sys/types.h>
+#	include <sys/stat.h>
+#	include <sys/mman.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+
+namespace COLLADAFW
+{
+	typedef CacheFormat::InputStream InputStream;
+
+	/** The size of the blocks the document is read in, to calculate its key.*/
+	static const size_t KEY_READ_BLOCK_SIZE = 1024 * 1024;
+
+	//------------------------------
+	static UniqueId readUniqueId( InputStream& stream )
+	{
+		ClassId classId = (ClassId)stream.readUInt64();
+		ObjectId objectId = (ObjectId)stream.readUInt64();
+		FileId fileId = (FileId)stream.readUInt64();
+		return UniqueId( classId, objectId, fileId );
+	}
+
+	//------------------------------
+	static void readUniqueIdArray( InputStream& stream, UniqueIdArray& uniqueIds )
+	{
+		size_t count = stream.readCount();
+		uniqueIds.allocMemory( count );
+		uniqueIds.setCount( count );
+		for ( size_t i = 0; i < count; ++i )
+			uniqueIds[i] = readUniqueId( stream );
+	}
+
+	//------------------------------
+	static COLLADABU::Math::Vector3 readVector3( InputStream& stream )
+	{
+		double x = stream.readDouble();
+		double y = stream.readDouble();
+		double z = stream.readDouble();
+		return COLLADABU::Math::Vector3( x, y, z );
+	}
+
+	//------------------------------
+	static void readMatrix4( InputStream& stream, COLLADABU::Math::Matrix4& matrix )
+	{
+		for ( size_t i = 0; i < 16; ++i )
+			matrix.setElement( i, stream.readDouble() );
+	}
+
+	//------------------------------
+	/** Lets @a array use the elements stored in the stream, without copying them.*/
+	template<class T>
+	static void readArray( InputStream& stream, ArrayPrimitiveType<T>& array )
+	{
+		size_t count = 0;
+		T* data = stream.readArray<T>( count );
+		if ( !data )
+			return;
+		array.setData( data, count );
+		array.yieldOwnerShip();
+	}
+
+	//------------------------------
+	static void readAnimatableFloat( InputStream& stream, AnimatableFloat& value )
+	{
+		value.setAnimationList( readUniqueId( stream ) );
+		value.setValue( stream.readDouble() );
+	}
+
+	//------------------------------
+	static void readColor( InputStream& stream, Color& color )
+	{
+		color.setAnimationList( readUniqueId( stream ) );
+		color.setRed( stream.readDouble() );
+		color.setGreen( stream.readDouble() );
+		color.setBlue( stream.readDouble() );
+		color.setAlpha( stream.readDouble() );
+	}
+
+	//------------------------------
+	static void readFloatOrDoubleArray( InputStream& stream, FloatOrDoubleArray& array )
+	{
+		array.setAnimationList( readUniqueId( stream ) );
+		FloatOrDoubleArray::DataType type = (FloatOrDoubleArray::DataType)stream.readUInt64();
+		if ( type == FloatOrDoubleArray::DATA_TYPE_FLOAT )
+		{
+			array.setType( type );
+			readArray( stream, *array.getFloatValues() );
+		}
+		else if ( type == FloatOrDoubleArray::DATA_TYPE_DOUBLE )
+		{
+			array.setType( type );
+			readArray( stream, *array.getDoubleValues() );
+		}
+		else if ( type != FloatOrDoubleArray::DATA_TYPE_UNKNOWN )
+		{
+			stream.invalidate();
+		}
+	}
+
+	//------------------------------
+	static void readMeshVertexData( InputStream& stream, MeshVertexData& vertexData )
+	{
+		readFloatOrDoubleArray( stream, vertexData );
+		size_t inputInfosCount = stream.readCount();
+		for ( size_t i = 0; i < inputInfosCount; ++i )
+		{
+			String name = stream.readString();
+			size_t stride = (size_t)stream.readUInt64();
+			size_t length = (size_t)stream.readUInt64();
+			vertexData.appendInputInfos( name, stride, length );
+		}
+	}
+
+	//------------------------------
+	static void readIndexLists( InputStream& stream, IndexListArray& indexLists )
+	{
+		size_t count = stream.readCount();
+		for ( size_t i = 0; i < count; ++i )
+		{
+			IndexList* indexList = FW_NEW IndexList();
+			indexLists.append( indexList );
+			indexList->setName( stream.readString() );
+			indexList->setStride( (size_t)stream.readUInt64() );
+			indexList->setSetIndex( (size_t)stream.readUInt64() );
+			indexList->setInitialIndex( (size_t)stream.readUInt64() );
+			readArray( stream, indexList->getIndices() );
+		}
+	}
+
+	//------------------------------
+	template<class VertexCountType>
+	static void readFaceVertexCounts( InputStream& stream, MeshPrimitive* meshPrimitive )
+	{
+		readArray( stream, ((MeshPrimitiveWithFaceVertexCount<VertexCountType>*)meshPrimitive)->getGroupedVerticesVertexCountArray() );
+	}
+
+	//------------------------------
+	static MeshPrimitive* readMeshPrimitive( InputStream& stream )
+	{
+		UniqueId uniqueId = readUniqueId( stream );
+		MeshPrimitive::PrimitiveType primitiveType = (MeshPrimitive::PrimitiveType)stream.readUInt64();
+
+		MeshPrimitive* meshPrimitive = 0;
+		switch ( primitiveType )
+		{
+		case MeshPrimitive::LINES:
+			meshPrimitive = FW_NEW Lines( uniqueId );
+			break;
+		case MeshPrimitive::LINE_STRIPS:
+			meshPrimitive = FW_NEW Linestrips( uniqueId );
+			break;
+		case MeshPrimitive::POLYGONS:
+			meshPrimitive = FW_NEW Polygons( uniqueId );
+			break;
+		case MeshPrimitive::POLYLIST:
+			meshPrimitive = FW_NEW Polylist( uniqueId );
+			break;
+		case MeshPrimitive::TRIANGLES:
+			meshPrimitive = FW_NEW Triangles( uniqueId );
+			break;
+		case MeshPrimitive::TRIANGLE_FANS:
+			meshPrimitive = FW_NEW Trifans( uniqueId );
+			break;
+		case MeshPrimitive::TRIANGLE_STRIPS:
+			meshPrimitive = FW_NEW Tristrips( uniqueId );
+			break;
+		default:
+			meshPrimitive = FW_NEW MeshPrimitive( uniqueId, primitiveType );
+			break;
+		}
+
+		meshPrimitive->setFaceCount( (size_t)stream.readUInt64() );
+		meshPrimitive->setMaterial( stream.readString() );
+		meshPrimitive->setMaterialId( (MaterialId)stream.readUInt64() );
+
+		readArray( stream, meshPrimitive->getPositionIndices() );
+		readArray( stream, meshPrimitive->getNormalIndices() );
+		readArray( stream, meshPrimitive->getTangentIndices() );
+		readArray( stream, meshPrimitive->getBinormalIndices() );
+
+		readIndexLists( stream, meshPrimitive->getColorIndicesArray() );
+		readIndexLists( stream, meshPrimitive->getUVCoordIndicesArray() );
+
+		switch ( primitiveType )
+		{
+		case MeshPrimitive::POLYGONS:
+		case MeshPrimitive::POLYLIST:
+			readFaceVertexCounts<int>( stream, meshPrimitive );
+			break;
+		case MeshPrimitive::TRIANGLE_STRIPS:
+			readFaceVertexCounts<unsigned int>( stream, meshPrimitive );
+			((Tristrips*)meshPrimitive)->setTristripCount( (size_t)stream.readUInt64() );
+			break;
+		case MeshPrimitive::TRIANGLE_FANS:
+			readFaceVertexCounts<unsigned int>( stream, meshPrimitive );
+			((Trifans*)meshPrimitive)->setTrifanCount( (size_t)stream.readUInt64() );
+			break;
+		case MeshPrimitive::LINE_STRIPS:
+			readFaceVertexCounts<unsigned int>( stream, meshPrimitive );
+			((Linestrips*)meshPrimitive)->setLinestripCount( (size_t)stream.readUInt64() );
+			break;
+		default:
+			break;
+		}
+		return meshPrimitive;
+	}
+
+	//------------------------------
+	static Mesh* readMesh( InputStream& stream )
+	{
+		Mesh* mesh = FW_NEW Mesh( readUniqueId( stream ) );
+		mesh->setOriginalId( stream.readString() );
+		mesh->setName( stream.readString() );
+
+		readMeshVertexData( stream, mesh->getPositions() );
+		readMeshVertexData( stream, mesh->getNormals() );
+		readMeshVertexData( stream, mesh->getColors() );
+		readMeshVertexData( stream, mesh->getUVCoords() );
+		readMeshVertexData( stream, mesh->getTangents() );
+		readMeshVertexData( stream, mesh->getBinormals() );
+
+		size_t meshPrimitivesCount = stream.readCount();
+		for ( size_t i = 0; i < meshPrimitivesCount; ++i )
+			mesh->appendPrimitive( readMeshPrimitive( stream ) );
+
+		unsigned long long contentHashHigh = stream.readUInt64();
+		unsigned long long contentHashLow = stream.readUInt64();
+		mesh->setContentHash( COLLADABU::ContentHash( contentHashHigh, contentHashLow ) );
+		mesh->setDuplicateOf( readUniqueId( stream ) );
+		return mesh;
+	}
+
+	//------------------------------
+	template<COLLADA_TYPE::ClassId classId>
+	static InstanceBase<classId>* readInstance( InputStream& stream )
+	{
+		UniqueId uniqueId = readUniqueId( stream );
+		UniqueId instanciatedObjectId = readUniqueId( stream );
+		InstanceBase<classId>* instance = FW_NEW InstanceBase<classId>( uniqueId, instanciatedObjectId );
+		instance->setName( stream.readString() );
+		return instance;
+	}
+
+	//------------------------------
+	template<COLLADA_TYPE::ClassId classId>
+	static void readInstances( InputStream& stream, PointerArray< InstanceBase<classId> >& instances )
+	{
+		size_t count = stream.readCount();
+		for ( size_t i = 0; i < count; ++i )
+			instances.append( readInstance<classId>( stream ) );
+	}
+
+	//------------------------------
+	template<COLLADA_TYPE::ClassId classId>
+	static void readInstanceBindings( InputStream& stream, PointerArray< InstanceBindingBase<classId> >& instances )
+	{
+		size_t count = stream.readCount();
+		for ( size_t i = 0; i < count; ++i )
+		{
+			UniqueId uniqueId = readUniqueId( stream );
+			UniqueId instanciatedObjectId = readUniqueId( stream );
+			InstanceBindingBase<classId>* instance = FW_NEW InstanceBindingBase<classId>( uniqueId, instanciatedObjectId );
+			instances.append( instance );
+			instance->setName( stream.readString() );
+
+			MaterialBindingArray& materialBindings = instance->getMaterialBindings();
+			size_t materialBindingsCount = stream.readCount();
+			if ( materialBindingsCount == 0 )
+				continue;
+			materialBindings.allocMemory( materialBindingsCount );
+			materialBindings.setCount( materialBindingsCount );
+			for ( size_t j = 0; j < materialBindingsCount; ++j )
+			{
+				MaterialBinding& materialBinding = materialBindings[j];
+				materialBinding.setMaterialId( (MaterialId)stream.readUInt64() );
+				materialBinding.setReferencedMaterial( readUniqueId( stream ) );
+				materialBinding.setName( stream.readString() );
+
+				TextureCoordinateBindingArray& textureCoordinateBindings = materialBinding.getTextureCoordinateBindingArray();
+				size_t textureCoordinateBindingsCount = stream.readCount();
+				if ( textureCoordinateBindingsCount == 0 )
+					continue;
+				textureCoordinateBindings.allocMemory( textureCoordinateBindingsCount );
+				textureCoordinateBindings.setCount( textureCoordinateBindingsCount );
+				for ( size_t k = 0; k < textureCoordinateBindingsCount; ++k )
+				{
+					TextureCoordinateBinding& textureCoordinateBinding = textureCoordinateBindings[k];
+					textureCoordinateBinding.setTextureMapId( (TextureMapId)stream.readUInt64() );
+					textureCoordinateBinding.setSetIndex( (size_t)stream.readUInt64() );
+					textureCoordinateBinding.setSemantic( stream.readString() );
+				}
+			}
+		}
+	}
+
+	//------------------------------
+	static Transformation* readTransformation( InputStream& stream )
+	{
+		Transformation::TransformationType transformationType = (Transformation::TransformationType)stream.readUInt64();
+		UniqueId animationList = readUniqueId( stream );
+
+		Transformation* transformation = 0;
+		switch ( transformationType )
+		{
+		case Transformation::MATRIX:
+			{
+				COLLADABU::Math::Matrix4 matrix;
+				readMatrix4( stream, matrix );
+				transformation = FW_NEW Matrix( matrix );
+				break;
+			}
+		case Transformation::TRANSLATE:
+			transformation = FW_NEW Translate( readVector3( stream ) );
+			break;
+		case Transformation::ROTATE:
+			{
+				COLLADABU::Math::Vector3 rotationAxis = readVector3( stream );
+				transformation = FW_NEW Rotate( rotationAxis, stream.readDouble() );
+				break;
+			}
+		case Transformation::SCALE:
+			transformation = FW_NEW Scale( readVector3( stream ) );
+			break;
+		case Transformation::LOOKAT:
+			{
+				Lookat* lookat = FW_NEW Lookat();
+				COLLADABU::Math::Vector3 eyePosition = readVector3( stream );
+				COLLADABU::Math::Vector3 interestPointPosition = readVector3( stream );
+				COLLADABU::Math::Vector3 upAxisDirection = readVector3( stream );
+				lookat->setEyePosition( eyePosition );
+				lookat->setInterestPointPosition( interestPointPosition );
+				lookat->setUpAxisDirection( upAxisDirection );
+				transformation = lookat;
+				break;
+			}
+		case Transformation::SKEW:
+			{
+				Skew* skew = FW_NEW Skew();
+				skew->setRotateAxis( readVector3( stream ) );
+				skew->setTranslateAxis( readVector3( stream ) );
+				skew->setAngle( (float)stream.readDouble() );
+				transformation = skew;
+				break;
+			}
+		default:
+			stream.invalidate();
+			return 0;
+		}
+
+		transformation->setAnimationList( animationList );
+		return transformation;
+	}
+
+	//------------------------------
+	static void readNodes( InputStream& stream, NodePointerArray& nodes )
+	{
+		size_t nodesCount = stream.readCount();
+		for ( size_t i = 0; i < nodesCount && stream.isValid(); ++i )
+		{
+			Node* node = FW_NEW Node( readUniqueId( stream ) );
+			nodes.append( node );
+			node->setOriginalId( stream.readString() );
+			node->setName( stream.readString() );
+			node->setSid( stream.readString() );
+			node->setType( (Node::NodeType)stream.readUInt64() );
+
+			TransformationPointerArray& transformations = node->getTransformations();
+			size_t transformationsCount = stream.readCount();
+			for ( size_t j = 0; j < transformationsCount; ++j )
+			{
+				Transformation* transformation = readTransformation( stream );
+				if ( !transformation )
+					break;
+				transformations.append( transformation );
+			}
+
+			readInstanceBindings( stream, node->getInstanceGeometries() );
+			readInstanceBindings( stream, node->getInstanceControllers() );
+			readInstances( stream, node->getInstanceNodes() );
+			readInstances( stream, node->getInstanceCameras() );
+			readInstances( stream, node->getInstanceLights() );
+
+			readNodes( stream, node->getChildNodes() );
+		}
+	}
+
+	//------------------------------
+	static void readColorOrTexture( InputStream& stream, ColorOrTexture& colorOrTexture )
+	{
+		colorOrTexture.setType( (ColorOrTexture::Type)stream.readUInt64() );
+		readColor( stream, colorOrTexture.getColor() );
+		Texture& texture = colorOrTexture.getTexture();
+		UniqueId textureUniqueId = readUniqueId( stream );
+		if ( textureUniqueId.isValid() )
+			texture.setUniqueId( textureUniqueId );
+		texture.setSamplerId( (SamplerID)stream.readUInt64() );
+		texture.setTextureMapId( (TextureMapId)stream.readUInt64() );
+		texture.setTexcoord( stream.readString() );
+	}
+
+	//------------------------------
+	static void readFloatOrParam( InputStream& stream, FloatOrParam& floatOrParam )
+	{
+		floatOrParam.setAnimationList( readUniqueId( stream ) );
+		floatOrParam.setType( (FloatOrParam::Type)stream.readUInt64() );
+		floatOrParam.setFloatValue( (float)stream.readDouble() );
+		Param param;
+		param.setName( stream.readString() );
+		param.setSid( stream.readString() );
+		param.setType( (ValueType::ColladaType)stream.readUInt64() );
+		param.setSemantic( stream.readString() );
+		floatOrParam.setParam( param );
+	}
+
+	//------------------------------
+	static Sampler* readSampler( InputStream& stream )
+	{
+		Sampler* sampler = FW_NEW Sampler( readUniqueId( stream ) );
+		sampler->setSamplerType( (Sampler::SamplerType)stream.readUInt64() );
+		sampler->setSource( readUniqueId( stream ) );
+		sampler->setMinFilter( (Sampler::SamplerFilter)stream.readUInt64() );
+		sampler->setMagFilter( (Sampler::SamplerFilter)stream.readUInt64() );
+		sampler->setMipFilter( (Sampler::SamplerFilter)stream.readUInt64() );
+		sampler->setWrapS( (Sampler::WrapMode)stream.readUInt64() );
+		sampler->setWrapT( (Sampler::WrapMode)stream.readUInt64() );
+		sampler->setWrapP( (Sampler::WrapMode)stream.readUInt64() );
+		Color borderColor;
+		readColor( stream, borderColor );
+		sampler->setBorderColor( borderColor );
+		sampler->setMipmapMaxlevel( (unsigned char)stream.readUInt64() );
+		sampler->setMipmapBias( (float)stream.readDouble() );
+		return sampler;
+	}
+
+	//------------------------------
+	static EffectCommon* readEffectCommon( InputStream& stream )
+	{
+		EffectCommon* effectCommon = FW_NEW EffectCommon();
+		effectCommon->setOriginalId( stream.readString() );
+		effectCommon->setShaderType( (EffectCommon::ShaderType)stream.readUInt64() );
+		readColorOrTexture( stream, effectCommon->getEmission() );
+		readColorOrTexture( stream, effectCommon->getAmbient() );
+		readColorOrTexture( stream, effectCommon->getDiffuse() );
+		readColorOrTexture( stream, effectCommon->getSpecular() );
+		readFloatOrParam( stream, effectCommon->getShininess() );
+		readColorOrTexture( stream, effectCommon->getReflective() );
+		readFloatOrParam( stream, effectCommon->getReflectivity() );
+		readColorOrTexture( stream, effectCommon->getOpacity() );
+		readFloatOrParam( stream, effectCommon->getIndexOfRefraction() );
+
+		SamplerPointerArray& samplers = effectCommon->getSamplerPointerArray();
+		size_t samplersCount = stream.readCount();
+		for ( size_t i = 0; i < samplersCount; ++i )
+			samplers.append( readSampler( stream ) );
+		return effectCommon;
+	}
+
+	//------------------------------
+	static FileInfo* readGlobalAsset( InputStream& stream )
+	{
+		FileInfo* asset = FW_NEW FileInfo();
+		FileInfo::Unit& unit = asset->getUnit();
+		unit.setLinearUnitName( stream.readString() );
+		unit.setLinearUnitMeter( stream.readDouble() );
+		unit.setLinearUnitUnit( (FileInfo::Unit::LinearUnit)stream.readUInt64() );
+		unit.setAngularUnitName( stream.readString() );
+		unit.setAngularUnit( (FileInfo::Unit::AngularUnit)stream.readUInt64() );
+		unit.setTimeUnitName( stream.readString() );
+		asset->setUpAxisType( (FileInfo::UpAxisType)stream.readUInt64() );
+
+		size_t valuePairsCount = stream.readCount();
+		for ( size_t i = 0; i < valuePairsCount; ++i )
+		{
+			String first = stream.readString();
+			String second = stream.readString();
+			asset->appendValuePair( first, second );
+		}
+		asset->setAbsoluteFileUri( COLLADABU::URI( stream.readString() ) );
+		return asset;
+	}
+
+	//------------------------------
+	static Scene* readScene( InputStream& stream )
+	{
+		Scene* scene = FW_NEW Scene( readUniqueId( stream ) );
+		if ( stream.readBool() )
+			scene->setInstanceVisualScene( readInstance<COLLADA_TYPE::INSTANCE_VISUAL_SCENE>( stream ) );
+		return scene;
+	}
+
+	//------------------------------
+	static VisualScene* readVisualScene( InputStream& stream )
+	{
+		VisualScene* visualScene = FW_NEW VisualScene( readUniqueId( stream ) );
+		visualScene->setName( stream.readString() );
+		readNodes( stream, visualScene->getRootNodes() );
+		return visualScene;
+	}
+
+	//------------------------------
+	static LibraryNodes* readLibraryNodes( InputStream& stream )
+	{
+		LibraryNodes* libraryNodes = FW_NEW LibraryNodes();
+		readNodes( stream, libraryNodes->getNodes() );
+		return libraryNodes;
+	}
+
+	//------------------------------
+	static Material* readMaterial( InputStream& stream )
+	{
+		Material* material = FW_NEW Material( readUniqueId( stream ) );
+		material->setOriginalId( stream.readString() );
+		material->setName( stream.readString() );
+		material->setInstantiatedEffect( readUniqueId( stream ) );
+		return material;
+	}
+
+	//------------------------------
+	static Effect* readEffect( InputStream& stream )
+	{
+		Effect* effect = FW_NEW Effect( readUniqueId( stream ) );
+		effect->setOriginalId( stream.readString() );
+		effect->setName( stream.readString() );
+		Color standardColor;
+		readColor( stream, standardColor );
+		effect->setStandardColor( standardColor );
+
+		CommonEffectPointerArray& commonEffects = effect->getCommonEffects();
+		size_t commonEffectsCount = stream.readCount();
+		for ( size_t i = 0; i < commonEffectsCount; ++i )
+			commonEffects.append( readEffectCommon( stream ) );
+
+		size_t extraTexturesCount = stream.readCount();
+		for ( size_t i = 0; i < extraTexturesCount; ++i )
+		{
+			TextureAttributes* textureAttributes = effect->createExtraTextureAttributes();
+			textureAttributes->samplerId = (SamplerID)stream.readUInt64();
+			textureAttributes->textureMapId = (TextureMapId)stream.readUInt64();
+			textureAttributes->textureSampler = stream.readString();
+			textureAttributes->texCoord = stream.readString();
+		}
+		return effect;
+	}
+
+	//------------------------------
+	static Camera* readCamera( InputStream& stream )
+	{
+		Camera* camera = FW_NEW Camera( readUniqueId( stream ) );
+		camera->setOriginalId( stream.readString() );
+		camera->setName( stream.readString() );
+		camera->setCameraType( (Camera::CameraType)stream.readUInt64() );
+		camera->setDescriptionType( (Camera::DescriptionType)stream.readUInt64() );
+		readAnimatableFloat( stream, camera->getXFov() );
+		readAnimatableFloat( stream, camera->getYFov() );
+		readAnimatableFloat( stream, camera->getAspectRatio() );
+		readAnimatableFloat( stream, camera->getNearClippingPlane() );
+		readAnimatableFloat( stream, camera->getFarClippingPlane() );
+		return camera;
+	}
+
+	//------------------------------
+	static Image* readImage( InputStream& stream, const unsigned char*& imageData, size_t& imageDataLength )
+	{
+		Image* image = FW_NEW Image( readUniqueId( stream ) );
+		image->setOriginalId( stream.readString() );
+		image->setSourceType( (Image::SourceType)stream.readUInt64() );
+		image->setName( stream.readString() );
+		image->setFormat( stream.readString() );
+		image->setHeight( (unsigned int)stream.readUInt64() );
+		image->setWidth( (unsigned int)stream.readUInt64() );
+		image->setDepth( (unsigned int)stream.readUInt64() );
+		image->setImageURI( COLLADABU::URI( stream.readString() ) );
+		imageData = stream.readArray<unsigned char>( imageDataLength );
+		return image;
+	}
+
+	//------------------------------
+	static Light* readLight( InputStream& stream )
+	{
+		Light* light = FW_NEW Light( readUniqueId( stream ) );
+		light->setOriginalId( stream.readString() );
+		light->setName( stream.readString() );
+		light->setLightType( (Light::LightType)stream.readUInt64() );
+		readColor( stream, light->getColor() );
+		readAnimatableFloat( stream, light->getConstantAttenuation() );
+		readAnimatableFloat( stream, light->getLinearAttenuation() );
+		readAnimatableFloat( stream, light->getQuadraticAttenuation() );
+		readAnimatableFloat( stream, light->getFallOffAngle() );
+		readAnimatableFloat( stream, light->getFallOffExponent() );
+		return light;
+	}
+
+	//------------------------------
+	static AnimationCurve* readAnimationCurve( InputStream& stream )
+	{
+		AnimationCurve* animationCurve = FW_NEW AnimationCurve( readUniqueId( stream ) );
+		animationCurve->setOriginalId( stream.readString() );
+		animationCurve->setName( stream.readString() );
+		animationCurve->setInPhysicalDimension( (PhysicalDimension)stream.readUInt64() );
+		readArray( stream, animationCurve->getOutPhysicalDimensions() );
+		animationCurve->setOutDimension( (size_t)stream.readUInt64() );
+		animationCurve->setInterpolationType( (AnimationCurve::InterpolationType)stream.readUInt64() );
+		readArray( stream, animationCurve->getInterpolationTypes() );
+		readFloatOrDoubleArray( stream, animationCurve->getInputValues() );
+		readFloatOrDoubleArray( stream, animationCurve->getOutputValues() );
+		readFloatOrDoubleArray( stream, animationCurve->getInTangentValues() );
+		readFloatOrDoubleArray( stream, animationCurve->getOutTangentValues() );
+		return animationCurve;
+	}
+
+	//------------------------------
+	static AnimationList* readAnimationList( InputStream& stream )
+	{
+		AnimationList* animationList = FW_NEW AnimationList( readUniqueId( stream ) );
+		AnimationList::AnimationBindings& animationBindings = animationList->getAnimationBindings();
+		size_t animationBindingsCount = stream.readCount();
+		if ( animationBindingsCount > 0 )
+			animationBindings.allocMemory( animationBindingsCount );
+		for ( size_t i = 0; i < animationBindingsCount; ++i )
+		{
+			AnimationList::AnimationBinding animationBinding;
+			animationBinding.animation = readUniqueId( stream );
+			animationBinding.animationClass = (AnimationList::AnimationClass)stream.readUInt64();
+			animationBinding.firstIndex = (size_t)stream.readUInt64();
+			animationBinding.secondIndex = (size_t)stream.readUInt64();
+			animationBindings.append( animationBinding );
+		}
+		return animationList;
+	}
+
+	//------------------------------
+	static SkinControllerData* readSkinControllerData( InputStream& stream )
+	{
+		SkinControllerData* skinControllerData = FW_NEW SkinControllerData( readUniqueId( stream ) );
+		skinControllerData->setOriginalId( stream.readString() );
+		skinControllerData->setName( stream.readString() );
+		skinControllerData->setJointsCount( (size_t)stream.readUInt64() );
+		COLLADABU::Math::Matrix4 bindShapeMatrix;
+		readMatrix4( stream, bindShapeMatrix );
+		skinControllerData->setBindShapeMatrix( bindShapeMatrix );
+
+		Matrix4Array& inverseBindMatrices = skinControllerData->getInverseBindMatrices();
+		size_t inverseBindMatricesCount = stream.readCount();
+		if ( inverseBindMatricesCount > 0 )
+		{
+			inverseBindMatrices.allocMemory( inverseBindMatricesCount );
+			inverseBindMatrices.setCount( inverseBindMatricesCount );
+			for ( size_t i = 0; i < inverseBindMatricesCount; ++i )
+				readMatrix4( stream, inverseBindMatrices[i] );
+		}
+
+		readFloatOrDoubleArray( stream, skinControllerData->getWeights() );
+		readArray( stream, skinControllerData->getJointsPerVertex() );
+		readArray( stream, skinControllerData->getWeightIndices() );
+		readArray( stream, skinControllerData->getJointIndices() );
+		return skinControllerData;
+	}
+
+	//------------------------------
+	static Controller* readController( InputStream& stream )
+	{
+		UniqueId uniqueId = readUniqueId( stream );
+		Controller::ControllerType controllerType = (Controller::ControllerType)stream.readUInt64();
+		UniqueId source = readUniqueId( stream );
+		if ( controllerType == Controller::CONTROLLER_TYPE_SKIN )
+		{
+			SkinController* skinController = FW_NEW SkinController( uniqueId );
+			skinController->setSource( source );
+			skinController->setSkinControllerData( readUniqueId( stream ) );
+			readUniqueIdArray( stream, skinController->getJoints() );
+			return skinController;
+		}
+		else
+		{
+			MorphController* morphController = FW_NEW MorphController( uniqueId );
+			morphController->setSource( source );
+			morphController->setOriginalId( stream.readString() );
+			morphController->setName( stream.readString() );
+			readUniqueIdArray( stream, morphController->getMorphTargets() );
+			readFloatOrDoubleArray( stream, morphController->getMorphWeights() );
+			return morphController;
+		}
+	}
+
+	//------------------------------
+	/** Passes @a object, that has been read from @a stream, to @a writer using @a writeFunction, if the
+	entire record has been read successfully. Deletes @a object, unless the writer takes its ownership.
+	@param valid Set to false, if the record is invalid.*/
+	template<class ObjectType, class WrittenType>
+	static bool passObject( InputStream& stream, ObjectType* object, IWriter* writer,
+		bool (IWriter::*writeFunction)( const WrittenType* ), bool& valid )
+	{
+		if ( !stream.isValid() || !stream.isAtEnd() )
+		{
+			FW_DELETE object;
+			valid = false;
+			return false;
+		}
+
+		bool success = (writer->*writeFunction)( object );
+		if ( !writer->takesObjectOwnership() )
+			FW_DELETE object;
+		return success;
+	}
+
+	//------------------------------
+	/** Reads the object in the record of type @a recordType and passes it to @a writer.
+	@param valid Set to false, if the record is invalid.
+	@return The result of the writer call.*/
+	static bool replayRecord( CacheFormat::RecordType recordType, InputStream& stream, IWriter* writer, bool& valid )
+	{
+		switch ( recordType )
+		{
+		case CacheFormat::RECORD_GLOBAL_ASSET:
+			return passObject( stream, readGlobalAsset( stream ), writer, &IWriter::writeGlobalAsset, valid );
+		case CacheFormat::RECORD_SCENE:
+			return passObject( stream, readScene( stream ), writer, &IWriter::writeScene, valid );
+		case CacheFormat::RECORD_VISUAL_SCENE:
+			return passObject( stream, readVisualScene( stream ), writer, &IWriter::writeVisualScene, valid );
+		case CacheFormat::RECORD_LIBRARY_NODES:
+			return passObject( stream, readLibraryNodes( stream ), writer, &IWriter::writeLibraryNodes, valid );
+		case CacheFormat::RECORD_GEOMETRY:
+			return passObject( stream, readMesh( stream ), writer, &IWriter::writeGeometry, valid );
+		case CacheFormat::RECORD_MATERIAL:
+			return passObject( stream, readMaterial( stream ), writer, &IWriter::writeMaterial, valid );
+		case CacheFormat::RECORD_EFFECT:
+			return passObject( stream, readEffect( stream ), writer, &IWriter::writeEffect, valid );
+		case CacheFormat::RECORD_CAMERA:
+			return passObject( stream, readCamera( stream ), writer, &IWriter::writeCamera, valid );
+		case CacheFormat::RECORD_IMAGE:
+			{
+				const unsigned char* imageData = 0;
+				size_t imageDataLength = 0;
+				Image* image = readImage( stream, imageData, imageDataLength );
+				// as the loader does, the embedded data is passed before the image itself
+				if ( stream.isValid() && stream.isAtEnd() && imageData && writer->startImageData( image ) )
+				{
+					if ( !writer->writeImageData( image, imageData, imageDataLength ) || !writer->finishImageData( image ) )
+					{
+						FW_DELETE image;
+						return false;
+					}
+				}
+				return passObject( stream, image, writer, &IWriter::writeImage, valid );
+			}
+		case CacheFormat::RECORD_LIGHT:
+			return passObject( stream, readLight( stream ), writer, &IWriter::writeLight, valid );
+		case CacheFormat::RECORD_ANIMATION:
+			return passObject( stream, readAnimationCurve( stream ), writer, &IWriter::writeAnimation, valid );
+		case CacheFormat::RECORD_ANIMATION_LIST:
+			return passObject( stream, readAnimationList( stream ), writer, &IWriter::writeAnimationList, valid );
+		case CacheFormat::RECORD_SKIN_CONTROLLER_DATA:
+			return passObject( stream, readSkinControllerData( stream ), writer, &IWriter::writeSkinControllerData, valid );
+		case CacheFormat::RECORD_CONTROLLER:
+			return passObject( stream, readController( stream ), writer, &IWriter::writeController, valid );
+		case CacheFormat::RECORD_FORMULAS:
+			return passObject( stream, FW_NEW Formulas(), writer, &IWriter::writeFormulas, valid );
+		case CacheFormat::RECORD_KINEMATICS_SCENE:
+			return passObject( stream, FW_NEW KinematicsScene(), writer, &IWriter::writeKinematicsScene, valid );
+		default:
+			valid = false;
+			return false;
+		}
+	}
+
+	//------------------------------
+	/** Appends everything besides the document content to @a hasher and returns the key.*/
+	static COLLADABU::ContentHash finishKey( COLLADABU::ContentHasher& hasher, unsigned long long documentLength,
+		const String& uri, const String& configurationKey )
+	{
+		hasher.updateValue( documentLength );
+		hasher.updateValue( (unsigned long long)uri.size() );
+		hasher.update( uri.data(), uri.size() );
+		hasher.updateValue( (unsigned long long)configurationKey.size() );
+		hasher.update( configurationKey.data(), configurationKey.size() );
+		hasher.updateValue( CacheFormat::VERSION );
+		return hasher.getHash();
+	}
+
+	//------------------------------
+	CacheLoader::CacheLoader( ILoader* fallbackLoader, const String& cacheDirectory )
+		: mFallbackLoader(fallbackLoader)
+		, mCacheDirectory(cacheDirectory)
+		, mCacheHit(false)
+		, mMapping(0)
+		, mMappingSize(0)
+		, mMappingIsFile(false)
+#if defined(COLLADABU_OS_WIN)
+		, mFileMapping(0)
+#endif
+	{
+	}
+
+	//------------------------------
+	CacheLoader::~CacheLoader()
+	{
+		releaseMapping();
+	}
+
+	//------------------------------
+	String CacheLoader::getCacheFileName( const COLLADABU::ContentHash& key ) const
+	{
+		String fileName = mCacheDirectory;
+		if ( !fileName.empty() && fileName[fileName.size() - 1] != '/' && fileName[fileName.size() - 1] != '\\' )
+			fileName += '/';
+		fileName += key.toString();
+		fileName += ".fwcache";
+		return fileName;
+	}
+
+	//------------------------------
+	COLLADABU::ContentHash CacheLoader::calculateKey( const String& uri, const char* buffer, size_t length ) const
+	{
+		COLLADABU::ContentHasher hasher;
+		hasher.update( buffer, length );
+		return finishKey( hasher, length, uri, mConfigurationKey );
+	}
+
+	//------------------------------
+	bool CacheLoader::calculateFileKey( const String& fileName, COLLADABU::ContentHash& key ) const
+	{
+		FILE* file = fopen( fileName.c_str(), "rb" );
+		if ( !file )
+			return false;
+
+		char* block = (char*)malloc( KEY_READ_BLOCK_SIZE );
+		if ( !block )
+		{
+			fclose( file );
+			return false;
+		}
+
+		COLLADABU::ContentHasher hasher;
+		unsigned long long documentLength = 0;
+		size_t readLength;
+		while ( (readLength = fread( block, 1, KEY_READ_BLOCK_SIZE, file )) > 0 )
+		{
+			hasher.update( block, readLength );
+			documentLength += readLength;
+		}
+		bool success = ferror( file ) == 0;
+		free( block );
+		fclose( file );
+
+		key = finishKey( hasher, documentLength, fileName, mConfigurationKey );
+		return success;
+	}
+
+	//------------------------------
+	bool CacheLoader::loadDocument( const String& fileName, IWriter* writer )
+	{
+		releaseMapping();
+		mCacheHit = false;
+
+		COLLADABU::ContentHash key;
+		if ( !calculateFileKey( fileName, key ) )
+			return mFallbackLoader->loadDocument( fileName, writer );
+
+		bool success = false;
+		if ( replayCacheFile( key, writer, success ) )
+		{
+			mCacheHit = true;
+			return success;
+		}
+
+		CacheWriter cacheWriter( writer );
+		success = mFallbackLoader->loadDocument( fileName, &cacheWriter );
+		if ( success )
+			cacheWriter.writeCacheFile( getCacheFileName( key ), key );
+		return success;
+	}
+
+	//------------------------------
+	bool CacheLoader::loadDocument( const String& uri, const char* buffer, int length, IWriter* writer )
+	{
+		releaseMapping();
+		mCacheHit = false;
+
+		if ( !buffer || length < 0 )
+			return mFallbackLoader->loadDocument( uri, buffer, length, writer );
+
+		COLLADABU::ContentHash key = calculateKey( uri, buffer, (size_t)length );
+
+		bool success = false;
+		if ( replayCacheFile( key, writer, success ) )
+		{
+			mCacheHit = true;
+			return success;
+		}
+
+		CacheWriter cacheWriter( writer );
+		success = mFallbackLoader->loadDocument( uri, buffer, length, &cacheWriter );
+		if ( success )
+			cacheWriter.writeCacheFile( getCacheFileName( key ), key );
+		return success;
+	}
+
+	//------------------------------
+	bool CacheLoader::replayCacheFile( const COLLADABU::ContentHash& key, IWriter* writer, bool& success )
+	{
+		if ( !mapFile( getCacheFileName( key ) ) )
+			return false;
+
+		// validate the entire file before the first object is passed to the writer
+		const CacheFormat::Header* header = (const CacheFormat::Header*)mMapping;
+		bool valid = mMappingSize >= sizeof(CacheFormat::Header)
+			&& memcmp( header->magic, CacheFormat::MAGIC, sizeof(header->magic) ) == 0
+			&& header->version == CacheFormat::VERSION
+			&& header->byteOrderMark == CacheFormat::BYTE_ORDER_MARK
+			&& header->keyHigh == key.high
+			&& header->keyLow == key.low
+			&& header->dataSize == mMappingSize - sizeof(CacheFormat::Header);
+		if ( valid )
+		{
+			COLLADABU::ContentHasher hasher;
+			hasher.update( mMapping + sizeof(CacheFormat::Header), (size_t)header->dataSize );
+			COLLADABU::ContentHash dataHash = hasher.getHash();
+			valid = header->dataHashHigh == dataHash.high && header->dataHashLow == dataHash.low;
+		}
+		if ( !valid )
+		{
+			releaseMapping();
+			return false;
+		}
+
+		InputStream stream( mMapping + sizeof(CacheFormat::Header), (size_t)header->dataSize );
+		unsigned long long recordCount = header->recordCount;
+
+		writer->start();
+
+		success = true;
+		for ( unsigned long long i = 0; i < recordCount && success; ++i )
+		{
+			CacheFormat::RecordType recordType = (CacheFormat::RecordType)stream.readUInt64();
+			size_t recordSize = (size_t)stream.readUInt64();
+			char* recordData = stream.skipPadded( recordSize );
+			if ( !stream.isValid() )
+			{
+				valid = false;
+				break;
+			}
+
+			InputStream recordStream( recordData, recordSize );
+			success = replayRecord( recordType, recordStream, writer, valid );
+			if ( !valid )
+				break;
+		}
+
+		if ( !valid )
+		{
+			// the file has been written by an incompatible version with the same format version
+			writer->cancel( "Invalid load cache file " + getCacheFileName( key ) );
+			success = false;
+		}
+
+		writer->finish();
+		return true;
+	}
+
+	//------------------------------
+	bool CacheLoader::mapFile( const String& fileName )
+	{
+#if defined(COLLADABU_OS_WIN)
+		HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+		if ( file == INVALID_HANDLE_VALUE )
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if ( GetFileSizeEx( file, &fileSize ) && fileSize.QuadPart > 0 )
+		{
+			mFileMapping = CreateFileMappingA( file, 0, PAGE_WRITECOPY, 0, 0, 0 );
+			if ( mFileMapping )
+			{
+				mMapping = (char*)MapViewOfFile( mFileMapping, FILE_MAP_COPY, 0, 0, 0 );
+				if ( mMapping )
+				{
+					mMappingSize = (size_t)fileSize.QuadPart;
+					mMappingIsFile = true;
+				}
+				else
+				{
+					CloseHandle( mFileMapping );
+					mFileMapping = 0;
+				}
+			}
+		}
+		CloseHandle( file );
+#else
+		int file = open( fileName.c_str(), O_RDONLY );
+		if ( file < 0 )
+			return false;
+
+		struct stat fileStatus;
+		if ( fstat( file, &fileStatus ) == 0 && fileStatus.st_size > 0 )
+		{
+			void* mapping = mmap( 0, (size_t)fileStatus.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0 );
+			if ( mapping != MAP_FAILED )
+			{
+				mMapping = (char*)mapping;
+				mMappingSize = (size_t)fileStatus.st_size;
+				mMappingIsFile = true;
+			}
+		}
+		close( file );
+#endif
+
+		if ( mMappingIsFile )
+			return true;
+
+		// The file could not be mapped. Read it instead.
+		FILE* stream = fopen( fileName.c_str(), "rb" );
+		if ( !stream )
+			return false;
+
+		fseek( stream, 0, SEEK_END );
+		long size = ftell( stream );
+		fseek( stream, 0, SEEK_SET );
+		if ( size > 0 )
+		{
+			// malloc returns memory aligned for all types, as required by the arrays
+			mMapping = (char*)malloc( (size_t)size );
+			if ( mMapping && fread( mMapping, 1, (size_t)size, stream ) == (size_t)size )
+			{
+				mMappingSize = (size_t)size;
+			}
+			else
+			{
+				free( mMapping );
+				mMapping = 0;
+			}
+		}
+		fclose( stream );
+		return mMapping != 0;
+	}
+
+	//------------------------------
+	void CacheLoader::releaseMapping()
+	{
+		if ( !mMapping )
+			return;
+
+		if ( mMappingIsFile )
+		{
+#if defined(COLLADABU_OS_WIN)
+			UnmapViewOfFile( mMapping );
+			CloseHandle( mFileMapping );
+			mFileMapping = 0;
+#else
+			munmap( mMapping, mMappingSize );
+#endif
+		}
+		else
+		{
+			free( mMapping );
+		}
+
+		mMapping = 0;
+		mMappingSize = 0;
+		mMappingIsFile = false;
+	}
+
+} // namespace COLLADAFW
@@ -0,0 +1,885 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADAFWStableHeaders.h"
+#include "COLLADAFWCacheWriter.h"
+#include "COLLADAFWCacheFormat.h"
+#include "COLLADAFWFileInfo.h"
+#include "COLLADAFWScene.h"
+#include "COLLADAFWVisualScene.h"
+#include "COLLADAFWLibraryNodes.h"
+#include "COLLADAFWNode.h"
+#include "COLLADAFWInstanceGeometry.h"
+#include "COLLADAFWInstanceController.h"
+#include "COLLADAFWInstanceNode.h"
+#include "COLLADAFWInstanceCamera.h"
+#include "COLLADAFWInstanceLight.h"
+#include "COLLADAFWInstanceVisualScene.h"
+#include "COLLADAFWTransformation.h"
+#include "COLLADAFWMatrix.h"
+#include "COLLADAFWTranslate.h"
+#include "COLLADAFWRotate.h"
+#include "COLLADAFWScale.h"
+#include "COLLADAFWLookat.h"
+#include "COLLADAFWSkew.h"
+#include "COLLADAFWGeometry.h"
+#include "COLLADAFWMesh.h"
+#include "COLLADAFWTristrips.h"
+#include "COLLADAFWTrifans.h"
+#include "COLLADAFWLinestrips.h"
+#include "COLLADAFWPolygons.h"
+#include "COLLADAFWPolylist.h"
+#include "COLLADAFWMaterial.h"
+#include "COLLADAFWEffect.h"
+#include "COLLADAFWEffectCommon.h"
+#include "COLLADAFWCamera.h"
+#include "COLLADAFWImage.h"
+#include "COLLADAFWLight.h"
+#include "COLLADAFWAnimationCurve.h"
+#include "COLLADAFWAnimationList.h"
+#include "COLLADAFWSkinControllerData.h"
+#include "COLLADAFWSkinController.h"
+#include "COLLADAFWMorphController.h"
+#include "COLLADAFWFormulas.h"
+#include "COLLADAFWKinematicsScene.h"
+
+#include <stdio.h>
+
+
+namespace COLLADAFW
+{
+	typedef CacheFormat::OutputStream OutputStream;
+
+	//------------------------------
+	static void writeUniqueId( OutputStream& stream, const UniqueId& uniqueId )
+	{
+		stream.writeUInt64( uniqueId.getClassId() );
+		stream.writeUInt64( uniqueId.getObjectId() );
+		stream.writeUInt64( uniqueId.getFileId() );
+	}
+
+	//------------------------------
+	static void writeUniqueIdArray( OutputStream& stream, const UniqueIdArray& uniqueIds )
+	{
+		size_t count = uniqueIds.getCount();
+		stream.writeUInt64( count );
+		for ( size_t i = 0; i < count; ++i )
+			writeUniqueId( stream, uniqueIds[i] );
+	}
+
+	//------------------------------
+	static void writeVector3( OutputStream& stream, const COLLADABU::Math::Vector3& vector )
+	{
+		stream.writeDouble( vector.x );
+		stream.writeDouble( vector.y );
+		stream.writeDouble( vector.z );
+	}
+
+	//------------------------------
+	static void writeMatrix4( OutputStream& stream, const COLLADABU::Math::Matrix4& matrix )
+	{
+		for ( int i = 0; i < 16; ++i )
+			stream.writeDouble( matrix.getElement( i ) );
+	}
+
+	//------------------------------
+	static void writeAnimatableFloat( OutputStream& stream, const AnimatableFloat& value )
+	{
+		writeUniqueId( stream, value.getAnimationList() );
+		stream.writeDouble( value.getValue() );
+	}
+
+	//------------------------------
+	static void writeColor( OutputStream& stream, const Color& color )
+	{
+		writeUniqueId( stream, color.getAnimationList() );
+		stream.writeDouble( color.getRed() );
+		stream.writeDouble( color.getGreen() );
+		stream.writeDouble( color.getBlue() );
+		stream.writeDouble( color.getAlpha() );
+	}
+
+	//------------------------------
+	static void writeFloatOrDoubleArray( OutputStream& stream, const FloatOrDoubleArray& array )
+	{
+		writeUniqueId( stream, array.getAnimationList() );
+		stream.writeUInt64( array.getType() );
+		if ( array.getType() == FloatOrDoubleArray::DATA_TYPE_FLOAT )
+		{
+			const FloatArray* values = array.getFloatValues();
+			stream.writeArray( values->getData(), values->getCount() );
+		}
+		else if ( array.getType() == FloatOrDoubleArray::DATA_TYPE_DOUBLE )
+		{
+			const DoubleArray* values = array.getDoubleValues();
+			stream.writeArray( values->getData(), values->getCount() );
+		}
+	}
+
+	//------------------------------
+	static void writeMeshVertexData( OutputStream& stream, const MeshVertexData& vertexData )
+	{
+		writeFloatOrDoubleArray( stream, vertexData );
+		size_t inputInfosCount = vertexData.getNumInputInfos();
+		stream.writeUInt64( inputInfosCount );
+		for ( size_t i = 0; i < inputInfosCount; ++i )
+		{
+			stream.writeString( vertexData.getName( i ) );
+			stream.writeUInt64( vertexData.getStride( i ) );
+			stream.writeUInt64( vertexData.getLength( i ) );
+		}
+	}
+
+	//------------------------------
+	static void writeIndexLists( OutputStream& stream, const IndexListArray& indexLists )
+	{
+		size_t count = indexLists.getCount();
+		stream.writeUInt64( count );
+		for ( size_t i = 0; i < count; ++i )
+		{
+			const IndexList* indexList = indexLists[i];
+			stream.writeString( indexList->getName() );
+			stream.writeUInt64( indexList->getStride() );
+			stream.writeUInt64( indexList->getSetIndex() );
+			stream.writeUInt64( indexList->getInitialIndex() );
+			const UIntValuesArray& indices = indexList->getIndices();
+			stream.writeArray( indices.getData(), indices.getCount() );
+		}
+	}
+
+	//------------------------------
+	template<class VertexCountType>
+	static void writeFaceVertexCounts( OutputStream& stream, const MeshPrimitive* meshPrimitive )
+	{
+		const typename MeshPrimitiveWithFaceVertexCount<VertexCountType>::VertexCountArray& faceVertexCounts =
+			((const MeshPrimitiveWithFaceVertexCount<VertexCountType>*)meshPrimitive)->getGroupedVerticesVertexCountArray();
+		stream.writeArray( faceVertexCounts.getData(), faceVertexCounts.getCount() );
+	}
+
+	//------------------------------
+	static void writeMeshPrimitive( OutputStream& stream, const MeshPrimitive* meshPrimitive )
+	{
+		MeshPrimitive::PrimitiveType primitiveType = meshPrimitive->getPrimitiveType();
+		writeUniqueId( stream, meshPrimitive->getUniqueId() );
+		stream.writeUInt64( primitiveType );
+		stream.writeUInt64( meshPrimitive->getFaceCount() );
+		stream.writeString( meshPrimitive->getMaterial() );
+		stream.writeUInt64( meshPrimitive->getMaterialId() );
+
+		const UIntValuesArray& positionIndices = meshPrimitive->getPositionIndices();
+		stream.writeArray( positionIndices.getData(), positionIndices.getCount() );
+		const UIntValuesArray& normalIndices = meshPrimitive->getNormalIndices();
+		stream.writeArray( normalIndices.getData(), normalIndices.getCount() );
+		const UIntValuesArray& tangentIndices = meshPrimitive->getTangentIndices();
+		stream.writeArray( tangentIndices.getData(), tangentIndices.getCount() );
+		const UIntValuesArray& binormalIndices = meshPrimitive->getBinormalIndices();
+		stream.writeArray( binormalIndices.getData(), binormalIndices.getCount() );
+
+		writeIndexLists( stream, meshPrimitive->getColorIndicesArray() );
+		writeIndexLists( stream, meshPrimitive->getUVCoordIndicesArray() );
+
+		switch ( primitiveType )
+		{
+		case MeshPrimitive::POLYGONS:
+		case MeshPrimitive::POLYLIST:
+			writeFaceVertexCounts<int>( stream, meshPrimitive );
+			break;
+		case MeshPrimitive::TRIANGLE_STRIPS:
+			writeFaceVertexCounts<unsigned int>( stream, meshPrimitive );
+			stream.writeUInt64( ((const Tristrips*)meshPrimitive)->getTristripCount() );
+			break;
+		case MeshPrimitive::TRIANGLE_FANS:
+			writeFaceVertexCounts<unsigned int>( stream, meshPrimitive );
+			stream.writeUInt64( ((const Trifans*)meshPrimitive)->getTrifanCount() );
+			break;
+		case MeshPrimitive::LINE_STRIPS:
+			writeFaceVertexCounts<unsigned int>( stream, meshPrimitive );
+			stream.writeUInt64( ((const Linestrips*)meshPrimitive)->getLinestripCount() );
+			break;
+		default:
+			break;
+		}
+	}
+
+	//------------------------------
+	static void writeMesh( OutputStream& stream, const Mesh* mesh )
+	{
+		writeUniqueId( stream, mesh->getUniqueId() );
+		stream.writeString( mesh->getOriginalId() );
+		stream.writeString( mesh->getName() );
+
+		writeMeshVertexData( stream, mesh->getPositions() );
+		writeMeshVertexData( stream, mesh->getNormals() );
+		writeMeshVertexData( stream, mesh->getColors() );
+		writeMeshVertexData( stream, mesh->getUVCoords() );
+		writeMeshVertexData( stream, mesh->getTangents() );
+		writeMeshVertexData( stream, mesh->getBinormals() );
+
+		const MeshPrimitiveArray& meshPrimitives = mesh->getMeshPrimitives();
+		size_t meshPrimitivesCount = meshPrimitives.getCount();
+		stream.writeUInt64( meshPrimitivesCount );
+		for ( size_t i = 0; i < meshPrimitivesCount; ++i )
+			writeMeshPrimitive( stream, meshPrimitives[i] );
+
+		const COLLADABU::ContentHash& contentHash = mesh->getContentHash();
+		stream.writeUInt64( contentHash.high );
+		stream.writeUInt64( contentHash.low );
+		writeUniqueId( stream, mesh->getDuplicateOf() );
+	}
+
+	//------------------------------
+	template<COLLADA_TYPE::ClassId classId>
+	static void writeInstance( OutputStream& stream, const InstanceBase<classId>* instance )
+	{
+		writeUniqueId( stream, instance->getUniqueId() );
+		writeUniqueId( stream, instance->getInstanciatedObjectId() );
+		stream.writeString( instance->getName() );
+	}
+
+	//------------------------------
+	template<COLLADA_TYPE::ClassId classId>
+	static void writeInstanceBinding( OutputStream& stream, const InstanceBindingBase<classId>* instance )
+	{
+		writeInstance( stream, instance );
+
+		const MaterialBindingArray& materialBindings = instance->getMaterialBindings();
+		size_t materialBindingsCount = materialBindings.getCount();
+		stream.writeUInt64( materialBindingsCount );
+		for ( size_t i = 0; i < materialBindingsCount; ++i )
+		{
+			const MaterialBinding& materialBinding = materialBindings[i];
+			stream.writeUInt64( materialBinding.getMaterialId() );
+			writeUniqueId( stream, materialBinding.getReferencedMaterial() );
+			stream.writeString( materialBinding.getName() );
+
+			const TextureCoordinateBindingArray& textureCoordinateBindings = materialBinding.getTextureCoordinateBindingArray();
+			size_t textureCoordinateBindingsCount = textureCoordinateBindings.getCount();
+			stream.writeUInt64( textureCoordinateBindingsCount );
+			for ( size_t j = 0; j < textureCoordinateBindingsCount; ++j )
+			{
+				const TextureCoordinateBinding& textureCoordinateBinding = textureCoordinateBindings[j];
+				stream.writeUInt64( textureCoordinateBinding.getTextureMapId() );
+				stream.writeUInt64( textureCoordinateBinding.getSetIndex() );
+				stream.writeString( textureCoordinateBinding.getSemantic() );
+			}
+		}
+	}
+
+	//------------------------------
+	template<class InstanceType>
+	static void writeInstances( OutputStream& stream, const PointerArray<InstanceType>& instances )
+	{
+		size_t count = instances.getCount();
+		stream.writeUInt64( count );
+		for ( size_t i = 0; i < count; ++i )
+			writeInstance( stream, instances[i] );
+	}
+
+	//------------------------------
+	template<class InstanceType>
+	static void writeInstanceBindings( OutputStream& stream, const PointerArray<InstanceType>& instances )
+	{
+		size_t count = instances.getCount();
+		stream.writeUInt64( count );
+		for ( size_t i = 0; i < count; ++i )
+			writeInstanceBinding( stream, instances[i] );
+	}
+
+	//------------------------------
+	static void writeTransformation( OutputStream& stream, const Transformation* transformation )
+	{
+		stream.writeUInt64( transformation->getTransformationType() );
+		writeUniqueId( stream, transformation->getAnimationList() );
+		switch ( transformation->getTransformationType() )
+		{
+		case Transformation::MATRIX:
+			writeMatrix4( stream, ((const Matrix*)transformation)->getMatrix() );
+			break;
+		case Transformation::TRANSLATE:
+			writeVector3( stream, ((const Translate*)transformation)->getTranslation() );
+			break;
+		case Transformation::ROTATE:
+			writeVector3( stream, ((const Rotate*)transformation)->getRotationAxis() );
+			stream.writeDouble( ((const Rotate*)transformation)->getRotationAngle() );
+			break;
+		case Transformation::SCALE:
+			writeVector3( stream, ((const Scale*)transformation)->getScale() );
+			break;
+		case Transformation::LOOKAT:
+			writeVector3( stream, ((const Lookat*)transformation)->getEyePosition() );
+			writeVector3( stream, ((const Lookat*)transformation)->getInterestPointPosition() );
+			writeVector3( stream, ((const Lookat*)transformation)->getUpAxisDirection() );
+			break;
+		case Transformation::SKEW:
+			writeVector3( stream, ((const Skew*)transformation)->getRotateAxis() );
+			writeVector3( stream, ((const Skew*)transformation)->getTranslateAxis() );
+			stream.writeDouble( ((const Skew*)transformation)->getAngle() );
+			break;
+		}
+	}
+
+	//------------------------------
+	static void writeNodes( OutputStream& stream, const NodePointerArray& nodes )
+	{
+		size_t nodesCount = nodes.getCount();
+		stream.writeUInt64( nodesCount );
+		for ( size_t i = 0; i < nodesCount; ++i )
+		{
+			const Node* node = nodes[i];
+			writeUniqueId( stream, node->getUniqueId() );
+			stream.writeString( node->getOriginalId() );
+			stream.writeString( node->getName() );
+			stream.writeString( node->getSid() );
+			stream.writeUInt64( node->getType() );
+
+			const TransformationPointerArray& transformations = node->getTransformations();
+			size_t transformationsCount = transformations.getCount();
+			stream.writeUInt64( transformationsCount );
+			for ( size_t j = 0; j < transformationsCount; ++j )
+				writeTransformation( stream, transformations[j] );
+
+			writeInstanceBindings( stream, node->getInstanceGeometries() );
+			writeInstanceBindings( stream, node->getInstanceControllers() );
+			writeInstances( stream, node->getInstanceNodes() );
+			writeInstances( stream, node->getInstanceCameras() );
+			writeInstances( stream, node->getInstanceLights() );
+
+			writeNodes( stream, node->getChildNodes() );
+		}
+	}
+
+	//------------------------------
+	static void writeColorOrTexture( OutputStream& stream, const ColorOrTexture& colorOrTexture )
+	{
+		stream.writeUInt64( colorOrTexture.getType() );
+		writeColor( stream, colorOrTexture.getColor() );
+		const Texture& texture = colorOrTexture.getTexture();
+		writeUniqueId( stream, texture.getUniqueId() );
+		stream.writeUInt64( texture.getSamplerId() );
+		stream.writeUInt64( texture.getTextureMapId() );
+		stream.writeString( texture.getTexcoord() );
+	}
+
+	//------------------------------
+	static void writeFloatOrParam( OutputStream& stream, const FloatOrParam& floatOrParam )
+	{
+		writeUniqueId( stream, floatOrParam.getAnimationList() );
+		stream.writeUInt64( floatOrParam.getType() );
+		stream.writeDouble( floatOrParam.getFloatValue() );
+		const Param& param = floatOrParam.getParam();
+		stream.writeString( param.getName() );
+		stream.writeString( param.getSid() );
+		stream.writeUInt64( param.getType() );
+		stream.writeString( param.getSemantic() );
+	}
+
+	//------------------------------
+	static void writeSampler( OutputStream& stream, const Sampler* sampler )
+	{
+		writeUniqueId( stream, sampler->getUniqueId() );
+		stream.writeUInt64( const_cast<Sampler*>(sampler)->getSamplerType() );
+		writeUniqueId( stream, sampler->getSourceImage() );
+		stream.writeUInt64( sampler->getMinFilter() );
+		stream.writeUInt64( sampler->getMagFilter() );
+		stream.writeUInt64( sampler->getMipFilter() );
+		stream.writeUInt64( sampler->getWrapS() );
+		stream.writeUInt64( sampler->getWrapT() );
+		stream.writeUInt64( sampler->getWrapP() );
+		writeColor( stream, sampler->getBorderColor() );
+		stream.writeUInt64( sampler->getMipmapMaxlevel() );
+		stream.writeDouble( sampler->getMipmapBias() );
+	}
+
+	//------------------------------
+	static void writeEffectCommon( OutputStream& stream, const EffectCommon* effectCommon )
+	{
+		stream.writeString( effectCommon->getOriginalId() );
+		stream.writeUInt64( effectCommon->getShaderType() );
+		writeColorOrTexture( stream, effectCommon->getEmission() );
+		writeColorOrTexture( stream, effectCommon->getAmbient() );
+		writeColorOrTexture( stream, effectCommon->getDiffuse() );
+		writeColorOrTexture( stream, effectCommon->getSpecular() );
+		writeFloatOrParam( stream, effectCommon->getShininess() );
+		writeColorOrTexture( stream, effectCommon->getReflective() );
+		writeFloatOrParam( stream, effectCommon->getReflectivity() );
+		writeColorOrTexture( stream, effectCommon->getOpacity() );
+		writeFloatOrParam( stream, effectCommon->getIndexOfRefraction() );
+
+		const SamplerPointerArray& samplers = effectCommon->getSamplerPointerArray();
+		size_t samplersCount = samplers.getCount();
+		stream.writeUInt64( samplersCount );
+		for ( size_t i = 0; i < samplersCount; ++i )
+			writeSampler( stream, samplers[i] );
+	}
+
+	//------------------------------
+	CacheWriter::CacheWriter( IWriter* targetWriter )
+		: mTargetWriter(targetWriter)
+		, mRecordCount(0)
+		, mCacheable(true)
+		, mFinished(false)
+		, mTargetWantsImageData(false)
+	{
+	}
+
+	//------------------------------
+	CacheWriter::~CacheWriter()
+	{
+	}
+
+	//------------------------------
+	bool CacheWriter::writeCacheFile( const String& fileName, const COLLADABU::ContentHash& key ) const
+	{
+		if ( !isCacheable() )
+			return false;
+
+		CacheFormat::Header header;
+		memset( &header, 0, sizeof(header) );
+		memcpy( header.magic, CacheFormat::MAGIC, sizeof(header.magic) );
+		header.version = CacheFormat::VERSION;
+		header.byteOrderMark = CacheFormat::BYTE_ORDER_MARK;
+		header.keyHigh = key.high;
+		header.keyLow = key.low;
+		COLLADABU::ContentHasher hasher;
+		if ( !mData.empty() )
+			hasher.update( &mData[0], mData.size() );
+		COLLADABU::ContentHash dataHash = hasher.getHash();
+		header.dataHashHigh = dataHash.high;
+		header.dataHashLow = dataHash.low;
+		header.recordCount = mRecordCount;
+		header.dataSize = mData.size();
+
+		String temporaryFileName = fileName + ".tmp";
+		FILE* file = fopen( temporaryFileName.c_str(), "wb" );
+		if ( !file )
+			return false;
+
+		bool success = fwrite( &header, sizeof(header), 1, file ) == 1;
+		if ( success && !mData.empty() )
+			success = fwrite( &mData[0], mData.size(), 1, file ) == 1;
+		success = (fclose( file ) == 0) && success;
+
+		if ( success && rename( temporaryFileName.c_str(), fileName.c_str() ) != 0 )
+		{
+			// rename does not replace existing files on all platforms
+			remove( fileName.c_str() );
+			success = rename( temporaryFileName.c_str(), fileName.c_str() ) == 0;
+		}
+		if ( !success )
+			remove( temporaryFileName.c_str() );
+		return success;
+	}
+
+	//------------------------------
+	void CacheWriter::cancel( const String& errorMessage )
+	{
+		mCacheable = false;
+		if ( mTargetWriter )
+			mTargetWriter->cancel( errorMessage );
+	}
+
+	//------------------------------
+	void CacheWriter::start()
+	{
+		mData.clear();
+		mRecordCount = 0;
+		mCacheable = true;
+		mFinished = false;
+		if ( mTargetWriter )
+			mTargetWriter->start();
+	}
+
+	//------------------------------
+	void CacheWriter::finish()
+	{
+		mFinished = true;
+		if ( mTargetWriter )
+			mTargetWriter->finish();
+	}
+
+	//------------------------------
+	bool CacheWriter::takesObjectOwnership() const
+	{
+		// the objects are serialized before they are passed on, i.e. the target may keep them
+		return mTargetWriter ? mTargetWriter->takesObjectOwnership() : false;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeGlobalAsset( const FileInfo* asset )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_GLOBAL_ASSET );
+		const FileInfo::Unit& unit = asset->getUnit();
+		stream.writeString( unit.getLinearUnitName() );
+		stream.writeDouble( unit.getLinearUnitMeter() );
+		stream.writeUInt64( unit.getLinearUnitUnit() );
+		stream.writeString( unit.getAngularUnitName() );
+		stream.writeUInt64( unit.getAngularUnit() );
+		stream.writeString( unit.getTimeUnitName() );
+		stream.writeUInt64( asset->getUpAxisType() );
+
+		const FileInfo::ValuePairPointerArray& valuePairs = asset->getValuePairArray();
+		size_t valuePairsCount = valuePairs.getCount();
+		stream.writeUInt64( valuePairsCount );
+		for ( size_t i = 0; i < valuePairsCount; ++i )
+		{
+			stream.writeString( valuePairs[i]->first );
+			stream.writeString( valuePairs[i]->second );
+		}
+		stream.writeString( asset->getAbsoluteFileUri().getURIString() );
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeGlobalAsset( asset ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeScene( const Scene* scene )
+	{
+		if ( scene->getInstanceKinematicsScene() )
+			mCacheable = false;
+
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_SCENE );
+		writeUniqueId( stream, scene->getUniqueId() );
+		const InstanceVisualScene* instanceVisualScene = scene->getInstanceVisualScene();
+		stream.writeBool( instanceVisualScene != 0 );
+		if ( instanceVisualScene )
+			writeInstance( stream, instanceVisualScene );
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeScene( scene ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeVisualScene( const VisualScene* visualScene )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_VISUAL_SCENE );
+		writeUniqueId( stream, visualScene->getUniqueId() );
+		stream.writeString( visualScene->getName() );
+		writeNodes( stream, visualScene->getRootNodes() );
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeVisualScene( visualScene ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeLibraryNodes( const LibraryNodes* libraryNodes )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_LIBRARY_NODES );
+		writeNodes( stream, libraryNodes->getNodes() );
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeLibraryNodes( libraryNodes ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeGeometry( const Geometry* geometry )
+	{
+		if ( geometry->getType() == Geometry::GEO_TYPE_MESH )
+		{
+			OutputStream stream( mData );
+			size_t record = stream.beginRecord( CacheFormat::RECORD_GEOMETRY );
+			writeMesh( stream, (const Mesh*)geometry );
+			stream.endRecord( record );
+			++mRecordCount;
+		}
+		else
+		{
+			mCacheable = false;
+		}
+
+		return mTargetWriter ? mTargetWriter->writeGeometry( geometry ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeMaterial( const Material* material )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_MATERIAL );
+		writeUniqueId( stream, material->getUniqueId() );
+		stream.writeString( material->getOriginalId() );
+		stream.writeString( material->getName() );
+		writeUniqueId( stream, material->getInstantiatedEffect() );
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeMaterial( material ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeEffect( const Effect* effect )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_EFFECT );
+		writeUniqueId( stream, effect->getUniqueId() );
+		stream.writeString( effect->getOriginalId() );
+		stream.writeString( effect->getName() );
+		writeColor( stream, effect->getStandardColor() );
+
+		const CommonEffectPointerArray& commonEffects = effect->getCommonEffects();
+		size_t commonEffectsCount = commonEffects.getCount();
+		stream.writeUInt64( commonEffectsCount );
+		for ( size_t i = 0; i < commonEffectsCount; ++i )
+			writeEffectCommon( stream, commonEffects[i] );
+
+		// getExtraTextures() is not const, although it does not change the effect
+		const PointerArray<TextureAttributes>& extraTextures = const_cast<Effect*>(effect)->getExtraTextures();
+		size_t extraTexturesCount = extraTextures.getCount();
+		stream.writeUInt64( extraTexturesCount );
+		for ( size_t i = 0; i < extraTexturesCount; ++i )
+		{
+			const TextureAttributes* textureAttributes = extraTextures[i];
+			stream.writeUInt64( textureAttributes->samplerId );
+			stream.writeUInt64( textureAttributes->textureMapId );
+			stream.writeString( textureAttributes->textureSampler );
+			stream.writeString( textureAttributes->texCoord );
+		}
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeEffect( effect ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeCamera( const Camera* camera )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_CAMERA );
+		writeUniqueId( stream, camera->getUniqueId() );
+		stream.writeString( camera->getOriginalId() );
+		stream.writeString( camera->getName() );
+		stream.writeUInt64( camera->getCameraType() );
+		stream.writeUInt64( camera->getDescriptionType() );
+		writeAnimatableFloat( stream, camera->getXFov() );
+		writeAnimatableFloat( stream, camera->getYFov() );
+		writeAnimatableFloat( stream, camera->getAspectRatio() );
+		writeAnimatableFloat( stream, camera->getNearClippingPlane() );
+		writeAnimatableFloat( stream, camera->getFarClippingPlane() );
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeCamera( camera ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeImage( const Image* image )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_IMAGE );
+		writeUniqueId( stream, image->getUniqueId() );
+		stream.writeString( image->getOriginalId() );
+		stream.writeUInt64( image->getSourceType() );
+		stream.writeString( image->getName() );
+		stream.writeString( image->getFormat() );
+		stream.writeUInt64( image->getHeight() );
+		stream.writeUInt64( image->getWidth() );
+		stream.writeUInt64( image->getDepth() );
+		stream.writeString( image->getImageURI().getURIString() );
+		// the embedded data has been passed before the image
+		stream.writeArray( mImageData.empty() ? 0 : &mImageData[0], mImageData.size() );
+		stream.endRecord( record );
+		++mRecordCount;
+		mImageData.clear();
+
+		return mTargetWriter ? mTargetWriter->writeImage( image ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::startImageData( const Image* image )
+	{
+		mImageData.clear();
+		mTargetWantsImageData = mTargetWriter && mTargetWriter->startImageData( image );
+		return true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeImageData( const Image* image, const unsigned char* data, size_t length )
+	{
+		mImageData.insert( mImageData.end(), data, data + length );
+		return mTargetWantsImageData ? mTargetWriter->writeImageData( image, data, length ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::finishImageData( const Image* image )
+	{
+		return mTargetWantsImageData ? mTargetWriter->finishImageData( image ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeLight( const Light* light )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_LIGHT );
+		writeUniqueId( stream, light->getUniqueId() );
+		stream.writeString( light->getOriginalId() );
+		stream.writeString( light->getName() );
+		stream.writeUInt64( light->getLightType() );
+		writeColor( stream, light->getColor() );
+		writeAnimatableFloat( stream, light->getConstantAttenuation() );
+		writeAnimatableFloat( stream, light->getLinearAttenuation() );
+		writeAnimatableFloat( stream, light->getQuadraticAttenuation() );
+		writeAnimatableFloat( stream, light->getFallOffAngle() );
+		writeAnimatableFloat( stream, light->getFallOffExponent() );
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeLight( light ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeAnimation( const Animation* animation )
+	{
+		if ( animation->getAnimationType() == Animation::ANIMATION_CURVE )
+		{
+			const AnimationCurve* animationCurve = (const AnimationCurve*)animation;
+			OutputStream stream( mData );
+			size_t record = stream.beginRecord( CacheFormat::RECORD_ANIMATION );
+			writeUniqueId( stream, animationCurve->getUniqueId() );
+			stream.writeString( animationCurve->getOriginalId() );
+			stream.writeString( animationCurve->getName() );
+			stream.writeUInt64( animationCurve->getInPhysicalDimension() );
+			const PhysicalDimensionArray& outPhysicalDimensions = animationCurve->getOutPhysicalDimensions();
+			stream.writeArray( outPhysicalDimensions.getData(), outPhysicalDimensions.getCount() );
+			stream.writeUInt64( animationCurve->getOutDimension() );
+			stream.writeUInt64( animationCurve->getInterpolationType() );
+			const AnimationCurve::InterpolationTypeArray& interpolationTypes = animationCurve->getInterpolationTypes();
+			stream.writeArray( interpolationTypes.getData(), interpolationTypes.getCount() );
+			writeFloatOrDoubleArray( stream, animationCurve->getInputValues() );
+			writeFloatOrDoubleArray( stream, animationCurve->getOutputValues() );
+			writeFloatOrDoubleArray( stream, animationCurve->getInTangentValues() );
+			writeFloatOrDoubleArray( stream, animationCurve->getOutTangentValues() );
+			stream.endRecord( record );
+			++mRecordCount;
+		}
+		else
+		{
+			mCacheable = false;
+		}
+
+		return mTargetWriter ? mTargetWriter->writeAnimation( animation ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeAnimationList( const AnimationList* animationList )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_ANIMATION_LIST );
+		writeUniqueId( stream, animationList->getUniqueId() );
+		const AnimationList::AnimationBindings& animationBindings = animationList->getAnimationBindings();
+		size_t animationBindingsCount = animationBindings.getCount();
+		stream.writeUInt64( animationBindingsCount );
+		for ( size_t i = 0; i < animationBindingsCount; ++i )
+		{
+			const AnimationList::AnimationBinding& animationBinding = animationBindings[i];
+			writeUniqueId( stream, animationBinding.animation );
+			stream.writeUInt64( animationBinding.animationClass );
+			stream.writeUInt64( animationBinding.firstIndex );
+			stream.writeUInt64( animationBinding.secondIndex );
+		}
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeAnimationList( animationList ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeSkinControllerData( const SkinControllerData* skinControllerData )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_SKIN_CONTROLLER_DATA );
+		writeUniqueId( stream, skinControllerData->getUniqueId() );
+		stream.writeString( skinControllerData->getOriginalId() );
+		stream.writeString( skinControllerData->getName() );
+		stream.writeUInt64( skinControllerData->getJointsCount() );
+		writeMatrix4( stream, skinControllerData->getBindShapeMatrix() );
+
+		const Matrix4Array& inverseBindMatrices = skinControllerData->getInverseBindMatrices();
+		size_t inverseBindMatricesCount = inverseBindMatrices.getCount();
+		stream.writeUInt64( inverseBindMatricesCount );
+		for ( size_t i = 0; i < inverseBindMatricesCount; ++i )
+			writeMatrix4( stream, inverseBindMatrices[i] );
+
+		writeFloatOrDoubleArray( stream, skinControllerData->getWeights() );
+		const UIntValuesArray& jointsPerVertex = skinControllerData->getJointsPerVertex();
+		stream.writeArray( jointsPerVertex.getData(), jointsPerVertex.getCount() );
+		const UIntValuesArray& weightIndices = skinControllerData->getWeightIndices();
+		stream.writeArray( weightIndices.getData(), weightIndices.getCount() );
+		const IntValuesArray& jointIndices = skinControllerData->getJointIndices();
+		stream.writeArray( jointIndices.getData(), jointIndices.getCount() );
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeSkinControllerData( skinControllerData ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeController( const Controller* controller )
+	{
+		OutputStream stream( mData );
+		size_t record = stream.beginRecord( CacheFormat::RECORD_CONTROLLER );
+		writeUniqueId( stream, controller->getUniqueId() );
+		stream.writeUInt64( controller->getControllerType() );
+		writeUniqueId( stream, controller->getSource() );
+		if ( controller->getControllerType() == Controller::CONTROLLER_TYPE_SKIN )
+		{
+			const SkinController* skinController = (const SkinController*)controller;
+			writeUniqueId( stream, skinController->getSkinControllerData() );
+			writeUniqueIdArray( stream, skinController->getJoints() );
+		}
+		else
+		{
+			const MorphController* morphController = (const MorphController*)controller;
+			stream.writeString( morphController->getOriginalId() );
+			stream.writeString( morphController->getName() );
+			writeUniqueIdArray( stream, morphController->getMorphTargets() );
+			writeFloatOrDoubleArray( stream, morphController->getMorphWeights() );
+		}
+		stream.endRecord( record );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeController( controller ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeFormulas( const Formulas* formulas )
+	{
+		// formulas hold MathML expression trees, which are not serialized
+		if ( formulas->getFormulas().getCount() > 0 )
+			mCacheable = false;
+
+		OutputStream stream( mData );
+		stream.endRecord( stream.beginRecord( CacheFormat::RECORD_FORMULAS ) );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeFormulas( formulas ) : true;
+	}
+
+	//------------------------------
+	bool CacheWriter::writeKinematicsScene( const KinematicsScene* kinematicsScene )
+	{
+		if ( kinematicsScene->getKinematicsModels().getCount() > 0
+			|| kinematicsScene->getKinematicsControllers().getCount() > 0
+			|| kinematicsScene->getInstanceKinematicsScenes().getCount() > 0 )
+			mCacheable = false;
+
+		OutputStream stream( mData );
+		stream.endRecord( stream.beginRecord( CacheFormat::RECORD_KINEMATICS_SCENE ) );
+		++mRecordCount;
+
+		return mTargetWriter ? mTargetWriter->writeKinematicsScene( kinematicsScene ) : true;
+	}
+
+} // namespace COLLADAFW
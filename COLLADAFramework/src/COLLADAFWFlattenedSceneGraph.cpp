@@ -0,0 +1,242 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADAFWStableHeaders.h"
+#include "COLLADAFWFlattenedSceneGraph.h"
+#include "COLLADAFWVisualScene.h"
+#include "COLLADAFWLibraryNodes.h"
+#include "COLLADAFWInstanceNode.h"
+
+#include <algorithm>
+
+
+namespace COLLADAFW
+{
+
+	//------------------------------
+	FlattenedSceneGraph::FlattenedSceneGraph()
+		: mDirtyCount(0)
+	{
+	}
+
+	//------------------------------
+	FlattenedSceneGraph::~FlattenedSceneGraph()
+	{
+	}
+
+	//------------------------------
+	void FlattenedSceneGraph::addLibraryNodes( const LibraryNodes* libraryNodes )
+	{
+		if ( libraryNodes )
+			addInstantiableNodes( libraryNodes->getNodes(), mLibraryNodes );
+	}
+
+	//------------------------------
+	void FlattenedSceneGraph::addInstantiableNodes( const NodePointerArray& nodes, UniqueIdNodeMap& instantiableNodes )
+	{
+		for ( size_t i = 0, count = nodes.getCount(); i < count; ++i )
+		{
+			const Node* node = nodes[i];
+			instantiableNodes.insert( std::make_pair( node->getUniqueId(), node ) );
+			addInstantiableNodes( node->getChildNodes(), instantiableNodes );
+		}
+	}
+
+	//------------------------------
+	const Node* FlattenedSceneGraph::findInstantiableNode( const UniqueId& uniqueId ) const
+	{
+		UniqueIdNodeMap::const_iterator it = mSceneNodes.find( uniqueId );
+		if ( it != mSceneNodes.end() )
+			return it->second;
+
+		it = mLibraryNodes.find( uniqueId );
+		if ( it != mLibraryNodes.end() )
+			return it->second;
+
+		return 0;
+	}
+
+	//------------------------------
+	void FlattenedSceneGraph::build( const VisualScene* visualScene )
+	{
+		if ( visualScene )
+		{
+			build( visualScene->getRootNodes() );
+		}
+		else
+		{
+			NodePointerArray noNodes;
+			build( noNodes );
+		}
+	}
+
+	//------------------------------
+	void FlattenedSceneGraph::build( const NodePointerArray& rootNodes )
+	{
+		mNodes.clear();
+		mParentIndices.clear();
+		mFirstChildIndices.clear();
+		mChildCounts.clear();
+		mLevelOffsets.clear();
+		mSceneNodes.clear();
+
+		addInstantiableNodes( rootNodes, mSceneNodes );
+
+		for ( size_t i = 0, count = rootNodes.getCount(); i < count; ++i )
+			appendEntry( rootNodes[i], NO_PARENT );
+
+		// Each pass appends the children of the entries of one level, which form the next level
+		size_t levelBegin = 0;
+		mLevelOffsets.push_back( levelBegin );
+		while ( levelBegin < mNodes.size() )
+		{
+			const size_t levelEnd = mNodes.size();
+			for ( size_t index = levelBegin; index < levelEnd; ++index )
+			{
+				const Node* node = mNodes[index];
+				mFirstChildIndices[index] = mNodes.size();
+
+				const NodePointerArray& childNodes = node->getChildNodes();
+				for ( size_t i = 0, count = childNodes.getCount(); i < count; ++i )
+					appendEntry( childNodes[i], index );
+
+				const InstanceNodePointerArray& instanceNodes = node->getInstanceNodes();
+				for ( size_t i = 0, count = instanceNodes.getCount(); i < count; ++i )
+				{
+					const Node* instantiatedNode = findInstantiableNode( instanceNodes[i]->getInstanciatedObjectId() );
+					if ( instantiatedNode && !isAncestorOrSelf( instantiatedNode, index ) )
+						appendEntry( instantiatedNode, index );
+				}
+
+				mChildCounts[index] = mNodes.size() - mFirstChildIndices[index];
+			}
+			mLevelOffsets.push_back( levelEnd );
+			levelBegin = levelEnd;
+		}
+
+		const size_t entryCount = mNodes.size();
+
+		mNodeIndices.resize( entryCount );
+		for ( size_t i = 0; i < entryCount; ++i )
+			mNodeIndices[i] = std::make_pair( mNodes[i], i );
+		std::sort( mNodeIndices.begin(), mNodeIndices.end() );
+
+		mLocalMatrices.resize( entryCount );
+		mWorldMatrices.resize( entryCount );
+		mDirtyFlags.assign( entryCount, 0 );
+		mDirtyCount = 0;
+
+		// The local matrices are independent of each other
+		const ptrdiff_t signedEntryCount = (ptrdiff_t)entryCount;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if( signedEntryCount >= MIN_PARALLEL_ENTRY_COUNT )
+#endif
+		for ( ptrdiff_t i = 0; i < signedEntryCount; ++i )
+		{
+			mNodes[i]->getTransformationMatrix( mLocalMatrices[i] );
+		}
+
+		calculateWorldMatrices( false );
+	}
+
+	//------------------------------
+	bool FlattenedSceneGraph::isAncestorOrSelf( const Node* node, size_t index ) const
+	{
+		for ( ; index != NO_PARENT; index = mParentIndices[index] )
+		{
+			if ( mNodes[index] == node )
+				return true;
+		}
+		return false;
+	}
+
+	//------------------------------
+	void FlattenedSceneGraph::appendEntry( const Node* node, size_t parentIndex )
+	{
+		mNodes.push_back( node );
+		mParentIndices.push_back( parentIndex );
+		mFirstChildIndices.push_back( 0 );
+		mChildCounts.push_back( 0 );
+	}
+
+	//------------------------------
+	void FlattenedSceneGraph::calculateWorldMatrices( bool dirtyOnly )
+	{
+		// The entries of a level only depend on the entries of the previous level
+		for ( size_t level = 0, levelCount = getLevelCount(); level < levelCount; ++level )
+		{
+			const ptrdiff_t levelBegin = (ptrdiff_t)mLevelOffsets[level];
+			const ptrdiff_t levelEnd = (ptrdiff_t)mLevelOffsets[level + 1];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if( levelEnd - levelBegin >= MIN_PARALLEL_ENTRY_COUNT )
+#endif
+			for ( ptrdiff_t i = levelBegin; i < levelEnd; ++i )
+			{
+				const size_t parentIndex = mParentIndices[i];
+				if ( dirtyOnly )
+				{
+					if ( !mDirtyFlags[i] && ((parentIndex == NO_PARENT) || !mDirtyFlags[parentIndex]) )
+						continue;
+
+					// pass the flag on to the children
+					mDirtyFlags[i] = 1;
+				}
+
+				if ( parentIndex == NO_PARENT )
+					mWorldMatrices[i] = mLocalMatrices[i];
+				else
+					mWorldMatrices[i] = mWorldMatrices[parentIndex] * mLocalMatrices[i];
+			}
+		}
+	}
+
+	//------------------------------
+	void FlattenedSceneGraph::invalidate( size_t index )
+	{
+		if ( !mDirtyFlags[index] )
+		{
+			mDirtyFlags[index] = 1;
+			mDirtyCount++;
+		}
+	}
+
+	//------------------------------
+	size_t FlattenedSceneGraph::invalidate( const Node* node )
+	{
+		NodeIndexList::const_iterator it = std::lower_bound( mNodeIndices.begin(), mNodeIndices.end(), std::make_pair( node, (size_t)0 ) );
+		size_t invalidatedCount = 0;
+		for ( ; (it != mNodeIndices.end()) && (it->first == node); ++it, ++invalidatedCount )
+			invalidate( it->second );
+		return invalidatedCount;
+	}
+
+	//------------------------------
+	void FlattenedSceneGraph::update()
+	{
+		if ( mDirtyCount == 0 )
+			return;
+
+		const ptrdiff_t signedEntryCount = (ptrdiff_t)mNodes.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if( signedEntryCount >= MIN_PARALLEL_ENTRY_COUNT )
+#endif
+		for ( ptrdiff_t i = 0; i < signedEntryCount; ++i )
+		{
+			if ( mDirtyFlags[i] )
+				mNodes[i]->getTransformationMatrix( mLocalMatrices[i] );
+		}
+
+		calculateWorldMatrices( true );
+
+		mDirtyFlags.assign( mNodes.size(), 0 );
+		mDirtyCount = 0;
+	}
+
+} // namespace COLLADAFW
@@ -0,0 +1,158 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADAFWStableHeaders.h"
+#include "COLLADAFWMemoryArena.h"
+
+#include <stdlib.h>
+#include <new>
+#include <algorithm>
+
+
+#if defined(_MSC_VER)
+#	define COLLADAFW_THREAD_LOCAL __declspec(thread)
+#else
+#	define COLLADAFW_THREAD_LOCAL __thread
+#endif
+
+
+namespace COLLADAFW
+{
+
+	/** Alignment of all memory returned by the arena.*/
+	static const size_t ARENA_ALIGNMENT = 16;
+
+	//------------------------------
+	static size_t alignSize( size_t size )
+	{
+		return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+	}
+
+	/** The arena framework objects are currently allocated from by this thread. Might be null.*/
+	static COLLADAFW_THREAD_LOCAL MemoryArena* currentArena = 0;
+
+	//------------------------------
+	MemoryArena::MemoryArena( size_t chunkSize )
+		: mChunkSize( chunkSize < 4 * ARENA_ALIGNMENT ? 4 * ARENA_ALIGNMENT : chunkSize )
+		, mCurrentPosition(0)
+		, mCurrentEnd(0)
+		, mAllocatedBytes(0)
+		, mReservedBytes(0)
+	{
+	}
+
+	//------------------------------
+	MemoryArena::~MemoryArena()
+	{
+		if ( currentArena == this )
+			currentArena = 0;
+		release();
+	}
+
+	//------------------------------
+	char* MemoryArena::addChunk( size_t size, bool makeCurrent )
+	{
+		char* memory = (char*)malloc( size );
+		if ( !memory )
+			throw std::bad_alloc();
+
+		mChunks.insert( std::upper_bound( mChunks.begin(), mChunks.end(), Chunk(memory, 0) ), Chunk(memory, size) );
+		mReservedBytes += size;
+
+		if ( makeCurrent )
+		{
+			mCurrentPosition = memory;
+			mCurrentEnd = memory + size;
+		}
+		return memory;
+	}
+
+	//------------------------------
+	void* MemoryArena::allocate( size_t size )
+	{
+		size = alignSize( size == 0 ? 1 : size );
+		mAllocatedBytes += size;
+
+		if ( size > mChunkSize / 4 )
+		{
+			// Large blocks get a chunk of their own, so they do not waste the rest of the current chunk
+			return addChunk( size, false );
+		}
+
+		if ( (size_t)(mCurrentEnd - mCurrentPosition) < size )
+			addChunk( mChunkSize, true );
+
+		void* memory = mCurrentPosition;
+		mCurrentPosition += size;
+		return memory;
+	}
+
+	//------------------------------
+	bool MemoryArena::contains( const void* memory ) const
+	{
+		// the last chunk starting at or before memory is the only one that might contain it
+		ChunkList::const_iterator it = std::upper_bound( mChunks.begin(), mChunks.end(), Chunk((char*)memory, (size_t)-1) );
+		if ( it == mChunks.begin() )
+			return false;
+		--it;
+		return (const char*)memory < it->first + it->second;
+	}
+
+	//------------------------------
+	void MemoryArena::release()
+	{
+		for ( ChunkList::const_iterator it = mChunks.begin(); it != mChunks.end(); ++it )
+			free( it->first );
+		ChunkList().swap( mChunks );
+		mCurrentPosition = 0;
+		mCurrentEnd = 0;
+		mAllocatedBytes = 0;
+		mReservedBytes = 0;
+	}
+
+	//------------------------------
+	MemoryArena* MemoryArena::getCurrent()
+	{
+		return currentArena;
+	}
+
+	//------------------------------
+	MemoryArena* MemoryArena::setCurrent( MemoryArena* arena )
+	{
+		MemoryArena* previousArena = currentArena;
+		currentArena = arena;
+		return previousArena;
+	}
+
+	//------------------------------
+	void* MemoryArena::allocateObject( size_t size )
+	{
+		MemoryArena* arena = currentArena;
+		if ( arena )
+			return arena->allocate( size );
+
+		void* object = malloc( size == 0 ? 1 : size );
+		if ( !object )
+			throw std::bad_alloc();
+		return object;
+	}
+
+	//------------------------------
+	void MemoryArena::deallocateObject( void* object )
+	{
+		if ( !object )
+			return;
+
+		MemoryArena* arena = currentArena;
+		if ( !arena || !arena->contains(object) )
+			free( object );
+	}
+
+} // namespace COLLADAFW
@@ -0,0 +1,482 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADAFWStableHeaders.h"
+#include "COLLADAFWMeshOptimizer.h"
+#include "COLLADAFWMesh.h"
+#include "COLLADAFWMeshPrimitive.h"
+
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+
+namespace COLLADAFW
+{
+	/** The size of the LRU cache the scores of the vertex cache optimization are tuned for.*/
+	static const size_t OPTIMIZER_CACHE_SIZE = 32;
+
+	static const unsigned int NO_INDEX = (unsigned int)-1;
+
+	typedef std::vector<const UIntValuesArray*> ConstIndexArrayList;
+
+	//------------------------------
+	// Collects the index arrays of @a meshPrimitive, that contain one index per corner.
+	static size_t getCornerIndexArrays( const MeshPrimitive* meshPrimitive, ConstIndexArrayList& indexArrays )
+	{
+		const UIntValuesArray& positionIndices = meshPrimitive->getPositionIndices();
+		const size_t cornerCount = positionIndices.getCount();
+		indexArrays.push_back( &positionIndices );
+
+		const UIntValuesArray* indexArrayList[] =
+		{
+			&meshPrimitive->getNormalIndices(),
+			&meshPrimitive->getTangentIndices(),
+			&meshPrimitive->getBinormalIndices()
+		};
+		for ( size_t i = 0; i < sizeof(indexArrayList) / sizeof(indexArrayList[0]); ++i )
+		{
+			if ( indexArrayList[i]->getCount() == cornerCount )
+				indexArrays.push_back( indexArrayList[i] );
+		}
+
+		const IndexListArray* indexListArrays[] =
+		{
+			&meshPrimitive->getColorIndicesArray(),
+			&meshPrimitive->getUVCoordIndicesArray()
+		};
+		for ( size_t i = 0; i < sizeof(indexListArrays) / sizeof(indexListArrays[0]); ++i )
+		{
+			const IndexListArray& indexLists = *indexListArrays[i];
+			for ( size_t j = 0; j < indexLists.getCount(); ++j )
+			{
+				if ( indexLists[j]->getIndicesCount() == cornerCount )
+					indexArrays.push_back( &indexLists[j]->getIndices() );
+			}
+		}
+
+		return cornerCount;
+	}
+
+	//------------------------------
+	// Orders corners by the combination of their indices.
+	struct CornerLess
+	{
+		const ConstIndexArrayList& indexArrays;
+
+		CornerLess( const ConstIndexArrayList& _indexArrays ) : indexArrays(_indexArrays) {}
+
+		bool operator()( unsigned int lhs, unsigned int rhs ) const
+		{
+			for ( size_t i = 0; i < indexArrays.size(); ++i )
+			{
+				const unsigned int* indices = indexArrays[i]->getData();
+				if ( indices[lhs] != indices[rhs] )
+					return indices[lhs] < indices[rhs];
+			}
+			return false;
+		}
+	};
+
+	//------------------------------
+	// Assigns the same vertex id to all corners with the same combination of indices. The ids are
+	// in [0, vertex count).
+	// @return The number of distinct vertices.
+	static size_t calculateVertexIds( const ConstIndexArrayList& indexArrays, size_t cornerCount, std::vector<unsigned int>& vertexIds )
+	{
+		std::vector<unsigned int> corners( cornerCount );
+		for ( size_t i = 0; i < cornerCount; ++i )
+			corners[i] = (unsigned int)i;
+
+		CornerLess cornerLess( indexArrays );
+		std::sort( corners.begin(), corners.end(), cornerLess );
+
+		vertexIds.resize( cornerCount );
+		size_t vertexCount = 0;
+		for ( size_t i = 0; i < cornerCount; ++i )
+		{
+			if ( i > 0 && cornerLess( corners[i - 1], corners[i] ) )
+				++vertexCount;
+			vertexIds[corners[i]] = (unsigned int)vertexCount;
+		}
+		return cornerCount > 0 ? vertexCount + 1 : 0;
+	}
+
+	//------------------------------
+	// The score of a vertex, as proposed by Tom Forsyth. Vertices in the cache and vertices used by
+	// few remaining triangles get high scores.
+	static float calculateVertexScore( int cachePosition, size_t valence )
+	{
+		if ( valence == 0 )
+			return -1.0f;
+
+		float score = 0;
+		if ( cachePosition >= 0 )
+		{
+			// The vertices of the last triangle get a fixed score, to avoid that the next
+			// triangle shares an edge with it, which is bad for strip like orders.
+			if ( cachePosition < 3 )
+				score = 0.75f;
+			else
+				score = powf( 1.0f - (float)(cachePosition - 3) / (float)(OPTIMIZER_CACHE_SIZE - 3), 1.5f );
+		}
+		score += 2.0f * powf( (float)valence, -0.5f );
+		return score;
+	}
+
+	//------------------------------
+	// Calculates the order of the triangles, whose corners have the vertex ids @a vertexIds, that
+	// minimizes the vertex cache misses.
+	static void calculateTriangleOrder( const std::vector<unsigned int>& vertexIds, size_t vertexCount, std::vector<unsigned int>& triangleOrder )
+	{
+		const size_t cornerCount = vertexIds.size();
+		const size_t triangleCount = cornerCount / 3;
+
+		// The not yet emitted triangles of each vertex are stored at adjacency[adjacencyOffsets[vertex]],
+		// their count is the valence of the vertex.
+		std::vector<size_t> adjacencyOffsets( vertexCount + 1, 0 );
+		for ( size_t i = 0; i < cornerCount; ++i )
+			++adjacencyOffsets[vertexIds[i] + 1];
+		for ( size_t i = 0; i < vertexCount; ++i )
+			adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+		std::vector<unsigned int> adjacency( cornerCount );
+		std::vector<size_t> valences( vertexCount, 0 );
+		for ( size_t i = 0; i < cornerCount; ++i )
+		{
+			unsigned int vertex = vertexIds[i];
+			adjacency[adjacencyOffsets[vertex] + valences[vertex]++] = (unsigned int)(i / 3);
+		}
+
+		std::vector<int> cachePositions( vertexCount, -1 );
+		std::vector<float> vertexScores( vertexCount );
+		for ( size_t i = 0; i < vertexCount; ++i )
+			vertexScores[i] = calculateVertexScore( -1, valences[i] );
+
+		std::vector<float> triangleScores( triangleCount );
+		std::vector<bool> emitted( triangleCount, false );
+		unsigned int bestTriangle = NO_INDEX;
+		float bestScore = -1.0f;
+		for ( size_t i = 0; i < triangleCount; ++i )
+		{
+			triangleScores[i] = vertexScores[vertexIds[3*i]] + vertexScores[vertexIds[3*i + 1]] + vertexScores[vertexIds[3*i + 2]];
+			if ( triangleScores[i] > bestScore )
+			{
+				bestScore = triangleScores[i];
+				bestTriangle = (unsigned int)i;
+			}
+		}
+
+		std::vector<unsigned int> cache;
+		std::vector<unsigned int> newCache;
+		cache.reserve( OPTIMIZER_CACHE_SIZE + 3 );
+		newCache.reserve( OPTIMIZER_CACHE_SIZE + 3 );
+
+		triangleOrder.clear();
+		triangleOrder.reserve( triangleCount );
+		size_t nextNotEmittedTriangle = 0;
+
+		while ( triangleOrder.size() < triangleCount )
+		{
+			// None of the vertices in the cache is used by a remaining triangle.
+			if ( bestTriangle == NO_INDEX )
+			{
+				while ( emitted[nextNotEmittedTriangle] )
+					++nextNotEmittedTriangle;
+				bestTriangle = (unsigned int)nextNotEmittedTriangle;
+			}
+
+			triangleOrder.push_back( bestTriangle );
+			emitted[bestTriangle] = true;
+
+			// The vertices of the emitted triangle move to the front of the cache.
+			newCache.clear();
+			for ( size_t i = 0; i < 3; ++i )
+			{
+				unsigned int vertex = vertexIds[3*bestTriangle + i];
+
+				unsigned int* triangles = &adjacency[adjacencyOffsets[vertex]];
+				size_t& valence = valences[vertex];
+				for ( size_t j = 0; j < valence; ++j )
+				{
+					if ( triangles[j] == bestTriangle )
+					{
+						triangles[j] = triangles[--valence];
+						break;
+					}
+				}
+
+				if ( std::find( newCache.begin(), newCache.end(), vertex ) == newCache.end() )
+					newCache.push_back( vertex );
+			}
+			const size_t newVertexCount = newCache.size();
+			for ( size_t i = 0; i < cache.size(); ++i )
+			{
+				if ( std::find( newCache.begin(), newCache.begin() + newVertexCount, cache[i] ) == newCache.begin() + newVertexCount )
+					newCache.push_back( cache[i] );
+			}
+
+			// Update the scores of the vertices, whose cache position changed, including the ones
+			// that fell out of the cache, and of their triangles.
+			for ( size_t i = 0; i < newCache.size(); ++i )
+			{
+				unsigned int vertex = newCache[i];
+				cachePositions[vertex] = i < OPTIMIZER_CACHE_SIZE ? (int)i : -1;
+
+				float score = calculateVertexScore( cachePositions[vertex], valences[vertex] );
+				float scoreDelta = score - vertexScores[vertex];
+				vertexScores[vertex] = score;
+
+				const unsigned int* triangles = &adjacency[adjacencyOffsets[vertex]];
+				for ( size_t j = 0; j < valences[vertex]; ++j )
+					triangleScores[triangles[j]] += scoreDelta;
+			}
+
+			// The next triangle is the one with the highest score, that uses a vertex in the cache.
+			bestTriangle = NO_INDEX;
+			bestScore = -1.0f;
+			if ( newCache.size() > OPTIMIZER_CACHE_SIZE )
+				newCache.resize( OPTIMIZER_CACHE_SIZE );
+			for ( size_t i = 0; i < newCache.size(); ++i )
+			{
+				unsigned int vertex = newCache[i];
+				const unsigned int* triangles = &adjacency[adjacencyOffsets[vertex]];
+				for ( size_t j = 0; j < valences[vertex]; ++j )
+				{
+					if ( triangleScores[triangles[j]] > bestScore )
+					{
+						bestScore = triangleScores[triangles[j]];
+						bestTriangle = triangles[j];
+					}
+				}
+			}
+
+			cache.swap( newCache );
+		}
+	}
+
+	//------------------------------
+	// Moves the three values of each vertex i to the position newIndices[i].
+	template<class T>
+	static void permuteVertexValues( T* values, const std::vector<unsigned int>& newIndices )
+	{
+		const size_t vertexCount = newIndices.size();
+		std::vector<T> oldValues( values, values + 3*vertexCount );
+		for ( size_t i = 0; i < vertexCount; ++i )
+		{
+			T* destination = values + 3*newIndices[i];
+			destination[0] = oldValues[3*i];
+			destination[1] = oldValues[3*i + 1];
+			destination[2] = oldValues[3*i + 2];
+		}
+	}
+
+	//------------------------------
+	MeshOptimizer::MeshOptimizer( int optimizationFlags )
+		: mOptimizationFlags(optimizationFlags)
+		, mStatisticsCacheSize(DEFAULT_STATISTICS_CACHE_SIZE)
+	{
+	}
+
+	//------------------------------
+	MeshOptimizer::~MeshOptimizer()
+	{
+	}
+
+	//------------------------------
+	bool MeshOptimizer::optimize( Mesh* mesh )
+	{
+		if ( !mesh )
+			return false;
+
+		std::vector<MeshPrimitive*> trianglesList;
+		const MeshPrimitiveArray& meshPrimitives = mesh->getMeshPrimitives();
+		for ( size_t i = 0, count = meshPrimitives.getCount(); i < count; ++i )
+		{
+			if ( meshPrimitives[i]->getPrimitiveType() == MeshPrimitive::TRIANGLES )
+				trianglesList.push_back( meshPrimitives[i] );
+		}
+
+		std::vector<Statistics> statisticsBefore( trianglesList.size() );
+		std::vector<Statistics> statisticsAfter( trianglesList.size() );
+
+		// The primitives are independent of each other
+		const ptrdiff_t trianglesCount = (ptrdiff_t)trianglesList.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+		for ( ptrdiff_t i = 0; i < trianglesCount; ++i )
+		{
+			MeshPrimitive* triangles = trianglesList[i];
+			statisticsBefore[i] = calculateStatistics( triangles, mStatisticsCacheSize );
+			if ( (mOptimizationFlags & OPTIMIZE_VERTEX_CACHE) != 0 )
+				optimizeVertexCache( triangles );
+			statisticsAfter[i] = calculateStatistics( triangles, mStatisticsCacheSize );
+		}
+
+		for ( size_t i = 0; i < trianglesList.size(); ++i )
+		{
+			mStatisticsBefore += statisticsBefore[i];
+			mStatisticsAfter += statisticsAfter[i];
+		}
+
+		if ( (mOptimizationFlags & OPTIMIZE_VERTEX_FETCH) != 0 )
+			return optimizeVertexFetch( mesh );
+		return true;
+	}
+
+	//------------------------------
+	MeshOptimizer::Statistics MeshOptimizer::calculateStatistics( const MeshPrimitive* triangles, size_t cacheSize )
+	{
+		Statistics statistics;
+		if ( triangles->getPrimitiveType() != MeshPrimitive::TRIANGLES )
+			return statistics;
+
+		ConstIndexArrayList indexArrays;
+		const size_t cornerCount = getCornerIndexArrays( triangles, indexArrays );
+		std::vector<unsigned int> vertexIds;
+		const size_t vertexCount = calculateVertexIds( indexArrays, cornerCount, vertexIds );
+
+		statistics.triangleCount = cornerCount / 3;
+		statistics.vertexCount = vertexCount;
+
+		// A vertex is in the FIFO cache, if less than cacheSize misses happened since it was added.
+		std::vector<size_t> additionTimes( vertexCount, (size_t)-1 );
+		size_t missCount = 0;
+		for ( size_t i = 0; i < cornerCount; ++i )
+		{
+			size_t& additionTime = additionTimes[vertexIds[i]];
+			if ( additionTime == (size_t)-1 || missCount - additionTime > cacheSize )
+				additionTime = missCount++;
+		}
+		statistics.cacheMissCount = missCount;
+
+		return statistics;
+	}
+
+	//------------------------------
+	void MeshOptimizer::optimizeVertexCache( MeshPrimitive* triangles )
+	{
+		if ( triangles->getPrimitiveType() != MeshPrimitive::TRIANGLES )
+			return;
+
+		ConstIndexArrayList indexArrays;
+		const size_t cornerCount = getCornerIndexArrays( triangles, indexArrays );
+		if ( cornerCount < 6 || (cornerCount % 3) != 0 )
+			return;
+
+		std::vector<unsigned int> vertexIds;
+		const size_t vertexCount = calculateVertexIds( indexArrays, cornerCount, vertexIds );
+
+		std::vector<unsigned int> triangleOrder;
+		calculateTriangleOrder( vertexIds, vertexCount, triangleOrder );
+
+		// Reorder the corners of all index arrays. They belong to triangles, so they may be changed.
+		std::vector<unsigned int> oldIndices( cornerCount );
+		for ( size_t i = 0; i < indexArrays.size(); ++i )
+		{
+			unsigned int* indices = const_cast<unsigned int*>( indexArrays[i]->getData() );
+			oldIndices.assign( indices, indices + cornerCount );
+			for ( size_t j = 0; j < triangleOrder.size(); ++j )
+			{
+				const unsigned int* oldTriangle = &oldIndices[3*triangleOrder[j]];
+				indices[3*j] = oldTriangle[0];
+				indices[3*j + 1] = oldTriangle[1];
+				indices[3*j + 2] = oldTriangle[2];
+			}
+		}
+	}
+
+	//------------------------------
+	bool MeshOptimizer::optimizeVertexFetch( Mesh* mesh )
+	{
+		typedef UIntValuesArray& (MeshPrimitive::*IndicesGetter)();
+
+		MeshVertexData* vertexDataList[] =
+		{
+			&mesh->getPositions(),
+			&mesh->getNormals(),
+			&mesh->getTangents(),
+			&mesh->getBinormals()
+		};
+		IndicesGetter indicesGetterList[] =
+		{
+			&MeshPrimitive::getPositionIndices,
+			&MeshPrimitive::getNormalIndices,
+			&MeshPrimitive::getTangentIndices,
+			&MeshPrimitive::getBinormalIndices
+		};
+		const size_t vertexDataCount = sizeof(vertexDataList) / sizeof(vertexDataList[0]);
+
+		MeshPrimitiveArray& meshPrimitives = mesh->getMeshPrimitives();
+		const size_t meshPrimitivesCount = meshPrimitives.getCount();
+
+		// Check all indices, before anything is changed.
+		for ( size_t i = 0; i < vertexDataCount; ++i )
+		{
+			const size_t vertexCount = vertexDataList[i]->getValuesCount() / 3;
+			for ( size_t j = 0; j < meshPrimitivesCount; ++j )
+			{
+				const UIntValuesArray& indices = (meshPrimitives[j]->*indicesGetterList[i])();
+				for ( size_t k = 0; k < indices.getCount(); ++k )
+				{
+					if ( indices[k] >= vertexCount )
+						return false;
+				}
+			}
+		}
+
+		std::vector<unsigned int> newIndices;
+		for ( size_t i = 0; i < vertexDataCount; ++i )
+		{
+			MeshVertexData& vertexData = *vertexDataList[i];
+			const size_t valuesCount = vertexData.getValuesCount();
+			if ( valuesCount == 0 || (valuesCount % 3) != 0 )
+				continue;
+
+			// The new index of each vertex is the order of its first reference. The vertices, that are
+			// not referenced, follow in their original order.
+			const size_t vertexCount = valuesCount / 3;
+			newIndices.assign( vertexCount, NO_INDEX );
+			unsigned int nextIndex = 0;
+			for ( size_t j = 0; j < meshPrimitivesCount; ++j )
+			{
+				const UIntValuesArray& indices = (meshPrimitives[j]->*indicesGetterList[i])();
+				for ( size_t k = 0; k < indices.getCount(); ++k )
+				{
+					if ( newIndices[indices[k]] == NO_INDEX )
+						newIndices[indices[k]] = nextIndex++;
+				}
+			}
+			for ( size_t j = 0; j < vertexCount; ++j )
+			{
+				if ( newIndices[j] == NO_INDEX )
+					newIndices[j] = nextIndex++;
+			}
+
+			if ( vertexData.getType() == MeshVertexData::DATA_TYPE_FLOAT )
+				permuteVertexValues( vertexData.getFloatValues()->getData(), newIndices );
+			else if ( vertexData.getType() == MeshVertexData::DATA_TYPE_DOUBLE )
+				permuteVertexValues( vertexData.getDoubleValues()->getData(), newIndices );
+			else
+				continue;
+
+			for ( size_t j = 0; j < meshPrimitivesCount; ++j )
+			{
+				UIntValuesArray& indices = (meshPrimitives[j]->*indicesGetterList[i])();
+				for ( size_t k = 0; k < indices.getCount(); ++k )
+					indices[k] = newIndices[indices[k]];
+			}
+		}
+
+		return true;
+	}
+
+} // namespace COLLADAFW
@@ -0,0 +1,326 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADAFWStableHeaders.h"
+#include "COLLADAFWPackedSkinInfluences.h"
+#include "COLLADAFWSkinControllerData.h"
+
+#include <vector>
+
+
+namespace COLLADAFW
+{
+
+	/** The largest joint index that can be stored in the packed joint indices.*/
+	static const size_t MAX_PACKED_JOINT_INDEX = 0xFFFF;
+
+	//------------------------------
+	template<class QuantizedType>
+	static void quantizeWeights( const float* weights, size_t count, unsigned int maxValue, bool renormalize, QuantizedType* quantizedWeights )
+	{
+		unsigned int sum = 0;
+		for ( size_t i = 0; i < count; ++i )
+		{
+			unsigned int quantizedWeight = (unsigned int)(weights[i] * maxValue + 0.5f);
+			if ( quantizedWeight > maxValue )
+				quantizedWeight = maxValue;
+			quantizedWeights[i] = (QuantizedType)quantizedWeight;
+			sum += quantizedWeight;
+		}
+
+		// Rounding might make the quantized weights sum up to a value different from maxValue.
+		// Since the weights are sorted, the rounding error is added to the largest one.
+		if ( renormalize && (count > 0) && (sum != 0) && (sum != maxValue) )
+		{
+			int corrected = (int)quantizedWeights[0] + (int)maxValue - (int)sum;
+			if ( corrected < 0 )
+				corrected = 0;
+			quantizedWeights[0] = (QuantizedType)corrected;
+		}
+	}
+
+	//------------------------------
+	PackedSkinInfluences::PackedSkinInfluences()
+		: mVertexCount(0)
+		, mInfluencesPerVertex(0)
+		, mWeightFormat(WEIGHT_FORMAT_FLOAT)
+		, mJointIndices(UShortValuesArray::OWNER)
+		, mFloatWeights(FloatArray::OWNER)
+		, mUnorm16Weights(UShortValuesArray::OWNER)
+		, mUnorm8Weights(UCharValuesArray::OWNER)
+		, mDiscardedInfluencesCount(0)
+	{
+	}
+
+	//------------------------------
+	PackedSkinInfluences::~PackedSkinInfluences()
+	{
+	}
+
+	//------------------------------
+	void PackedSkinInfluences::clear()
+	{
+		mJointIndices.releaseMemory();
+		mFloatWeights.releaseMemory();
+		mUnorm16Weights.releaseMemory();
+		mUnorm8Weights.releaseMemory();
+		mVertexCount = 0;
+		mInfluencesPerVertex = 0;
+		mDiscardedInfluencesCount = 0;
+	}
+
+	//------------------------------
+	bool PackedSkinInfluences::pack( const SkinControllerData& skinControllerData, const Options& options )
+	{
+		const UIntValuesArray& jointsPerVertex = skinControllerData.getJointsPerVertex();
+		const IntValuesArray& jointIndices = skinControllerData.getJointIndices();
+		const UIntValuesArray& weightIndices = skinControllerData.getWeightIndices();
+		const FloatOrDoubleArray& weights = skinControllerData.getWeights();
+
+		if ( jointIndices.getCount() != weightIndices.getCount() )
+			return false;
+
+		switch ( weights.getType() )
+		{
+		case FloatOrDoubleArray::DATA_TYPE_FLOAT:
+			return pack( jointsPerVertex.getData(), jointsPerVertex.getCount(), jointIndices.getData(), weightIndices.getData(),
+				         weightIndices.getCount(), weights.getFloatValues()->getData(), weights.getValuesCount(), skinControllerData.getJointsCount(), options);
+		case FloatOrDoubleArray::DATA_TYPE_DOUBLE:
+			return pack( jointsPerVertex.getData(), jointsPerVertex.getCount(), jointIndices.getData(), weightIndices.getData(),
+				         weightIndices.getCount(), weights.getDoubleValues()->getData(), weights.getValuesCount(), skinControllerData.getJointsCount(), options);
+		default:
+			return false;
+		}
+	}
+
+	//------------------------------
+	bool PackedSkinInfluences::pack( const unsigned int* jointsPerVertex,
+		                             size_t vertexCount,
+		                             const int* jointIndices,
+		                             const unsigned int* weightIndices,
+		                             size_t influencesCount,
+		                             const float* weights,
+		                             size_t weightsCount,
+		                             size_t jointsCount,
+		                             const Options& options )
+	{
+		return packInfluences(jointsPerVertex, vertexCount, jointIndices, weightIndices, influencesCount, weights, weightsCount, jointsCount, options);
+	}
+
+	//------------------------------
+	bool PackedSkinInfluences::pack( const unsigned int* jointsPerVertex,
+		                             size_t vertexCount,
+		                             const int* jointIndices,
+		                             const unsigned int* weightIndices,
+		                             size_t influencesCount,
+		                             const double* weights,
+		                             size_t weightsCount,
+		                             size_t jointsCount,
+		                             const Options& options )
+	{
+		return packInfluences(jointsPerVertex, vertexCount, jointIndices, weightIndices, influencesCount, weights, weightsCount, jointsCount, options);
+	}
+
+	//------------------------------
+	template<class WeightType>
+	bool PackedSkinInfluences::packInfluences( const unsigned int* jointsPerVertex,
+		                                       size_t vertexCount,
+		                                       const int* jointIndices,
+		                                       const unsigned int* weightIndices,
+		                                       size_t influencesCount,
+		                                       const WeightType* weights,
+		                                       size_t weightsCount,
+		                                       size_t jointsCount,
+		                                       const Options& options )
+	{
+		clear();
+
+		const size_t stride = options.influencesPerVertex;
+		if ( (stride == 0) || (stride > MAX_INFLUENCES_PER_VERTEX) )
+			return false;
+
+		if ( jointsCount > MAX_PACKED_JOINT_INDEX + 1 )
+			return false;
+
+		if ( vertexCount == 0 )
+		{
+			mInfluencesPerVertex = stride;
+			mWeightFormat = options.weightFormat;
+			return true;
+		}
+
+		if ( !jointsPerVertex || !jointIndices || !weightIndices || !weights )
+			return false;
+
+		// The influences of a vertex start at the sum of the influences of all previous vertices.
+		// Calculate these offsets up front to be able to process the vertices independently.
+		std::vector<size_t> influenceOffsets(vertexCount + 1);
+		influenceOffsets[0] = 0;
+		for ( size_t i = 0; i < vertexCount; ++i )
+			influenceOffsets[i + 1] = influenceOffsets[i] + jointsPerVertex[i];
+
+		// The influences are accessed in parallel below, a malformed vcount must not make them exceed
+		// the index arrays
+		if ( influenceOffsets[vertexCount] > influencesCount )
+			return false;
+
+		const size_t packedCount = vertexCount * stride;
+
+		mJointIndices.allocMemory(packedCount);
+		mJointIndices.setCount(packedCount);
+
+		switch ( options.weightFormat )
+		{
+		case WEIGHT_FORMAT_FLOAT:
+			mFloatWeights.allocMemory(packedCount);
+			mFloatWeights.setCount(packedCount);
+			break;
+		case WEIGHT_FORMAT_UNORM16:
+			mUnorm16Weights.allocMemory(packedCount);
+			mUnorm16Weights.setCount(packedCount);
+			break;
+		case WEIGHT_FORMAT_UNORM8:
+			mUnorm8Weights.allocMemory(packedCount);
+			mUnorm8Weights.setCount(packedCount);
+			break;
+		default:
+			return false;
+		}
+
+		unsigned short* packedJoints = mJointIndices.getData();
+		float* packedFloatWeights = mFloatWeights.getData();
+		unsigned short* packedUnorm16Weights = mUnorm16Weights.getData();
+		unsigned char* packedUnorm8Weights = mUnorm8Weights.getData();
+
+		const float minimumWeight = (float)options.minimumWeight;
+		const bool renormalize = options.renormalize;
+		const WeightFormat weightFormat = options.weightFormat;
+
+		size_t discardedCount = 0;
+		int invalid = 0;
+
+		// Each vertex is processed independently and writes only to its own slots
+		const ptrdiff_t signedVertexCount = (ptrdiff_t)vertexCount;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:discardedCount) reduction(|:invalid)
+#endif
+		for ( ptrdiff_t vertex = 0; vertex < signedVertexCount; ++vertex )
+		{
+			// the kept influences, sorted by descending weight
+			float keptWeights[MAX_INFLUENCES_PER_VERTEX];
+			unsigned short keptJoints[MAX_INFLUENCES_PER_VERTEX];
+			size_t keptCount = 0;
+
+			const size_t influenceBegin = influenceOffsets[vertex];
+			const size_t influenceEnd = influenceOffsets[vertex + 1];
+
+			for ( size_t influence = influenceBegin; influence < influenceEnd; ++influence )
+			{
+				int jointIndex = jointIndices[influence];
+				unsigned int weightIndex = weightIndices[influence];
+
+				if ( (weightIndex >= weightsCount) || (jointIndex >= (int)jointsCount) )
+				{
+					invalid |= 1;
+					continue;
+				}
+
+				float weight = (float)weights[weightIndex];
+
+				// Negative joint indices reference the bind shape, which has no joint to be packed
+				if ( (jointIndex < 0) || (weight <= minimumWeight) )
+				{
+					++discardedCount;
+					continue;
+				}
+
+				// insert into the kept influences, dropping the smallest one if there are too many
+				size_t position = keptCount;
+				while ( (position > 0) && (keptWeights[position - 1] < weight) )
+					--position;
+
+				if ( position >= stride )
+				{
+					++discardedCount;
+					continue;
+				}
+
+				if ( keptCount == stride )
+					++discardedCount;
+				else
+					++keptCount;
+
+				for ( size_t i = keptCount - 1; i > position; --i )
+				{
+					keptWeights[i] = keptWeights[i - 1];
+					keptJoints[i] = keptJoints[i - 1];
+				}
+				keptWeights[position] = weight;
+				keptJoints[position] = (unsigned short)jointIndex;
+			}
+
+			if ( renormalize )
+			{
+				float weightSum = 0;
+				for ( size_t i = 0; i < keptCount; ++i )
+					weightSum += keptWeights[i];
+
+				if ( weightSum > 0 )
+				{
+					float scale = 1.0f / weightSum;
+					for ( size_t i = 0; i < keptCount; ++i )
+						keptWeights[i] *= scale;
+				}
+			}
+
+			for ( size_t i = keptCount; i < stride; ++i )
+			{
+				keptWeights[i] = 0;
+				keptJoints[i] = 0;
+			}
+
+			const size_t packedOffset = (size_t)vertex * stride;
+
+			for ( size_t i = 0; i < stride; ++i )
+				packedJoints[packedOffset + i] = keptJoints[i];
+
+			switch ( weightFormat )
+			{
+			case WEIGHT_FORMAT_FLOAT:
+				for ( size_t i = 0; i < stride; ++i )
+					packedFloatWeights[packedOffset + i] = keptWeights[i];
+				break;
+			case WEIGHT_FORMAT_UNORM16:
+				quantizeWeights(keptWeights, keptCount, 0xFFFF, renormalize, packedUnorm16Weights + packedOffset);
+				for ( size_t i = keptCount; i < stride; ++i )
+					packedUnorm16Weights[packedOffset + i] = 0;
+				break;
+			case WEIGHT_FORMAT_UNORM8:
+				quantizeWeights(keptWeights, keptCount, 0xFF, renormalize, packedUnorm8Weights + packedOffset);
+				for ( size_t i = keptCount; i < stride; ++i )
+					packedUnorm8Weights[packedOffset + i] = 0;
+				break;
+			}
+		}
+
+		if ( invalid )
+		{
+			clear();
+			return false;
+		}
+
+		mVertexCount = vertexCount;
+		mInfluencesPerVertex = stride;
+		mWeightFormat = weightFormat;
+		mDiscardedInfluencesCount = discardedCount;
+		return true;
+	}
+
+} // namespace COLLADAFW
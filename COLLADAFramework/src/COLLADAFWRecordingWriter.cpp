@@ -0,0 +1,381 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADAFramework.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADAFWStableHeaders.h"
+#include "COLLADAFWRecordingWriter.h"
+#include "COLLADAFWFileInfo.h"
+#include "COLLADAFWScene.h"
+#include "COLLADAFWVisualScene.h"
+#include "COLLADAFWLibraryNodes.h"
+#include "COLLADAFWGeometry.h"
+#include "COLLADAFWMaterial.h"
+#include "COLLADAFWEffect.h"
+#include "COLLADAFWCamera.h"
+#include "COLLADAFWImage.h"
+#include "COLLADAFWLight.h"
+#include "COLLADAFWAnimation.h"
+#include "COLLADAFWAnimationList.h"
+#include "COLLADAFWSkinControllerData.h"
+#include "COLLADAFWController.h"
+#include "COLLADAFWFormulas.h"
+#include "COLLADAFWKinematicsScene.h"
+
+
+namespace COLLADAFW
+{
+
+	//------------------------------
+	RecordingWriter::RecordingWriter()
+		: mCanceled(false)
+		, mFinished(false)
+	{
+	}
+
+	//------------------------------
+	RecordingWriter::~RecordingWriter()
+	{
+		clear();
+	}
+
+	//------------------------------
+	void RecordingWriter::clear()
+	{
+		for ( RecordList::const_iterator it = mRecords.begin(); it != mRecords.end(); ++it )
+		{
+			deleteObject( *it );
+			delete it->imageData;
+		}
+		mRecords.clear();
+
+		for ( ImageImageDataMap::const_iterator it = mPendingImageData.begin(); it != mPendingImageData.end(); ++it )
+			delete it->second;
+		mPendingImageData.clear();
+
+		mCanceled = false;
+		mErrorMessage.clear();
+		mFinished = false;
+	}
+
+	//------------------------------
+	bool RecordingWriter::replay( IWriter* writer, int objectFlags ) const
+	{
+		if ( !mFinished || !writer )
+			return false;
+
+		writer->start();
+
+		bool success = true;
+		for ( RecordList::const_iterator it = mRecords.begin(); it != mRecords.end(); ++it )
+		{
+			const Record& record = *it;
+			if ( (objectFlags & record.objectType) == 0 )
+				continue;
+
+			if ( !replayObject( record, writer ) )
+			{
+				success = false;
+				break;
+			}
+		}
+
+		if ( mCanceled )
+			writer->cancel( mErrorMessage );
+
+		writer->finish();
+
+		return success;
+	}
+
+	//------------------------------
+	void RecordingWriter::record( ObjectFlags objectType, const void* object, ImageData* imageData )
+	{
+		Record record;
+		record.objectType = objectType;
+		record.object = object;
+		record.imageData = imageData;
+		mRecords.push_back( record );
+	}
+
+	//------------------------------
+	void RecordingWriter::deleteObject( const Record& record )
+	{
+		switch ( record.objectType )
+		{
+		case GLOBAL_ASSET_FLAG:
+			FW_DELETE (FileInfo*)record.object;
+			break;
+		case SCENE_FLAG:
+			FW_DELETE (Scene*)record.object;
+			break;
+		case VISUAL_SCENE_FLAG:
+			FW_DELETE (VisualScene*)record.object;
+			break;
+		case LIBRARY_NODES_FLAG:
+			FW_DELETE (LibraryNodes*)record.object;
+			break;
+		case GEOMETRY_FLAG:
+			FW_DELETE (Geometry*)record.object;
+			break;
+		case MATERIAL_FLAG:
+			FW_DELETE (Material*)record.object;
+			break;
+		case EFFECT_FLAG:
+			FW_DELETE (Effect*)record.object;
+			break;
+		case CAMERA_FLAG:
+			FW_DELETE (Camera*)record.object;
+			break;
+		case IMAGE_FLAG:
+			FW_DELETE (Image*)record.object;
+			break;
+		case LIGHT_FLAG:
+			FW_DELETE (Light*)record.object;
+			break;
+		case ANIMATION_FLAG:
+			FW_DELETE (Animation*)record.object;
+			break;
+		case ANIMATION_LIST_FLAG:
+			FW_DELETE (AnimationList*)record.object;
+			break;
+		case SKIN_CONTROLLER_DATA_FLAG:
+			FW_DELETE (SkinControllerData*)record.object;
+			break;
+		case CONTROLLER_FLAG:
+			FW_DELETE (Controller*)record.object;
+			break;
+		case FORMULAS_FLAG:
+			FW_DELETE (Formulas*)record.object;
+			break;
+		case KINEMATICS_SCENE_FLAG:
+			FW_DELETE (KinematicsScene*)record.object;
+			break;
+		default:
+			break;
+		}
+	}
+
+	//------------------------------
+	bool RecordingWriter::replayObject( const Record& record, IWriter* writer )
+	{
+		switch ( record.objectType )
+		{
+		case GLOBAL_ASSET_FLAG:
+			return writer->writeGlobalAsset( (const FileInfo*)record.object );
+		case SCENE_FLAG:
+			return writer->writeScene( (const Scene*)record.object );
+		case VISUAL_SCENE_FLAG:
+			return writer->writeVisualScene( (const VisualScene*)record.object );
+		case LIBRARY_NODES_FLAG:
+			return writer->writeLibraryNodes( (const LibraryNodes*)record.object );
+		case GEOMETRY_FLAG:
+			return writer->writeGeometry( (const Geometry*)record.object );
+		case MATERIAL_FLAG:
+			return writer->writeMaterial( (const Material*)record.object );
+		case EFFECT_FLAG:
+			return writer->writeEffect( (const Effect*)record.object );
+		case CAMERA_FLAG:
+			return writer->writeCamera( (const Camera*)record.object );
+		case IMAGE_FLAG:
+			{
+				const Image* image = (const Image*)record.object;
+				// as the loader does, the embedded data is passed before the image itself
+				if ( record.imageData && writer->startImageData( image ) )
+				{
+					const ImageData& imageData = *record.imageData;
+					if ( !imageData.empty() && !writer->writeImageData( image, &imageData[0], imageData.size() ) )
+						return false;
+					if ( !writer->finishImageData( image ) )
+						return false;
+				}
+				return writer->writeImage( image );
+			}
+		case LIGHT_FLAG:
+			return writer->writeLight( (const Light*)record.object );
+		case ANIMATION_FLAG:
+			return writer->writeAnimation( (const Animation*)record.object );
+		case ANIMATION_LIST_FLAG:
+			return writer->writeAnimationList( (const AnimationList*)record.object );
+		case SKIN_CONTROLLER_DATA_FLAG:
+			return writer->writeSkinControllerData( (const SkinControllerData*)record.object );
+		case CONTROLLER_FLAG:
+			return writer->writeController( (const Controller*)record.object );
+		case FORMULAS_FLAG:
+			return writer->writeFormulas( (const Formulas*)record.object );
+		case KINEMATICS_SCENE_FLAG:
+			return writer->writeKinematicsScene( (const KinematicsScene*)record.object );
+		default:
+			return true;
+		}
+	}
+
+	//------------------------------
+	void RecordingWriter::cancel( const String& errorMessage )
+	{
+		mCanceled = true;
+		mErrorMessage = errorMessage;
+	}
+
+	//------------------------------
+	void RecordingWriter::start()
+	{
+		clear();
+	}
+
+	//------------------------------
+	void RecordingWriter::finish()
+	{
+		// data of images that have never been written can not be replayed
+		for ( ImageImageDataMap::const_iterator it = mPendingImageData.begin(); it != mPendingImageData.end(); ++it )
+			delete it->second;
+		mPendingImageData.clear();
+
+		mFinished = true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeGlobalAsset( const FileInfo* asset )
+	{
+		record( GLOBAL_ASSET_FLAG, asset );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeScene( const Scene* scene )
+	{
+		record( SCENE_FLAG, scene );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeVisualScene( const VisualScene* visualScene )
+	{
+		record( VISUAL_SCENE_FLAG, visualScene );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeLibraryNodes( const LibraryNodes* libraryNodes )
+	{
+		record( LIBRARY_NODES_FLAG, libraryNodes );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeGeometry( const Geometry* geometry )
+	{
+		record( GEOMETRY_FLAG, geometry );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeMaterial( const Material* material )
+	{
+		record( MATERIAL_FLAG, material );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeEffect( const Effect* effect )
+	{
+		record( EFFECT_FLAG, effect );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeCamera( const Camera* camera )
+	{
+		record( CAMERA_FLAG, camera );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeImage( const Image* image )
+	{
+		ImageData* imageData = 0;
+		ImageImageDataMap::iterator it = mPendingImageData.find( image );
+		if ( it != mPendingImageData.end() )
+		{
+			imageData = it->second;
+			mPendingImageData.erase( it );
+		}
+		record( IMAGE_FLAG, image, imageData );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::startImageData( const Image* image )
+	{
+		ImageData*& imageData = mPendingImageData[image];
+		if ( !imageData )
+			imageData = new ImageData();
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeImageData( const Image* image, const unsigned char* data, size_t length )
+	{
+		ImageImageDataMap::iterator it = mPendingImageData.find( image );
+		if ( it == mPendingImageData.end() )
+			return false;
+		ImageData& imageData = *it->second;
+		imageData.insert( imageData.end(), data, data + length );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeLight( const Light* light )
+	{
+		record( LIGHT_FLAG, light );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeAnimation( const Animation* animation )
+	{
+		record( ANIMATION_FLAG, animation );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeAnimationList( const AnimationList* animationList )
+	{
+		record( ANIMATION_LIST_FLAG, animationList );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeSkinControllerData( const SkinControllerData* skinControllerData )
+	{
+		record( SKIN_CONTROLLER_DATA_FLAG, skinControllerData );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeController( const Controller* controller )
+	{
+		record( CONTROLLER_FLAG, controller );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeFormulas( const Formulas* formulas )
+	{
+		record( FORMULAS_FLAG, formulas );
+		return true;
+	}
+
+	//------------------------------
+	bool RecordingWriter::writeKinematicsScene( const KinematicsScene* kinematicsScene )
+	{
+		record( KINEMATICS_SCENE_FLAG, kinematicsScene );
+		return true;
+	}
+
+} // namespace COLLADAFW
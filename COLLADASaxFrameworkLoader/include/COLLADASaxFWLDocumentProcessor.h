@@ -82,6 +82,10 @@ namespace COLLADASaxFWL
 		completely been parsed.*/
 		Loader::CameraList& mCameras;
 
+		/** The number of objects at the end of the lists above, that have already been sent to the writer
+		during the current load.*/
+		Loader::WrittenObjectCounts& mWrittenObjectCounts;
+
 		/** List of all joints already created. They will be written as part of kinematics.*/
 		KinematicsIntermediateData& mKinematicsIntermediateData;
 
@@ -155,23 +159,23 @@ namespace COLLADASaxFWL
 
 		/** Adds @a visualScene to the list of visual scenes. It will be sent to the writer and delete by the
 		file loader.*/
-		void addVisualScene( COLLADAFW::VisualScene* visualScene ) { mVisualScenes.push_back(visualScene); }
+		void addVisualScene( COLLADAFW::VisualScene* visualScene );
 
 		/** Adds @a libraryNodes to the list of library nodes. It will be sent to the writer and delete by the
 		file loader.*/
-		void addLibraryNodes( COLLADAFW::LibraryNodes* libraryNodes ) { mLibraryNodes.push_back(libraryNodes); }
+		void addLibraryNodes( COLLADAFW::LibraryNodes* libraryNodes );
 
 		/** Adds @a effect to the list of effects. It will be sent to the writer and delete by the
 		file loader.*/
-		void addEffect( COLLADAFW::Effect* effect ) { mEffects.push_back(effect); }
+		void addEffect( COLLADAFW::Effect* effect );
 
 		/** Adds @a light to the list of lights. It will be sent to the writer and delete by the
 		file loader.*/
-		void addLight( COLLADAFW::Light* light ) { mLights.push_back(light); }
+		void addLight( COLLADAFW::Light* light );
 
 		/** Adds @a camera to the list of cameras. It will be sent to the writer and delete by the
 		file loader.*/
-		void addCamera( COLLADAFW::Camera* camera ) { mCameras.push_back(camera); }
+		void addCamera( COLLADAFW::Camera* camera );
 
 		/** Adds @a formula to the list of formulas. It will be sent to the writer and delete by the
 		file loader.*/
@@ -262,7 +266,7 @@ namespace COLLADASaxFWL
 		COLLADAFW::AnimationList*& getAnimationListByUniqueId( const COLLADAFW::UniqueId& animationListUniqueId);
 
 		/** Adds the pair @a skinDataUniqueId, @a jointSids to mSkinDataJointSidsMap.*/
-		void addSkinDataJointSidsPair( const COLLADAFW::UniqueId& skinDataUniqueId, const StringList& sidsOrIds, bool areIds );
+		void addSkinDataJointSidsPair( const COLLADAFW::UniqueId& skinDataUniqueId, const SymbolIdList& sidsOrIds, bool areIds );
 
 		/** Returns the sids of the nodes used by a skin controller using skin data with unique id 
 		@a skinDataUniqueId*/
@@ -295,17 +299,19 @@ namespace COLLADASaxFWL
 
 		/** Creates a controller which instantiation is described by @a InstanceControllerData and that uses 
 		the controller with id @a controllerDataUniqueId.
-		@param sidsOrIds The sids or ids used to resolve joints.
+		@param sidsOrIds The symbol ids of the sids or ids used to resolve joints.
 		@param resolveIds If true, the strings in @a sidsOrIds are resolved as Ids, otherwise as Sids
 		*/
 		bool createAndWriteSkinController( const Loader::InstanceControllerData& instanceControllerData, 
 			const COLLADAFW::UniqueId& controllerDataUniqueId,
 			const COLLADAFW::UniqueId& sourceUniqueId,
-			const StringList& sidsOrIds,
+			const SymbolIdList& sidsOrIds,
 			bool resolveIds);
 
 
-		/** Creates all skin controllers instantiated in the visual scene.*/
+		/** Creates all skin controllers instantiated in the visual scene. The joints of all instance controllers
+		are resolved in parallel first. Instance controllers with the same skin data and skeleton roots share the
+		resolved joints. Afterwards the skin controllers are written in the order of the instance controllers.*/
 		bool createAndWriteSkinControllers();
 
 
@@ -317,6 +323,12 @@ namespace COLLADASaxFWL
 		/** Returns a const pointer to the COLLADA document. */
 		const Loader* getColladaLoader() const { return mColladaLoader; }
 
+		/** Returns true, if the objects of type @a objectFlag (Loader::ObjectFlags) can be sent to the writer
+		as soon as they have been parsed. This is the case, if they should be written at all and none of the
+		steps performed by the post processor could still modify them or resolve sids into them. Otherwise,
+		they are held back until the document has completely been parsed.*/
+		bool canWriteWhileParsing( int objectFlag ) const;
+
 	private:
 		friend class VersionParser;
 
@@ -329,8 +341,63 @@ namespace COLLADASaxFWL
 		/** The version of the collada document.*/
 		void setCOLLADAVersion(COLLADAVersion cOLLADAVersion);
 
+		/** The joints of a skin controller, resolved for the skeleton roots of an instance controller.*/
+		struct SkinControllerJoints
+		{
+			/** The joints that could be resolved, in the order of the sids or ids.*/
+			NodeList joints;
+
+			/** The sids or ids that could not be resolved.*/
+			SymbolIdList unresolvedSidsOrIds;
+		};
+
+		/** An instance controller, a skin controller is created for by createAndWriteSkinControllers().*/
+		struct SkinControllerInstance
+		{
+			/** The instance controller.*/
+			const Loader::InstanceControllerData* instanceControllerData;
+
+			/** The unique id of the skin data used by the instance controller.*/
+			COLLADAFW::UniqueId skinDataUniqueId;
+
+			/** The unique id of the source of the skin controller.*/
+			COLLADAFW::UniqueId sourceUniqueId;
+
+			/** The index of the joints of the skin controller in the list of resolved joints.*/
+			size_t jointsIndex;
+		};
+
 		/** add joint for skin controller */
 		bool addValidatedJoint(const SidTreeNode &joint, NodeList &joints);
+
+		/** Resolves the joints @a sidsOrIds of a skin controller, instantiated with the skeleton roots
+		@a skeletonRoots. Only reads the sid tree, i.e. might be called concurrently.
+		@param resolveIds If true, the strings in @a sidsOrIds are resolved as Ids, otherwise as Sids
+		@param skinControllerJoints Receives the resolved joints.*/
+		void resolveSkinControllerJoints( const URIList& skeletonRoots,
+			const SymbolIdList& sidsOrIds,
+			bool resolveIds,
+			SkinControllerJoints& skinControllerJoints );
+
+		/** Creates a controller with the joints @a skinControllerJoints, which instantiation is described by
+		@a InstanceControllerData and that uses the controller with id @a controllerDataUniqueId, and writes
+		it, if no equal one has been written before. Reports the joints that could not be resolved.*/
+		bool writeSkinController( const Loader::InstanceControllerData& instanceControllerData, 
+			const COLLADAFW::UniqueId& controllerDataUniqueId,
+			const COLLADAFW::UniqueId& sourceUniqueId,
+			const SkinControllerJoints& skinControllerJoints,
+			bool resolveIds );
+
+		/** Sends @a object to the writer using @a writeFunction, if canWriteWhileParsing() is true for
+		@a objectFlag. Unless it has been sent and the writer takes the ownership, @a object is added to
+		@a objectList.
+		@param writtenCount The number of objects at the end of @a objectList that have already been written.*/
+		template<class ObjectType>
+		void addObject( ObjectType* object,
+			std::vector<ObjectType*>& objectList,
+			size_t& writtenCount,
+			int objectFlag,
+			bool (COLLADAFW::IWriter::*writeFunction)( const ObjectType* ) );
 	};
 
 } // namespace COLLADASAXFWL
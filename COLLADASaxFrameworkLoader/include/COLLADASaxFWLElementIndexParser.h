@@ -0,0 +1,119 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADASaxFrameworkLoader.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADASAXFWL_ELEMENTINDEXPARSER_H__
+#define __COLLADASAXFWL_ELEMENTINDEXPARSER_H__
+
+#include "COLLADASaxFWLPrerequisites.h"
+#include "COLLADASaxFWLLoader.h"
+
+#include "GeneratedSaxParserParser.h"
+
+#include "COLLADABUURI.h"
+
+#include <vector>
+
+
+namespace COLLADASaxFWL
+{
+    /**
+     * Stays between the sax parser and the private parser of a file loaded with lazy loading enabled
+     * (see Loader::setLazyLoading()). All events are passed on to the private parser unchanged.
+     * Additionally, the byte offsets of the geometry, animation and controller elements in the libraries
+     * are recorded in the loader, keyed by the unique ids of the objects they are loaded into, together
+     * with the start tag of the root element. This allows the loader to parse these elements later on,
+     * without parsing the file again.
+     */
+    class ElementIndexParser : public GeneratedSaxParser::Parser
+    {
+    private:
+        /** The loader the positions of the elements are recorded in.*/
+        Loader* mLoader;
+
+        /** The uri of the indexed file.*/
+        COLLADABU::URI mFileUri;
+
+        /** The file id of the indexed file.*/
+        COLLADAFW::FileId mFileId;
+
+        /** The parser all events are passed on to.*/
+        GeneratedSaxParser::Parser* mPrivateParser;
+
+        /** The depth of the current element, where the root element has depth 1.*/
+        size_t mDepth;
+
+        /** The type of the library element currently parsed. Only valid, if mDepth is at least 2.*/
+        Loader::IndexedElementType mLibraryType;
+
+        /** True, if the current library element is one of the indexed libraries.*/
+        bool mInIndexedLibrary;
+
+        /** True, if an element of an indexed library is parsed, i.e. mCurrentElement is valid.*/
+        bool mInIndexedElement;
+
+        /** The position of the indexed element currently parsed.*/
+        Loader::IndexedElement mCurrentElement;
+
+        /** The id of the indexed element currently parsed.*/
+        String mCurrentId;
+
+        /** True, if the controller currently parsed is a morph controller.*/
+        bool mCurrentIsMorph;
+
+        /** The ids of the samplers of the animation currently parsed.*/
+        std::vector<String> mSamplerIds;
+
+    public:
+
+        /** Constructor.
+        @param errorHandler The error handler to pass the errors to.
+        @param loader The loader the positions of the elements are recorded in.
+        @param fileUri The uri of the indexed file.
+        @param privateParser The parser all events are passed on to.*/
+        ElementIndexParser( GeneratedSaxParser::IErrorHandler* errorHandler, Loader* loader, const COLLADABU::URI& fileUri, GeneratedSaxParser::Parser* privateParser );
+
+        /** Destructor. */
+        virtual ~ElementIndexParser();
+
+        virtual bool elementBegin( const ParserChar* elementName, const ParserAttributes& attributes );
+
+        virtual bool elementEnd( const ParserChar* elementName );
+
+        virtual bool textData( const ParserChar* text, size_t textLength );
+
+        virtual bool rawContentsRequested();
+
+        virtual bool rawContents( const ParserChar* contents, size_t length );
+
+    private:
+
+        /** Disable default copy ctor. */
+        ElementIndexParser( const ElementIndexParser& pre );
+
+        /** Disable default assignment operator. */
+        const ElementIndexParser& operator= ( const ElementIndexParser& pre );
+
+        /** Returns the value of the attribute @a attributeName in @a attributes, null if there is none.*/
+        static const ParserChar* findAttribute( const ParserAttributes& attributes, const char* attributeName );
+
+        /** Stores the start tag of the root element @a elementName, rebuilt from @a attributes.*/
+        void indexRootElement( const ParserChar* elementName, const ParserAttributes& attributes );
+
+        /** Registers the element that ends at @a endOffset in the loader.*/
+        void registerCurrentElement( size_t endOffset );
+
+        /** Registers @a id of the current file as indexed element of class @a classId.*/
+        void registerId( const String& id, COLLADAFW::ClassId classId );
+
+    };
+
+} // namespace COLLADASaxFWL
+
+#endif // __COLLADASAXFWL_ELEMENTINDEXPARSER_H__
@@ -52,6 +52,11 @@ namespace COLLADASaxFWL
         virtual bool elementEnd(const ParserChar* elementName);
         virtual bool textData(const ParserChar* text, size_t textLength);
 
+        /** Returns true, if no callback handler parses the current technique, i.e. its contents can be
+        skipped, or all parsing handlers want the raw contents. */
+        virtual bool wantsRawContents();
+        virtual bool rawContents( const ParserChar* contents, size_t length );
+
 	private:
 
         /** Disable default copy ctor. */
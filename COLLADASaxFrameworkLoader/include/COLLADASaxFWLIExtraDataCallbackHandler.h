@@ -35,6 +35,18 @@ namespace COLLADASaxFWL
         virtual bool elementEnd(const ParserChar* elementName ) = 0;
         virtual bool textData(const ParserChar* text, size_t textLength) = 0;
 
+        /** Returns true, if the handler wants to receive the contents of the children of the technique
+        elements it parses unparsed, in one call of rawContents() per child, between elementBegin() and
+        elementEnd() of the child. This is only done, if all handlers parsing the technique want it and
+        the sax parser supports it (the native parser). Otherwise the contents are passed to
+        elementBegin(), elementEnd() and textData() as usual. */
+        virtual bool wantsRawContents() { return false; }
+
+        /** Receives the unparsed contents of a child of a technique element, if requested by
+        wantsRawContents(). @a contents is a view of the original document, that is not null terminated
+        and only valid during the call. */
+        virtual bool rawContents( const ParserChar* contents, size_t length ) { return true; }
+
         /** Method to ask, if the current callback handler want to read the data of the given extra element. */
         virtual bool parseElement ( 
             const ParserChar* profileName, 
@@ -230,7 +230,21 @@ namespace COLLADASaxFWL
 		COLLADAFW::AnimationList*& getAnimationListByUniqueId( const COLLADAFW::UniqueId& animationListUniqueId);
 
 		/** Adds the pair @a skinDataUniqueId, @a jointSids to mSkinDataJointSidsMap.*/
-		void addSkinDataJointSidsPair( const COLLADAFW::UniqueId& skinDataUniqueId, const StringList& sidsOrIds, bool areIds );
+		void addSkinDataJointSidsPair( const COLLADAFW::UniqueId& skinDataUniqueId, const SymbolIdList& sidsOrIds, bool areIds );
+
+		/** Returns the symbol table shared by all files of the document.*/
+		GeneratedSaxParser::StringTable& getStringTable();
+
+		/** Returns the maximum number of vertices of the mesh primitives passed to a writer that streams
+		meshes.*/
+		size_t getMeshStreamChunkSize();
+
+		/** Returns true, if a hash of the vertex data and the primitives of each mesh is calculated.*/
+		bool getCalculateMeshContentHashes();
+
+		/** Returns the unique id of the first mesh registered with @a contentHash. If there is none,
+		@a meshUniqueId is registered with @a contentHash and returned.*/
+		const COLLADAFW::UniqueId& registerMeshContentHash( const COLLADABU::ContentHash& contentHash, const COLLADAFW::UniqueId& meshUniqueId );
 
 		/** Adds the pair @a skinDataUniqueId, @a skinSource to mSkinDataSkinSourceMap.*/
 		void addSkinDataSkinSourcePair( const COLLADAFW::UniqueId& skinDataUniqueId, const COLLADABU::URI& skinSource );
@@ -32,6 +32,9 @@ namespace COLLADASaxFWL
 		/** Maps strings to unique ids.*/
 		typedef std::map< String /*samplerId*/,AnimationInfo > StringAnimationInfoMap;
 
+		/** Maps symbol ids of the string table to interpolation types.*/
+		typedef std::vector< COLLADAFW::AnimationCurve::InterpolationType > InterpolationTypeList;
+
 	private:
 
         /**
@@ -59,6 +62,10 @@ namespace COLLADASaxFWL
 		to parse a sampler. This allows to not store tangents, if set to false.*/
 		bool mCurrentAnimationCurveRequiresTangents;
 
+		/** The interpolation types of the strings already found in Name_array elements, indexed by their
+		symbol id in the string table. Entries not yet determined are INTERPOLATION_UNKNOWN.*/
+		InterpolationTypeList mInterpolationTypesBySymbolId;
+
 	public:
 
         /** Constructor. */
@@ -77,6 +84,10 @@ namespace COLLADASaxFWL
         /** Determines the interpolation with @a name.*/
         static COLLADAFW::AnimationCurve::InterpolationType getInterpolationTypeByString( const ParserString& string);
 
+		/** Determines the interpolation with @a name. The name is interned in the string table and the 
+		interpolation type is cached per symbol id, i.e. each distinct name is compared only once.*/
+		COLLADAFW::AnimationCurve::InterpolationType getInterpolationTypeBySymbol( const ParserString& string);
+
 		/** Cleans up everything and gives control to calling file part loader.*/
 		bool end__library_animations();
 
@@ -46,7 +46,7 @@ namespace COLLADASaxFWL
 			MORPH_CONTROLLER
 		};
 
-		typedef std::map< String /*Id of the name array*/,  StringList> StringListMap;
+		typedef std::map< String /*Id of the name array*/,  SymbolIdList> SymbolIdListMap;
 
 	private:
 		/** The type of the controller currently being parsed.*/
@@ -74,14 +74,14 @@ namespace COLLADASaxFWL
 		currently not allowed.*/
 		InputParent mCurrentInputParent;
 
-		/** The sids of the joints of the current skin controller.*/
-		StringList *mJointSidsOrIds;
+		/** The symbol ids of the sids of the joints of the current skin controller.*/
+		SymbolIdList *mJointSidsOrIds;
 
-		/** Maps ids of name array to the list of name in the name array.*/
-		StringListMap mJointSidsMap;
+		/** Maps ids of name array to the symbol ids of the names in the name array.*/
+		SymbolIdListMap mJointSidsMap;
 
-		/** Maps ids of id_ref array to the list of ids in the id_ref array.*/
-		StringListMap mJointIdsMap;
+		/** Maps ids of id_ref array to the symbol ids of the ids in the id_ref array.*/
+		SymbolIdListMap mJointIdsMap;
 
 		/** The expected joints/vertex pair count of the current skin data.*/
 		size_t mCurrentJointsVertexPairCount;
@@ -118,7 +118,7 @@ namespace COLLADASaxFWL
 		/** Write the indices of the v element into the framework.*/
 		bool writeVIndices ( const sint64* data, size_t length );
 
-		/** Sets the String list, the values of an id_ref or name_array should be stored in.
+		/** Sets the symbol id list, the values of an id_ref or name_array should be stored in.
 		@param isIdArray If true, values are stored in idMap otherwise in in sid map*/
 		bool beginJointsArray(bool isIdArray);
 		bool dataJointArray( const ParserString* data, size_t length );
@@ -32,6 +32,9 @@ namespace COLLADASaxFWL
 		/** The current image.*/
 		COLLADAFW::Image* mCurrentImage;
 
+		/** True, if the writer receives the data embedded in the current image.*/
+		bool mStreamImageData;
+
 	public:
 
         /** Constructor. */
@@ -65,13 +68,13 @@ namespace COLLADASaxFWL
 		virtual bool data__init_from____anyURI( COLLADABU::URI value );
 
 
-		/** Set source type.*/
+		/** Set source type and ask the writer, if it wants to receive the embedded data.*/
 		virtual bool begin__data();
 
-		/** We don't need to do anything here.*/
-		virtual bool end__data(){return true;}
+		/** Tells the writer that all embedded data has been passed.*/
+		virtual bool end__data();
 
-		/** Store data in current image.*/
+		/** Passes the decoded embedded data to the writer.*/
 		virtual bool data__data( const uint8* data, size_t length );
 
 	private:
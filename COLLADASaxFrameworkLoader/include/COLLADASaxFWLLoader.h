@@ -23,11 +23,15 @@
 #include "COLLADAFWTypes.h"
 #include "COLLADAFWSkinController.h"
 #include "COLLADAFWInstanceController.h"
+#include "COLLADAFWMemoryArena.h"
 
 #include "COLLADABUHashFunctions.h"
+#include "COLLADABUContentHash.h"
 #include "COLLADABUURI.h"
 #include "COLLADABUhash_map.h"
 
+#include "GeneratedSaxParserStringTable.h"
+
 #include <set>
 
 namespace COLLADAFW
@@ -51,10 +55,14 @@ namespace COLLADASaxFWL
 	class DocumentProcessor;
 	class PostProcessor;
     class FileLoader;
+	class ElementIndexParser;
 
 
 	typedef std::list<String> StringList;
 
+	/** List of symbol ids of strings interned in the string table of the loader.*/
+	typedef std::vector<GeneratedSaxParser::StringTable::SymbolId> SymbolIdList;
+
 	typedef std::list<COLLADABU::URI> URIList;
 
 	static StringList EMPTY_STRING_LIST = StringList();
@@ -124,12 +132,24 @@ namespace COLLADASaxFWL
 		/** List of morph controller.*/
 		typedef std::vector<COLLADAFW::MorphController*> MorphControllerList;
 
+		/** The number of objects at the end of the lists of visual scenes, library nodes, effects, lights
+		and cameras, that have already been sent to the writer while the current document has been parsed.
+		The post processor only writes the objects in front of them.*/
+		struct WrittenObjectCounts
+		{
+			size_t visualScenes;
+			size_t libraryNodes;
+			size_t effects;
+			size_t lights;
+			size_t cameras;
+		};
+
 		struct JointSidsOrIds
 		{
 			JointSidsOrIds():areIds(true){}
 
-			/** List of sids or ids.*/
-			StringList sidsOrIds;
+			/** List of sids or ids, as symbol ids of the loaders string table.*/
+			SymbolIdList sidsOrIds;
 			/** True if sidsOrIds contains ids, false if sidsOrIds contains sids.*/
 			bool areIds;
 		};
@@ -165,6 +185,9 @@ namespace COLLADASaxFWL
 		/** List of formulas.*/
 		typedef std::map<COLLADAFW::UniqueId, COLLADAFW::Formula*> UniqueIdFormulaMap;
 
+		/** Maps a mesh content hash to the unique id of the first mesh with that hash.*/
+		typedef std::map<COLLADABU::ContentHash, COLLADAFW::UniqueId> ContentHashUniqueIdMap;
+
 		/** Contains the binding of an animation to the referenced object. Required to create animation lists*/
 		struct AnimationSidAddressBinding
 		{
@@ -181,11 +204,60 @@ namespace COLLADASaxFWL
 		/** Function pointer to functions provided to registerExternalReferenceDeciderCallbackFunction.*/
 		typedef bool (*ExternalReferenceDeciderCallbackFunction)( const COLLADABU::URI&, COLLADAFW::FileId );
 
+		/** The types of the elements indexed for lazy loading.*/
+		enum IndexedElementType
+		{
+			INDEXED_GEOMETRY,
+			INDEXED_ANIMATION,
+			INDEXED_CONTROLLER
+		};
+
+		/** The position of an element indexed for lazy loading, within the file it has been found in.*/
+		struct IndexedElement
+		{
+			/** The file the element has been found in.*/
+			COLLADAFW::FileId fileId;
+
+			/** The offset of a byte within or directly behind the start tag of the element.*/
+			size_t beginOffset;
+
+			/** The offset of the byte directly behind the end tag of the element.*/
+			size_t endOffset;
+
+			/** The type of the element.*/
+			IndexedElementType type;
+		};
+
+		/** Maps the unique ids of the objects loaded from indexed elements to the positions of the elements.*/
+		typedef std::map<COLLADAFW::UniqueId, IndexedElement> UniqueIdIndexedElementMap;
+
+		/** The data of an indexed file required to parse its indexed elements.*/
+		struct IndexedFile
+		{
+			/** The qualified name of the root element.*/
+			String rootElementName;
+
+			/** The start tag of the root element, including all its namespace declarations.*/
+			String rootStartTag;
+		};
+
+		/** Maps file ids to the data of the indexed files.*/
+		typedef std::map<COLLADAFW::FileId, IndexedFile> FileIdIndexedFileMap;
+
 	public:
 		const static InstanceControllerDataList EMPTY_INSTANCE_CONTROLLER_DATALIST;
 		static const JointSidsOrIds EMPTY_JOINTSIDSORIDS;
 
 	private:
+		/** The arena the framework objects of loadDocument() are allocated from, if mUseMemoryArena is
+		true. It is declared first, to be destroyed after all other members that might still own framework
+		objects.*/
+		COLLADAFW::MemoryArena mMemoryArena;
+
+		/** The arena the framework objects of loadGeometry(), loadAnimation() and loadController() are
+		allocated from, if mUseMemoryArena is true. It is released at the end of each of these calls.*/
+		COLLADAFW::MemoryArena mIndexedElementMemoryArena;
+
 		/** The version of the collada document.*/
 		COLLADAVersion mCOLLADAVersion;
 
@@ -260,6 +332,10 @@ namespace COLLADASaxFWL
 		completely been parsed.*/
 		CameraList mCameras;
 
+		/** The number of objects at the end of the lists above, that have already been sent to the writer
+		during the current load.*/
+		WrittenObjectCounts mWrittenObjectCounts;
+
 		/** List of all effects in the file. They are send to the writer and deleted, when the file has 
 		completely been parsed. This is required to assign animations of the morph weights.*/
 		MorphControllerList mMorphControllerList;
@@ -298,6 +374,41 @@ namespace COLLADASaxFWL
 		/** The call back function used to decide which filed should be leaded.*/
 		ExternalReferenceDeciderCallbackFunction mExternalReferenceDeciderCallbackFunction;
 
+		/** Symbol table shared by all files of the document. Used to intern strings that occur 
+		repeatedly, like the names in Name_array and IDREF_array elements. It is cleared at the beginning
+		of each loadDocument(), the strings are kept for the elements loaded later on by 
+		loadGeometry(), loadAnimation() and loadController().*/
+		GeneratedSaxParser::StringTable mStringTable;
+
+		/** True, if the framework objects created during the load are allocated from mMemoryArena.*/
+		bool mUseMemoryArena;
+
+		/** The maximum number of vertices of a mesh primitive passed to a writer that streams meshes.
+		Zero means no limit.*/
+		size_t mMeshStreamChunkSize;
+
+		/** True, if the content hashes of the meshes are calculated.*/
+		bool mCalculateMeshContentHashes;
+
+		/** The size of the chunks files are read ahead in, if mReadAheadBufferCount is not zero.*/
+		size_t mReadAheadBufferSize;
+
+		/** The number of chunks files are read ahead of the parser. Zero disables reading ahead.*/
+		size_t mReadAheadBufferCount;
+
+		/** Maps the content hash of each mesh loaded so far to the unique id of the first mesh with
+		that hash.*/
+		ContentHashUniqueIdMap mMeshContentHashUniqueIdMap;
+
+		/** True, if the geometries, animations and controllers of the loaded files are indexed.*/
+		bool mLazyLoading;
+
+		/** The positions of all indexed elements.*/
+		UniqueIdIndexedElementMap mIndexedElements;
+
+		/** The data of all indexed files.*/
+		FileIdIndexedFileMap mIndexedFiles;
+
 	public:
 
         /** Constructor. */
@@ -331,6 +442,86 @@ namespace COLLADASaxFWL
 		@param objectFlags The flags indicating which objects should be loaded.*/
 		void setObjectFlags( int objectFlags ) { mObjectFlags = objectFlags; }
 
+		/** Sets if the framework objects created during the load should be allocated from a memory arena
+		owned by the loader, instead of being taken from and returned to the heap one by one. The objects
+		of loadDocument() are released in one go at the beginning of the next loadDocument() or when the 
+		loader is destroyed. The visual scenes, library nodes, effects, lights, cameras and animation lists
+		the loader keeps of the previous document are deleted then. The objects of loadGeometry(), 
+		loadAnimation() and loadController() are released at the end of each of these calls. Only use 
+		this, if the writer does not keep any of the objects passed to it, or clones of them, beyond these
+		points. Ignored, if the writer takes the ownership of the objects (see
+		COLLADAFW::IWriter::takesObjectOwnership()). Default is false.*/
+		void setUseMemoryArena( bool useMemoryArena ) { mUseMemoryArena = useMemoryArena; }
+
+		/** Sets the maximum number of vertices of the mesh primitives passed to a writer that streams
+		meshes (see COLLADAFW::IWriter::startMeshStream()). Triangles and lines primitives with more
+		vertices are passed in multiple parts, each of them containing complete faces only. Other primitive
+		types are always passed in one part. Zero means no limit. Default is zero.*/
+		void setMeshStreamChunkSize( size_t meshStreamChunkSize ) { mMeshStreamChunkSize = meshStreamChunkSize; }
+
+		/** Returns the maximum number of vertices of the mesh primitives passed to a writer that streams
+		meshes.*/
+		size_t getMeshStreamChunkSize() const { return mMeshStreamChunkSize; }
+
+		/** Sets if a hash of the vertex data and the primitives of each mesh is calculated while it is
+		parsed (see COLLADAFW::Mesh::getContentHash()). Each mesh whose hash equals the one of a mesh
+		loaded before by this loader, refers to the unique id of that mesh (see 
+		COLLADAFW::Mesh::getDuplicateOf()), so that the writer can detect identical meshes with different
+		ids, also across the documents loaded by the same loader. The hash does not depend on the mesh 
+		stream chunk size, nor on whether the mesh is streamed. Default is false.*/
+		void setCalculateMeshContentHashes( bool calculateMeshContentHashes ) { mCalculateMeshContentHashes = calculateMeshContentHashes; }
+
+		/** Returns true, if a hash of the vertex data and the primitives of each mesh is calculated.*/
+		bool getCalculateMeshContentHashes() const { return mCalculateMeshContentHashes; }
+
+		/** Sets how the files loaded by loadDocument() are read ahead of the parser. If @a bufferCount is
+		not zero, a separate thread reads a file in chunks of @a bufferSize bytes into the file system 
+		cache, up to @a bufferCount chunks ahead of the parser. Files that are not larger than all these 
+		chunks together are read by the parser only. Only used by the expat parser. Default is no read
+		ahead.*/
+		void setReadAhead( size_t bufferSize, size_t bufferCount ) { mReadAheadBufferSize = bufferSize; mReadAheadBufferCount = bufferCount; }
+
+		/** Returns the size of the chunks files are read ahead in.*/
+		size_t getReadAheadBufferSize() const { return mReadAheadBufferSize; }
+
+		/** Returns the number of chunks files are read ahead of the parser. Zero means no read ahead.*/
+		size_t getReadAheadBufferCount() const { return mReadAheadBufferCount; }
+
+		/** Sets if the geometries, animations and controllers of the files loaded by loadDocument() are
+		indexed, such that they can be loaded on demand later on, using loadGeometry(), loadAnimation() and
+		loadController(). Combined with object flags that exclude these objects (see setObjectFlags()), the
+		scene graph can be loaded first and the heavy data fetched when it is needed. Only documents loaded
+		from files are indexed, not those passed in a buffer. The indexed elements are read again from the
+		files, i.e. the files must not change in the meantime, and they must be UTF-8 encoded.
+		Default is false.*/
+		void setLazyLoading( bool lazyLoading ) { mLazyLoading = lazyLoading; }
+
+		/** Returns true, if the geometries, animations and controllers of the loaded files are indexed.*/
+		bool getLazyLoading() const { return mLazyLoading; }
+
+		/** Returns true, if the object with unique id @a uniqueId can be loaded on demand.*/
+		bool isIndexed( const COLLADAFW::UniqueId& uniqueId ) const { return mIndexedElements.find( uniqueId ) != mIndexedElements.end(); }
+
+		/** Loads the geometry with unique id @a geometryUniqueId, e.g. the instanciated object id of an 
+		instance geometry, and passes it to @a writer. Only the element of the geometry is parsed. 
+		IWriter::start() and IWriter::finish() are not called.
+		@return False, if the geometry has not been indexed or could not be loaded.*/
+		bool loadGeometry( const COLLADAFW::UniqueId& geometryUniqueId, COLLADAFW::IWriter* writer );
+
+		/** Loads the animation curve with unique id @a animationUniqueId, e.g. taken from an animation
+		list, and passes it to @a writer. All curves of the top level animation element that contains the
+		curve are passed, since they are parsed together. IWriter::start() and IWriter::finish() are not
+		called.
+		@return False, if the animation has not been indexed or could not be loaded.*/
+		bool loadAnimation( const COLLADAFW::UniqueId& animationUniqueId, COLLADAFW::IWriter* writer );
+
+		/** Loads the controller with unique id @a controllerUniqueId, e.g. the instanciated object id of an
+		instance controller, and passes the skin controller data of a skin controller or the morph 
+		controller to @a writer. Skin controllers, that bind the skin controller data to the joints, are only
+		created by loadDocument(). IWriter::start() and IWriter::finish() are not called.
+		@return False, if the controller has not been indexed or could not be loaded.*/
+		bool loadController( const COLLADAFW::UniqueId& controllerUniqueId, COLLADAFW::IWriter* writer );
+
         /** Register an extra data callback handler.
         * @param ExtraDataCallbackHandler* extraDataCallbackHandler The callback handler to register.
         * @return bool True, if the handler could be registered successfull. */
@@ -361,6 +552,7 @@ namespace COLLADASaxFWL
 		friend class FileLoader;
 		friend class PostProcessor;
 		friend class DocumentProcessor;
+		friend class ElementIndexParser;
 
 		/** The version of the collada document.*/
 		void setCOLLADAVersion(COLLADAVersion cOLLADAVersion) { mCOLLADAVersion = cOLLADAVersion; }
@@ -402,6 +594,10 @@ namespace COLLADASaxFWL
 		/** Returns the GeometryMaterialIdInfo to map symbols to ids*/
 		GeometryMaterialIdInfo& getMeshMaterialIdInfo( );
 
+		/** Returns the unique id of the first mesh registered with @a contentHash. If there is none,
+		@a meshUniqueId is registered with @a contentHash and returned.*/
+		const COLLADAFW::UniqueId& registerMeshContentHash( const COLLADABU::ContentHash& contentHash, const COLLADAFW::UniqueId& meshUniqueId );
+
 		/** Returns TextureMapId for @a semantic. Successive call with same semantic return the same TextureMapId.*/
 		COLLADAFW::TextureMapId getTextureMapIdBySematic( const String& semantic );
 
@@ -431,6 +627,10 @@ namespace COLLADASaxFWL
 		completely been parsed.*/
 		CameraList& getCameras() { return mCameras; }
 
+		/** The number of objects at the end of the lists of visual scenes, library nodes, effects, lights
+		and cameras, that have already been sent to the writer during the current load.*/
+		WrittenObjectCounts& getWrittenObjectCounts() { return mWrittenObjectCounts; }
+
 		/** Returns the intermediate data to build up the kinematics after the COLLADA file has been parsed.*/
 		KinematicsIntermediateData& getKinematicsIntermediateData() { return mKinematicsIntermediateData; }
 
@@ -469,6 +669,26 @@ namespace COLLADASaxFWL
 		/** Returns the writer the data will be written to.*/
 		COLLADAFW::IWriter* writer(){ return mWriter; }
 
+		/** Symbol table shared by all files of the document.*/
+		GeneratedSaxParser::StringTable& getStringTable() { return mStringTable; }
+
+		/** The positions of all indexed elements.*/
+		UniqueIdIndexedElementMap& getIndexedElementMap() { return mIndexedElements; }
+
+		/** The data of all indexed files.*/
+		FileIdIndexedFileMap& getIndexedFileMap() { return mIndexedFiles; }
+
+		/** Parses the indexed element of type @a type the object with unique id @a uniqueId is loaded from,
+		and passes the objects in @a objectFlags to @a writer.*/
+		bool loadIndexedElement( const COLLADAFW::UniqueId& uniqueId, IndexedElementType type, int objectFlags, COLLADAFW::IWriter* writer );
+
+		/** Deletes the objects kept of the previous document, that might have been allocated from 
+		mMemoryArena, and releases the arena.*/
+		void releaseMemoryArena();
+
+		/** Reads the indexed element @a indexedElement from the file @a fileName into @a buffer.*/
+		static bool readIndexedElement( const String& fileName, const IndexedElement& indexedElement, String& buffer );
+
 
         /** Disable default copy ctor. */
 		Loader( const Loader& pre );
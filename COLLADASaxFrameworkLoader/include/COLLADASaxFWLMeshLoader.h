@@ -19,6 +19,8 @@
 
 #include "COLLADAFWMesh.h"
 
+#include "COLLADABUContentHash.h"
+
 
 namespace COLLADASaxFWL
 {
@@ -167,6 +169,83 @@ namespace COLLADASaxFWL
         /** Flag for the extra tag preservation, to know if we are parsing in the mesh. */
         bool mInMesh;
 
+		/** True, if the mesh is streamed, i.e. the vertex data and the mesh primitives are passed to the 
+		writer as soon as they have been loaded, instead of passing the entire mesh at the end.*/
+		bool mStreamMesh;
+
+		/** The maximum number of vertices of a triangles or lines primitive passed to the writer, if the 
+		mesh is streamed. Zero means no limit.*/
+		size_t mStreamChunkSize;
+
+		/** The number of values of the positions, normals, ... that have already been passed to the writer,
+		if the mesh is streamed.*/
+		size_t mStreamedPositionsCount;
+		size_t mStreamedNormalsCount;
+		size_t mStreamedColorsCount;
+		size_t mStreamedUVCoordsCount;
+		size_t mStreamedTangentsCount;
+		size_t mStreamedBinormalsCount;
+
+		/** True, if the content hash of the mesh is calculated (see Loader::setCalculateMeshContentHashes()).*/
+		bool mCalculateContentHash;
+
+		/** The hashes of the positions, normals, colors, uv coordinates, tangents and binormals, 
+		calculated over the values passed to the writer so far.*/
+		COLLADABU::ContentHasher mVertexDataHashers[6];
+
+		/** The hash of the mesh primitives passed to the writer so far.*/
+		COLLADABU::ContentHasher mMeshPrimitivesHasher;
+
+		/** The hash of an index array of the current mesh primitive, calculated over the chunks of the
+		primitive passed to the writer so far.*/
+		struct IndicesHash
+		{
+			COLLADABU::ContentHasher hasher;
+
+			/** The number of indices hashed so far.*/
+			unsigned long long count;
+
+			/** The stride and the initial index of an index list, which are the same in all chunks.*/
+			unsigned long long stride;
+			unsigned long long initialIndex;
+
+			IndicesHash() : count(0), stride(0), initialIndex(0) {}
+
+			/** Appends @a indicesCount indices of @a indexSize bytes, starting at @a indices.*/
+			void update( const void* indices, size_t indicesCount, size_t indexSize )
+			{
+				hasher.update( indices, indicesCount * indexSize );
+				count += indicesCount;
+			}
+
+			/** Appends the count, the stride, the initial index and the hash of the indices to 
+			@a primitivesHasher.*/
+			void addTo( COLLADABU::ContentHasher& primitivesHasher ) const
+			{
+				primitivesHasher.updateValue( count );
+				primitivesHasher.updateValue( stride );
+				primitivesHasher.updateValue( initialIndex );
+				primitivesHasher.updateHash( hasher.getHash() );
+			}
+		};
+		typedef std::vector<IndicesHash> IndicesHashList;
+
+		/** The hashes of the position, normal, tangent and binormal indices and of the face vertex 
+		counts of the current mesh primitive. The hashes of a primitive are added to 
+		mMeshPrimitivesHasher once it is complete, so that the content hash does not depend on the
+		number of chunks the primitive is split into.*/
+		IndicesHash mPrimitiveIndicesHashes[5];
+
+		/** The hashes of the color and the uv coordinate index lists of the current mesh primitive.*/
+		IndicesHashList mPrimitiveColorIndicesHashes;
+		IndicesHashList mPrimitiveUVCoordIndicesHashes;
+
+		/** The number of faces of the chunks of the current mesh primitive hashed so far.*/
+		size_t mPrimitiveHashedFaceCount;
+
+		/** The number of chunks of the current mesh primitive hashed so far.*/
+		size_t mPrimitiveHashedChunkCount;
+
     public:
 
         /** Constructor. */
@@ -181,6 +260,12 @@ namespace COLLADASaxFWL
         /** Returns the mesh that has just been loaded.*/
 		COLLADAFW::Mesh* getMesh() { return mMesh; }
 
+		/** Releases the ownership of the mesh, i.e. it will not be deleted by the mesh loader.*/
+		void releaseMesh() { mMesh = 0; }
+
+		/** Returns true, if the mesh has been passed to the writer while it has been loaded.*/
+		bool isStreamingMesh() const { return mStreamMesh; }
+
 		/** Sax callback function for the beginning of a source element.*/
 		virtual bool begin__source(const source__AttributeData& attributes);
 
@@ -430,6 +515,56 @@ namespace COLLADASaxFWL
         bool appendVertexValues ( 
             SourceBase* sourceBase, 
             COLLADAFW::MeshVertexData& vertexData );
+
+        /**
+        * Returns the index of the next value appended to @a vertexData, taking the values into
+        * account, that have already been passed to the writer.
+        */
+        size_t getInitialIndex ( const COLLADAFW::MeshVertexData& vertexData ) const;
+
+        /**
+        * Passes the vertex data loaded since the last call to the writer and releases it.
+        */
+        bool writeStreamedVertexData ();
+
+        /**
+        * Appends @a meshPrimitive to the mesh or, if the mesh is streamed, passes it to the writer 
+        * and deletes it. @a isLastChunk is false, if more chunks of the same primitive follow.
+        */
+        bool appendMeshPrimitive ( COLLADAFW::MeshPrimitive* meshPrimitive, bool isLastChunk = true );
+
+        /**
+        * Passes the completed faces of the current triangles or lines primitive to the writer and 
+        * continues with a new primitive of the same type and material.
+        */
+        bool writeMeshPrimitiveChunk ();
+
+        /**
+        * Adds the vertex data, that has been loaded since the last call, to the content hash.
+        */
+        void hashVertexData ();
+
+        /**
+        * Adds the indices of @a meshPrimitive, which might be a chunk of the current primitive, to the
+        * hashes of the current primitive.
+        */
+        void hashMeshPrimitive ( const COLLADAFW::MeshPrimitive* meshPrimitive );
+
+        /**
+        * Adds the index lists of @a indexLists to @a indicesHashes.
+        */
+        void hashIndexLists ( IndicesHashList& indicesHashes, const COLLADAFW::IndexListArray& indexLists );
+
+        /**
+        * Adds the hashes of the current primitive, whose last chunk is @a meshPrimitive, to the content
+        * hash and resets them. Does nothing, if no chunk of the primitive has been hashed.
+        */
+        void finishMeshPrimitiveHash ( const COLLADAFW::MeshPrimitive* meshPrimitive );
+
+        /**
+        * Sets the content hash of the mesh and the unique id of the first mesh with the same hash.
+        */
+        void setMeshContentHash ();
     };
 }
 
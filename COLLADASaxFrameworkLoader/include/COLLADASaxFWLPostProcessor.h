@@ -59,19 +59,19 @@ namespace COLLADASaxFWL
 
 	private:
 
-		/** Writes all the visual scenes.*/
+		/** Writes all the visual scenes, that have not already been written while parsing.*/
 		void writeVisualScenes();
 
-		/** Writes all the library nodes.*/
+		/** Writes all the library nodes, that have not already been written while parsing.*/
 		void writeLibraryNodes();
 
-		/** Writes all the effects.*/
+		/** Writes all the effects, that have not already been written while parsing.*/
 		void writeEffects();
 
-		/** Writes all the lights.*/
+		/** Writes all the lights, that have not already been written while parsing.*/
 		void writeLights();
 
-		/** Writes all the cameras.*/
+		/** Writes all the cameras, that have not already been written while parsing.*/
 		void writeCameras();
 
 		/** Creates all the animation lists.*/
@@ -92,6 +92,10 @@ namespace COLLADASaxFWL
 		/** Creates and writes the kinematics scene.*/
 		void createAndWriteKinematicsScene();
 
+		/** Removes the objects that have been passed to a writer, that takes their ownership, from the
+		loader, to prevent them from being deleted by the loader.*/
+		void releaseWrittenObjects();
+
 
 		/** Returns a pointer to the file loader. */
 		virtual FileLoader* getFileLoader() { return 0; }
@@ -0,0 +1,87 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADASaxFrameworkLoader.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COLLADASAXFWL_SCHEMAVALIDATOR_H__
+#define __COLLADASAXFWL_SCHEMAVALIDATOR_H__
+
+#include "COLLADASaxFWLPrerequisites.h"
+
+
+namespace COLLADASaxFWL
+{
+    class IErrorHandler;
+
+    /**
+     * Validates a COLLADA file against the schema, without loading it.
+     * The generated private parser of the COLLADA version of the file is driven with callbacks
+     * that do nothing, i.e. no framework objects are created, no array data is stored and no post
+     * processing is done. The memory needed does not depend on the size of the file.
+     * The schema is only validated, if the library has been built with GENERATEDSAXPARSER_VALIDATION.
+     * Optionally, the references to elements in the same file (attributes starting with '#') can be
+     * checked to resolve to the id of an element.
+     */
+    class SchemaValidator
+    {
+    private:
+        /** The error handler to pass the errors to.*/
+        IErrorHandler* mErrorHandler;
+
+        /** If true, the references are checked.*/
+        bool mCheckReferences;
+
+        /** The size of the chunks files are read ahead in, if mReadAheadBufferCount is not zero.*/
+        size_t mReadAheadBufferSize;
+
+        /** The number of chunks files are read ahead of the parser. Zero disables reading ahead.*/
+        size_t mReadAheadBufferCount;
+
+        /** The COLLADA version of the last validated file.*/
+        COLLADAVersion mCOLLADAVersion;
+
+    public:
+
+        /** Constructor.
+        @param errorHandler The error handler all errors are passed to.*/
+        SchemaValidator( IErrorHandler* errorHandler );
+
+        /** Destructor. */
+        virtual ~SchemaValidator();
+
+        /** If set to true, the references to elements in the same file are checked to resolve to the
+        id of an element. Unresolved references are reported as SaxFWLError::ERROR_UNRESOLVED_REFERENCE.
+        This needs memory for all ids and references of the file. Default is false.*/
+        void setCheckReferences( bool checkReferences ) { mCheckReferences = checkReferences; }
+
+        /** Returns true, if the references are checked.*/
+        bool getCheckReferences() const { return mCheckReferences; }
+
+        /** Sets how files are read ahead of the parser, see Loader::setReadAhead().*/
+        void setReadAhead( size_t bufferSize, size_t bufferCount ) { mReadAheadBufferSize = bufferSize; mReadAheadBufferCount = bufferCount; }
+
+        /** Validates the file @a fileName.
+        @return False, if the file could not be parsed.*/
+        bool validate( const String& fileName );
+
+        /** Returns the COLLADA version of the last validated file.*/
+        COLLADAVersion getCOLLADAVersion() const { return mCOLLADAVersion; }
+
+    private:
+
+        /** Disable default copy ctor. */
+        SchemaValidator( const SchemaValidator& pre );
+
+        /** Disable default assignment operator. */
+        const SchemaValidator& operator= ( const SchemaValidator& pre );
+
+    };
+
+} // namespace COLLADASaxFWL
+
+#endif // __COLLADASAXFWL_SCHEMAVALIDATOR_H__
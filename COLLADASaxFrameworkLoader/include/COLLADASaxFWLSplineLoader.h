@@ -72,6 +72,9 @@ namespace COLLADASaxFWL
         /** Returns the mesh that has just been loaded.*/
 		COLLADAFW::Spline* getSpline() { return mSpline; }
 
+		/** Releases the ownership of the spline, i.e. it will not be deleted by the spline loader.*/
+		void releaseSpline() { mSpline = 0; }
+
 		/** Sax callback function for the beginning of a source element.*/
 		virtual bool begin__source(const source__AttributeData& attributes);
 
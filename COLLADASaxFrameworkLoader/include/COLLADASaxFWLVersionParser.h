@@ -30,6 +30,7 @@ namespace COLLADASaxFWL15
 namespace COLLADASaxFWL
 {
     class FileLoader;
+    class ElementIndexParser;
 
     /**
      * Starts parsing a file to find out which COLLADA version it uses.
@@ -55,6 +56,12 @@ namespace COLLADASaxFWL
         /** Indicates which parts of the file have already been parsed. */
         int& mParsedFlags;
 
+        /** True, if the elements of the file are indexed for lazy loading. */
+        bool mIndexElements;
+
+        /** Stays between the sax parser and the private parser, if mIndexElements is true. */
+        ElementIndexParser* mElementIndexParser;
+
     public:
         VersionParser(GeneratedSaxParser::IErrorHandler* errorHandler, 
             FileLoader* fileLoader,
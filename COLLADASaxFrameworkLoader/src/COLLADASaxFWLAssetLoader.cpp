@@ -38,6 +38,8 @@ namespace COLLADASaxFWL
 		if ( (getObjectFlags() & Loader::ASSET_FLAG) != 0 )
 		{
 			success = writer()->writeGlobalAsset ( mAsset );
+			if ( writer()->takesObjectOwnership() )
+				mAsset = 0;
 		}
 		delete mAsset;
 		finish();
@@ -31,6 +31,7 @@ namespace COLLADASaxFWL
 		, mEffects( colladaLoader->getEffects() )
 		, mLights( colladaLoader->getLights() )
 		, mCameras( colladaLoader->getCameras() )
+		, mWrittenObjectCounts( colladaLoader->getWrittenObjectCounts() )
 		, mKinematicsIntermediateData( colladaLoader->getKinematicsIntermediateData() )
 		, mFormulasMap( colladaLoader->getFormulasMap() )
 		, mAnimationSidAddressBindings( colladaLoader->getAnimationSidAddressBindings() )
@@ -214,7 +215,7 @@ namespace COLLADASaxFWL
 	}
 
 	//-----------------------------
-	void DocumentProcessor::addSkinDataJointSidsPair( const COLLADAFW::UniqueId& skinDataUniqueId, const StringList& sidsOrIds, bool areIds )
+	void DocumentProcessor::addSkinDataJointSidsPair( const COLLADAFW::UniqueId& skinDataUniqueId, const SymbolIdList& sidsOrIds, bool areIds )
 	{
 		Loader::JointSidsOrIds jointSidsOrIds;
 		jointSidsOrIds.sidsOrIds = sidsOrIds;
@@ -301,19 +302,30 @@ namespace COLLADASaxFWL
 	bool DocumentProcessor::createAndWriteSkinController( const Loader::InstanceControllerData& instanceControllerData, 
 		const COLLADAFW::UniqueId& controllerDataUniqueId, 
 		const COLLADAFW::UniqueId& sourceUniqueId,
-		const StringList& sidsOrIds,
+		const SymbolIdList& sidsOrIds,
 		bool resolveIds)
 	{
 		if ( !controllerDataUniqueId.isValid() )
 			return false;
 
-		const URIList& skeletonRoots = instanceControllerData.skeletonRoots;
+		SkinControllerJoints skinControllerJoints;
+		resolveSkinControllerJoints( instanceControllerData.skeletonRoots, sidsOrIds, resolveIds, skinControllerJoints );
+		return writeSkinController( instanceControllerData, controllerDataUniqueId, sourceUniqueId, skinControllerJoints, resolveIds );
+	}
 
-		NodeList joints;
+	//-----------------------------
+	void DocumentProcessor::resolveSkinControllerJoints( const URIList& skeletonRoots,
+		const SymbolIdList& sidsOrIds,
+		bool resolveIds,
+		SkinControllerJoints& skinControllerJoints )
+	{
+		const GeneratedSaxParser::StringTable& stringTable = mColladaLoader->getStringTable();
 
-		for ( StringList::const_iterator it = sidsOrIds.begin(); it != sidsOrIds.end(); ++it)
+		NodeList& joints = skinControllerJoints.joints;
+
+		for ( SymbolIdList::const_iterator it = sidsOrIds.begin(); it != sidsOrIds.end(); ++it)
 		{
-			const String sidOrId = *it;
+			const String& sidOrId = stringTable.getString(*it);
 
 			bool jointFound = false;
 			if ( resolveIds )
@@ -354,18 +366,35 @@ namespace COLLADASaxFWL
 				}
 			}
 
-
 			if ( !jointFound )
 			{
-				std::stringstream msg;
-				msg << "Could not resolve " << (resolveIds ? "id" : "sid") << " \"";
-				msg << sidOrId << "\" referenced in skin controller.";
-				if ( handleFWLError( SaxFWLError::ERROR_UNRESOLVED_REFERENCE, msg.str() ))
-				{
-					return false;
-				}
+				skinControllerJoints.unresolvedSidsOrIds.push_back( *it );
 			}
 		}
+	}
+
+	//-----------------------------
+	bool DocumentProcessor::writeSkinController( const Loader::InstanceControllerData& instanceControllerData, 
+		const COLLADAFW::UniqueId& controllerDataUniqueId,
+		const COLLADAFW::UniqueId& sourceUniqueId,
+		const SkinControllerJoints& skinControllerJoints,
+		bool resolveIds )
+	{
+		const GeneratedSaxParser::StringTable& stringTable = mColladaLoader->getStringTable();
+
+		const SymbolIdList& unresolvedSidsOrIds = skinControllerJoints.unresolvedSidsOrIds;
+		for ( SymbolIdList::const_iterator it = unresolvedSidsOrIds.begin(); it != unresolvedSidsOrIds.end(); ++it)
+		{
+			std::stringstream msg;
+			msg << "Could not resolve " << (resolveIds ? "id" : "sid") << " \"";
+			msg << stringTable.getString(*it) << "\" referenced in skin controller.";
+			if ( handleFWLError( SaxFWLError::ERROR_UNRESOLVED_REFERENCE, msg.str() ))
+			{
+				return false;
+			}
+		}
+
+		const NodeList& joints = skinControllerJoints.joints;
 
 		COLLADAFW::SkinController skinController( createUniqueId(COLLADAFW::SkinController::ID()));
 
@@ -393,7 +422,10 @@ namespace COLLADASaxFWL
 		if ( skinControllerIt == mSkinControllerSet.end() )
 		{
 			skinControllerToWrite = &skinController;
-			success = writer()->writeController(skinControllerToWrite);
+			if ( writer()->takesObjectOwnership() )
+				success = writer()->writeController( FW_NEW COLLADAFW::SkinController(skinController) );
+			else
+				success = writer()->writeController(skinControllerToWrite);
 			mSkinControllerSet.insert( skinController );
 		}
 		else
@@ -410,9 +442,20 @@ namespace COLLADASaxFWL
 	//-----------------------------
 	bool DocumentProcessor::createAndWriteSkinControllers()
 	{
+		std::vector<SkinControllerInstance> skinControllerInstances;
+
+		// The index of the first instance of each pair of skin data and skeleton roots. The joints are resolved
+		// only once for each of these pairs.
+		std::vector<size_t> firstInstanceIndices;
+		typedef std::map<std::pair<COLLADAFW::UniqueId, URIList>, size_t> SkinDataSkeletonRootsJointsIndexMap;
+		SkinDataSkeletonRootsJointsIndexMap jointsIndices;
+
+		// An instance with invalid skin data stops writing the skin controllers
+		bool invalidSkinDataFound = false;
+
 		Loader::InstanceControllerDataListMap::const_iterator mapIt = mInstanceControllerDataListMap.begin();
 
-		for ( ; mapIt != mInstanceControllerDataListMap.end(); ++mapIt )
+		for ( ; (mapIt != mInstanceControllerDataListMap.end()) && !invalidSkinDataFound; ++mapIt )
 		{
 			const COLLADAFW::UniqueId& skinDataUniqueId = mapIt->first;
 			const Loader::InstanceControllerDataList& instanceControllerDataList = mapIt->second;
@@ -436,11 +479,59 @@ namespace COLLADASaxFWL
 					// TODO handle error
 					continue;
 				}
-				if ( !createAndWriteSkinController( instanceControllerData, skinDataUniqueId, sourceUniqueId ) )
-					return false;
+
+				if ( !skinDataUniqueId.isValid() )
+				{
+					invalidSkinDataFound = true;
+					break;
+				}
+
+				SkinControllerInstance skinControllerInstance;
+				skinControllerInstance.instanceControllerData = &instanceControllerData;
+				skinControllerInstance.skinDataUniqueId = skinDataUniqueId;
+				skinControllerInstance.sourceUniqueId = sourceUniqueId;
+
+				std::pair<SkinDataSkeletonRootsJointsIndexMap::iterator, bool> inserted = jointsIndices.insert(
+					std::make_pair( std::make_pair( skinDataUniqueId, instanceControllerData.skeletonRoots ), firstInstanceIndices.size() ) );
+				if ( inserted.second )
+				{
+					firstInstanceIndices.push_back( skinControllerInstances.size() );
+				}
+				skinControllerInstance.jointsIndex = inserted.first->second;
+
+				skinControllerInstances.push_back( skinControllerInstance );
 			}
 		}
-		return true;
+
+		// Resolving the joints only reads the sid tree, the pairs are independent of each other
+		std::vector<SkinControllerJoints> skinControllerJointsList( firstInstanceIndices.size() );
+		const ptrdiff_t jointsCount = (ptrdiff_t)firstInstanceIndices.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+		for ( ptrdiff_t i = 0; i < jointsCount; ++i )
+		{
+			const SkinControllerInstance& skinControllerInstance = skinControllerInstances[firstInstanceIndices[i]];
+			const Loader::JointSidsOrIds& sidsOrIds = getJointSidsOrIdsBySkinDataUniqueId( skinControllerInstance.skinDataUniqueId );
+			resolveSkinControllerJoints( skinControllerInstance.instanceControllerData->skeletonRoots, 
+				sidsOrIds.sidsOrIds, 
+				sidsOrIds.areIds, 
+				skinControllerJointsList[i] );
+		}
+
+		// The unique ids are created and the controllers are written in the order of the instance controllers
+		for ( size_t i = 0, count = skinControllerInstances.size(); i < count; ++i )
+		{
+			const SkinControllerInstance& skinControllerInstance = skinControllerInstances[i];
+			const Loader::JointSidsOrIds& sidsOrIds = getJointSidsOrIdsBySkinDataUniqueId( skinControllerInstance.skinDataUniqueId );
+			if ( !writeSkinController( *skinControllerInstance.instanceControllerData, 
+				skinControllerInstance.skinDataUniqueId, 
+				skinControllerInstance.sourceUniqueId, 
+				skinControllerJointsList[skinControllerInstance.jointsIndex], 
+				sidsOrIds.areIds ) )
+				return false;
+		}
+		return !invalidSkinDataFound;
 	}
 
 	//------------------------------
@@ -538,6 +629,79 @@ namespace COLLADASaxFWL
 		}
 	}
 
+	//------------------------------
+	bool DocumentProcessor::canWriteWhileParsing( int objectFlag ) const
+	{
+		if ( (mObjectFlags & objectFlag) == 0 )
+			return false;
+
+		// Animation lists, formulas and kinematics resolve sids into all objects in the sid tree. 
+		// The animations of a target might follow it in the document, so these can only be resolved
+		// after the entire document has been parsed.
+		int dependingSteps = Loader::ANIMATION_LIST_FLAG | Loader::FORMULA_FLAG | Loader::KINEMATICS_FLAG;
+
+		// The controllers resolve their joints in the nodes and set the controller ids of the instance 
+		// controllers
+		if ( (objectFlag == Loader::VISUAL_SCENES_FLAG) || (objectFlag == Loader::LIBRARY_NODES_FLAG) )
+			dependingSteps |= Loader::CONTROLLER_FLAG;
+
+		return (mObjectFlags & dependingSteps) == 0;
+	}
+
+	//------------------------------
+	template<class ObjectType>
+	void DocumentProcessor::addObject( ObjectType* object,
+		std::vector<ObjectType*>& objectList,
+		size_t& writtenCount,
+		int objectFlag,
+		bool (COLLADAFW::IWriter::*writeFunction)( const ObjectType* ) )
+	{
+		if ( !canWriteWhileParsing( objectFlag ) )
+		{
+			objectList.push_back( object );
+			return;
+		}
+
+		(writer()->*writeFunction)( object );
+
+		// keep the object for loads with other object flags, like the post processor does
+		if ( !writer()->takesObjectOwnership() )
+		{
+			objectList.push_back( object );
+			writtenCount++;
+		}
+	}
+
+	//------------------------------
+	void DocumentProcessor::addVisualScene( COLLADAFW::VisualScene* visualScene )
+	{
+		addObject( visualScene, mVisualScenes, mWrittenObjectCounts.visualScenes, Loader::VISUAL_SCENES_FLAG, &COLLADAFW::IWriter::writeVisualScene );
+	}
+
+	//------------------------------
+	void DocumentProcessor::addLibraryNodes( COLLADAFW::LibraryNodes* libraryNodes )
+	{
+		addObject( libraryNodes, mLibraryNodes, mWrittenObjectCounts.libraryNodes, Loader::LIBRARY_NODES_FLAG, &COLLADAFW::IWriter::writeLibraryNodes );
+	}
+
+	//------------------------------
+	void DocumentProcessor::addEffect( COLLADAFW::Effect* effect )
+	{
+		addObject( effect, mEffects, mWrittenObjectCounts.effects, Loader::EFFECT_FLAG, &COLLADAFW::IWriter::writeEffect );
+	}
+
+	//------------------------------
+	void DocumentProcessor::addLight( COLLADAFW::Light* light )
+	{
+		addObject( light, mLights, mWrittenObjectCounts.lights, Loader::LIGHT_FLAG, &COLLADAFW::IWriter::writeLight );
+	}
+
+	//------------------------------
+	void DocumentProcessor::addCamera( COLLADAFW::Camera* camera )
+	{
+		addObject( camera, mCameras, mWrittenObjectCounts.cameras, Loader::CAMERA_FLAG, &COLLADAFW::IWriter::writeCamera );
+	}
+
 	//------------------------------
 	void DocumentProcessor::addFormula( COLLADAFW::Formula* formula )
 	{
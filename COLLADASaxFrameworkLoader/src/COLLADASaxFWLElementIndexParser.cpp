@@ -0,0 +1,237 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADASaxFrameworkLoader.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADASaxFWLStableHeaders.h"
+#include "COLLADASaxFWLElementIndexParser.h"
+
+#include "COLLADAFWGeometry.h"
+#include "COLLADAFWAnimation.h"
+#include "COLLADAFWSkinControllerData.h"
+#include "COLLADAFWMorphController.h"
+
+#include "GeneratedSaxParserSaxParser.h"
+
+#include <string.h>
+
+
+namespace COLLADASaxFWL
+{
+
+    /** Returns @a elementName without its namespace prefix.*/
+    static const ParserChar* getLocalName( const ParserChar* elementName )
+    {
+        const ParserChar* colon = strchr( elementName, ':' );
+        return colon ? colon + 1 : elementName;
+    }
+
+    //------------------------------
+    ElementIndexParser::ElementIndexParser( GeneratedSaxParser::IErrorHandler* errorHandler, Loader* loader, const COLLADABU::URI& fileUri, GeneratedSaxParser::Parser* privateParser )
+        : GeneratedSaxParser::Parser( errorHandler )
+        , mLoader( loader )
+        , mFileUri( fileUri )
+        , mFileId( loader->getFileId( fileUri ) )
+        , mPrivateParser( privateParser )
+        , mDepth( 0 )
+        , mLibraryType( Loader::INDEXED_GEOMETRY )
+        , mInIndexedLibrary( false )
+        , mInIndexedElement( false )
+        , mCurrentIsMorph( false )
+    {
+    }
+
+    //------------------------------
+    ElementIndexParser::~ElementIndexParser()
+    {
+    }
+
+    //------------------------------
+    bool ElementIndexParser::elementBegin( const ParserChar* elementName, const ParserAttributes& attributes )
+    {
+        mDepth++;
+        const ParserChar* localName = getLocalName( elementName );
+
+        if ( mDepth == 1 )
+        {
+            indexRootElement( elementName, attributes );
+        }
+        else if ( mDepth == 2 )
+        {
+            mInIndexedLibrary = true;
+            if ( strcmp( localName, "library_geometries" ) == 0 )
+                mLibraryType = Loader::INDEXED_GEOMETRY;
+            else if ( strcmp( localName, "library_animations" ) == 0 )
+                mLibraryType = Loader::INDEXED_ANIMATION;
+            else if ( strcmp( localName, "library_controllers" ) == 0 )
+                mLibraryType = Loader::INDEXED_CONTROLLER;
+            else
+                mInIndexedLibrary = false;
+        }
+        else if ( mDepth == 3 )
+        {
+            static const char* indexedElementNames[] = { "geometry", "animation", "controller" };
+
+            const ParserChar* id = findAttribute( attributes, "id" );
+            if ( mInIndexedLibrary && id && *id && (strcmp( localName, indexedElementNames[mLibraryType] ) == 0) )
+            {
+                mInIndexedElement = true;
+                mCurrentElement.fileId = mFileId;
+                mCurrentElement.beginOffset = getSaxParser()->getByteOffset();
+                mCurrentElement.endOffset = 0;
+                mCurrentElement.type = mLibraryType;
+                mCurrentId = id;
+                mCurrentIsMorph = false;
+                mSamplerIds.clear();
+            }
+        }
+        else if ( mInIndexedElement )
+        {
+            if ( (mLibraryType == Loader::INDEXED_ANIMATION) && (strcmp( localName, "sampler" ) == 0) )
+            {
+                // the curves are identified by the ids of their samplers, also in nested animations
+                const ParserChar* samplerId = findAttribute( attributes, "id" );
+                if ( samplerId && *samplerId )
+                    mSamplerIds.push_back( samplerId );
+            }
+            else if ( (mLibraryType == Loader::INDEXED_CONTROLLER) && (mDepth == 4) && (strcmp( localName, "morph" ) == 0) )
+            {
+                mCurrentIsMorph = true;
+            }
+        }
+
+        return mPrivateParser->elementBegin( elementName, attributes );
+    }
+
+    //------------------------------
+    bool ElementIndexParser::elementEnd( const ParserChar* elementName )
+    {
+        bool success = mPrivateParser->elementEnd( elementName );
+
+        if ( (mDepth == 3) && mInIndexedElement )
+        {
+            registerCurrentElement( getSaxParser()->getByteOffset() );
+            mInIndexedElement = false;
+        }
+        else if ( mDepth == 2 )
+        {
+            mInIndexedLibrary = false;
+        }
+
+        mDepth--;
+        return success;
+    }
+
+    //------------------------------
+    bool ElementIndexParser::textData( const ParserChar* text, size_t textLength )
+    {
+        return mPrivateParser->textData( text, textLength );
+    }
+
+    //------------------------------
+    bool ElementIndexParser::rawContentsRequested()
+    {
+        return mPrivateParser->rawContentsRequested();
+    }
+
+    //------------------------------
+    bool ElementIndexParser::rawContents( const ParserChar* contents, size_t length )
+    {
+        return mPrivateParser->rawContents( contents, length );
+    }
+
+    //------------------------------
+    const ParserChar* ElementIndexParser::findAttribute( const ParserAttributes& attributes, const char* attributeName )
+    {
+        const ParserChar** attributeArray = attributes.attributes;
+        if ( !attributeArray )
+            return 0;
+
+        while ( *attributeArray )
+        {
+            const ParserChar* attribute = *attributeArray++;
+            const ParserChar* attributeValue = *attributeArray++;
+            if ( !attributeValue )
+                break;
+            if ( strcmp( attribute, attributeName ) == 0 )
+                return attributeValue;
+        }
+        return 0;
+    }
+
+    //------------------------------
+    void ElementIndexParser::indexRootElement( const ParserChar* elementName, const ParserAttributes& attributes )
+    {
+        Loader::IndexedFile indexedFile;
+        indexedFile.rootElementName = elementName;
+
+        // The start tag is rebuilt from the attributes, to contain all namespace declarations
+        String& startTag = indexedFile.rootStartTag;
+        startTag.append( "<" ).append( elementName );
+
+        const ParserChar** attributeArray = attributes.attributes;
+        while ( attributeArray && *attributeArray )
+        {
+            const ParserChar* attribute = *attributeArray++;
+            const ParserChar* attributeValue = *attributeArray++;
+            if ( !attributeValue )
+                break;
+
+            startTag.append( " " ).append( attribute ).append( "=\"" );
+            for ( const ParserChar* c = attributeValue; *c; ++c )
+            {
+                switch ( *c )
+                {
+                case '&': startTag.append( "&amp;" ); break;
+                case '<': startTag.append( "&lt;" ); break;
+                case '"': startTag.append( "&quot;" ); break;
+                default: startTag.push_back( *c ); break;
+                }
+            }
+            startTag.append( "\"" );
+        }
+        startTag.append( ">" );
+
+        mLoader->getIndexedFileMap()[mFileId] = indexedFile;
+    }
+
+    //------------------------------
+    void ElementIndexParser::registerCurrentElement( size_t endOffset )
+    {
+        if ( (mCurrentElement.beginOffset == 0) || (endOffset <= mCurrentElement.beginOffset) )
+            return;
+
+        mCurrentElement.endOffset = endOffset;
+
+        switch ( mCurrentElement.type )
+        {
+        case Loader::INDEXED_GEOMETRY:
+            registerId( mCurrentId, COLLADAFW::Geometry::ID() );
+            break;
+        case Loader::INDEXED_ANIMATION:
+            {
+                std::vector<String>::const_iterator it = mSamplerIds.begin();
+                for ( ; it != mSamplerIds.end(); ++it )
+                    registerId( *it, COLLADAFW::Animation::ID() );
+                break;
+            }
+        case Loader::INDEXED_CONTROLLER:
+            registerId( mCurrentId, mCurrentIsMorph ? COLLADAFW::MorphController::ID() : COLLADAFW::SkinControllerData::ID() );
+            break;
+        }
+    }
+
+    //------------------------------
+    void ElementIndexParser::registerId( const String& id, COLLADAFW::ClassId classId )
+    {
+        COLLADABU::URI uri( mFileUri, String("#") + id );
+        const COLLADAFW::UniqueId& uniqueId = mLoader->getUniqueId( uri, classId );
+        mLoader->getIndexedElementMap()[uniqueId] = mCurrentElement;
+    }
+
+} // namespace COLLADASaxFWL
@@ -44,7 +44,7 @@ namespace COLLADASaxFWL
             delete[] mCallbackHandlersCallingList;
             mCallbackHandlersCallingList = 0;
         }
-        mCallbackHandlersCallingList = new bool [mExtraDataCallbackHandlerList.size ()];
+        mCallbackHandlersCallingList = new bool [mExtraDataCallbackHandlerList.size ()]();
     }
 
     //------------------------------
@@ -90,6 +90,37 @@ namespace COLLADASaxFWL
         return true;
     }
 
+    //------------------------------
+    bool ExtraDataElementHandler::wantsRawContents()
+    {
+        // If no handler parses the current element, its contents are skipped.
+        const size_t numHandlers = mExtraDataCallbackHandlerList.size ();
+        if ( numHandlers > 0 && !mCallbackHandlersCallingList ) return false;
+        for ( size_t i=0; i<numHandlers; ++i )
+        {
+            if ( mCallbackHandlersCallingList[i] && !mExtraDataCallbackHandlerList[i]->wantsRawContents () )
+                return false;
+        }
+        return true;
+    }
+
+    //------------------------------
+    bool ExtraDataElementHandler::rawContents( const ParserChar* contents, size_t length )
+    {
+        // Go through the list of extra data callback handlers and call the rawContents method.
+        const size_t numHandlers = mExtraDataCallbackHandlerList.size ();
+        if ( numHandlers > 0 && !mCallbackHandlersCallingList ) return false;
+        for ( size_t i=0; i<numHandlers; ++i )
+        {
+            if ( mCallbackHandlersCallingList[i] )
+            {
+                IExtraDataCallbackHandler* callbackHandler = mExtraDataCallbackHandlerList [i];
+                callbackHandler->rawContents ( contents, length );
+            }
+        }
+        return true;
+    }
+
     //------------------------------
     bool ExtraDataElementHandler::textData( const ParserChar* text, size_t textLength )
     {
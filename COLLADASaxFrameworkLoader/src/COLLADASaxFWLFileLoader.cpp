@@ -29,7 +29,9 @@
 
 #include "COLLADAFWObject.h"
 
-#if defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
+#if defined(GENERATEDSAXPARSER_XMLPARSER_NATIVE)
+#	include "GeneratedSaxParserNativeSaxParser.h"
+#elif defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
 #	include "GeneratedSaxParserLibxmlSaxParser.h"
 #elif defined(GENERATEDSAXPARSER_XMLPARSER_EXPAT)
 #	include "GeneratedSaxParserExpatSaxParser.h"
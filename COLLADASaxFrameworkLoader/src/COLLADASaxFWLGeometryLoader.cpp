@@ -92,20 +92,37 @@ namespace COLLADASaxFWL
 	bool GeometryLoader::end__geometry()
 	{
 		bool success = true;
+		bool releaseMesh = false;
 		COLLADAFW::Mesh * mesh = mMeshLoader ? mMeshLoader->getMesh() : 0;
 		if ( ((getObjectFlags() & Loader::GEOMETRY_FLAG) != 0) && mesh )
 		{
-			success |= writer()->writeGeometry(mesh);
+			// A streamed mesh has already been passed to the writer.
+			if ( mMeshLoader->isStreamingMesh() )
+			{
+				success |= writer()->finishMeshStream(mesh);
+			}
+			else
+			{
+				success |= writer()->writeGeometry(mesh);
+				releaseMesh = writer()->takesObjectOwnership();
+			}
 		}
 
+        bool releaseSpline = false;
         COLLADAFW::Spline * spline = mSplineLoader ? mSplineLoader->getSpline() : 0;
         if ( ((getObjectFlags() & Loader::GEOMETRY_FLAG) != 0) && spline )
         {
             success |= writer()->writeGeometry(spline);
+            releaseSpline = writer()->takesObjectOwnership();
         }
 
 		finish();
 		moveUpInSidTree();
+
+		if ( releaseMesh )
+			mMeshLoader->releaseMesh();
+		if ( releaseSpline )
+			mSplineLoader->releaseSpline();
 		return success;
 	}
 
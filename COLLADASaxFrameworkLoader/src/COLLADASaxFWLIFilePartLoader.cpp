@@ -243,11 +243,35 @@ namespace COLLADASaxFWL
 	}
 
 	//-----------------------------
-	void IFilePartLoader::addSkinDataJointSidsPair( const COLLADAFW::UniqueId& skinDataUniqueId, const StringList& sidsOrIds, bool areIds )
+	void IFilePartLoader::addSkinDataJointSidsPair( const COLLADAFW::UniqueId& skinDataUniqueId, const SymbolIdList& sidsOrIds, bool areIds )
 	{
 		getFileLoader()->addSkinDataJointSidsPair( skinDataUniqueId, sidsOrIds, areIds );
 	}
 
+	//-----------------------------
+	GeneratedSaxParser::StringTable& IFilePartLoader::getStringTable()
+	{
+		return getColladaLoader()->getStringTable();
+	}
+
+	//-----------------------------
+	size_t IFilePartLoader::getMeshStreamChunkSize()
+	{
+		return getColladaLoader()->getMeshStreamChunkSize();
+	}
+
+	//-----------------------------
+	bool IFilePartLoader::getCalculateMeshContentHashes()
+	{
+		return getColladaLoader()->getCalculateMeshContentHashes();
+	}
+
+	//-----------------------------
+	const COLLADAFW::UniqueId& IFilePartLoader::registerMeshContentHash( const COLLADABU::ContentHash& contentHash, const COLLADAFW::UniqueId& meshUniqueId )
+	{
+		return getColladaLoader()->registerMeshContentHash( contentHash, meshUniqueId );
+	}
+
 	//-----------------------------
 	void IFilePartLoader::addSkinDataSkinSourcePair( const COLLADAFW::UniqueId& skinDataUniqueId, const COLLADABU::URI& skinSource )
 	{
@@ -250,6 +250,23 @@ namespace COLLADASaxFWL
 		return COLLADAFW::AnimationCurve::INTERPOLATION_UNKNOWN;
 	}
 
+	//------------------------------
+	COLLADAFW::AnimationCurve::InterpolationType LibraryAnimationsLoader::getInterpolationTypeBySymbol( const ParserString& string )
+	{
+		GeneratedSaxParser::StringTable::SymbolId symbolId = getStringTable().intern( string );
+		if ( symbolId >= mInterpolationTypesBySymbolId.size() )
+		{
+			mInterpolationTypesBySymbolId.resize( symbolId + 1, COLLADAFW::AnimationCurve::INTERPOLATION_UNKNOWN );
+		}
+
+		COLLADAFW::AnimationCurve::InterpolationType& interpolationType = mInterpolationTypesBySymbolId[symbolId];
+		if ( interpolationType == COLLADAFW::AnimationCurve::INTERPOLATION_UNKNOWN )
+		{
+			interpolationType = getInterpolationTypeByString( string );
+		}
+		return interpolationType;
+	}
+
 	//------------------------------
 	SamplerInputSemantics getSemanticBySemanticStr( const char * semanticStr)
 	{
@@ -394,7 +411,8 @@ namespace COLLADASaxFWL
 			if ( COLLADAFW::validate( mCurrentAnimationCurve ) )
 			{
 				success = writer()->writeAnimation(mCurrentAnimationCurve);
-				FW_DELETE mCurrentAnimationCurve;
+				if ( !writer()->takesObjectOwnership() )
+					FW_DELETE mCurrentAnimationCurve;
 			}
 			else
 			{
@@ -697,7 +715,7 @@ namespace COLLADASaxFWL
 		for ( size_t i = 0; i < length;  ++i)
 		{
 			const ParserString& interpolationTypeString = data[i];
-			COLLADAFW::AnimationCurve::InterpolationType interpolationType = getInterpolationTypeByString( interpolationTypeString );
+			COLLADAFW::AnimationCurve::InterpolationType interpolationType = getInterpolationTypeBySymbol( interpolationTypeString );
 			COLLADAFW::AnimationCurve::InterpolationTypeArray& array  = interpolationTypeSource->getArrayElement().getValues();
 			array.append( interpolationType );
 
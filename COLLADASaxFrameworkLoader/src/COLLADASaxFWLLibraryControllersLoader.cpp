@@ -164,10 +164,12 @@ namespace COLLADASaxFWL
 		if ( !mJointSidsOrIds )
 			return true;
 
+		// Joint names repeat across skins. Interning them avoids a string copy per name.
+		GeneratedSaxParser::StringTable& stringTable = getStringTable();
+		mJointSidsOrIds->reserve( mJointSidsOrIds->size() + length );
 		for ( size_t i = 0; i < length;  ++i)
 		{
-			const ParserString& parserString = data[i];
-			mJointSidsOrIds->push_back( String( parserString.str, parserString.length ) );
+			mJointSidsOrIds->push_back( stringTable.intern( data[i] ) );
 		}
 		return true;
 	}
@@ -229,6 +231,8 @@ namespace COLLADASaxFWL
 		if ( validate( mCurrentSkinControllerData ) )
 		{
 			success = writer()->writeSkinControllerData( mCurrentSkinControllerData );
+			if ( writer()->takesObjectOwnership() )
+				mCurrentSkinControllerData = 0;
 		}
 
 		FW_DELETE mCurrentSkinControllerData;
@@ -325,9 +329,9 @@ namespace COLLADASaxFWL
 
 						String sourceId = getIdFromURIFragmentType(attributeData.source);
 
-						const StringList* nodeSidsOrIds = 0;
+						const SymbolIdList* nodeSidsOrIds = 0;
 						bool isIdArray = false;
-						StringListMap::const_iterator itSid = mJointSidsMap.find(sourceId);
+						SymbolIdListMap::const_iterator itSid = mJointSidsMap.find(sourceId);
 						// check if the node sid array could be found
 						if ( itSid != mJointSidsMap.end() )
 						{
@@ -337,7 +341,7 @@ namespace COLLADASaxFWL
 						else
 						{
 							// check if it is an id_array
-							StringListMap::const_iterator itId = mJointIdsMap.find(sourceId);
+							SymbolIdListMap::const_iterator itId = mJointIdsMap.find(sourceId);
 							if ( itId != mJointIdsMap.end() )
 							{
 								nodeSidsOrIds = &itId->second;
@@ -446,7 +450,7 @@ namespace COLLADASaxFWL
 						}
 
 						String sourceId = getIdFromURIFragmentType(attributeData.source);
-						StringListMap::const_iterator it = mJointIdsMap.find(sourceId);
+						SymbolIdListMap::const_iterator it = mJointIdsMap.find(sourceId);
 
 						// check if the node sid array could be found
 						if ( it == mJointIdsMap.end() )
@@ -456,16 +460,17 @@ namespace COLLADASaxFWL
 							break;
 						}
 
-						const StringList& meshIds = it->second;
+						const SymbolIdList& meshIds = it->second;
 						size_t meshIdCount = meshIds.size();
+						const GeneratedSaxParser::StringTable& stringTable = getStringTable();
 
 						COLLADAFW::UniqueIdArray& morphTargets = mCurrentMorphController->getMorphTargets();
 						morphTargets.allocMemory(meshIdCount);
 						morphTargets.setCount(meshIdCount);
-						StringList::const_iterator itTarget = meshIds.begin();
+						SymbolIdList::const_iterator itTarget = meshIds.begin();
 						for ( size_t i = 0 ; itTarget != meshIds.end(); ++itTarget, ++i)
 						{
-							morphTargets[i] = createUniqueIdFromId( itTarget->c_str(), COLLADAFW::Geometry::ID());
+							morphTargets[i] = createUniqueIdFromId( stringTable.getString(*itTarget).c_str(), COLLADAFW::Geometry::ID());
 						}
 
 					}
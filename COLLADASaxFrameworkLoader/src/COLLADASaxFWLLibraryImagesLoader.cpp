@@ -23,6 +23,7 @@ namespace COLLADASaxFWL
 	LibraryImagesLoader::LibraryImagesLoader( IFilePartLoader* callingFilePartLoader )
 		: FilePartLoader(callingFilePartLoader)
 		, mCurrentImage(0)
+		, mStreamImageData(false)
 	{
 
 	}
@@ -78,6 +79,8 @@ namespace COLLADASaxFWL
 		if ( (getObjectFlags() & Loader::IMAGE_FLAG) != 0 )
 		{
 		    success = writer()->writeImage(mCurrentImage);
+			if ( writer()->takesObjectOwnership() )
+				mCurrentImage = 0;
 		}
 		FW_DELETE mCurrentImage;
 		mCurrentImage = 0;
@@ -108,18 +111,34 @@ namespace COLLADASaxFWL
 	//------------------------------
 	bool LibraryImagesLoader::begin__data()
 	{
-		// disabled see COLALDAFW::Image
-		//mCurrentImage->setSourceType( COLLADAFW::Image::SOURCE_TYPE_DATA);
+		mCurrentImage->setSourceType( COLLADAFW::Image::SOURCE_TYPE_DATA);
+
+		// The embedded data is not stored in the image, but passed to the writer as it is decoded
+		mStreamImageData = false;
+		if ( (getObjectFlags() & Loader::IMAGE_FLAG) != 0 )
+		{
+			mStreamImageData = writer()->startImageData(mCurrentImage);
+		}
 		return true;
 	}
 
+	//------------------------------
+	bool LibraryImagesLoader::end__data()
+	{
+		if ( !mStreamImageData )
+			return true;
+
+		mStreamImageData = false;
+		return writer()->finishImageData(mCurrentImage);
+	}
+
 	//------------------------------
 	bool LibraryImagesLoader::data__data( const uint8* data, size_t length )
 	{
-		// disabled see COLALDAFW::Image
-		//COLLADAFW::Image::CharacterArray& dataArray = mCurrentImage->getData();
-		//dataArray.appendValues( (char *)data, length );
-		return true;
+		if ( !mStreamImageData )
+			return true;
+
+		return writer()->writeImageData(mCurrentImage, data, length);
 	}
 
 } // namespace COLLADASaxFWL
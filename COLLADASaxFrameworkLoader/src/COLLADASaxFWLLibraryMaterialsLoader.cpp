@@ -57,6 +57,8 @@ namespace COLLADASaxFWL
 		if ( (getObjectFlags() & Loader::MATERIAL_FLAG) != 0 )
 		{
 			success = writer()->writeMaterial(mCurrentMaterial);
+			if ( writer()->takesObjectOwnership() )
+				mCurrentMaterial = 0;
 		}
 
 		FW_DELETE mCurrentMaterial;
@@ -24,6 +24,7 @@ http://www.opensource.org/licenses/mit-license.php
 #include "COLLADAFWLight.h"
 #include "COLLADAFWCamera.h"
 #include "COLLADAFWAnimationList.h"
+#include "COLLADAFWMorphController.h"
 #include "COLLADAFWConstants.h"
 
 #include <sys/types.h>
@@ -47,8 +48,15 @@ namespace COLLADASaxFWL
 		, mObjectFlags( Loader::ALL_OBJECTS_MASK )
 		, mParsedObjectFlags( Loader::NO_FLAG )
 		, mSidTreeRoot( new SidTreeNode("", 0) )
+		, mWrittenObjectCounts()
 		, mSkinControllerSet( compare )
 		, mExternalReferenceDeciderCallbackFunction()
+		, mUseMemoryArena(false)
+		, mMeshStreamChunkSize(0)
+		, mCalculateMeshContentHashes(false)
+		, mReadAheadBufferSize(0)
+		, mReadAheadBufferCount(0)
+		, mLazyLoading(false)
 
 	{
 	}
@@ -57,6 +65,9 @@ namespace COLLADASaxFWL
 	//---------------------------------
 	Loader::~Loader()
 	{
+		// objects allocated from mMemoryArena are left to it, it is released after this destructor
+		COLLADAFW::MemoryArenaScope memoryArenaScope( &mMemoryArena );
+
 		delete mSidTreeRoot;
 
 		// delete visual scenes
@@ -85,6 +96,46 @@ namespace COLLADASaxFWL
 		}
 	}
 
+	//---------------------------------
+	void Loader::releaseMemoryArena()
+	{
+		{
+			COLLADAFW::MemoryArenaScope memoryArenaScope( &mMemoryArena );
+
+			deleteVectorFW(mVisualScenes);
+			mVisualScenes.clear();
+			deleteVectorFW(mLibraryNodes);
+			mLibraryNodes.clear();
+			deleteVectorFW(mEffects);
+			mEffects.clear();
+			deleteVectorFW(mLights);
+			mLights.clear();
+			deleteVectorFW(mCameras);
+			mCameras.clear();
+
+			Loader::UniqueIdAnimationListMap::const_iterator it = mUniqueIdAnimationListMap.begin();
+			for ( ; it != mUniqueIdAnimationListMap.end(); ++it )
+			{
+				COLLADAFW::AnimationList* animationList = it->second;
+				FW_DELETE animationList;
+			}
+			mUniqueIdAnimationListMap.clear();
+		}
+
+		// the formulas have been deleted with the formulas object passed to the writer, the morph 
+		// controllers are left to the arena
+		mFormulasMap.clear();
+		mMorphControllerList.clear();
+		mInstanceControllerDataListMap.clear();
+
+		// the sid tree refers to the released objects
+		delete mSidTreeRoot;
+		mSidTreeRoot = new SidTreeNode("", 0);
+		mIdStringSidTreeNodeMap.clear();
+
+		mMemoryArena.release();
+	}
+
     //---------------------------------
 	const COLLADAFW::UniqueId& Loader::getUniqueId( const COLLADABU::URI& uri, COLLADAFW::ClassId classId )
 	{
@@ -192,6 +243,20 @@ namespace COLLADASaxFWL
 		if ( !writer )
 			return false;
 		mWriter = writer;
+		mWrittenObjectCounts = WrittenObjectCounts();
+
+		// the strings interned by a previous document are not needed anymore, nor are the symbol ids
+		// referring to them
+		mStringTable.clear();
+		mSkinDataJointSidsMap.clear();
+
+		// the objects kept from the previous document might have been allocated from the arena
+		if ( mMemoryArena.getReservedBytes() != 0 )
+			releaseMemoryArena();
+
+		// objects of a writer that takes their ownership must not be allocated from any arena
+		bool useMemoryArena = mUseMemoryArena && !writer->takesObjectOwnership();
+		COLLADAFW::MemoryArenaScope memoryArenaScope( useMemoryArena ? &mMemoryArena : 0 );
 
 		mWriter->start();
 
@@ -252,6 +317,20 @@ namespace COLLADASaxFWL
 		if ( !writer )
 			return false;
 		mWriter = writer;
+		mWrittenObjectCounts = WrittenObjectCounts();
+
+		// the strings interned by a previous document are not needed anymore, nor are the symbol ids
+		// referring to them
+		mStringTable.clear();
+		mSkinDataJointSidsMap.clear();
+
+		// the objects kept from the previous document might have been allocated from the arena
+		if ( mMemoryArena.getReservedBytes() != 0 )
+			releaseMemoryArena();
+
+		// objects of a writer that takes their ownership must not be allocated from any arena
+		bool useMemoryArena = mUseMemoryArena && !writer->takesObjectOwnership();
+		COLLADAFW::MemoryArenaScope memoryArenaScope( useMemoryArena ? &mMemoryArena : 0 );
         
 		SaxParserErrorHandler saxParserErrorHandler(mErrorHandler);
         
@@ -303,6 +382,154 @@ namespace COLLADASaxFWL
 		return !abortLoading;
 	}
 
+	//---------------------------------
+	bool Loader::loadGeometry( const COLLADAFW::UniqueId& geometryUniqueId, COLLADAFW::IWriter* writer )
+	{
+		return loadIndexedElement( geometryUniqueId, INDEXED_GEOMETRY, GEOMETRY_FLAG, writer );
+	}
+
+	//---------------------------------
+	bool Loader::loadAnimation( const COLLADAFW::UniqueId& animationUniqueId, COLLADAFW::IWriter* writer )
+	{
+		return loadIndexedElement( animationUniqueId, INDEXED_ANIMATION, ANIMATION_FLAG, writer );
+	}
+
+	//---------------------------------
+	bool Loader::loadController( const COLLADAFW::UniqueId& controllerUniqueId, COLLADAFW::IWriter* writer )
+	{
+		return loadIndexedElement( controllerUniqueId, INDEXED_CONTROLLER, SKIN_CONTROLLER_DATA_FLAG, writer );
+	}
+
+	//---------------------------------
+	bool Loader::loadIndexedElement( const COLLADAFW::UniqueId& uniqueId, IndexedElementType type, int objectFlags, COLLADAFW::IWriter* writer )
+	{
+		static const char* libraryNames[] = { "library_geometries", "library_animations", "library_controllers" };
+
+		if ( !writer )
+			return false;
+
+		UniqueIdIndexedElementMap::const_iterator it = mIndexedElements.find( uniqueId );
+		if ( (it == mIndexedElements.end()) || (it->second.type != type) )
+			return false;
+		const IndexedElement& indexedElement = it->second;
+
+		FileIdIndexedFileMap::const_iterator fileIt = mIndexedFiles.find( indexedElement.fileId );
+		if ( fileIt == mIndexedFiles.end() )
+			return false;
+		const IndexedFile& indexedFile = fileIt->second;
+
+		const COLLADABU::URI& fileUri = getFileUri( indexedElement.fileId );
+		String element;
+		if ( !readIndexedElement( fileUri.toNativePath(), indexedElement, element ) )
+			return false;
+
+		// wrap the element into its library and the root element, using the prefix of the root element
+		const String& rootElementName = indexedFile.rootElementName;
+		size_t colonPosition = rootElementName.find( ':' );
+		String libraryName = ( colonPosition == String::npos ) ? String() : rootElementName.substr( 0, colonPosition + 1 );
+		libraryName.append( libraryNames[type] );
+
+		String document;
+		document.reserve( indexedFile.rootStartTag.size() + element.size() + 2 * libraryName.size() + rootElementName.size() + 8 );
+		document.append( indexedFile.rootStartTag );
+		document.append( "<" ).append( libraryName ).append( ">" );
+		document.append( element );
+		document.append( "</" ).append( libraryName ).append( ">" );
+		document.append( "</" ).append( rootElementName ).append( ">" );
+		element.clear();
+
+		mWriter = writer;
+
+		// objects of a writer that takes their ownership must not be allocated from any arena
+		bool useMemoryArena = mUseMemoryArena && !writer->takesObjectOwnership();
+		COLLADAFW::MemoryArenaScope memoryArenaScope( useMemoryArena ? &mIndexedElementMemoryArena : 0 );
+
+		SaxParserErrorHandler saxParserErrorHandler(mErrorHandler);
+
+		// relative uris in the element refer to the file it has been found in
+		COLLADAFW::FileId currentFileId = mCurrentFileId;
+		mCurrentFileId = indexedElement.fileId;
+
+		// the animation bindings are only used by the post processing of loadDocument(), which
+		// has been done already
+		size_t animationSidAddressBindingCount = mAnimationSidAddressBindings.size();
+		size_t morphControllerCount = mMorphControllerList.size();
+
+		// the parsed object flags of the loader are not changed, since only a part of a file is parsed
+		int parsedObjectFlags = mParsedObjectFlags;
+
+		// the file loader is destroyed before the arena is released, since its part loaders might still
+		// refer to objects allocated from it
+		bool success = false;
+		{
+			FileLoader fileLoader(this, 
+				fileUri,
+				&saxParserErrorHandler, 
+				objectFlags,
+				parsedObjectFlags, 
+				mExtraDataCallbackHandlerList );
+			success = fileLoader.load( document.c_str(), (int)document.size() );
+		}
+
+		mCurrentFileId = currentFileId;
+		mAnimationSidAddressBindings.erase( mAnimationSidAddressBindings.begin() + animationSidAddressBindingCount, mAnimationSidAddressBindings.end() );
+
+		// morph controllers are written by the post processor otherwise
+		for ( size_t i = morphControllerCount; i < mMorphControllerList.size(); ++i )
+		{
+			COLLADAFW::MorphController* morphController = mMorphControllerList[i];
+			if ( success && !writer->writeController( morphController ) )
+				success = false;
+			if ( !writer->takesObjectOwnership() )
+				FW_DELETE morphController;
+		}
+		mMorphControllerList.resize( morphControllerCount );
+
+		// all objects of the element have been deleted, once they have been written
+		mIndexedElementMemoryArena.release();
+
+		return success;
+	}
+
+	//---------------------------------
+	bool Loader::readIndexedElement( const String& fileName, const IndexedElement& indexedElement, String& buffer )
+	{
+		if ( (indexedElement.beginOffset == 0) || (indexedElement.endOffset <= indexedElement.beginOffset) )
+			return false;
+
+		std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary );
+		if ( !file )
+			return false;
+
+		// The begin offset lies within or directly behind the start tag. Its beginning is the last '<' 
+		// before the offset, since attribute values cannot contain '<'. The start tag is searched in a
+		// growing range in front of the offset.
+		size_t lookBehind = 1024;
+		while ( true )
+		{
+			size_t readBegin = ( indexedElement.beginOffset > lookBehind ) ? indexedElement.beginOffset - lookBehind : 0;
+			size_t length = indexedElement.endOffset - readBegin;
+
+			buffer.resize( length );
+			file.clear();
+			file.seekg( (std::streamoff)readBegin, std::ios::beg );
+			file.read( &buffer[0], (std::streamsize)length );
+			if ( (size_t)file.gcount() != length )
+				return false;
+
+			size_t tagBegin = buffer.rfind( '<', indexedElement.beginOffset - readBegin - 1 );
+			if ( tagBegin != String::npos )
+			{
+				buffer.erase( 0, tagBegin );
+				return true;
+			}
+
+			if ( readBegin == 0 )
+				return false;
+			lookBehind *= 2;
+		}
+	}
+
     //---------------------------------
     bool Loader::registerExtraDataCallbackHandler ( IExtraDataCallbackHandler* extraDataCallbackHandler )
     {
@@ -318,6 +545,12 @@ namespace COLLADASaxFWL
 		return mGeometryMaterialIdInfo;
 	}
 
+	//---------------------------------
+	const COLLADAFW::UniqueId& Loader::registerMeshContentHash( const COLLADABU::ContentHash& contentHash, const COLLADAFW::UniqueId& meshUniqueId )
+	{
+		return mMeshContentHashUniqueIdMap.insert( std::make_pair( contentHash, meshUniqueId ) ).first->second;
+	}
+
 	//---------------------------------
 	COLLADAFW::TextureMapId Loader::getTextureMapIdBySematic( const String& semantic )
 	{
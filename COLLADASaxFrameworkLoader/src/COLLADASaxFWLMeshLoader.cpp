@@ -59,6 +59,17 @@ namespace COLLADASaxFWL
 		, mCurrentPrimitiveType(NONE)
 		, mPOrPhElementCountOfCurrentPrimitive(0)
         , mInMesh (true)
+		, mStreamMesh(false)
+		, mStreamChunkSize(0)
+		, mStreamedPositionsCount(0)
+		, mStreamedNormalsCount(0)
+		, mStreamedColorsCount(0)
+		, mStreamedUVCoordsCount(0)
+		, mStreamedTangentsCount(0)
+		, mStreamedBinormalsCount(0)
+		, mCalculateContentHash(false)
+		, mPrimitiveHashedFaceCount(0)
+		, mPrimitiveHashedChunkCount(0)
 	{
         if ( !geometryName.empty() )
             mMesh->setName ( geometryName );
@@ -67,6 +78,14 @@ namespace COLLADASaxFWL
 
         if ( !geometryId.empty() )
             mMesh->setOriginalId ( geometryId );
+
+		if ( (getObjectFlags() & Loader::GEOMETRY_FLAG) != 0 )
+		{
+			mStreamMesh = writer()->startMeshStream(mMesh);
+			if ( mStreamMesh )
+				mStreamChunkSize = getMeshStreamChunkSize();
+			mCalculateContentHash = getCalculateMeshContentHashes();
+		}
 	}
 
     //------------------------------
@@ -207,12 +226,12 @@ namespace COLLADASaxFWL
                 // Check if there are already some values in the positions list.
                 // If so, we have to store the last index to increment the following indexes.
                 COLLADAFW::MeshVertexData& positions = mMesh->getPositions ();
-                const size_t initialIndex = positions.getValuesCount ();
+                const size_t initialIndex = getInitialIndex ( positions );
                 sourceBase->setInitialIndex ( initialIndex );
 
                 // Push the new positions into the list of positions.
                 positions.setType ( COLLADAFW::MeshVertexData::DATA_TYPE_FLOAT );
-                if ( initialIndex != 0 ) 
+                if ( !positions.empty () )
 				{
 					positions.appendValues ( valuesArray );
 				}
@@ -220,6 +239,9 @@ namespace COLLADASaxFWL
 				{
 					positions.setData ( valuesArray.getData (), valuesArray.getCount () );
 					valuesArray.yieldOwnerShip();
+					// The mesh releases the values, once they have been passed to the writer.
+					if ( mStreamMesh )
+						valuesArray.setData ( 0, 0 );
 				}
 
                 // Set the source base as loaded element.
@@ -237,12 +259,12 @@ namespace COLLADASaxFWL
                 // Check if there are already some values in the positions list.
                 // If so, we have to store the last index to increment the following indexes.
                 COLLADAFW::MeshVertexData& positions = mMesh->getPositions ();
-                const size_t initialIndex = positions.getValuesCount ();
+                const size_t initialIndex = getInitialIndex ( positions );
                 sourceBase->setInitialIndex ( initialIndex );
 
                 // Push the new positions into the list of positions.
                 positions.setType ( COLLADAFW::MeshVertexData::DATA_TYPE_DOUBLE );
-                if ( initialIndex != 0 ) 
+                if ( !positions.empty () )
 				{
 					positions.appendValues ( valuesArray );
 				}
@@ -250,6 +272,9 @@ namespace COLLADASaxFWL
 				{
 					positions.setData ( valuesArray.getData (), valuesArray.getCount () );
 					valuesArray.yieldOwnerShip();
+					// The mesh releases the values, once they have been passed to the writer.
+					if ( mStreamMesh )
+						valuesArray.setData ( 0, 0 );
 				}
                 
                 // Set the source base as loaded element.
@@ -299,12 +324,12 @@ namespace COLLADASaxFWL
                 // Check if there are already some values in the positions list.
                 // If so, we have to store the last index to increment the following indexes.
                 COLLADAFW::MeshVertexData& normals = mMesh->getNormals ();
-                const size_t initialIndex = normals.getValuesCount ();
+                const size_t initialIndex = getInitialIndex ( normals );
                 sourceBase->setInitialIndex ( initialIndex );
 
                 // Push the new positions into the list of positions.
                 normals.setType ( COLLADAFW::MeshVertexData::DATA_TYPE_FLOAT );
-                if ( initialIndex != 0 ) 
+                if ( !normals.empty () )
 				{
 					normals.appendValues ( valuesArray );
 				}
@@ -312,6 +337,9 @@ namespace COLLADASaxFWL
 				{
 					normals.setData ( valuesArray.getData (), valuesArray.getCount () );
 					valuesArray.yieldOwnerShip();
+					// The mesh releases the values, once they have been passed to the writer.
+					if ( mStreamMesh )
+						valuesArray.setData ( 0, 0 );
 				}
 
                 // Set the source base as loaded element.
@@ -329,12 +357,12 @@ namespace COLLADASaxFWL
                 // Check if there are already some values in the positions list.
                 // If so, we have to store the last index to increment the following indexes.
                 COLLADAFW::MeshVertexData& normals = mMesh->getNormals ();
-                const size_t initialIndex = normals.getValuesCount ();
+                const size_t initialIndex = getInitialIndex ( normals );
                 sourceBase->setInitialIndex ( initialIndex );
 
                 // Push the new positions into the list of positions.
                 normals.setType ( COLLADAFW::MeshVertexData::DATA_TYPE_DOUBLE );
-                if ( initialIndex != 0 ) 
+                if ( !normals.empty () )
 				{
 					normals.appendValues ( valuesArray );
 				}
@@ -342,6 +370,9 @@ namespace COLLADASaxFWL
 				{ 
 					normals.setData ( valuesArray.getData (), valuesArray.getCount () );
 					valuesArray.yieldOwnerShip();
+					// The mesh releases the values, once they have been passed to the writer.
+					if ( mStreamMesh )
+						valuesArray.setData ( 0, 0 );
 				}
 
                 // Set the source base as loaded element.
@@ -489,6 +520,15 @@ namespace COLLADASaxFWL
         return retValue;
     }
 
+    //------------------------------
+    // Releases the memory of @a values.
+    template<class Type>
+    static void releaseValues ( COLLADAFW::ArrayPrimitiveType<Type>& values )
+    {
+        values.clear ();
+        values.setData ( 0, 0 );
+    }
+
     //------------------------------
     bool MeshLoader::appendVertexValues ( 
         SourceBase* sourceBase, 
@@ -498,7 +538,7 @@ namespace COLLADASaxFWL
 
         // Check if there are already some values in the positions list.
         // If so, we have to store the last index to increment the following indexes.
-        const size_t initialIndex = vertexData.getValuesCount ();
+        const size_t initialIndex = getInitialIndex ( vertexData );
         sourceBase->setInitialIndex ( initialIndex );
 
         // Get the source input array
@@ -515,6 +555,10 @@ namespace COLLADASaxFWL
                 // Push the values with the infos into the list.
                 vertexData.appendValues ( valuesArray, source->getId (), (size_t) source->getStride () );
 
+                // The values of the source are not needed anymore, once they have been copied.
+                if ( mStreamMesh )
+                    releaseValues ( valuesArray );
+
                 break;  
             }
         case SourceBase::DATA_TYPE_DOUBLE:
@@ -527,6 +571,10 @@ namespace COLLADASaxFWL
                 // Push the values with the infos into the list.
                 vertexData.appendValues ( valuesArray, source->getId (), (size_t) source->getStride () );
 
+                // The values of the source are not needed anymore, once they have been copied.
+                if ( mStreamMesh )
+                    releaseValues ( valuesArray );
+
                 break;
             }
         default:
@@ -537,6 +585,314 @@ namespace COLLADASaxFWL
         return retValue;
     }
 
+    //------------------------------
+    size_t MeshLoader::getInitialIndex ( const COLLADAFW::MeshVertexData& vertexData ) const
+    {
+        size_t streamedValuesCount = 0;
+        if ( &vertexData == &mMesh->getPositions () )
+            streamedValuesCount = mStreamedPositionsCount;
+        else if ( &vertexData == &mMesh->getNormals () )
+            streamedValuesCount = mStreamedNormalsCount;
+        else if ( &vertexData == &mMesh->getColors () )
+            streamedValuesCount = mStreamedColorsCount;
+        else if ( &vertexData == &mMesh->getUVCoords () )
+            streamedValuesCount = mStreamedUVCoordsCount;
+        else if ( &vertexData == &mMesh->getTangents () )
+            streamedValuesCount = mStreamedTangentsCount;
+        else if ( &vertexData == &mMesh->getBinormals () )
+            streamedValuesCount = mStreamedBinormalsCount;
+
+        return streamedValuesCount + vertexData.getValuesCount ();
+    }
+
+    //------------------------------
+    bool MeshLoader::writeStreamedVertexData ()
+    {
+        COLLADAFW::MeshVertexData* vertexDataList[] = 
+        {
+            &mMesh->getPositions (),
+            &mMesh->getNormals (),
+            &mMesh->getColors (),
+            &mMesh->getUVCoords (),
+            &mMesh->getTangents (),
+            &mMesh->getBinormals ()
+        };
+        size_t* streamedValuesCountList[] = 
+        {
+            &mStreamedPositionsCount,
+            &mStreamedNormalsCount,
+            &mStreamedColorsCount,
+            &mStreamedUVCoordsCount,
+            &mStreamedTangentsCount,
+            &mStreamedBinormalsCount
+        };
+        const size_t vertexDataCount = sizeof(vertexDataList) / sizeof(vertexDataList[0]);
+
+        // Nothing has been loaded since the last call.
+        bool hasValues = false;
+        for ( size_t i=0; i<vertexDataCount; ++i )
+        {
+            if ( !vertexDataList[i]->empty () )
+                hasValues = true;
+        }
+        if ( !hasValues )
+            return true;
+
+        hashVertexData ();
+
+        bool success = writer()->writeMeshVertexData ( mMesh );
+
+        // The values have been passed to the writer. Remember their count, to calculate the initial
+        // index of the following values, and release them.
+        for ( size_t i=0; i<vertexDataCount; ++i )
+        {
+            COLLADAFW::MeshVertexData* vertexData = vertexDataList[i];
+            *streamedValuesCountList[i] += vertexData->getValuesCount ();
+            vertexData->clear ();
+            vertexData->clearInputInfos ();
+        }
+
+        return success;
+    }
+
+    //------------------------------
+    bool MeshLoader::appendMeshPrimitive ( COLLADAFW::MeshPrimitive* meshPrimitive, bool isLastChunk )
+    {
+        hashMeshPrimitive ( meshPrimitive );
+        if ( isLastChunk )
+            finishMeshPrimitiveHash ( meshPrimitive );
+
+        if ( !mStreamMesh )
+        {
+            mMesh->appendPrimitive ( meshPrimitive );
+            return true;
+        }
+
+        bool success = writer()->writeMeshPrimitive ( mMesh, meshPrimitive );
+        delete meshPrimitive;
+        return success;
+    }
+
+    //------------------------------
+    bool MeshLoader::writeMeshPrimitiveChunk ()
+    {
+        // Only primitives with a fixed number of vertices per face are split.
+        size_t faceVertexCount = 0;
+        COLLADAFW::MeshPrimitive* nextMeshPrimitive = 0;
+        switch ( mCurrentPrimitiveType )
+        {
+        case TRIANGLES:
+            if ( (mCurrentVertexCount % 3) != 0 )
+                return true;
+            faceVertexCount = 3;
+            nextMeshPrimitive = new COLLADAFW::Triangles(createUniqueId(COLLADAFW::Triangles::ID()));
+            break;
+        case LINES:
+            if ( (mCurrentVertexCount % 2) != 0 )
+                return true;
+            faceVertexCount = 2;
+            nextMeshPrimitive = new COLLADAFW::Lines(createUniqueId(COLLADAFW::Lines::ID()));
+            break;
+        default:
+            return true;
+        }
+
+        nextMeshPrimitive->setMaterialId ( mCurrentMeshPrimitive->getMaterialId () );
+        nextMeshPrimitive->setMaterial ( mCurrentMeshPrimitive->getMaterial () );
+
+        mCurrentMeshPrimitive->setFaceCount ( mCurrentVertexCount / faceVertexCount );
+        bool success = appendMeshPrimitive ( mCurrentMeshPrimitive, false );
+
+        mCurrentMeshPrimitive = nextMeshPrimitive;
+        mCurrentVertexCount = 0;
+        return success;
+    }
+
+    //------------------------------
+    // Adds the values of @a values, starting at @a first, to @a hasher.
+    static void hashValues ( COLLADABU::ContentHasher& hasher, const COLLADAFW::FloatOrDoubleArray& values, size_t first, size_t count )
+    {
+        switch ( values.getType () )
+        {
+        case COLLADAFW::FloatOrDoubleArray::DATA_TYPE_FLOAT:
+            hasher.update ( values.getFloatValues ()->getData () + first, count * sizeof(float) );
+            break;
+        case COLLADAFW::FloatOrDoubleArray::DATA_TYPE_DOUBLE:
+            hasher.update ( values.getDoubleValues ()->getData () + first, count * sizeof(double) );
+            break;
+        default:
+            break;
+        }
+    }
+
+    //------------------------------
+    void MeshLoader::hashVertexData ()
+    {
+        if ( !mCalculateContentHash )
+            return;
+
+        const COLLADAFW::MeshVertexData* vertexDataList[] = 
+        {
+            &mMesh->getPositions (),
+            &mMesh->getNormals (),
+            &mMesh->getColors (),
+            &mMesh->getUVCoords (),
+            &mMesh->getTangents (),
+            &mMesh->getBinormals ()
+        };
+        const size_t vertexDataCount = sizeof(vertexDataList) / sizeof(vertexDataList[0]);
+
+        for ( size_t i=0; i<vertexDataCount; ++i )
+        {
+            const COLLADAFW::MeshVertexData& vertexData = *vertexDataList[i];
+            COLLADABU::ContentHasher& hasher = mVertexDataHashers[i];
+            const size_t valuesCount = vertexData.getValuesCount ();
+
+            // Hash each input with its stride, such that the hash does not depend on the number
+            // of inputs passed at once. The names of the inputs are the ids of the sources.
+            size_t position = 0;
+            const COLLADAFW::MeshVertexData::InputInfosArray& inputInfos = vertexData.getInputInfosArray ();
+            for ( size_t j=0; j<inputInfos.getCount (); ++j )
+            {
+                const COLLADAFW::MeshVertexData::InputInfos* inputInfo = inputInfos[j];
+                size_t length = std::min ( inputInfo->mLength, valuesCount - position );
+                hasher.updateValue ( (unsigned long long)inputInfo->mStride );
+                hasher.updateValue ( (unsigned long long)length );
+                hashValues ( hasher, vertexData, position, length );
+                position += length;
+            }
+            hashValues ( hasher, vertexData, position, valuesCount - position );
+        }
+    }
+
+    //------------------------------
+    void MeshLoader::hashMeshPrimitive ( const COLLADAFW::MeshPrimitive* meshPrimitive )
+    {
+        if ( !mCalculateContentHash )
+            return;
+
+        // Only the indices are hashed per chunk. The counts are added once the primitive is complete, 
+        // so that the hash of the primitive does not depend on the number of chunks.
+        mPrimitiveHashedFaceCount += meshPrimitive->getFaceCount ();
+        ++mPrimitiveHashedChunkCount;
+
+        const COLLADAFW::UIntValuesArray* indicesList[] = 
+        {
+            &meshPrimitive->getPositionIndices (),
+            &meshPrimitive->getNormalIndices (),
+            &meshPrimitive->getTangentIndices (),
+            &meshPrimitive->getBinormalIndices ()
+        };
+        const size_t indicesCount = sizeof(indicesList) / sizeof(indicesList[0]);
+        for ( size_t i=0; i<indicesCount; ++i )
+            mPrimitiveIndicesHashes[i].update ( indicesList[i]->getData (), indicesList[i]->getCount (), sizeof(unsigned int) );
+
+        hashIndexLists ( mPrimitiveColorIndicesHashes, meshPrimitive->getColorIndicesArray () );
+        hashIndexLists ( mPrimitiveUVCoordIndicesHashes, meshPrimitive->getUVCoordIndicesArray () );
+
+        // The vertex counts of the faces, strips or fans. Their element types have the same size.
+        IndicesHash& vertexCountsHash = mPrimitiveIndicesHashes[indicesCount];
+        switch ( meshPrimitive->getPrimitiveType () )
+        {
+        case COLLADAFW::MeshPrimitive::POLYGONS:
+        case COLLADAFW::MeshPrimitive::POLYLIST:
+            {
+                const COLLADAFW::MeshPrimitiveWithFaceVertexCount<int>::VertexCountArray& vertexCounts = 
+                    ((const COLLADAFW::MeshPrimitiveWithFaceVertexCount<int>*)meshPrimitive)->getGroupedVerticesVertexCountArray ();
+                vertexCountsHash.update ( vertexCounts.getData (), vertexCounts.getCount (), sizeof(int) );
+                break;
+            }
+        case COLLADAFW::MeshPrimitive::LINE_STRIPS:
+        case COLLADAFW::MeshPrimitive::TRIANGLE_STRIPS:
+        case COLLADAFW::MeshPrimitive::TRIANGLE_FANS:
+            {
+                const COLLADAFW::MeshPrimitiveWithFaceVertexCount<unsigned int>::VertexCountArray& vertexCounts = 
+                    ((const COLLADAFW::MeshPrimitiveWithFaceVertexCount<unsigned int>*)meshPrimitive)->getGroupedVerticesVertexCountArray ();
+                vertexCountsHash.update ( vertexCounts.getData (), vertexCounts.getCount (), sizeof(unsigned int) );
+                break;
+            }
+        default:
+            break;
+        }
+    }
+
+    //------------------------------
+    void MeshLoader::hashIndexLists ( IndicesHashList& indicesHashes, const COLLADAFW::IndexListArray& indexLists )
+    {
+        // An empty last chunk might not have all index lists.
+        if ( indicesHashes.size () < indexLists.getCount () )
+            indicesHashes.resize ( indexLists.getCount () );
+
+        // The name is not hashed, since it is the id of the source.
+        for ( size_t i=0; i<indexLists.getCount (); ++i )
+        {
+            const COLLADAFW::IndexList& indexList = *indexLists[i];
+            const COLLADAFW::UIntValuesArray& indices = indexList.getIndices ();
+            IndicesHash& indicesHash = indicesHashes[i];
+            indicesHash.stride = indexList.getStride ();
+            indicesHash.initialIndex = indexList.getInitialIndex ();
+            indicesHash.update ( indices.getData (), indices.getCount (), sizeof(unsigned int) );
+        }
+    }
+
+    //------------------------------
+    void MeshLoader::finishMeshPrimitiveHash ( const COLLADAFW::MeshPrimitive* meshPrimitive )
+    {
+        if ( !mCalculateContentHash || mPrimitiveHashedChunkCount == 0 )
+            return;
+
+        COLLADABU::ContentHasher& hasher = mMeshPrimitivesHasher;
+        hasher.updateValue ( (unsigned long long)meshPrimitive->getPrimitiveType () );
+        hasher.updateValue ( (unsigned long long)mPrimitiveHashedFaceCount );
+
+        // The material is bound by its symbol when the mesh is instantiated.
+        const String material = meshPrimitive->getMaterial ();
+        hasher.updateValue ( (unsigned long long)material.length () );
+        hasher.update ( material.c_str (), material.length () );
+
+        const size_t indicesHashesCount = sizeof(mPrimitiveIndicesHashes) / sizeof(mPrimitiveIndicesHashes[0]);
+        for ( size_t i=0; i<indicesHashesCount; ++i )
+        {
+            mPrimitiveIndicesHashes[i].addTo ( hasher );
+            mPrimitiveIndicesHashes[i] = IndicesHash ();
+        }
+
+        hasher.updateValue ( (unsigned long long)mPrimitiveColorIndicesHashes.size () );
+        for ( size_t i=0; i<mPrimitiveColorIndicesHashes.size (); ++i )
+            mPrimitiveColorIndicesHashes[i].addTo ( hasher );
+        mPrimitiveColorIndicesHashes.clear ();
+
+        hasher.updateValue ( (unsigned long long)mPrimitiveUVCoordIndicesHashes.size () );
+        for ( size_t i=0; i<mPrimitiveUVCoordIndicesHashes.size (); ++i )
+            mPrimitiveUVCoordIndicesHashes[i].addTo ( hasher );
+        mPrimitiveUVCoordIndicesHashes.clear ();
+
+        mPrimitiveHashedFaceCount = 0;
+        mPrimitiveHashedChunkCount = 0;
+    }
+
+    //------------------------------
+    void MeshLoader::setMeshContentHash ()
+    {
+        if ( !mCalculateContentHash )
+            return;
+
+        // The vertex data of a mesh, that is not streamed, has not been hashed yet.
+        hashVertexData ();
+
+        COLLADABU::ContentHasher hasher;
+        for ( size_t i=0; i<sizeof(mVertexDataHashers) / sizeof(mVertexDataHashers[0]); ++i )
+            hasher.updateHash ( mVertexDataHashers[i].getHash () );
+        hasher.updateHash ( mMeshPrimitivesHasher.getHash () );
+
+        COLLADABU::ContentHash contentHash = hasher.getHash ();
+        mMesh->setContentHash ( contentHash );
+
+        const COLLADAFW::UniqueId& firstMeshUniqueId = registerMeshContentHash ( contentHash, mMesh->getUniqueId () );
+        if ( firstMeshUniqueId != mMesh->getUniqueId () )
+            mMesh->setDuplicateOf ( firstMeshUniqueId );
+    }
+
     //------------------------------
     bool MeshLoader::loadTexCoordsSourceElement ( const InputShared& input )
     {
@@ -695,6 +1051,12 @@ namespace COLLADASaxFWL
 				// Reset the current offset value
 				mCurrentOffset = 0;
 				++mCurrentVertexCount;
+
+				if ( mStreamChunkSize > 0 && mCurrentVertexCount >= mStreamChunkSize )
+				{
+					if ( !writeMeshPrimitiveChunk() )
+						return false;
+				}
 			}
 			else
 			{
@@ -974,6 +1336,7 @@ namespace COLLADASaxFWL
         mInMesh = false;
 
 		// The mesh will be written by the GeometyLoader. Therefore nothing to with the mesh here
+		setMeshContentHash();
 		finish();
 		return true;
 	}
@@ -1061,21 +1424,24 @@ namespace COLLADASaxFWL
 	//------------------------------
 	bool MeshLoader::end__triangles()
 	{
+		bool success = true;
 		size_t trianglesCount = mCurrentVertexCount/3;
 		// check if the triangles really contains triangles. If not, we will discard it
 		if ( trianglesCount > 0 )
 		{
 			mCurrentMeshPrimitive->setFaceCount(trianglesCount);
-			mMesh->appendPrimitive(mCurrentMeshPrimitive);
+			success = appendMeshPrimitive(mCurrentMeshPrimitive);
 		}
 		else
 		{
+			// all faces have been passed in chunks before
+			finishMeshPrimitiveHash(mCurrentMeshPrimitive);
 			delete mCurrentMeshPrimitive;
 		}
 		initCurrentValues();
 		mMeshPrimitiveInputs.clearInputs();
 		mCurrentPrimitiveType = NONE;
-		return true;
+		return success;
 	}
 
 
@@ -1121,6 +1487,7 @@ namespace COLLADASaxFWL
 	//------------------------------
 	bool MeshLoader::end__polylist()
 	{
+		bool success = true;
 		// check if there are enough vertices as expected by the vcount and that there exist at least
 		// one polygon. If not, we will discard it
 		if ( mCurrentVertexCount >= mCurrentExpectedVertexCount && mCurrentVertexCount > 0 )
@@ -1129,7 +1496,7 @@ namespace COLLADASaxFWL
 			COLLADAFW::Polylist::VertexCountArray& vertexCountArray = polylist->getGroupedVerticesVertexCountArray();
 
 			mCurrentMeshPrimitive->setFaceCount(vertexCountArray.getCount());
-			mMesh->appendPrimitive(mCurrentMeshPrimitive);
+			success = appendMeshPrimitive(mCurrentMeshPrimitive);
 		}
 		else
 		{
@@ -1138,7 +1505,7 @@ namespace COLLADASaxFWL
 		initCurrentValues();
 		mMeshPrimitiveInputs.clearInputs();
 		mCurrentPrimitiveType = NONE;
-		return true;
+		return success;
 	}
 
 	//------------------------------
@@ -1180,12 +1547,13 @@ namespace COLLADASaxFWL
 	//------------------------------
 	bool MeshLoader::end__linestrips()
 	{
+		bool success = true;
 		mCurrentPrimitiveType = LINESTRIPS;
 		// check if there is at least one linestrip. If not, we will discard it.
 		if ( mCurrentFaceOrLineCount > 0 )
 		{
 			mCurrentMeshPrimitive->setFaceCount(mCurrentFaceOrLineCount);
-			mMesh->appendPrimitive(mCurrentMeshPrimitive);
+			success = appendMeshPrimitive(mCurrentMeshPrimitive);
 		}
 		else
 		{
@@ -1194,7 +1562,7 @@ namespace COLLADASaxFWL
 		initCurrentValues();
 		mMeshPrimitiveInputs.clearInputs();
 		mCurrentPrimitiveType = NONE;
-		return true;
+		return success;
 	}
 
 	//------------------------------
@@ -1245,11 +1613,12 @@ namespace COLLADASaxFWL
 	//------------------------------
 	bool MeshLoader::end__polygons()
 	{
+		bool success = true;
 		// check if there is at least one polygon. If not, we will discard it.
 		if ( mCurrentFaceOrLineCount > 0 )
 		{
 			mCurrentMeshPrimitive->setFaceCount(mCurrentFaceOrLineCount);
-			mMesh->appendPrimitive(mCurrentMeshPrimitive);
+			success = appendMeshPrimitive(mCurrentMeshPrimitive);
 		}
 		else
 		{
@@ -1258,7 +1627,7 @@ namespace COLLADASaxFWL
 		initCurrentValues();
 		mMeshPrimitiveInputs.clearInputs();
 		mCurrentPrimitiveType = NONE;
-		return true;
+		return success;
 	}
 
 	//------------------------------
@@ -1325,12 +1694,13 @@ namespace COLLADASaxFWL
 	//------------------------------
 	bool MeshLoader::end__tristrips()
 	{
+		bool success = true;
 		mCurrentPrimitiveType = TRISTRIPS;
 		// check if there is at least one tristrip. If not, we will discard it.
 		if ( mCurrentFaceOrLineCount > 0 )
 		{
 			mCurrentMeshPrimitive->setFaceCount(mCurrentFaceOrLineCount);
-			mMesh->appendPrimitive(mCurrentMeshPrimitive);
+			success = appendMeshPrimitive(mCurrentMeshPrimitive);
 		}
 		else
 		{
@@ -1339,7 +1709,7 @@ namespace COLLADASaxFWL
 		initCurrentValues();
 		mMeshPrimitiveInputs.clearInputs();
 		mCurrentPrimitiveType = NONE;
-		return true;
+		return success;
 	}
 
 	//------------------------------
@@ -1361,11 +1731,12 @@ namespace COLLADASaxFWL
 	//------------------------------
 	bool MeshLoader::end__trifans()
 	{
+		bool success = true;
 		// check if there is at least one trifan. If not, we will discard it.
 		if ( mCurrentFaceOrLineCount > 0 )
 		{
 			mCurrentMeshPrimitive->setFaceCount(mCurrentFaceOrLineCount);
-			mMesh->appendPrimitive(mCurrentMeshPrimitive);
+			success = appendMeshPrimitive(mCurrentMeshPrimitive);
 		}
 		else
 		{
@@ -1374,7 +1745,7 @@ namespace COLLADASaxFWL
 		initCurrentValues();
 		mMeshPrimitiveInputs.clearInputs();
 		mCurrentPrimitiveType = NONE;
-		return true;
+		return success;
 	}
 
 	//------------------------------
@@ -1455,12 +1826,16 @@ namespace COLLADASaxFWL
 			}
 			break;
 		}
+
+		if ( mStreamMesh )
+			return writeStreamedVertexData();
 		return true;
 	}
 
 	//------------------------------
 	bool MeshLoader::end__p()
 	{
+		bool success = true;
 		mPOrPhElementCountOfCurrentPrimitive++;
 		switch ( mCurrentPrimitiveType )
 		{
@@ -1476,10 +1851,12 @@ namespace COLLADASaxFWL
                 if ( linesCount > 0 )
                 {
                     mCurrentMeshPrimitive->setFaceCount(linesCount);
-                    mMesh->appendPrimitive(mCurrentMeshPrimitive);
+                    success = appendMeshPrimitive(mCurrentMeshPrimitive);
                 }
                 else
                 {
+                    // all lines have been passed in chunks before
+                    finishMeshPrimitiveHash(mCurrentMeshPrimitive);
                     delete mCurrentMeshPrimitive;
                 }
                 initCurrentValues();
@@ -1612,7 +1989,7 @@ namespace COLLADASaxFWL
 			}
 			break;
 		}
-		return true;
+		return success;
 	}
 
 	//------------------------------
@@ -86,12 +86,17 @@ namespace COLLADASaxFWL
 		{
 			createAndWriteKinematicsScene();
 		}
+
+		if ( writer()->takesObjectOwnership() )
+		{
+			releaseWrittenObjects();
+		}
 	}
 
 	//-----------------------------
 	void PostProcessor::writeVisualScenes()
 	{
-		for ( size_t i = 0, count = mVisualScenes.size(); i < count; ++i)
+		for ( size_t i = 0, count = mVisualScenes.size() - mWrittenObjectCounts.visualScenes; i < count; ++i)
 		{
 			COLLADAFW::VisualScene *visualScene = mVisualScenes[i];
 			writer()->writeVisualScene(visualScene);
@@ -101,7 +106,7 @@ namespace COLLADASaxFWL
 	//-----------------------------
 	void PostProcessor::writeLibraryNodes()
 	{
-		for ( size_t i = 0, count = mLibraryNodes.size(); i < count; ++i)
+		for ( size_t i = 0, count = mLibraryNodes.size() - mWrittenObjectCounts.libraryNodes; i < count; ++i)
 		{
 			COLLADAFW::LibraryNodes *libraryNodes = mLibraryNodes[i];
 			writer()->writeLibraryNodes(libraryNodes);
@@ -111,7 +116,7 @@ namespace COLLADASaxFWL
 	//-----------------------------
 	void PostProcessor::writeEffects()
 	{
-		for ( size_t i = 0, count = mEffects.size(); i < count; ++i)
+		for ( size_t i = 0, count = mEffects.size() - mWrittenObjectCounts.effects; i < count; ++i)
 		{
 			COLLADAFW::Effect *effect = mEffects[i];
 			writer()->writeEffect(effect);
@@ -121,7 +126,7 @@ namespace COLLADASaxFWL
 	//-----------------------------
 	void PostProcessor::writeLights()
 	{
-		for ( size_t i = 0, count = mLights.size(); i < count; ++i)
+		for ( size_t i = 0, count = mLights.size() - mWrittenObjectCounts.lights; i < count; ++i)
 		{
 			COLLADAFW::Light *light = mLights[i];
 			writer()->writeLight(light);
@@ -131,7 +136,7 @@ namespace COLLADASaxFWL
 	//-----------------------------
 	void PostProcessor::writeCameras()
 	{
-		for ( size_t i = 0, count = mCameras.size(); i < count; ++i)
+		for ( size_t i = 0, count = mCameras.size() - mWrittenObjectCounts.cameras; i < count; ++i)
 		{
 			COLLADAFW::Camera *camera = mCameras[i];
 			writer()->writeCamera(camera);
@@ -251,7 +256,8 @@ namespace COLLADASaxFWL
 		formulasLinker.link();
 
 		writer()->writeFormulas(formulas);
-		FW_DELETE formulas;
+		if ( !writer()->takesObjectOwnership() )
+			FW_DELETE formulas;
 	}
 
 	//-----------------------------
@@ -260,7 +266,30 @@ namespace COLLADASaxFWL
 		KinematicsSceneCreator kinematicsSceneCreator( this );
 		COLLADAFW::KinematicsScene* kinematicsScene = kinematicsSceneCreator.createAndGetKinematicsScene();
 		writer()->writeKinematicsScene( kinematicsScene );
-		FW_DELETE kinematicsScene;
+		if ( !writer()->takesObjectOwnership() )
+			FW_DELETE kinematicsScene;
+	}
+
+	//-----------------------------
+	void PostProcessor::releaseWrittenObjects()
+	{
+		if ( (getObjectFlags() & Loader::EFFECT_FLAG) != 0 )
+			mEffects.clear();
+
+		if ( (getObjectFlags() & Loader::LIGHT_FLAG) != 0 )
+			mLights.clear();
+
+		if ( (getObjectFlags() & Loader::CAMERA_FLAG) != 0 )
+			mCameras.clear();
+
+		if ( (getObjectFlags() & Loader::VISUAL_SCENES_FLAG) != 0 )
+			mVisualScenes.clear();
+
+		if ( (getObjectFlags() & Loader::LIBRARY_NODES_FLAG) != 0 )
+			mLibraryNodes.clear();
+
+		if ( (getObjectFlags() & Loader::ANIMATION_LIST_FLAG) != 0 )
+			mUniqueIdAnimationListMap.clear();
 	}
 
 
@@ -66,6 +66,8 @@ namespace COLLADASaxFWL
 		if ( (getObjectFlags() & Loader::SCENE_FLAG) != 0 )
 		{
 			success = writer()->writeScene ( mCurrentScene );
+			if ( writer()->takesObjectOwnership() )
+				mCurrentScene = 0;
 		}
         delete mCurrentScene;
         finish();
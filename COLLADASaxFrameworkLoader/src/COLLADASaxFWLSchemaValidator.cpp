@@ -0,0 +1,295 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of COLLADASaxFrameworkLoader.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "COLLADASaxFWLStableHeaders.h"
+#include "COLLADASaxFWLSchemaValidator.h"
+#include "COLLADASaxFWLSaxParserErrorHandler.h"
+#include "COLLADASaxFWLSaxFWLError.h"
+#include "COLLADASaxFWLIErrorHandler.h"
+#include "COLLADASaxFWLColladaParserAutoGen14Private.h"
+#include "COLLADASaxFWLColladaParserAutoGen15Private.h"
+
+#include "GeneratedSaxParserUtils.h"
+
+#include "COLLADABUURI.h"
+
+#include <set>
+#include <map>
+#include <string.h>
+
+
+namespace COLLADASaxFWL
+{
+    const StringHash HASH_NAMESPACE_COLLADA_14 = 221035537;
+    const StringHash HASH_NAMESPACE_COLLADA_15 = 234671633;
+    const StringHash HASH_ELEMENT_COLLADA = 138479041;
+    const StringHash HASH_ATTRIBUTE_XMLNS = 8340307;
+
+#if defined(GENERATEDSAXPARSER_XMLPARSER_EXPAT)
+    extern size_t XMLPARSER_BUFFERSIZE;
+#endif
+
+    /**
+     * Accepts the elements not defined in the schema, i.e. the contents of extra/technique elements,
+     * as the ExtraDataElementHandler of the loader does, without passing them anywhere.
+     */
+    class IgnoreUnknownElementHandler : public GeneratedSaxParser::IUnknownElementHandler
+    {
+    public:
+        IgnoreUnknownElementHandler() {}
+        virtual ~IgnoreUnknownElementHandler() {}
+
+        virtual bool elementBegin( const ParserChar* elementName, const GeneratedSaxParser::xmlChar** attributes ) { return true; }
+        virtual bool elementEnd( const ParserChar* elementName ) { return true; }
+        virtual bool textData( const ParserChar* text, size_t textLength ) { return true; }
+    };
+
+    /**
+     * Parser that finds out the COLLADA version of the file, like the VersionParser does, and passes
+     * the file to the private parser of that version, with callbacks that do nothing.
+     * If references are checked, it stays between the sax parser and the private parser, to collect
+     * the ids and references of all elements.
+     */
+    class SchemaValidationParser : public GeneratedSaxParser::Parser
+    {
+    private:
+        typedef std::set<String> StringSet;
+
+        /** Maps a reference, that has not been resolved yet, to the line it has been found first in.*/
+        typedef std::map<String, size_t> StringLineMap;
+
+    private:
+        /** If true, the references are checked.*/
+        bool mCheckReferences;
+
+        /** The COLLADA version of the file.*/
+        COLLADAVersion mCOLLADAVersion;
+
+        /** The callbacks of the private parsers. They do nothing.*/
+        COLLADASaxFWL14::ColladaParserAutoGen14 mCallbacks14;
+        COLLADASaxFWL15::ColladaParserAutoGen15 mCallbacks15;
+
+        /** Handles the elements not defined in the schema.*/
+        IgnoreUnknownElementHandler mUnknownElementHandler;
+
+        /** The private parser of the COLLADA version of the file.*/
+        GeneratedSaxParser::Parser* mPrivateParser;
+
+        /** The ids of all elements parsed so far.*/
+        StringSet mIds;
+
+        /** The references, that have not been resolved yet.*/
+        StringLineMap mUnresolvedReferences;
+
+    public:
+        SchemaValidationParser( GeneratedSaxParser::IErrorHandler* errorHandler, bool checkReferences )
+            : GeneratedSaxParser::Parser( errorHandler )
+            , mCheckReferences( checkReferences )
+            , mCOLLADAVersion( COLLADA_UNKNOWN )
+            , mPrivateParser( 0 )
+        {
+        }
+
+        virtual ~SchemaValidationParser()
+        {
+            delete mPrivateParser;
+        }
+
+        COLLADAVersion getCOLLADAVersion() const { return mCOLLADAVersion; }
+
+        /** Passes the references, that could not be resolved, to @a errorHandler.*/
+        void reportUnresolvedReferences( IErrorHandler* errorHandler );
+
+        virtual bool elementBegin( const ParserChar* elementName, const ParserAttributes& attributes );
+
+        virtual bool elementEnd( const ParserChar* elementName )
+        {
+            return mPrivateParser ? mPrivateParser->elementEnd( elementName ) : true;
+        }
+
+        virtual bool textData( const ParserChar* text, size_t textLength )
+        {
+            return mPrivateParser ? mPrivateParser->textData( text, textLength ) : true;
+        }
+
+    private:
+        /** Disable default copy ctor. */
+        SchemaValidationParser( const SchemaValidationParser& pre );
+        /** Disable default assignment operator. */
+        const SchemaValidationParser& operator= ( const SchemaValidationParser& pre );
+
+        /** Returns the COLLADA version of the namespace declared in the attributes of the root element.*/
+        static COLLADAVersion getVersion( const ParserAttributes& attributes );
+
+        /** Adds the id and the references in @a attributes.*/
+        void collectReferences( const ParserAttributes& attributes );
+    };
+
+    //------------------------------
+    COLLADAVersion SchemaValidationParser::getVersion( const ParserAttributes& attributes )
+    {
+        const ParserChar** attributeArray = attributes.attributes;
+        if ( !attributeArray )
+            return COLLADA_UNKNOWN;
+
+        while ( *attributeArray )
+        {
+            StringHashPair hashPair = GeneratedSaxParser::Utils::calculateStringHashWithNamespace( *attributeArray++ );
+            const ParserChar* attributeValue = *attributeArray++;
+            if ( !attributeValue )
+                break;
+
+            StringHash prefix = hashPair.first;
+            StringHash name = hashPair.second;
+            if ( (prefix == 0 && name == HASH_ATTRIBUTE_XMLNS) || prefix == HASH_ATTRIBUTE_XMLNS )
+            {
+                StringHash attributeValueHash = GeneratedSaxParser::Utils::calculateStringHash( attributeValue );
+                if ( attributeValueHash == HASH_NAMESPACE_COLLADA_14 )
+                    return COLLADA_14;
+                if ( attributeValueHash == HASH_NAMESPACE_COLLADA_15 )
+                    return COLLADA_15;
+            }
+        }
+        return COLLADA_UNKNOWN;
+    }
+
+    //------------------------------
+    bool SchemaValidationParser::elementBegin( const ParserChar* elementName, const ParserAttributes& attributes )
+    {
+        if ( mPrivateParser )
+        {
+            collectReferences( attributes );
+            return mPrivateParser->elementBegin( elementName, attributes );
+        }
+
+        StringHashPair hashPair = GeneratedSaxParser::Utils::calculateStringHashWithNamespace( elementName );
+        if ( hashPair.second != HASH_ELEMENT_COLLADA )
+            return true;
+
+        mCOLLADAVersion = getVersion( attributes );
+        switch ( mCOLLADAVersion )
+        {
+        case COLLADA_14:
+            {
+                COLLADASaxFWL14::ColladaParserAutoGen14Private* privateParser = new COLLADASaxFWL14::ColladaParserAutoGen14Private( &mCallbacks14, getErrorHandler() );
+                privateParser->registerUnknownElementHandler( &mUnknownElementHandler );
+                mPrivateParser = privateParser;
+                break;
+            }
+        case COLLADA_15:
+            {
+                COLLADASaxFWL15::ColladaParserAutoGen15Private* privateParser = new COLLADASaxFWL15::ColladaParserAutoGen15Private( &mCallbacks15, getErrorHandler() );
+                privateParser->registerUnknownElementHandler( &mUnknownElementHandler );
+                mPrivateParser = privateParser;
+                break;
+            }
+        default:
+            return false;
+        }
+
+        // The private parser needs the sax parser to know the line numbers of the errors.
+        getSaxParser()->setParser( mPrivateParser );
+        if ( mCheckReferences )
+        {
+            // stay between the sax parser and the private parser
+            getSaxParser()->setParser( this );
+            collectReferences( attributes );
+        }
+
+        return mPrivateParser->elementBegin( elementName, attributes );
+    }
+
+    //------------------------------
+    void SchemaValidationParser::collectReferences( const ParserAttributes& attributes )
+    {
+        if ( !mCheckReferences || !attributes.attributes )
+            return;
+
+        const ParserChar** attributeArray = attributes.attributes;
+        while ( *attributeArray )
+        {
+            const ParserChar* attributeName = *attributeArray++;
+            const ParserChar* attributeValue = *attributeArray++;
+            if ( !attributeValue )
+                break;
+
+            if ( strcmp( attributeName, "id" ) == 0 )
+            {
+                String id( attributeValue );
+                mUnresolvedReferences.erase( id );
+                mIds.insert( id );
+            }
+            else if ( attributeValue[0] == '#' && attributeValue[1] != 0 )
+            {
+                // only references to elements in the same file are checked
+                String reference( COLLADABU::URI::uriDecode( attributeValue + 1 ) );
+                if ( mIds.find( reference ) == mIds.end() )
+                    mUnresolvedReferences.insert( std::make_pair( reference, getLineNumber() ) );
+            }
+        }
+    }
+
+    //------------------------------
+    void SchemaValidationParser::reportUnresolvedReferences( IErrorHandler* errorHandler )
+    {
+        if ( !errorHandler )
+            return;
+
+        for ( StringLineMap::const_iterator it = mUnresolvedReferences.begin(); it != mUnresolvedReferences.end(); ++it )
+        {
+            SaxFWLError error( SaxFWLError::ERROR_UNRESOLVED_REFERENCE, "Could not resolve reference \"#" + it->first + "\"." );
+            error.setLineNumber( it->second );
+            if ( errorHandler->handleError( &error ) )
+                break;
+        }
+    }
+
+    //------------------------------
+    SchemaValidator::SchemaValidator( IErrorHandler* errorHandler )
+        : mErrorHandler( errorHandler )
+        , mCheckReferences( false )
+        , mReadAheadBufferSize( 0 )
+        , mReadAheadBufferCount( 0 )
+        , mCOLLADAVersion( COLLADA_UNKNOWN )
+    {
+    }
+
+    //------------------------------
+    SchemaValidator::~SchemaValidator()
+    {
+    }
+
+    //------------------------------
+    bool SchemaValidator::validate( const String& fileName )
+    {
+        SaxParserErrorHandler saxParserErrorHandler( mErrorHandler );
+        SchemaValidationParser parser( &saxParserErrorHandler, mCheckReferences );
+
+        COLLADABU::URI fileUri( COLLADABU::URI::nativePathToUri( fileName ) );
+        String nativePath = fileUri.toNativePath();
+
+#if defined(GENERATEDSAXPARSER_XMLPARSER_NATIVE)
+        GeneratedSaxParser::NativeSaxParser saxParser( &parser );
+#elif defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
+        GeneratedSaxParser::LibxmlSaxParser saxParser( &parser );
+#elif defined(GENERATEDSAXPARSER_XMLPARSER_EXPAT)
+        GeneratedSaxParser::ExpatSaxParser saxParser( &parser, mReadAheadBufferCount ? mReadAheadBufferSize : XMLPARSER_BUFFERSIZE, mReadAheadBufferCount );
+#endif
+        bool success = saxParser.parseFile( nativePath.c_str() );
+
+        mCOLLADAVersion = parser.getCOLLADAVersion();
+
+        if ( success && (mCOLLADAVersion != COLLADA_UNKNOWN) )
+            parser.reportUnresolvedReferences( mErrorHandler );
+
+        return success;
+    }
+
+} // namespace COLLADASaxFWL
@@ -13,6 +13,7 @@
 #include "COLLADASaxFWLFileLoader.h"
 #include "COLLADASaxFWLRootParser14.h"
 #include "COLLADASaxFWLRootParser15.h"
+#include "COLLADASaxFWLElementIndexParser.h"
 
 #include "GeneratedSaxParserUtils.h"
 
@@ -22,6 +23,9 @@ namespace COLLADASaxFWL
     const StringHash HASH_NAMESPACE_COLLADA_15 = 234671633;
     const StringHash HASH_ELEMENT_COLLADA = 138479041;
     const StringHash HASH_ATTRIBUTE_XMLNS = 8340307;
+    const StringHash HASH_ELEMENT_ANIMATION = 3721230;
+    const StringHash HASH_ELEMENT_CONTROLLER = 194286738;
+    const StringHash HASH_ELEMENT_GEOMETRY = 207867209;
 
     size_t XMLPARSER_BUFFERSIZE = 64*1024;
 
@@ -279,6 +283,22 @@ namespace COLLADASaxFWL
                 }
             }
 
+            // The function map of the asset contains all elements an asset can be a child of. Remove 
+            // those of the libraries that are not required, to skip them entirely. This is what makes 
+            // the first pass of lazy loading cheap.
+            if ( (requiredFunctionMaps & COLLADA_LIBRARY_GEOMETRIES) == 0 )
+            {
+                functionMap.erase( HASH_ELEMENT_GEOMETRY );
+            }
+            if ( (requiredFunctionMaps & COLLADA_LIBRARY_CONTROLLERS) == 0 )
+            {
+                functionMap.erase( HASH_ELEMENT_CONTROLLER );
+            }
+            if ( (requiredFunctionMaps & COLLADA_LIBRARY_ANIMATIONS) == 0 )
+            {
+                functionMap.erase( HASH_ELEMENT_ANIMATION );
+            }
+
             parsedFlags = afterLoadParsedObjectFlags;
         }
     }
@@ -305,6 +325,8 @@ namespace COLLADASaxFWL
         , mParsedFlags( parsedFlags )
         , mPrivateParser14( 0 )
         , mPrivateParser15( 0 )
+        , mIndexElements( false )
+        , mElementIndexParser( 0 )
     {
 
     }
@@ -321,15 +343,24 @@ namespace COLLADASaxFWL
         const COLLADABU::URI& fileURI = mFileLoader->getFileUri();
         String nativePath = fileURI.toNativePath();
         const char* fileName = nativePath.c_str();
-#if defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
+#if defined(GENERATEDSAXPARSER_XMLPARSER_NATIVE)
+        GeneratedSaxParser::NativeSaxParser versionSaxParser( this );
+#elif defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
         GeneratedSaxParser::LibxmlSaxParser versionSaxParser( this );
 #elif defined(GENERATEDSAXPARSER_XMLPARSER_EXPAT)
-        GeneratedSaxParser::ExpatSaxParser versionSaxParser( this, XMLPARSER_BUFFERSIZE );
+        const Loader* loader = mFileLoader->getColladaLoader();
+        size_t readAheadBufferCount = loader->getReadAheadBufferCount();
+        GeneratedSaxParser::ExpatSaxParser versionSaxParser( this, readAheadBufferCount ? loader->getReadAheadBufferSize() : XMLPARSER_BUFFERSIZE, readAheadBufferCount );
 #endif
+        // only files can be indexed, since the indexed elements are read again from the file
+        mIndexElements = mFileLoader->getColladaLoader()->getLazyLoading();
+
         bool success = versionSaxParser.parseFile( fileName );
 
  //       mFileLoader->postProcess();
 
+        delete mElementIndexParser;
+        mElementIndexParser = 0;
         delete mPrivateParser14;
         delete mPrivateParser15;
 
@@ -345,7 +376,9 @@ namespace COLLADASaxFWL
         const COLLADABU::URI& uri = mFileLoader->getFileUri();
         const char* uriString = uri.originalStr().c_str();
 //        const char* uriString = uri.getURIString().c_str();
-#if defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
+#if defined(GENERATEDSAXPARSER_XMLPARSER_NATIVE)
+        GeneratedSaxParser::NativeSaxParser versionSaxParser( this );
+#elif defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
         GeneratedSaxParser::LibxmlSaxParser versionSaxParser( this );
 #elif defined(GENERATEDSAXPARSER_XMLPARSER_EXPAT)
         GeneratedSaxParser::ExpatSaxParser versionSaxParser( this, XMLPARSER_BUFFERSIZE );
@@ -443,6 +476,14 @@ namespace COLLADASaxFWL
 
         getSaxParser()->setParser( mPrivateParser14 );
 
+        if ( mIndexElements )
+        {
+            // stay between the sax parser and the private parser
+            mElementIndexParser = new ElementIndexParser( getErrorHandler(), mFileLoader->getColladaLoader(), mFileLoader->getFileUri(), mPrivateParser14 );
+            getSaxParser()->setParser( mElementIndexParser );
+            return mElementIndexParser->elementBegin( elementName, attributes );
+        }
+
         return mPrivateParser14->elementBegin( elementName, attributes );
     }
     //------------------------------
@@ -466,6 +507,14 @@ namespace COLLADASaxFWL
 
         getSaxParser()->setParser( mPrivateParser15 );
 
+        if ( mIndexElements )
+        {
+            // stay between the sax parser and the private parser
+            mElementIndexParser = new ElementIndexParser( getErrorHandler(), mFileLoader->getColladaLoader(), mFileLoader->getFileUri(), mPrivateParser15 );
+            getSaxParser()->setParser( mElementIndexParser );
+            return mElementIndexParser->elementBegin( elementName, attributes );
+        }
+
         return mPrivateParser15->elementBegin( elementName, attributes );
     }
 
@@ -10837,15 +10837,15 @@ bool ColladaParserAutoGen14Private::_data__data( const ParserChar* text, size_t
 #ifdef GENERATEDSAXPARSER_VALIDATION
     if ( mValidate )
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen14::data__data, 0, 0, 0);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen14::data__data, 0, 0, 0);
     }
     else
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen14::data__data);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen14::data__data);
     }
 #else
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen14::data__data);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen14::data__data);
     } // validation
 #endif
 
@@ -10883,16 +10883,16 @@ bool ColladaParserAutoGen14Private::_preEnd__data()
 #ifdef GENERATEDSAXPARSER_VALIDATION
     if ( mValidate )
     {
-bool returnValue = uint8DataEnd( &ColladaParserAutoGen14::data__data, 0, 0, 0 );
+bool returnValue = hexBinaryDataEnd( &ColladaParserAutoGen14::data__data, 0, 0, 0 );
         return returnValue;
     }
     else
     {
-return uint8DataEnd( &ColladaParserAutoGen14::data__data );
+return hexBinaryDataEnd( &ColladaParserAutoGen14::data__data );
     }
 #else
     {
-return uint8DataEnd( &ColladaParserAutoGen14::data__data );
+return hexBinaryDataEnd( &ColladaParserAutoGen14::data__data );
     } // validation
 #endif
 
@@ -27996,15 +27996,15 @@ bool ColladaParserAutoGen15Private::_data__binary__hex( const ParserChar* text,
 #ifdef GENERATEDSAXPARSER_VALIDATION
     if ( mValidate )
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen15::data__binary__hex, 0, 0, 0);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen15::data__binary__hex, 0, 0, 0);
     }
     else
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen15::data__binary__hex);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen15::data__binary__hex);
     }
 #else
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen15::data__binary__hex);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen15::data__binary__hex);
     } // validation
 #endif
 
@@ -28079,16 +28079,16 @@ bool ColladaParserAutoGen15Private::_preEnd__binary__hex()
 #ifdef GENERATEDSAXPARSER_VALIDATION
     if ( mValidate )
     {
-bool returnValue = uint8DataEnd( &ColladaParserAutoGen15::data__binary__hex, 0, 0, 0 );
+bool returnValue = hexBinaryDataEnd( &ColladaParserAutoGen15::data__binary__hex, 0, 0, 0 );
         return returnValue;
     }
     else
     {
-return uint8DataEnd( &ColladaParserAutoGen15::data__binary__hex );
+return hexBinaryDataEnd( &ColladaParserAutoGen15::data__binary__hex );
     }
 #else
     {
-return uint8DataEnd( &ColladaParserAutoGen15::data__binary__hex );
+return hexBinaryDataEnd( &ColladaParserAutoGen15::data__binary__hex );
     } // validation
 #endif
 
@@ -67510,15 +67510,15 @@ bool ColladaParserAutoGen15Private::_data__library_images__image__init_from__hex
 #ifdef GENERATEDSAXPARSER_VALIDATION
     if ( mValidate )
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen15::data__library_images__image__init_from__hex, 0, 0, 0);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen15::data__library_images__image__init_from__hex, 0, 0, 0);
     }
     else
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen15::data__library_images__image__init_from__hex);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen15::data__library_images__image__init_from__hex);
     }
 #else
     {
-return characterData2Uint8Data(text, textLength, &ColladaParserAutoGen15::data__library_images__image__init_from__hex);
+return characterData2HexBinaryData(text, textLength, &ColladaParserAutoGen15::data__library_images__image__init_from__hex);
     } // validation
 #endif
 
@@ -67598,16 +67598,16 @@ bool ColladaParserAutoGen15Private::_preEnd__library_images__image__init_from__h
 #ifdef GENERATEDSAXPARSER_VALIDATION
     if ( mValidate )
     {
-bool returnValue = uint8DataEnd( &ColladaParserAutoGen15::data__library_images__image__init_from__hex, 0, 0, 0 );
+bool returnValue = hexBinaryDataEnd( &ColladaParserAutoGen15::data__library_images__image__init_from__hex, 0, 0, 0 );
         return returnValue;
     }
     else
     {
-return uint8DataEnd( &ColladaParserAutoGen15::data__library_images__image__init_from__hex );
+return hexBinaryDataEnd( &ColladaParserAutoGen15::data__library_images__image__init_from__hex );
     }
 #else
     {
-return uint8DataEnd( &ColladaParserAutoGen15::data__library_images__image__init_from__hex );
+return hexBinaryDataEnd( &ColladaParserAutoGen15::data__library_images__image__init_from__hex );
     } // validation
 #endif
 
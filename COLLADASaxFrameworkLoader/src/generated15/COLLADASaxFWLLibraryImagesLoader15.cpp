@@ -89,6 +89,27 @@ return mLoader->data__data(data, length);
 }
 
 
+bool LibraryImagesLoader15::begin__library_images__image__init_from__hex( const COLLADASaxFWL15::library_images__image__init_from__hex__AttributeData& attributeData )
+{
+SaxVirtualFunctionTest15(begin__library_images__image__init_from__hex(attributeData));
+return mLoader->begin__data();
+}
+
+
+bool LibraryImagesLoader15::end__library_images__image__init_from__hex()
+{
+SaxVirtualFunctionTest15(end__library_images__image__init_from__hex());
+return mLoader->end__data();
+}
+
+
+bool LibraryImagesLoader15::data__library_images__image__init_from__hex( const uint8* data, size_t length )
+{
+SaxVirtualFunctionTest15(data__library_images__image__init_from__hex(data, length));
+return mLoader->data__data(data, length);
+}
+
+
 bool LibraryImagesLoader15::begin__technique____technique_type( const COLLADASaxFWL15::technique____technique_type__AttributeData& attributeData )
 {
 SaxVirtualFunctionTest15(begin__technique____technique_type(attributeData));
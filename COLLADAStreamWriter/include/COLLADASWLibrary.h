@@ -38,9 +38,15 @@ namespace COLLADASW
         This function must be called before the first geometry is added*/
         void openLibrary();
 
+        /** Tells the library, that its element has already been opened in the parent of the sub writer
+        it writes to, see StreamWriter::createSubWriter(). openLibrary() and closeLibrary() do nothing
+        afterwards, i.e. the elements of the library are written directly to the sub writer.*/
+        void setOpenedInParentWriter() { mOpenedInParentWriter = true; }
+
     private:
         TagCloser mLibraryCloser;    ///< Used to close the library  tag
         bool mLibraryOpen;      ///< true, if a library has been open and not closed. false otherwise.
+        bool mOpenedInParentWriter;     ///< true, if the library element has been opened in the parent of the stream writer.
         const String& mName;
 
 
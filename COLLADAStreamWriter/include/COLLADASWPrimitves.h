@@ -50,6 +50,12 @@ namespace COLLADASW
         /** List of the number in the @a \<vcount\> element*/
         VCountList mVCountList;
 
+        /** If true, the count attribute is written, when finish() is called.*/
+        bool mCountDeferred;
+
+        /** The count attribute, if mCountDeferred is true.*/
+        StreamWriter::DeferredAttribute mCountAttribute;
+
     public:
 
         /**
@@ -60,6 +66,7 @@ namespace COLLADASW
         : ElementWriter ( streamWriter )
         , mInputList ( streamWriter )
         , mPrimitiveName ( primitiveName )
+        , mCountDeferred ( false )
         {
             if ( strcmp(primitiveName.c_str(), mPrimitiveName.c_str() ) != 0)
             {
@@ -130,6 +137,21 @@ namespace COLLADASW
             return mCount;
         }
 
+        /** If @a countDeferred is true, the count attribute is written when finish() is called,
+        instead of prepareToAppendValues(). This allows to append primitives of unknown number and
+        call setCount() afterwards, before finish() is called. Must be called before
+        prepareToAppendValues().*/
+        void setCountDeferred ( bool countDeferred )
+        {
+            mCountDeferred = countDeferred;
+        }
+
+        /** Returns true, if the count attribute is written when finish() is called.*/
+        bool getCountDeferred() const
+        {
+            return mCountDeferred;
+        }
+
         /** Returns a reference to the list of all the inputs*/
         InputList& getInputList()
         {
@@ -205,8 +227,9 @@ namespace COLLADASW
         /** 
          * This function must be called after the last value has been added to 
          * the array and before another element has been opened
+         * @return False, if the deferred count attribute could not be written, true otherwise.
          */
-        void finish();
+        bool finish();
 
 	protected:
         /** 
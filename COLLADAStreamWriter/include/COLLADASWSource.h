@@ -54,12 +54,19 @@ namespace COLLADASW
         /** The list with the parameters. */
         ParameterNameList mParameterNameList;
 
+        /** If true, the count attribute of the array is written, when finish() is called.*/
+        bool mAccessorCountDeferred;
+
+        /** The count attribute of the array, if mAccessorCountDeferred is true.*/
+        StreamWriter::DeferredAttribute mArrayCountAttribute;
+
     public:
 
     	SourceBase ( StreamWriter* streamWriter ) 
             : ElementWriter ( streamWriter )
             , mAccessorCount (0)
             , mAccessorStride (0)
+            , mAccessorCountDeferred (false)
         {}
 
         /** Returns a reference to the id of the source*/
@@ -110,6 +117,21 @@ namespace COLLADASW
             mAccessorCount = accessorCount;
         }
 
+        /** Returns true, if the count attribute of the array is written when finish() is called.*/
+        bool getAccessorCountDeferred() const
+        {
+            return mAccessorCountDeferred;
+        }
+
+        /** If @a accessorCountDeferred is true, the count attribute of the array is written when
+        finish() is called, instead of prepareToAppendValues(). This allows to append values of
+        unknown number and call setAccessorCount() afterwards, before finish() is called. Must be
+        called before prepareToAppendValues().*/
+        void setAccessorCountDeferred ( bool accessorCountDeferred )
+        {
+            mAccessorCountDeferred = accessorCountDeferred;
+        }
+
         /** Returns the value of the stride attribute of the accessor*/
         unsigned long getAccessorStride() const
         {
@@ -136,8 +158,9 @@ namespace COLLADASW
         void prepareBaseToAppendValues ( const String* arrayName );
 
         /** This function must be called after the last value has been added to the array and before another
-        element has been opened*/
-        void finishBase ( const String* parameterTypeName, bool closeSourceElement=true );
+        element has been opened
+        @return False, if the deferred count attribute could not be written, true otherwise.*/
+        bool finishBase ( const String* parameterTypeName, bool closeSourceElement=true );
 
         /** Close the array element. */
         void closeArray();
@@ -218,10 +241,11 @@ namespace COLLADASW
          * This function must be called after the last value has been added to the array
          * and before another element has been opened.
          * @param closeSourceElement false, if we want to add some extra tags and close the element later.
+         * @return False, if the deferred count attribute could not be written, true otherwise.
          */
-        void finish ( bool closeSourceElement=true )
+        bool finish ( bool closeSourceElement=true )
         {
-            finishBase ( mParameterTypeName, closeSourceElement );
+            return finishBase ( mParameterTypeName, closeSourceElement );
         }
 
         /** Close the source element. */
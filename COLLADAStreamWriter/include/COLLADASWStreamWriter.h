@@ -16,6 +16,8 @@
 #include "COLLADASWPrerequisites.h"
 #include "COLLADASWColor.h"
 
+#include "CommonIBufferFlusher.h"
+
 #include <fstream>
 #include <stack>
 #include <list>
@@ -33,7 +35,7 @@ namespace COLLADABU
 
 namespace Common
 {
-	class FWriteBufferFlusher;
+	class MemoryBufferFlusher;
 	class CharacterBuffer;
 }
 
@@ -69,7 +71,30 @@ namespace COLLADASW
     };
 
 
-    /** A class to write a COLLADASW document directly to a file, without storing the data in an internal data model*/
+    /** A class to write a COLLADASW document directly to a file, without storing the data in an internal data model.
+
+    Independent elements, like the geometries of a library, can be written in parallel using sub writers.
+    A sub writer is created by createSubWriter() and writes into memory at the indentation level of the
+    element currently open in its parent. Each sub writer must be used by one thread only. The parent
+    must not be written to, while its sub writers are used. After all sub writers are finished, the
+    parent appends their contents with appendSubWriter(), in the order of the calls, which makes the
+    resulting file independent of the scheduling of the threads:
+    @code
+    library.openLibrary();
+    std::vector<StreamWriter*> subWriters( count );
+    for ( size_t i = 0; i < count; ++i )
+        subWriters[i] = streamWriter.createSubWriter();
+    #pragma omp parallel for
+    for ( ptrdiff_t i = 0; i < (ptrdiff_t)count; ++i )
+        writeGeometry( subWriters[i], i );
+    for ( size_t i = 0; i < count; ++i )
+    {
+        streamWriter.appendSubWriter( subWriters[i] );
+        delete subWriters[i];
+    }
+    library.closeLibrary();
+    @endcode
+    */
     class StreamWriter
     {
 	public:
@@ -78,6 +103,26 @@ namespace COLLADASW
 			COLLADA_1_4_1,
 			COLLADA_1_5_0
 		};
+
+		/** The default number of characters reserved for the value of a deferred attribute.*/
+		static const size_t DEFAULT_DEFERRED_ATTRIBUTE_WIDTH = 10;
+
+		/** Identifies an attribute, whose value is written after the contents of its element, see
+		appendDeferredAttribute().*/
+		struct DeferredAttribute
+		{
+			DeferredAttribute() : mMarkId( Common::IBufferFlusher::INVALID_ID ), mWidth( 0 ) {}
+
+			/** Returns true, if the space for the value has been reserved by appendDeferredAttribute().*/
+			bool isReserved() const { return mMarkId != Common::IBufferFlusher::INVALID_ID; }
+
+			/** The id of the mark set in the buffer flusher at the beginning of the value or
+			INVALID_ID, if no space has been reserved.*/
+			Common::IBufferFlusher::MarkId mMarkId;
+
+			/** The number of characters reserved for the value.*/
+			size_t mWidth;
+		};
     private:
 
         /** Contains information about an open tag*/
@@ -99,7 +144,11 @@ namespace COLLADASW
 		typedef std::deque<OpenTag> OpenTagStack;
 
     private:
-		Common::FWriteBufferFlusher* mBufferFlusher;
+		Common::IBufferFlusher* mBufferFlusher;
+
+		/** The flusher of a sub writer, i.e. the same object as mBufferFlusher. Null, if this is not a
+		sub writer.*/
+		Common::MemoryBufferFlusher* mMemoryBufferFlusher;
 
 		Common::CharacterBuffer* mCharacterBuffer;
 
@@ -116,6 +165,8 @@ namespace COLLADASW
 
 		static const int CHARACTERBUFFERSIZE;
 
+		static const int SUBWRITERBUFFERSIZE;
+
         static const String mWhiteSpaceString;
 
         friend class TagCloser;
@@ -133,6 +184,20 @@ namespace COLLADASW
         /** Closes all open tags and closes the stream*/
         ~StreamWriter();
 
+        /** Creates a sub writer, that writes into memory at the indentation level of the element
+        currently open, using the settings of this stream writer. The sub writer can be used in a
+        different thread, while this stream writer is not used. Its contents are added to this stream
+        writer by appendSubWriter(). The caller takes ownership of the sub writer.*/
+        StreamWriter* createSubWriter() const;
+
+        /** Closes all open tags of @a subWriter and appends its contents to this stream writer. The same
+        element must be open, as when @a subWriter has been created. @a subWriter is empty afterwards
+        and can be reused.*/
+        void appendSubWriter( StreamWriter* subWriter );
+
+        /** Returns true, if this stream writer has been created by createSubWriter().*/
+        bool isSubWriter() const { return mMemoryBufferFlusher != 0; }
+
         /** Writes the document start, including the opening @a \<COLLADASW\> element.
         This member must be called, before any other member function can be called.*/
         void startDocument();
@@ -164,6 +229,21 @@ namespace COLLADASW
         This function can only be called after openElement() before any content is written.*/
         void appendAttribute ( const String& name, const int value );
 
+        /** Adds the attribute @a name to the last opened element and reserves @a width characters for its
+        value, which is written later by setDeferredAttributeValue(). This allows to write the contents
+        of an element before its size is known, e.g. to write the values of an array in one pass and set
+        its count attribute afterwards.
+        This function can only be called after openElement() before any content is written.*/
+        DeferredAttribute appendDeferredAttribute ( const String& name, size_t width = DEFAULT_DEFERRED_ATTRIBUTE_WIDTH );
+
+        /** Writes @a value into the space reserved for @a attribute by appendDeferredAttribute(), right
+        aligned and padded with leading white spaces. This function must be called exactly once for each
+        deferred attribute. For a sub writer, it must be called before the sub writer is appended to its
+        parent.
+        @return False, if @a attribute has not been reserved, @a value does not fit into the reserved
+        space or the file could not be written, true otherwise.*/
+        bool setDeferredAttributeValue ( const DeferredAttribute& attribute, unsigned long value );
+
         /** Adds @a text to the COLLADASW file.
         No checks are performed, if @a text contains forbidden characters. */
         void appendText ( const String& text );
@@ -319,6 +399,15 @@ namespace COLLADASW
 
     private:
 
+        /** Creates a sub writer, that writes into memory at indentation level @a level.*/
+        StreamWriter ( size_t level, size_t indent, bool doublePrecision, COLLADAVersion cOLLADAVersion );
+
+        /** Disable default copy ctor. */
+        StreamWriter( const StreamWriter& pre );
+
+        /** Disable default assignment operator. */
+        const StreamWriter& operator= ( const StreamWriter& pre );
+
 		/** Closes all elements opened since the element with index @a elementIndex has been open, 
 		including the element itself. */
 		void closeElements( ElementIndexType elementIndex );
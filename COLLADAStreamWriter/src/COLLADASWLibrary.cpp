@@ -19,6 +19,7 @@ namespace COLLADASW
     Library::Library ( COLLADASW::StreamWriter *streamWriter, const String &name )
             : ElementWriter ( streamWriter ),
             mLibraryOpen ( false ),
+            mOpenedInParentWriter ( false ),
             mName ( name )
     {}
 
@@ -26,7 +27,7 @@ namespace COLLADASW
     //---------------------------------------------------------------
     void Library::openLibrary()
     {
-        if ( !mLibraryOpen )
+        if ( !mLibraryOpen && !mOpenedInParentWriter )
         {
             mLibraryCloser = mSW->openElement ( mName );
             mLibraryOpen = true;
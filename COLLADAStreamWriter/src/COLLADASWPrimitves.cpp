@@ -22,7 +22,10 @@ namespace COLLADASW
         if ( !mMaterial.empty() )
             mSW->appendAttribute ( CSWC::CSW_ATTRIBUTE_MATERIAL, mMaterial );
 
-        mSW->appendAttribute ( CSWC::CSW_ATTRIBUTE_COUNT, mCount );
+        if ( mCountDeferred )
+            mCountAttribute = mSW->appendDeferredAttribute ( CSWC::CSW_ATTRIBUTE_COUNT );
+        else
+            mSW->appendAttribute ( CSWC::CSW_ATTRIBUTE_COUNT, mCount );
 
         mInputList.add();
 
@@ -105,9 +108,15 @@ namespace COLLADASW
     }
 
     //---------------------------------------------------------------
-    void PrimitivesBase::finish()
+    bool PrimitivesBase::finish()
     {
+        // the count attribute has already been written, if the count has been deferred after
+        // prepareToAppendValues()
+        bool success = true;
+        if ( mCountDeferred && mCountAttribute.isReserved() )
+            success = mSW->setDeferredAttributeValue ( mCountAttribute, mCount );
         mPrimitiveCloser.close();
+        return success;
     }
 
 	void PrimitivesBase::CloseVCountAndOpenVElement()
@@ -23,17 +23,27 @@ namespace COLLADASW
             mSW->appendAttribute ( CSWC::CSW_ATTRIBUTE_NAME, mNodeName );
         mSW->openElement ( *arrayName );
         mSW->appendAttribute ( CSWC::CSW_ATTRIBUTE_ID, mArrayId );
-        mSW->appendAttribute ( CSWC::CSW_ATTRIBUTE_COUNT, mAccessorCount * mAccessorStride );
+        if ( mAccessorCountDeferred )
+            mArrayCountAttribute = mSW->appendDeferredAttribute ( CSWC::CSW_ATTRIBUTE_COUNT );
+        else
+            mSW->appendAttribute ( CSWC::CSW_ATTRIBUTE_COUNT, mAccessorCount * mAccessorStride );
     }
 
     //---------------------------------------------------------------
-    void SourceBase::finishBase ( const String* parameterTypeName, bool closeSourceElement )
+    bool SourceBase::finishBase ( const String* parameterTypeName, bool closeSourceElement )
     {
         closeArray();
 
+        // the count attribute has already been written, if the count has been deferred after
+        // prepareToAppendValues()
+        bool success = true;
+        if ( mAccessorCountDeferred && mArrayCountAttribute.isReserved() )
+            success = mSW->setDeferredAttributeValue ( mArrayCountAttribute, mAccessorCount * mAccessorStride );
+
         addBaseTechnique ( parameterTypeName );
 
         if ( closeSourceElement ) closeSource();
+        return success;
     }
 
     //---------------------------------------------------------------
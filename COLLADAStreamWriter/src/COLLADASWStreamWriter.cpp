@@ -17,6 +17,7 @@
 
 #include "CommonCharacterBuffer.h"
 #include "CommonFWriteBufferFlusher.h"
+#include "CommonMemoryBufferFlusher.h"
 
 #include <string>
 #include <fstream>
@@ -62,11 +63,13 @@ namespace COLLADASW
 
 	const int StreamWriter::FWRITEBUFFERSIZE = 1024*64;
 	const int StreamWriter::CHARACTERBUFFERSIZE = 1024*64*64;
+	const int StreamWriter::SUBWRITERBUFFERSIZE = 1024*64;
 
 
     //---------------------------------------------------------------
     StreamWriter::StreamWriter ( const NativeString & fileName, bool doublePrecision /*= false*/, COLLADAVersion cOLLADAVersion /*= COLLADA_1_4_1*/ )
             : mBufferFlusher( new Common::FWriteBufferFlusher(fileName.c_str(), FWRITEBUFFERSIZE))
+			, mMemoryBufferFlusher( 0 )
 			, mCharacterBuffer( new Common::CharacterBuffer(CHARACTERBUFFERSIZE, mBufferFlusher) )
 			, mLevel ( 0 )
             , mIndent ( 2 )
@@ -81,6 +84,19 @@ namespace COLLADASW
 		}
     }
 
+    //---------------------------------------------------------------
+    StreamWriter::StreamWriter ( size_t level, size_t indent, bool doublePrecision, COLLADAVersion cOLLADAVersion )
+            : mBufferFlusher( new Common::MemoryBufferFlusher() )
+			, mMemoryBufferFlusher( static_cast<Common::MemoryBufferFlusher*>(mBufferFlusher) )
+			, mCharacterBuffer( new Common::CharacterBuffer(SUBWRITERBUFFERSIZE, mBufferFlusher) )
+			, mLevel ( level )
+            , mIndent ( indent )
+            , mDoublePrecision (doublePrecision)
+			, mCOLLADAVersion(cOLLADAVersion)
+			, mNextElementIndex(0)
+    {
+    }
+
     //---------------------------------------------------------------
     StreamWriter::~StreamWriter()
     {
@@ -89,6 +105,32 @@ namespace COLLADASW
 		delete mBufferFlusher;
     }
 
+    //---------------------------------------------------------------
+    StreamWriter* StreamWriter::createSubWriter() const
+    {
+        return new StreamWriter ( mLevel, mIndent, mDoublePrecision, mCOLLADAVersion );
+    }
+
+    //---------------------------------------------------------------
+    void StreamWriter::appendSubWriter( StreamWriter* subWriter )
+    {
+        COLLADABU_ASSERT ( subWriter && subWriter->isSubWriter() && subWriter != this );
+
+        subWriter->endDocument();
+        COLLADABU_ASSERT ( subWriter->mLevel == mLevel );
+
+        subWriter->mCharacterBuffer->flushBuffer();
+        Common::MemoryBufferFlusher* subWriterFlusher = subWriter->mMemoryBufferFlusher;
+        size_t dataSize = subWriterFlusher->getDataSize();
+        if ( dataSize > 0 )
+        {
+            // the sub writer has written elements into the currently open element
+            prepareToAddContents();
+            appendString ( subWriterFlusher->getData(), dataSize );
+        }
+        subWriterFlusher->clear();
+    }
+
     //---------------------------------------------------------------
     void StreamWriter::startDocument()
     {
@@ -201,6 +243,50 @@ namespace COLLADASW
         appendChar ( '\"' );
     }
 
+    //---------------------------------------------------------------
+    StreamWriter::DeferredAttribute StreamWriter::appendDeferredAttribute ( const String &name, size_t width )
+    {
+        COLLADABU_ASSERT ( !mOpenTags.back().mHasContents );
+
+        appendChar ( ' ' );
+        appendNCNameString ( name );
+        appendChar ( '=' );
+        appendChar ( '\"' );
+
+        DeferredAttribute attribute;
+        attribute.mWidth = width;
+        mCharacterBuffer->startMark();
+        addWhiteSpace ( width );
+        attribute.mMarkId = mCharacterBuffer->endMark();
+
+        appendChar ( '\"' );
+        return attribute;
+    }
+
+    //---------------------------------------------------------------
+    bool StreamWriter::setDeferredAttributeValue ( const DeferredAttribute& attribute, unsigned long value )
+    {
+        if ( !attribute.isReserved() )
+            return false;
+
+        // the value is right aligned, as leading white spaces are ignored by xml schema integer types
+        String text ( attribute.mWidth, ' ' );
+        size_t pos = attribute.mWidth;
+        do
+        {
+            if ( pos == 0 )
+                return false;
+            text[--pos] = (char)( '0' + value % 10 );
+            value /= 10;
+        }
+        while ( value != 0 );
+
+        if ( !mCharacterBuffer->jumpToMark ( attribute.mMarkId ) )
+            return false;
+        bool success = mCharacterBuffer->copyToBuffer ( text.c_str(), text.length() );
+        return mCharacterBuffer->jumpToMark ( Common::IBufferFlusher::END_OF_STREAM ) && success;
+    }
+
     //---------------------------------------------------------------
     void StreamWriter::appendText ( const String &text )
     {
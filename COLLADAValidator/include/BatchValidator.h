@@ -0,0 +1,147 @@
+#ifndef ___BATCHVALIDATOR_H__
+#define ___BATCHVALIDATOR_H__
+
+#include "COLLADASaxFWLPrerequisites.h"
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+/** Validates a batch of files in one process. The files are validated concurrently, each one
+with its own loader and error handler, if the validator is built with OpenMP. The results can
+be written as JSON or CSV report.*/
+class BatchValidator
+{
+public:
+	/** The formats of the report.*/
+	enum ReportFormat
+	{
+		REPORT_JSON,
+		REPORT_CSV
+	};
+
+	/** The result of the validation of one file.*/
+	struct Result
+	{
+		/** The name of the file, as passed to the validator.*/
+		std::string fileName;
+
+		/** The COLLADA version of the file.*/
+		COLLADASaxFWL::COLLADAVersion version;
+
+		/** The number of schema validation errors.*/
+		size_t saxParserErrorCount;
+
+		/** The number of errors of the sax frame work loader.*/
+		size_t saxFWLErrorCount;
+
+		/** The number of references, that could not be resolved. Only counted in schema only
+		validation, if references are checked. Loading the file reports unresolved references as
+		errors of the sax frame work loader, which do not make the file invalid.*/
+		size_t unresolvedReferenceCount;
+
+		/** The message of the first error, empty if there is none.*/
+		std::string firstErrorMessage;
+
+		/** True, if the file could not be opened.*/
+		bool fileNotFound;
+
+		/** The time needed to validate the file, in seconds.*/
+		double seconds;
+
+		/** Returns true, if the file is valid against the COLLADA schema and, in schema only validation 
+		with reference checks, all references could be resolved.*/
+		bool isValid() const { return !fileNotFound && (saxParserErrorCount == 0) && (unresolvedReferenceCount == 0); }
+	};
+
+	typedef std::vector<Result> ResultList;
+
+private:
+	/** The files to validate and, after validate() has been called, their results.*/
+	ResultList mResults;
+
+	/** The number of threads used to validate the files. Zero uses one thread per processor.*/
+	int mThreadCount;
+
+	/** The time needed to validate all files, in seconds.*/
+	double mSeconds;
+
+	/** If true, the files are only validated against the schema, without loading them.*/
+	bool mSchemaOnly;
+
+	/** If true, the references are checked in schema only validation.*/
+	bool mCheckReferences;
+
+public:
+	BatchValidator();
+	virtual ~BatchValidator();
+
+	/** Sets the number of threads used to validate the files. Zero, the default, uses one thread
+	per processor. Without OpenMP the files are always validated one after another.*/
+	void setThreadCount( int threadCount ) { mThreadCount = threadCount; }
+
+	/** Returns the number of threads used to validate the files.*/
+	int getThreadCount() const { return mThreadCount; }
+
+	/** If set to true, the files are only validated against the schema, without loading them (see
+	COLLADASaxFWL::SchemaValidator). Default is false.*/
+	void setSchemaOnly( bool schemaOnly ) { mSchemaOnly = schemaOnly; }
+
+	/** If set to true, the references are checked in schema only validation. Default is false.*/
+	void setCheckReferences( bool checkReferences ) { mCheckReferences = checkReferences; }
+
+	/** Adds @a fileName to the files to validate.*/
+	void addFile( const std::string& fileName );
+
+	/** Adds the files listed in @a listFileName, one per line, to the files to validate. Empty lines
+	and lines starting with '#' are ignored.
+	@return False, if the list could not be read.*/
+	bool addFileList( const std::string& listFileName );
+
+	/** Adds all .dae files in @a directory and its sub directories to the files to validate.
+	@return False, if the directory could not be read.*/
+	bool addDirectory( const std::string& directory );
+
+	/** Returns the number of files to validate.*/
+	size_t getFileCount() const { return mResults.size(); }
+
+	/** Validates all added files.*/
+	void validate();
+
+	/** Returns the results of validate(), in the order the files have been added.*/
+	const ResultList& getResults() const { return mResults; }
+
+	/** Returns the number of files, that are not valid.*/
+	size_t getInvalidFileCount() const;
+
+	/** Writes the results of validate() in @a format to @a stream.*/
+	void writeReport( std::ostream& stream, ReportFormat format ) const;
+
+private:
+	/** Disable default copy ctor. */
+	BatchValidator( const BatchValidator& pre );
+	/** Disable default assignment operator. */
+	const BatchValidator& operator= ( const BatchValidator& pre );
+
+	/** Validates the file of @a result and stores the result in it.*/
+	void validateFile( Result& result ) const;
+
+	/** Returns a wall clock time in seconds.*/
+	static double getTime();
+
+	/** Returns the name of @a version, as used in the reports.*/
+	static const char* getVersionName( COLLADASaxFWL::COLLADAVersion version );
+
+	void writeJsonReport( std::ostream& stream ) const;
+
+	void writeCsvReport( std::ostream& stream ) const;
+
+	/** Writes @a text as JSON string literal.*/
+	static void writeJsonString( std::ostream& stream, const std::string& text );
+
+	/** Writes @a text as CSV field.*/
+	static void writeCsvField( std::ostream& stream, const std::string& text );
+
+};
+
+#endif // ___BATCHVALIDATOR_H__
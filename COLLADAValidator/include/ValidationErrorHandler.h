@@ -3,6 +3,8 @@
 
 #include "COLLADASaxFWLIErrorHandler.h"
 
+#include <string>
+
 class ValidationErrorHandler : public	COLLADASaxFWL::IErrorHandler
 {
 private:
@@ -10,8 +12,27 @@ private:
 	bool mHasHandledSaxFWLError;
 	bool mFileNotFound;
 
+	/** The number of handled errors of the sax parser, i.e. schema validation errors.*/
+	size_t mSaxParserErrorCount;
+
+	/** The number of handled errors of the sax frame work loader.*/
+	size_t mSaxFWLErrorCount;
+
+	/** The number of references, that could not be resolved. They are also counted as errors of
+	the sax frame work loader.*/
+	size_t mUnresolvedReferenceCount;
+
+	/** The message of the first handled error.*/
+	std::string mFirstErrorMessage;
+
+	/** True, if the errors are printed to std::cout.*/
+	bool mPrintErrors;
+
 public:
-	ValidationErrorHandler();
+	/** Constructor.
+	@param printErrors If false, the errors are only counted. This is used if several files are
+	validated concurrently.*/
+	ValidationErrorHandler( bool printErrors = true );
 	virtual ~ValidationErrorHandler();
 
 	bool virtual handleError(const COLLADASaxFWL::IError* error);
@@ -22,6 +43,14 @@ public:
 
 	bool getFileNotFound()const {return mFileNotFound; }
 
+	size_t getSaxParserErrorCount()const {return mSaxParserErrorCount; }
+
+	size_t getSaxFWLErrorCount()const {return mSaxFWLErrorCount; }
+
+	size_t getUnresolvedReferenceCount()const {return mUnresolvedReferenceCount; }
+
+	const std::string& getFirstErrorMessage()const {return mFirstErrorMessage; }
+
 private:
 	/** Disable default copy ctor. */
 	ValidationErrorHandler( const ValidationErrorHandler& pre );
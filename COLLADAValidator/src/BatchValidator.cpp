@@ -0,0 +1,362 @@
+#include "BatchValidator.h"
+#include "ValidationErrorHandler.h"
+#include "Writer.h"
+
+#include "COLLADASaxFWLLoader.h"
+#include "COLLADASaxFWLSchemaValidator.h"
+
+#include "COLLADAFWRoot.h"
+
+#include <fstream>
+#include <algorithm>
+
+#ifdef _OPENMP
+#	include <omp.h>
+#endif
+
+#ifdef WIN32
+#	include <windows.h>
+#else
+#	include <sys/time.h>
+#	include <sys/types.h>
+#	include <sys/stat.h>
+#	include <dirent.h>
+#endif
+
+
+//--------------------------------------------------------------------
+// Returns true, if @a fileName has the extension ".dae", ignoring the case.
+static bool hasColladaExtension( const std::string& fileName )
+{
+	if ( fileName.length() < 4 )
+		return false;
+	std::string extension = fileName.substr( fileName.length() - 4 );
+	std::transform( extension.begin(), extension.end(), extension.begin(), ::tolower );
+	return extension == ".dae";
+}
+
+//--------------------------------------------------------------------
+BatchValidator::BatchValidator()
+	: mThreadCount(0)
+	, mSeconds(0)
+	, mSchemaOnly(false)
+	, mCheckReferences(false)
+{
+}
+
+//--------------------------------------------------------------------
+BatchValidator::~BatchValidator()
+{
+}
+
+//--------------------------------------------------------------------
+void BatchValidator::addFile( const std::string& fileName )
+{
+	Result result;
+	result.fileName = fileName;
+	result.version = COLLADASaxFWL::COLLADA_UNKNOWN;
+	result.saxParserErrorCount = 0;
+	result.saxFWLErrorCount = 0;
+	result.unresolvedReferenceCount = 0;
+	result.fileNotFound = false;
+	result.seconds = 0;
+	mResults.push_back( result );
+}
+
+//--------------------------------------------------------------------
+bool BatchValidator::addFileList( const std::string& listFileName )
+{
+	std::ifstream listFile( listFileName.c_str() );
+	if ( !listFile )
+		return false;
+
+	std::string line;
+	while ( std::getline( listFile, line ) )
+	{
+		// also accept lists written on windows
+		if ( !line.empty() && line[line.length() - 1] == '\r' )
+			line.erase( line.length() - 1 );
+		if ( line.empty() || line[0] == '#' )
+			continue;
+		addFile( line );
+	}
+	return true;
+}
+
+//--------------------------------------------------------------------
+bool BatchValidator::addDirectory( const std::string& directory )
+{
+	std::vector<std::string> fileNames;
+	std::vector<std::string> subDirectories;
+
+#ifdef WIN32
+	WIN32_FIND_DATAA findData;
+	HANDLE findHandle = FindFirstFileA( (directory + "\\*").c_str(), &findData );
+	if ( findHandle == INVALID_HANDLE_VALUE )
+		return false;
+	do
+	{
+		std::string name = findData.cFileName;
+		if ( name == "." || name == ".." )
+			continue;
+		std::string path = directory + "\\" + name;
+		if ( findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY )
+			subDirectories.push_back( path );
+		else if ( hasColladaExtension( name ) )
+			fileNames.push_back( path );
+	}
+	while ( FindNextFileA( findHandle, &findData ) );
+	FindClose( findHandle );
+#else
+	DIR* dir = opendir( directory.c_str() );
+	if ( !dir )
+		return false;
+	while ( dirent* entry = readdir( dir ) )
+	{
+		std::string name = entry->d_name;
+		if ( name == "." || name == ".." )
+			continue;
+		std::string path = directory + "/" + name;
+		struct stat status;
+		if ( stat( path.c_str(), &status ) != 0 )
+			continue;
+		if ( S_ISDIR( status.st_mode ) )
+			subDirectories.push_back( path );
+		else if ( hasColladaExtension( name ) )
+			fileNames.push_back( path );
+	}
+	closedir( dir );
+#endif
+
+	// the order of the directory entries is not defined, sort them to get reproducible reports
+	std::sort( fileNames.begin(), fileNames.end() );
+	std::sort( subDirectories.begin(), subDirectories.end() );
+
+	for ( size_t i = 0; i < fileNames.size(); ++i )
+		addFile( fileNames[i] );
+	for ( size_t i = 0; i < subDirectories.size(); ++i )
+		addDirectory( subDirectories[i] );
+	return true;
+}
+
+//--------------------------------------------------------------------
+void BatchValidator::validate()
+{
+	double startTime = getTime();
+
+	if ( !mResults.empty() )
+	{
+		// The first file is validated alone, to initialize the static data of the parser
+		// libraries, i.e. of libxml and the compiled patterns, before the threads share it.
+		validateFile( mResults[0] );
+
+		const ptrdiff_t fileCount = (ptrdiff_t)mResults.size();
+#ifdef _OPENMP
+		int threadCount = mThreadCount > 0 ? mThreadCount : omp_get_num_procs();
+#pragma omp parallel for schedule(dynamic, 1) num_threads(threadCount)
+#endif
+		for ( ptrdiff_t i = 1; i < fileCount; ++i )
+		{
+			validateFile( mResults[i] );
+		}
+	}
+
+	mSeconds = getTime() - startTime;
+}
+
+//--------------------------------------------------------------------
+void BatchValidator::validateFile( Result& result ) const
+{
+	double startTime = getTime();
+
+	ValidationErrorHandler errorHandler( false );
+	if ( mSchemaOnly )
+	{
+		COLLADASaxFWL::SchemaValidator schemaValidator( &errorHandler );
+		schemaValidator.setCheckReferences( mCheckReferences );
+		schemaValidator.validate( result.fileName );
+		result.version = schemaValidator.getCOLLADAVersion();
+		if ( mCheckReferences )
+			result.unresolvedReferenceCount = errorHandler.getUnresolvedReferenceCount();
+	}
+	else
+	{
+		COLLADASaxFWL::Loader loader( &errorHandler );
+		::Writer writer;
+		COLLADAFW::Root root( &loader, &writer );
+
+		root.loadDocument( result.fileName );
+		result.version = loader.getCOLLADAVersion();
+	}
+
+	result.saxParserErrorCount = errorHandler.getSaxParserErrorCount();
+	result.saxFWLErrorCount = errorHandler.getSaxFWLErrorCount();
+	result.firstErrorMessage = errorHandler.getFirstErrorMessage();
+	result.fileNotFound = errorHandler.getFileNotFound();
+	result.seconds = getTime() - startTime;
+}
+
+//--------------------------------------------------------------------
+size_t BatchValidator::getInvalidFileCount() const
+{
+	size_t invalidFileCount = 0;
+	for ( ResultList::const_iterator it = mResults.begin(); it != mResults.end(); ++it )
+	{
+		if ( !it->isValid() )
+			++invalidFileCount;
+	}
+	return invalidFileCount;
+}
+
+//--------------------------------------------------------------------
+double BatchValidator::getTime()
+{
+#ifdef WIN32
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+	QueryPerformanceFrequency( &frequency );
+	QueryPerformanceCounter( &counter );
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	timeval time;
+	gettimeofday( &time, 0 );
+	return (double)time.tv_sec + (double)time.tv_usec * 1e-6;
+#endif
+}
+
+//--------------------------------------------------------------------
+const char* BatchValidator::getVersionName( COLLADASaxFWL::COLLADAVersion version )
+{
+	switch ( version )
+	{
+	case COLLADASaxFWL::COLLADA_14:
+		return "1.4.1";
+	case COLLADASaxFWL::COLLADA_15:
+		return "1.5.0";
+	default:
+		return "unknown";
+	}
+}
+
+//--------------------------------------------------------------------
+void BatchValidator::writeReport( std::ostream& stream, ReportFormat format ) const
+{
+	switch ( format )
+	{
+	case REPORT_JSON:
+		writeJsonReport( stream );
+		break;
+	case REPORT_CSV:
+		writeCsvReport( stream );
+		break;
+	}
+}
+
+//--------------------------------------------------------------------
+void BatchValidator::writeJsonReport( std::ostream& stream ) const
+{
+	stream << "{" << std::endl;
+	stream << "\t\"fileCount\": " << mResults.size() << "," << std::endl;
+	stream << "\t\"invalidFileCount\": " << getInvalidFileCount() << "," << std::endl;
+	stream << "\t\"seconds\": " << mSeconds << "," << std::endl;
+	stream << "\t\"files\": [";
+
+	for ( ResultList::const_iterator it = mResults.begin(); it != mResults.end(); ++it )
+	{
+		const Result& result = *it;
+		stream << (it == mResults.begin() ? "" : ",") << std::endl;
+		stream << "\t\t{ \"file\": ";
+		writeJsonString( stream, result.fileName );
+		stream << ", \"valid\": " << (result.isValid() ? "true" : "false");
+		stream << ", \"version\": \"" << getVersionName( result.version ) << "\"";
+		stream << ", \"schemaErrors\": " << result.saxParserErrorCount;
+		stream << ", \"loaderErrors\": " << result.saxFWLErrorCount;
+		stream << ", \"unresolvedReferences\": " << result.unresolvedReferenceCount;
+		stream << ", \"fileNotFound\": " << (result.fileNotFound ? "true" : "false");
+		stream << ", \"seconds\": " << result.seconds;
+		stream << ", \"firstError\": ";
+		writeJsonString( stream, result.firstErrorMessage );
+		stream << " }";
+	}
+
+	stream << std::endl << "\t]" << std::endl;
+	stream << "}" << std::endl;
+}
+
+//--------------------------------------------------------------------
+void BatchValidator::writeCsvReport( std::ostream& stream ) const
+{
+	stream << "file,valid,version,schema_errors,loader_errors,unresolved_references,file_not_found,seconds,first_error" << std::endl;
+
+	for ( ResultList::const_iterator it = mResults.begin(); it != mResults.end(); ++it )
+	{
+		const Result& result = *it;
+		writeCsvField( stream, result.fileName );
+		stream << "," << (result.isValid() ? 1 : 0);
+		stream << "," << getVersionName( result.version );
+		stream << "," << result.saxParserErrorCount;
+		stream << "," << result.saxFWLErrorCount;
+		stream << "," << result.unresolvedReferenceCount;
+		stream << "," << (result.fileNotFound ? 1 : 0);
+		stream << "," << result.seconds;
+		stream << ",";
+		writeCsvField( stream, result.firstErrorMessage );
+		stream << std::endl;
+	}
+}
+
+//--------------------------------------------------------------------
+void BatchValidator::writeJsonString( std::ostream& stream, const std::string& text )
+{
+	static const char hexDigits[] = "0123456789abcdef";
+
+	stream << '"';
+	for ( std::string::const_iterator it = text.begin(); it != text.end(); ++it )
+	{
+		unsigned char c = (unsigned char)*it;
+		switch ( c )
+		{
+		case '"':
+			stream << "\\\"";
+			break;
+		case '\\':
+			stream << "\\\\";
+			break;
+		case '\n':
+			stream << "\\n";
+			break;
+		case '\r':
+			stream << "\\r";
+			break;
+		case '\t':
+			stream << "\\t";
+			break;
+		default:
+			if ( c < 0x20 )
+				stream << "\\u00" << hexDigits[c >> 4] << hexDigits[c & 0xf];
+			else
+				stream << (char)c;
+			break;
+		}
+	}
+	stream << '"';
+}
+
+//--------------------------------------------------------------------
+void BatchValidator::writeCsvField( std::ostream& stream, const std::string& text )
+{
+	if ( text.find_first_of( ",\"\r\n" ) == std::string::npos )
+	{
+		stream << text;
+		return;
+	}
+
+	stream << '"';
+	for ( std::string::const_iterator it = text.begin(); it != text.end(); ++it )
+	{
+		if ( *it == '"' )
+			stream << '"';
+		stream << *it;
+	}
+	stream << '"';
+}
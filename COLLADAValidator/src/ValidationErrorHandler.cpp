@@ -10,10 +10,14 @@
 #include <string.h>
 
 //--------------------------------------------------------------------
-ValidationErrorHandler::ValidationErrorHandler()
+ValidationErrorHandler::ValidationErrorHandler( bool printErrors )
 	: mHasHandledSaxParserError(false)
 	, mHasHandledSaxFWLError(false)
 	, mFileNotFound(false)
+	, mSaxParserErrorCount(0)
+	, mSaxFWLErrorCount(0)
+	, mUnresolvedReferenceCount(0)
+	, mPrintErrors(printErrors)
 {
 }
 
@@ -53,14 +57,24 @@ bool ValidationErrorHandler::handleError( const COLLADASaxFWL::IError* error )
 			mFileNotFound = true;
 		}
 
-		std::cout << "Schema validation error: " << parserError.getErrorMessage() << std::endl;
+		if ( mPrintErrors )
+			std::cout << "Schema validation error: " << parserError.getErrorMessage() << std::endl;
+		if ( mFirstErrorMessage.empty() )
+			mFirstErrorMessage = parserError.getErrorMessage();
 		mHasHandledSaxParserError = true;
+		++mSaxParserErrorCount;
 	}
 	else if ( error->getErrorClass() == COLLADASaxFWL::IError::ERROR_SAXFWL )
 	{
 		COLLADASaxFWL::SaxFWLError* saxFWLError = (COLLADASaxFWL::SaxFWLError*) error;
-		std::cout << "Sax FWL Error: " << saxFWLError->getErrorMessage() << std::endl;
+		if ( mPrintErrors )
+			std::cout << "Sax FWL Error: " << saxFWLError->getErrorMessage() << std::endl;
+		if ( mFirstErrorMessage.empty() )
+			mFirstErrorMessage = saxFWLError->getErrorMessage();
 		mHasHandledSaxFWLError = true;
+		++mSaxFWLErrorCount;
+		if ( saxFWLError->getErrorType() == COLLADASaxFWL::SaxFWLError::ERROR_UNRESOLVED_REFERENCE )
+			++mUnresolvedReferenceCount;
 	}
 	return false;
 }
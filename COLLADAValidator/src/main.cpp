@@ -1,11 +1,16 @@
 #include "../include/Writer.h"
 
 #include <iostream>
+#include <fstream>
 #include <string>
+#include <stdlib.h>
+#include <string.h>
 
 #include "ValidationErrorHandler.h"
+#include "BatchValidator.h"
 
 #include "COLLADASaxFWLLoader.h"
+#include "COLLADASaxFWLSchemaValidator.h"
 
 #include "GeneratedSaxParserCoutErrorHandler.h"
 
@@ -38,20 +43,142 @@ void parse(char* fileName, ValidationErrorHandler& errorHandler)
 	version = loader.getCOLLADAVersion();
 }
 
+void parseSchemaOnly(char* fileName, ValidationErrorHandler& errorHandler, bool checkReferences)
+{
+	COLLADASaxFWL::SchemaValidator schemaValidator(&errorHandler);
+	schemaValidator.setCheckReferences(checkReferences);
+
+	schemaValidator.validate(fileName);
+	version = schemaValidator.getCOLLADAVersion();
+}
+
 void printHelpText()
 {
 	std::cout << "Version 1.1.3" << std::endl;
-	std::cout << "Usage: " << programName << " <filename>." << std::endl;
+	std::cout << "Usage: " << programName << " [-schemaonly [-references]] <filename>." << std::endl;
+	std::cout << "       " << programName << " -batch [-schemaonly [-references]] [-threads <count>] [-format json|csv]" << std::endl;
+	std::cout << "           [-report <reportfile>] [-list <listfile>] [<filename or directory> ...]" << std::endl;
+	std::cout << "  -schemaonly  Only validate against the schema, without loading the file. This is faster and" << std::endl;
+	std::cout << "               needs less memory." << std::endl;
+	std::cout << "  -references  Check that references to elements in the same file can be resolved." << std::endl;
+	std::cout << "  -batch       Validate all passed files, all .dae files in the passed directories and all" << std::endl;
+	std::cout << "               files listed in the list files (one per line) and write a report." << std::endl;
+	std::cout << "  -threads     The number of files validated concurrently, default is one per processor." << std::endl;
+	std::cout << "  -format      The format of the report, default is json." << std::endl;
+	std::cout << "  -report      The file to write the report to, default is stdout." << std::endl;
+}
+
+int validateBatch(int argc, char* argv[])
+{
+	BatchValidator batchValidator;
+	BatchValidator::ReportFormat reportFormat = BatchValidator::REPORT_JSON;
+	const char* reportFileName = 0;
+
+	for ( int i = 2; i < argc; ++i )
+	{
+		const char* argument = argv[i];
+		bool hasValue = (i + 1) < argc;
+
+		if ( strcmp(argument, "-schemaonly") == 0 )
+		{
+			batchValidator.setSchemaOnly(true);
+		}
+		else if ( strcmp(argument, "-references") == 0 )
+		{
+			batchValidator.setCheckReferences(true);
+		}
+		else if ( strcmp(argument, "-threads") == 0 && hasValue )
+		{
+			batchValidator.setThreadCount( atoi(argv[++i]) );
+		}
+		else if ( strcmp(argument, "-format") == 0 && hasValue )
+		{
+			const char* format = argv[++i];
+			if ( strcmp(format, "json") == 0 )
+				reportFormat = BatchValidator::REPORT_JSON;
+			else if ( strcmp(format, "csv") == 0 )
+				reportFormat = BatchValidator::REPORT_CSV;
+			else
+			{
+				printHelpText();
+				return -2;
+			}
+		}
+		else if ( strcmp(argument, "-report") == 0 && hasValue )
+		{
+			reportFileName = argv[++i];
+		}
+		else if ( strcmp(argument, "-list") == 0 && hasValue )
+		{
+			const char* listFileName = argv[++i];
+			if ( !batchValidator.addFileList(listFileName) )
+			{
+				std::cerr << "Could not read file list \"" << listFileName << "\"." << std::endl;
+				return -2;
+			}
+		}
+		else if ( argument[0] == '-' )
+		{
+			printHelpText();
+			return -2;
+		}
+		else if ( !batchValidator.addDirectory(argument) )
+		{
+			// not a directory, validate it as file
+			batchValidator.addFile(argument);
+		}
+	}
+
+	batchValidator.validate();
+
+	if ( reportFileName )
+	{
+		std::ofstream reportFile(reportFileName);
+		if ( !reportFile )
+		{
+			std::cerr << "Could not write report \"" << reportFileName << "\"." << std::endl;
+			return -2;
+		}
+		batchValidator.writeReport(reportFile, reportFormat);
+	}
+	else
+	{
+		batchValidator.writeReport(std::cout, reportFormat);
+	}
+
+	return batchValidator.getInvalidFileCount() == 0 ? 0 : -1;
 }
 
 
 int main(int argc, char* argv[]) 
 {
-	if ( argc > 1 ) 
+	if ( argc > 1 && strcmp(argv[1], "-batch") == 0 )
 	{
+		return validateBatch(argc, argv);
+	}
+
+	bool schemaOnly = false;
+	bool checkReferences = false;
+	int fileNameIndex = 1;
+	for ( ; fileNameIndex < argc - 1; ++fileNameIndex )
+	{
+		if ( strcmp(argv[fileNameIndex], "-schemaonly") == 0 )
+			schemaOnly = true;
+		else if ( strcmp(argv[fileNameIndex], "-references") == 0 )
+			checkReferences = true;
+		else
+			break;
+	}
+
+	if ( fileNameIndex < argc ) 
+	{
+		char* fileName = argv[fileNameIndex];
 		ValidationErrorHandler errorHandler;
 
-		parse( argv[1], errorHandler);
+		if ( schemaOnly )
+			parseSchemaOnly( fileName, errorHandler, checkReferences);
+		else
+			parse( fileName, errorHandler);
 
 		if ( errorHandler.getFileNotFound() )
 		{
@@ -59,13 +186,15 @@ int main(int argc, char* argv[])
 			return -2;
 		} 
 		
-		if ( errorHandler.hasHandledSaxParserError() )
+		// unresolved references reported while loading the file do not make it invalid
+		bool hasUnresolvedReferences = schemaOnly && checkReferences && (errorHandler.getUnresolvedReferenceCount() != 0);
+		if ( errorHandler.hasHandledSaxParserError() || hasUnresolvedReferences )
 		{
 			return -1;
 		}
 		else
 		{
-			std::cout << "\"" << argv[1]<< "\" is valid against the COLLADA ";
+			std::cout << "\"" << fileName << "\" is valid against the COLLADA ";
 			switch ( version )
 			{
 			case COLLADASaxFWL::COLLADA_14:
@@ -14,12 +14,14 @@
 
 // This header includes all headers needed to use this library.
 // note: you have to set one of these preprocessor flags:
+// - GENERATEDSAXPARSER_XMLPARSER_NATIVE
 // - GENERATEDSAXPARSER_XMLPARSER_LIBXML
 // - GENERATEDSAXPARSER_XMLPARSER_EXPAT
 #include "GeneratedSaxParserPrerequisites.h"
 #include "GeneratedSaxParserStackMemoryManager.h"
 #include "GeneratedSaxParserTypes.h"
 #include "GeneratedSaxParserUtils.h"
+#include "GeneratedSaxParserStringTable.h"
 #include "GeneratedSaxParserIErrorHandler.h"
 #include "GeneratedSaxParserCoutErrorHandler.h"
 #include "GeneratedSaxParserIUnknownElementHandler.h"
@@ -28,7 +30,9 @@
 #include "GeneratedSaxParserParserError.h"
 #include "GeneratedSaxParserParser.h"
 #include "GeneratedSaxParserSaxParser.h"
-#if defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
+#if defined(GENERATEDSAXPARSER_XMLPARSER_NATIVE)
+#include "GeneratedSaxParserNativeSaxParser.h"
+#elif defined(GENERATEDSAXPARSER_XMLPARSER_LIBXML)
 #include "GeneratedSaxParserLibxmlSaxParser.h"
 #elif defined(GENERATEDSAXPARSER_XMLPARSER_EXPAT)
 #include "GeneratedSaxParserExpatSaxParser.h"
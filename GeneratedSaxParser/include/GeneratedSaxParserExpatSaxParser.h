@@ -13,6 +13,7 @@
 #include "GeneratedSaxParserPrerequisites.h"
 #include "GeneratedSaxParserSaxParser.h"
 
+#include <stdio.h>
 
 
 struct XML_ParserStruct;
@@ -32,8 +33,19 @@ namespace GeneratedSaxParser
 		XML_Parser mParser;
 		size_t mBufferSize;
 
+		/** The number of chunks of size mBufferSize, a reader thread reads into the file system cache ahead
+		of the parser in parseFile(). If zero, or if the file is not larger than all these chunks together,
+		the file is only read by the parser.*/
+		size_t mReadAheadBufferCount;
+
 	public:
-		ExpatSaxParser(Parser* parser, size_t bufferSize);
+		/** Constructor.
+		@param bufferSize The size of the chunks the file is read in.
+		@param readAheadBufferCount If not zero, parseFile() reads files larger than @a readAheadBufferCount
+		chunks in a separate thread into the file system cache, up to @a readAheadBufferCount chunks ahead of
+		the parser. In any case the parser reads the file directly into the buffer of expat. Ignored on 
+		platforms without thread support.*/
+		ExpatSaxParser(Parser* parser, size_t bufferSize, size_t readAheadBufferCount = 0);
 		virtual ~ExpatSaxParser();
 
 		bool parseFile(const char* fileName);
@@ -41,6 +53,7 @@ namespace GeneratedSaxParser
 
 		size_t getLineNumer()const;
 		size_t getColumnNumer()const;
+		size_t getByteOffset()const;
 
 	private:
 		/** Disable default copy ctor. */
@@ -53,6 +66,19 @@ namespace GeneratedSaxParser
 
 		static void characters( void* user_data, const XML_Char* name, int length );
 
+		/** Creates mParser and sets the handlers.*/
+		void createParser();
+
+		/** Returns true, if @a file is larger than @a size bytes or if its size cannot be determined. 
+		Afterwards @a file is positioned at its beginning.*/
+		static bool isLargerThan( FILE* file, size_t size );
+
+		/** Reads and parses @a file in the calling thread.*/
+		bool parseFileSynchronous( FILE* file );
+
+		/** Reads and parses @a file in the calling thread, while a reader thread reads the following chunks
+		of @a file into the file system cache.*/
+		bool parseFileReadAhead( FILE* file );
 
 		void abortParsing();
 
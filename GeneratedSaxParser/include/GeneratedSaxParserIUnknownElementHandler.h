@@ -29,6 +29,18 @@ namespace GeneratedSaxParser
         virtual bool elementEnd(const ParserChar* elementName) = 0;
         virtual bool textData(const ParserChar* text, size_t textLength) = 0;
 
+        /** Called after elementBegin() for an unknown element, that is not nested in another unknown
+        element. If it returns true, sax parsers that support it (the NativeSaxParser) pass the contents
+        of the element unparsed to rawContents() instead of calling elementBegin(), elementEnd() and
+        textData() for them. Other sax parsers call these methods as usual, i.e. they still have to be
+        implemented. Skipping the contents this way is much faster than parsing them.*/
+        virtual bool wantsRawContents() { return false; }
+
+        /** Receives the unparsed contents of an unknown element, as requested by wantsRawContents(), i.e.
+        a view of the original document. @a contents is not null terminated and only valid during
+        the call.*/
+        virtual bool rawContents(const ParserChar* contents, size_t length) { return true; }
+
 	private:
 		/** Disable default copy ctor. */
 		IUnknownElementHandler( const IUnknownElementHandler& pre );
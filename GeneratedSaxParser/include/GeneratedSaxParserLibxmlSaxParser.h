@@ -38,6 +38,7 @@ namespace GeneratedSaxParser
 
 		size_t getLineNumer()const;
 		size_t getColumnNumer()const;
+		size_t getByteOffset()const;
 
 	private:
         /** Disable default copy ctor. */
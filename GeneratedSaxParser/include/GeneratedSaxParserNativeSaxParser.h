@@ -0,0 +1,147 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of GeneratedSaxParser.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __GENERATEDSAXPARSER_NATIVESAXPARSER_H__
+#define __GENERATEDSAXPARSER_NATIVESAXPARSER_H__
+
+#include "GeneratedSaxParserPrerequisites.h"
+#include "GeneratedSaxParserSaxParser.h"
+#include "GeneratedSaxParserParserError.h"
+#include "GeneratedSaxParserTypes.h"
+
+#include <vector>
+
+
+namespace GeneratedSaxParser
+{
+
+	class Parser;
+
+	/** Non-validating xml parser that does not depend on an external library. The document is
+	tokenized in place: names, attribute values and text are terminated, unescaped and passed to the
+	parser directly in the document buffer. The buffer of a file is mapped copy on write, i.e. only the
+	pages that are modified are copied. A buffer passed to parseBuffer() is copied once.
+	The text of an element is always passed in one call of Parser::textData(), even if it is interrupted
+	by comments or CDATA sections.
+	Only UTF-8 (and ASCII) encoded documents are supported. Document type declarations are skipped,
+	i.e. only the predefined entities and character references are replaced. Namespace prefixes are
+	passed as part of the element and attribute names.
+	If the parser requests it after an element has been begun (see Parser::rawContentsRequested()), the
+	contents of the element are only scanned for the matching end tag and passed unmodified.*/
+	class NativeSaxParser : public SaxParser
+	{
+	private:
+		/** The document buffer, while a document is parsed.*/
+		ParserChar* mBuffer;
+
+		/** The first byte after the document buffer.*/
+		ParserChar* mBufferEnd;
+
+		/** True, if mBuffer is a mapped file, false if it has been allocated.*/
+		bool mBufferIsMapped;
+
+#if defined(COLLADABU_OS_WIN)
+		/** The handle of the file mapping of mBuffer.*/
+		void* mFileMapping;
+#endif
+
+		/** The current line number.*/
+		size_t mLineNumber;
+
+		/** The first byte of the current line.*/
+		const ParserChar* mLineBegin;
+
+		/** The current parse position.*/
+		ParserChar* mPosition;
+
+		/** The names of the open elements.*/
+		std::vector<const ParserChar*> mElementNames;
+
+		/** The null terminated list of attribute name value pairs of the current element.*/
+		std::vector<const ParserChar*> mAttributes;
+
+	public:
+		NativeSaxParser(Parser* parser);
+		virtual ~NativeSaxParser();
+
+		bool parseFile(const char* fileName);
+		bool parseBuffer(const char* uri, const char* buffer, int length);
+
+		size_t getLineNumer()const;
+		size_t getColumnNumer()const;
+		size_t getByteOffset()const;
+
+	private:
+        /** Disable default copy ctor. */
+		NativeSaxParser( const NativeSaxParser& pre );
+        /** Disable default assignment operator. */
+		const NativeSaxParser& operator= ( const NativeSaxParser& pre );
+
+		/** Maps the file @a fileName into mBuffer. Falls back to reading the file, if it cannot be mapped.*/
+		bool mapFile(const char* fileName);
+
+		/** Releases mBuffer.*/
+		void releaseBuffer();
+
+		/** Parses the document in mBuffer.*/
+		bool parseDocument();
+
+		/** Parses the text starting at mPosition up to the next tag, including comments, processing
+		instructions and CDATA sections, and passes it to the parser.
+		@return False, if parsing should be stopped.*/
+		bool parseText();
+
+		/** Parses the start tag at mPosition.*/
+		bool parseStartTag();
+
+		/** Parses the end tag at mPosition.*/
+		bool parseEndTag();
+
+		/** Scans the contents of the element @a elementName, that starts at mPosition, up to its end tag
+		without modifying them, passes them to Parser::rawContents() and ends the element.*/
+		bool parseRawContents(const ParserChar* elementName);
+
+		/** Skips the comment at mPosition.*/
+		bool skipComment();
+
+		/** Skips the processing instruction or xml declaration at mPosition.*/
+		bool skipProcessingInstruction();
+
+		/** Skips the document type declaration at mPosition.*/
+		bool skipDocumentTypeDeclaration();
+
+		/** Moves the content of the CDATA section at mPosition to @a textEnd and returns the end of
+		the moved text, or 0 on error.*/
+		ParserChar* moveCDataSection(ParserChar* textEnd);
+
+		/** Replaces the reference at mPosition, by the character it references, written to @a
+		output and returns the end of the written character, or 0 on error.*/
+		ParserChar* replaceReference(ParserChar* output);
+
+		/** Skips white spaces, counting new lines.*/
+		void skipWhiteSpaces();
+
+		/** Skips the characters up to @a terminator, counting new lines. mPosition is set to the
+		first character of the terminator.
+		@return False, if the terminator could not be found.*/
+		bool skipTo(const char* terminator);
+
+		/** Reads a name at mPosition and terminates it in place.
+		@param nameEnd Is set to the character that followed the name, before it was replaced.
+		@return The name or 0 on error.*/
+		const ParserChar* readName(ParserChar& nameEnd);
+
+		/** Reports a syntax error.*/
+		void handleError(const char* message);
+
+	};
+} // namespace GeneratedSaxParser
+
+#endif // __GENERATEDSAXPARSER_NATIVESAXPARSER_H__
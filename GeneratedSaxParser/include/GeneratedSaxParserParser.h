@@ -35,6 +35,15 @@ namespace GeneratedSaxParser
 
 		virtual bool textData(const ParserChar* text, size_t textLength)=0;
 
+		/** Returns true, if the contents of the element passed to elementBegin() last should be passed
+		unparsed to rawContents(), followed by elementEnd(). Only asked by sax parsers that support it,
+		directly after elementBegin(). Other sax parsers parse the contents as usual.*/
+		virtual bool rawContentsRequested() { return false; }
+
+		/** Receives the unparsed contents of an element, if requested by rawContentsRequested().
+		@a contents is not null terminated and only valid during the call.*/
+		virtual bool rawContents(const ParserChar* contents, size_t length) { return true; }
+
 		IErrorHandler* getErrorHandler() { return mErrorHandler; }
 
 	protected:
@@ -134,6 +134,8 @@ namespace GeneratedSaxParser
         size_t mUnknownElements;
         /** Number of elements that have been opened and are in a different namespace. */
         size_t mNamespaceElements;
+        /** True, if the unknown handler wants the contents of the element begun last unparsed. */
+        bool mRawContentsRequested;
 
 
 	public:
@@ -147,7 +149,8 @@ namespace GeneratedSaxParser
               mLaxNamespaceHandling(false),
 			  mIgnoreElements(0),
               mUnknownElements(0),
-              mNamespaceElements(0)
+              mNamespaceElements(0),
+              mRawContentsRequested(false)
 		  {};
 		virtual ~ParserTemplate(){};
 
@@ -184,6 +187,13 @@ namespace GeneratedSaxParser
 
 		bool textData(const ParserChar* text, size_t textLength);
 
+        /** Returns true, if the unknown handler requested the contents of the unknown element begun
+        last unparsed. See IUnknownElementHandler::wantsRawContents(). */
+        bool rawContentsRequested() { return mRawContentsRequested; }
+
+        /** Passes the unparsed contents of an unknown element to the unknown handler. */
+        bool rawContents(const ParserChar* contents, size_t length);
+
     protected:
         virtual bool findElementHash( ElementData& elementData ) = 0;
         virtual bool isXsAnyAllowed( const StringHash& elementHash ) = 0;
@@ -459,6 +469,32 @@ namespace GeneratedSaxParser
 #endif
             );
 
+        /** Decodes text data of type xs:hexBinary, or a list of it, and passes the decoded bytes to
+        @a hexBinaryDataFunction. A digit of a byte split across two calls is kept in mPendingHexDigit.
+        The bytes of all list items are passed as one contiguous stream. The length facets are
+        validated against the number of decoded bytes.*/
+        bool characterData2HexBinaryData( const ParserChar* text,
+            size_t textLength,
+            uint8DataFunctionPtr hexBinaryDataFunction
+#ifdef GENERATEDSAXPARSER_VALIDATION
+            ,
+            ParserError::ErrorType (*listValidationFunc)( const uint8*, size_t ) = 0,
+            size_t* wholeListLength = 0,
+            ParserError::ErrorType (*itemTypeValidationFunc)( uint8 ) = 0
+#endif
+            );
+
+        /** Finishes the decoding of hexBinary text data. Reports an error if an odd number of
+        digits has been decoded.*/
+        bool hexBinaryDataEnd( uint8DataFunctionPtr hexBinaryDataFunction
+#ifdef GENERATEDSAXPARSER_VALIDATION
+            ,
+            ParserError::ErrorType (*listValidationFunc)( const uint8*, size_t ) = 0,
+            size_t* wholeListLength = 0,
+            ParserError::ErrorType (*itemTypeValidationFunc)( uint8 ) = 0
+#endif
+            );
+
 
         /**
         * Converts buffer representing a xs:list to a buffer containing the list as C++ item type.
@@ -1777,6 +1813,139 @@ namespace GeneratedSaxParser
             );
 	}
 
+	//--------------------------------------------------------------------
+	template<class DerivedClass, class ImplClass>
+	bool ParserTemplate<DerivedClass, ImplClass>::characterData2HexBinaryData(
+        const ParserChar* text,
+        size_t textLength,
+        uint8DataFunctionPtr hexBinaryDataFunction
+#ifdef GENERATEDSAXPARSER_VALIDATION
+        ,
+        ParserError::ErrorType (*listValidationFunc)( const uint8*, size_t ),
+        size_t* wholeListLength,
+        ParserError::ErrorType (*itemTypeValidationFunc)( uint8 )
+#endif
+        )
+	{
+		const ParserChar* dataBufferPos = text;
+		const ParserChar* bufferEnd = text + textLength;
+		uint8* byteBuffer = (uint8*)mStackMemoryManager.newObject(HEX_BINARY_BUFFER_SIZE);
+
+		while ( dataBufferPos != bufferEnd )
+		{
+			bool failed = false;
+			size_t byteCount = Utils::hexBinaryToBytes(&dataBufferPos, bufferEnd, byteBuffer, HEX_BINARY_BUFFER_SIZE, mPendingHexDigit, failed);
+
+			if ( byteCount > 0 )
+			{
+#ifdef GENERATEDSAXPARSER_VALIDATION
+                if ( itemTypeValidationFunc != 0 )
+                {
+                    for ( size_t i = 0; i < byteCount; ++i )
+                    {
+                        ParserError::ErrorType simpleTypeValidationResult = (itemTypeValidationFunc)(byteBuffer[i]);
+                        if ( simpleTypeValidationResult != ParserError::SIMPLE_TYPE_VALIDATION_OK )
+                        {
+                            ParserChar msg[21];
+                            Utils::fillErrorMsg(msg, text, 20);
+                            if( handleError(ParserError::SEVERITY_ERROR_NONCRITICAL,
+                                simpleTypeValidationResult,
+                                0,
+                                msg) )
+                            {
+                                mStackMemoryManager.deleteObject(); //byteBuffer
+                                mPendingHexDigit = -1;
+                                return false;
+                            }
+                        }
+                    }
+                }
+                if ( listValidationFunc != 0 )
+                {
+                    *wholeListLength += byteCount;
+                    ParserError::ErrorType simpleTypeValidationResult = (listValidationFunc)(0, *wholeListLength);
+                    if ( simpleTypeValidationResult != ParserError::SIMPLE_TYPE_VALIDATION_OK )
+                    {
+                        ParserChar msg[21];
+                        Utils::fillErrorMsg(msg, text, 20);
+                        if( handleError(ParserError::SEVERITY_ERROR_NONCRITICAL,
+                            simpleTypeValidationResult,
+                            0,
+                            msg) )
+                        {
+                            mStackMemoryManager.deleteObject(); //byteBuffer
+                            mPendingHexDigit = -1;
+                            return false;
+                        }
+                    }
+                }
+#endif
+				if ( !(mImpl->*hexBinaryDataFunction)(byteBuffer, byteCount) )
+				{
+					mStackMemoryManager.deleteObject(); //byteBuffer
+					mPendingHexDigit = -1;
+					return false;
+				}
+			}
+
+			if ( failed )
+			{
+				mStackMemoryManager.deleteObject(); //byteBuffer
+				mPendingHexDigit = -1;
+				ParserChar msg[21];
+				Utils::fillErrorMsg(msg, dataBufferPos, 20);
+				return !handleError(ParserError::SEVERITY_ERROR_NONCRITICAL,
+					                ParserError::ERROR_TEXTDATA_PARSING_FAILED,
+					                0,
+					                msg);
+			}
+		}
+
+		mStackMemoryManager.deleteObject(); //byteBuffer
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	template<class DerivedClass, class ImplClass>
+	bool ParserTemplate<DerivedClass, ImplClass>::hexBinaryDataEnd(
+        uint8DataFunctionPtr hexBinaryDataFunction
+#ifdef GENERATEDSAXPARSER_VALIDATION
+        ,
+        ParserError::ErrorType (*listValidationFunc)( const uint8*, size_t ),
+        size_t* wholeListLength,
+        ParserError::ErrorType (*itemTypeValidationFunc)( uint8 )
+#endif
+        )
+	{
+		if ( mPendingHexDigit >= 0 )
+		{
+			mPendingHexDigit = -1;
+			return !handleError(ParserError::SEVERITY_ERROR_NONCRITICAL,
+				                ParserError::ERROR_TEXTDATA_PARSING_FAILED,
+				                0,
+				                "odd number of hexadecimal digits");
+		}
+
+#ifdef GENERATEDSAXPARSER_VALIDATION
+        // all bytes have been passed already, only the length of the whole data is left to check
+        if ( listValidationFunc != 0 )
+        {
+            ParserError::ErrorType simpleTypeValidationResult = (listValidationFunc)(0, *wholeListLength);
+            if ( simpleTypeValidationResult != ParserError::SIMPLE_TYPE_VALIDATION_OK )
+            {
+                if( handleError(ParserError::SEVERITY_ERROR_NONCRITICAL,
+                    simpleTypeValidationResult,
+                    0,
+                    0) )
+                {
+                    return false;
+                }
+            }
+        }
+#endif
+		return true;
+	}
+
 	//--------------------------------------------------------------------
 	template<class DerivedClass, class ImplClass>
 	bool ParserTemplate<DerivedClass, ImplClass>::uint64DataEnd(
@@ -1844,6 +2013,19 @@ namespace GeneratedSaxParser
 	}
 
 
+	//--------------------------------------------------------------------
+	template<class DerivedClass, class ImplClass>
+	bool ParserTemplate<DerivedClass, ImplClass>::rawContents(const ParserChar* contents,
+															  size_t length)
+	{
+        if ( mUnknownElements > 0 && mUnknownHandler != 0 )
+        {
+            return mUnknownHandler->rawContents( contents, length );
+        }
+        return true;
+	}
+
+
 	//--------------------------------------------------------------------
 	template<class DerivedClass, class ImplClass>
 	bool ParserTemplate<DerivedClass, ImplClass>::elementEnd(const ParserChar* elementName)
@@ -1920,6 +2102,7 @@ namespace GeneratedSaxParser
 	bool ParserTemplate<DerivedClass, ImplClass>::elementBegin( const ParserChar* elementName,
 																   const ParserAttributes& attributes)
 	{
+        mRawContentsRequested = false;
         if ( (mIgnoreElements > 0 || mUnknownElements > 0 || mNamespaceElements > 0) 
             && !mNamespacesStack.empty() )
         {
@@ -2023,7 +2206,10 @@ namespace GeneratedSaxParser
             {
                 if ( mUnknownHandler != 0 )
                 {
-                    return mUnknownHandler->elementBegin( elementName, attributes.attributes );
+                    if ( !mUnknownHandler->elementBegin( elementName, attributes.attributes ) )
+                        return false;
+                    mRawContentsRequested = mUnknownHandler->wantsRawContents();
+                    return true;
                 }
                 else
                 {
@@ -35,9 +35,17 @@ namespace GeneratedSaxParser
 
 		static const size_t STACK_SIZE = 1024*1024;
 
+		/** Initial size of the validation data stack. It only holds one validation data struct of
+		at most about 1.2 KiB per open element, i.e. it is by far smaller than the stack holding
+		the character data. The stack grows, if a document is nested more deeply.*/
+		static const size_t VALIDATION_STACK_SIZE = 32*1024;
+
 		/** Number of floats that fit into the buffer, used to convert text data to a float array.*/
 		static const size_t TYPED_VALUES_BUFFER_SIZE = 1000;
 
+		/** Number of bytes decoded from hexBinary text data, before they are passed to the data function.*/
+		static const size_t HEX_BINARY_BUFFER_SIZE = 16*1024;
+
 		struct ElementData
 		{
 			StringHash elementHash;
@@ -76,15 +84,22 @@ namespace GeneratedSaxParser
          */
         ParserChar* mEndOfDataInCurrentObjectOnStack;
 
+        /**
+         * The value of the first digit of a hexBinary byte, whose second digit
+         * has not been received yet, or -1.
+         */
+        int mPendingHexDigit;
+
         ElementNameMap mHashNameMap;
 
 	public:
 		ParserTemplateBase(IErrorHandler* errorHandler)
 			: Parser(errorHandler),
 			mStackMemoryManager(STACK_SIZE),
-            mValidationDataStack(STACK_SIZE),
+            mValidationDataStack(VALIDATION_STACK_SIZE),
             mValidate(true),
-			mLastIncompleteFragmentInCharacterData(0){}
+			mLastIncompleteFragmentInCharacterData(0),
+			mPendingHexDigit(-1){}
 		virtual ~ParserTemplateBase(){};
 
 		/** Returns the element or attribute name that corresponds to @a hash. Null is returned,
@@ -40,6 +40,9 @@ namespace GeneratedSaxParser
 
 		OpenTagsStack mOpenTags;  //!< A stack that holds all the open tags.
 
+		/** If true, the contents of unknown elements are requested unparsed and copied as they are.*/
+		bool mCaptureRawContents;
+
 	public:
 		RawUnknownElementHandler();
 		virtual ~RawUnknownElementHandler();
@@ -50,6 +53,13 @@ namespace GeneratedSaxParser
 		virtual bool elementBegin( const ParserChar* elementName, const xmlChar** attributes);
 		virtual bool elementEnd(const ParserChar* elementName);
 		virtual bool textData(const ParserChar* text, size_t textLength);
+		virtual bool wantsRawContents() { return mCaptureRawContents; }
+		virtual bool rawContents(const ParserChar* contents, size_t length);
+
+		/** If @a captureRawContents is true, the contents of the unknown elements are copied from the
+		document as they are, instead of being reconstructed from the parsed elements and text, if the
+		sax parser supports it. The raw data then keeps comments, CDATA sections and references.*/
+		void setCaptureRawContents( bool captureRawContents ) { mCaptureRawContents = captureRawContents; }
 
 		/** Clears the string containing the raw data.*/
 		void clearRawData() {mRawData.clear();}
@@ -33,6 +33,11 @@ namespace GeneratedSaxParser
 		virtual size_t getLineNumer()const=0;
 		virtual size_t getColumnNumer()const=0;
 
+		/** Returns the number of bytes of the document processed so far. During Parser::elementBegin() the
+		offset lies within or directly behind the start tag, during Parser::elementEnd() directly behind
+		the end tag.*/
+		virtual size_t getByteOffset()const=0;
+
 		Parser* getParser(){return mParser;}
         void setParser( Parser* parser );
 
@@ -13,6 +13,8 @@
 
 #include "GeneratedSaxParserPrerequisites.h"
 
+#include <vector>
+
 
 
 namespace GeneratedSaxParser
@@ -23,11 +25,17 @@ namespace GeneratedSaxParser
 		|              | |              | |              | |
 		 -------------- - -------------- - -------------- - 
 		     data0    size0   data1    size1   data2    size2
+
+		If the active frame is full, a new frame, SIZE_OF_NEW_FRAME_FACTOR times as large as the
+		active one, is allocated. The number of frames is not limited. A frame that becomes empty
+		is kept as spare frame and reused by the next allocation that does not fit into the active
+		frame, to avoid allocating and freeing a frame for each element of a document whose depth
+		oscillates around a frame boundary. At most one spare frame is kept, i.e. the memory used
+		is bounded by the largest stack depth reached.
 	*/
 	class StackMemoryManager 
 	{
 	private:
-        static const size_t MAX_NUM_OF_FRAMES = 12;
         static const size_t SIZE_OF_NEW_FRAME_FACTOR = 2;
 
         struct StackFrame
@@ -49,8 +57,13 @@ namespace GeneratedSaxParser
             /** Pointer to allocated memory. */
 		    char* mMemoryBlob;
         };
+        typedef std::vector<StackFrame> StackFrameList;
+
+        /** Index of the frame the top object is in.*/
         size_t mActiveFrame;
-        StackFrame* mFrames;
+
+        /** All allocated frames. The frames after mActiveFrame are empty spare frames.*/
+        StackFrameList mFrames;
 
 	public:
 		StackMemoryManager(size_t stackSize);
@@ -71,8 +84,13 @@ namespace GeneratedSaxParser
 
         inline void writeNewObjectSize(size_t position, size_t size);
 
+        /** Makes the next frame the active one. A spare frame is reused, if there is one.
+            Otherwise a new frame is allocated.*/
         bool allocateMoreMemory();
 
+        /** Frees all spare frames but the one after the active frame.*/
+        void releaseSpareFrames();
+
     private:
 		/** Disable default copy ctor. */
 		StackMemoryManager( const StackMemoryManager& pre );
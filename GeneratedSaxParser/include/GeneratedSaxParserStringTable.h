@@ -0,0 +1,103 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of GeneratedSaxParser.
+
+    Licensed under the MIT Open Source License, 
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __GENERATEDSAXPARSER_STRINGTABLE_H__
+#define __GENERATEDSAXPARSER_STRINGTABLE_H__
+
+#include "GeneratedSaxParserPrerequisites.h"
+#include "GeneratedSaxParserTypes.h"
+
+#include <vector>
+
+
+namespace GeneratedSaxParser
+{
+
+	/** Hash consed symbol table. Each distinct string passed to intern() is stored exactly once and
+	identified by a compact symbol id. Equal strings always yield the same symbol id, i.e. symbols can
+	be compared by their ids instead of comparing the strings.
+	The symbol ids are assigned consecutively, starting with 0. They can therefore be used as indices
+	into arrays that cache information derived from the strings.*/
+	class StringTable
+	{
+	public:
+
+		/** Compact identifier of an interned string.*/
+		typedef unsigned int SymbolId;
+
+		/** Symbol id that is never assigned to a string.*/
+		static const SymbolId INVALID_SYMBOL;
+
+	private:
+
+		typedef std::vector<String> StringList;
+		typedef std::vector<StringHash> StringHashList;
+		typedef std::vector<SymbolId> BucketList;
+
+		/** The interned strings. The i'th string has symbol id i.*/
+		StringList mStrings;
+
+		/** The hashes of the interned strings. Used to avoid rehashing when the table grows.*/
+		StringHashList mHashes;
+
+		/** Open addressing hash table. Each bucket contains the symbol id plus one, or zero if the
+		bucket is empty. The number of buckets is always a power of two.*/
+		BucketList mBuckets;
+
+	public:
+
+		/** Constructor. */
+		StringTable();
+
+		/** Destructor. */
+		virtual ~StringTable();
+
+		/** Returns the symbol id of the string @a str of length @a length. If the string has not
+		been interned before, it is added to the table.*/
+		SymbolId intern( const ParserChar* str, size_t length );
+
+		/** Returns the symbol id of the string @a parserString. If the string has not been interned 
+		before, it is added to the table.*/
+		SymbolId intern( const ParserString& parserString ) { return intern(parserString.str, parserString.length); }
+
+		/** Returns the symbol id of the string @a str of length @a length, if it has been interned
+		before, INVALID_SYMBOL otherwise. The table is not modified.*/
+		SymbolId find( const ParserChar* str, size_t length ) const;
+
+		/** Returns the string with symbol id @a symbolId. @a symbolId must be valid.*/
+		const String& getString( SymbolId symbolId ) const { return mStrings[symbolId]; }
+
+		/** Returns the number of interned strings.*/
+		size_t getSymbolCount() const { return mStrings.size(); }
+
+		/** Removes all interned strings and releases their memory. Previously returned symbol ids become
+		invalid.*/
+		void clear();
+
+	private:
+
+		/** Returns the bucket that contains the string @a str with hash @a hash or the empty bucket 
+		where it would be inserted.*/
+		size_t findBucket( const ParserChar* str, size_t length, StringHash hash ) const;
+
+		/** Doubles the number of buckets and reinserts all symbols.*/
+		void grow();
+
+		/** Disable default copy ctor. */
+		StringTable( const StringTable& pre );
+
+		/** Disable default assignment operator. */
+		const StringTable& operator= ( const StringTable& pre );
+
+	};
+
+} // namespace GeneratedSaxParser
+
+#endif // __GENERATEDSAXPARSER_STRINGTABLE_H__
@@ -386,6 +386,29 @@ namespace GeneratedSaxParser
         static bool toBool( const ParserChar** buffer, bool& failed  );
 
 
+		/** Decodes hexadecimal encoded binary data (xs:hexBinary) within a ParserChar buffer to bytes and
+		advances the character pointer to the first character that has not been decoded. White spaces
+		between the digits are skipped. Decoding stops at bufferEnd, if @a output is full or at the first
+		character that is neither a hexadecimal digit nor a white space.
+		Runs of 16 digits without white spaces are decoded 8 bytes at a time.
+		@param buffer Pointer to the first character in the buffer. Will be set to the first
+		character after the last interpreted.
+		@param bufferEnd the first character after the last in the buffer
+		@param output The buffer the decoded bytes are written to.
+		@param outputSize The size of @a output in bytes.
+		@param pendingDigit The value of the first digit of a byte whose second digit has not been
+		decoded yet, or -1. Must be passed unchanged to the call that decodes the following characters.
+		@param failed Set to true, if a character that is neither a hexadecimal digit nor a white space
+		has been found, false otherwise.
+		@return The number of bytes written to @a output.*/
+		static size_t hexBinaryToBytes( const ParserChar** buffer,
+			const ParserChar* bufferEnd,
+			uint8* output,
+			size_t outputSize,
+			int& pendingDigit,
+			bool& failed );
+
+
         /**
          * Checks if given floating point value is infinity.
          * @tparam T Type of floating point value.
@@ -19,17 +19,194 @@
 #include <iostream>
 #include "GeneratedSaxParserParser.h"
 
+#if !defined(COLLADABU_OS_WIN)
+#	define GENERATEDSAXPARSER_EXPAT_READAHEAD
+#	include <pthread.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/stat.h>
+#endif
+
 
 namespace GeneratedSaxParser
 {
 	
+#if defined(GENERATEDSAXPARSER_EXPAT_READAHEAD)
+	namespace
+	{
+		/** Reads a file in a separate thread into the file system cache, ahead of the position the parsing
+		thread has read the file up to. The parsing thread reads the file directly into the buffer of expat,
+		which then only copies the data from the cache, instead of waiting for the disk.*/
+		class ReadAheadReader
+		{
+		private:
+			FILE* mFile;
+			size_t mChunkSize;
+			size_t mChunkCount;
+
+			/** The size of the file.*/
+			off_t mFileSize;
+
+			/** The position the parsing thread has read the file up to.*/
+			off_t mParsePosition;
+
+			/** The position the file has been read up to by the reader thread.*/
+			off_t mReadPosition;
+
+#if !defined(__linux__)
+			/** The buffer the reader thread reads the chunks into. Only the side effect of filling the
+			file system cache is used.*/
+			char* mBuffer;
+#endif
+
+			/** True, if the reader thread should stop.*/
+			bool mStop;
+
+			/** True, if the reader thread has been started.*/
+			bool mThreadStarted;
+
+			pthread_t mThread;
+			pthread_mutex_t mMutex;
+			pthread_cond_t mCondition;
+
+		public:
+			ReadAheadReader( FILE* file, size_t chunkSize, size_t chunkCount );
+			~ReadAheadReader();
+
+			/** Starts the reader thread.
+			@return False, if the thread could not be started.*/
+			bool start();
+
+			/** Tells the reader thread, that the parsing thread has read the file up to @a parsePosition.*/
+			void setParsePosition( off_t parsePosition );
+
+		private:
+			static void* readerThread( void* reader );
+			void read();
+
+			/** Reads the chunk starting at @a position into the file system cache.
+			@return False, if the file could not be read.*/
+			bool readChunk( off_t position );
+		};
+
+		//--------------------------------------------------------------------
+		ReadAheadReader::ReadAheadReader( FILE* file, size_t chunkSize, size_t chunkCount )
+			: mFile(file)
+			, mChunkSize(chunkSize)
+			, mChunkCount(chunkCount)
+			, mFileSize(0)
+			, mParsePosition(0)
+			, mReadPosition(0)
+#if !defined(__linux__)
+			, mBuffer(0)
+#endif
+			, mStop(false)
+			, mThreadStarted(false)
+		{
+			pthread_mutex_init(&mMutex, 0);
+			pthread_cond_init(&mCondition, 0);
+		}
+
+		//--------------------------------------------------------------------
+		ReadAheadReader::~ReadAheadReader()
+		{
+			if ( mThreadStarted )
+			{
+				pthread_mutex_lock(&mMutex);
+				mStop = true;
+				pthread_cond_signal(&mCondition);
+				pthread_mutex_unlock(&mMutex);
+				pthread_join(mThread, 0);
+			}
+#if !defined(__linux__)
+			free(mBuffer);
+#endif
+			pthread_cond_destroy(&mCondition);
+			pthread_mutex_destroy(&mMutex);
+		}
+
+		//--------------------------------------------------------------------
+		bool ReadAheadReader::start()
+		{
+			struct stat fileStat;
+			if ( fstat(fileno(mFile), &fileStat) != 0 )
+				return false;
+			mFileSize = fileStat.st_size;
+
+#if !defined(__linux__)
+			mBuffer = (char*)malloc(mChunkSize);
+			if ( !mBuffer )
+				return false;
+#endif
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+			posix_fadvise(fileno(mFile), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+			mThreadStarted = ( pthread_create(&mThread, 0, readerThread, this) == 0 );
+			return mThreadStarted;
+		}
+
+		//--------------------------------------------------------------------
+		void ReadAheadReader::setParsePosition( off_t parsePosition )
+		{
+			pthread_mutex_lock(&mMutex);
+			mParsePosition = parsePosition;
+			pthread_cond_signal(&mCondition);
+			pthread_mutex_unlock(&mMutex);
+		}
+
+		//--------------------------------------------------------------------
+		void* ReadAheadReader::readerThread( void* reader )
+		{
+			((ReadAheadReader*)reader)->read();
+			return 0;
+		}
+
+		//--------------------------------------------------------------------
+		void ReadAheadReader::read()
+		{
+			const off_t readAheadSize = (off_t)(mChunkSize * mChunkCount);
+			pthread_mutex_lock(&mMutex);
+			while ( mReadPosition < mFileSize )
+			{
+				while ( (mReadPosition >= mParsePosition + readAheadSize) && !mStop )
+					pthread_cond_wait(&mCondition, &mMutex);
+				if ( mStop )
+					break;
+				off_t position = mReadPosition;
+				pthread_mutex_unlock(&mMutex);
+
+				bool success = readChunk(position);
+
+				pthread_mutex_lock(&mMutex);
+				if ( !success )
+					break;
+				mReadPosition = position + (off_t)mChunkSize;
+			}
+			pthread_mutex_unlock(&mMutex);
+		}
+
+		//--------------------------------------------------------------------
+		bool ReadAheadReader::readChunk( off_t position )
+		{
+#if defined(__linux__)
+			// blocks until the chunk is in the file system cache, without copying it
+			return readahead(fileno(mFile), position, mChunkSize) == 0;
+#else
+			// pread does not change the file position used by the parsing thread
+			return pread(fileno(mFile), mBuffer, mChunkSize, position) >= 0;
+#endif
+		}
+	}
+#endif
 
 
 	//--------------------------------------------------------------------
-	ExpatSaxParser::ExpatSaxParser(Parser* parser, size_t bufferSize)
+	ExpatSaxParser::ExpatSaxParser(Parser* parser, size_t bufferSize, size_t readAheadBufferCount)
 		: SaxParser(parser)
 		, mParser(0)
 		, mBufferSize(bufferSize)
+		, mReadAheadBufferCount(readAheadBufferCount)
 	{
 	}
 
@@ -39,15 +216,19 @@ namespace GeneratedSaxParser
 	}
 
 	//--------------------------------------------------------------------
-	bool ExpatSaxParser::parseBuffer(const char* uri, const char* buffer, int length)
+	void ExpatSaxParser::createParser()
 	{
-		
 		mParser = XML_ParserCreate(0);
 
 		XML_SetUserData(mParser, this);
 		XML_SetElementHandler(mParser, startElement, endElement);
 		XML_SetCharacterDataHandler(mParser, characters);
+	}
 
+	//--------------------------------------------------------------------
+	bool ExpatSaxParser::parseBuffer(const char* uri, const char* buffer, int length)
+	{
+		createParser();
 
 		XML_Status status = XML_STATUS_OK;
 		bool isFinal = true;
@@ -57,6 +238,8 @@ namespace GeneratedSaxParser
 
 		return status != XML_STATUS_ERROR;
 	}
+
+	//--------------------------------------------------------------------
 	bool ExpatSaxParser::parseFile( const char* fileName )
 	{
 		FILE *fd;
@@ -64,30 +247,78 @@ namespace GeneratedSaxParser
 		if (!fd)
 			return false;
 
-		//XML_ParserCreate(const XML_Char *encoding);
-		mParser = XML_ParserCreate(0);
+		createParser();
 
-		XML_SetUserData(mParser, this);
-		XML_SetElementHandler(mParser, startElement, endElement);
-		XML_SetCharacterDataHandler(mParser, characters);
+		// a small file is read in a few chunks anyway, a reader thread would not pay off
+		bool readAhead = ( mReadAheadBufferCount > 0 ) && isLargerThan(fd, mBufferSize * mReadAheadBufferCount);
+		bool success = readAhead ? parseFileReadAhead(fd) : parseFileSynchronous(fd);
 
+		fclose (fd);
+		XML_ParserFree(mParser);
 
-		char * buffer;
-		buffer = (char*) malloc (sizeof(char)*mBufferSize);
+		return success;
+	}
 
+	//--------------------------------------------------------------------
+	bool ExpatSaxParser::isLargerThan( FILE* file, size_t size )
+	{
+		if ( fseek(file, 0, SEEK_END) != 0 )
+			return true;
+		long fileSize = ftell(file);
+		rewind(file);
+		return (fileSize < 0) || ((unsigned long)fileSize > size);
+	}
 
+	//--------------------------------------------------------------------
+	bool ExpatSaxParser::parseFileSynchronous( FILE* file )
+	{
 		XML_Status status = XML_STATUS_OK;
-		while (!feof(fd) && (status != XML_STATUS_ERROR) )
+		bool isFinal = false;
+		while ( !isFinal && (status != XML_STATUS_ERROR) )
 		{
-			size_t length = fread(buffer, 1,  mBufferSize, fd);
-			status = XML_Parse(mParser, buffer, (int)length, feof(fd));
+			// read directly into the buffer of expat, to avoid copying the data
+			void* buffer = XML_GetBuffer(mParser, (int)mBufferSize);
+			if ( !buffer )
+				return false;
+			size_t length = fread(buffer, 1,  mBufferSize, file);
+			if ( ferror(file) )
+				return false;
+			isFinal = (feof(file) != 0);
+			status = XML_ParseBuffer(mParser, (int)length, isFinal);
 		}
+		return status != XML_STATUS_ERROR;
+	}
 
-		fclose (fd);
-		free (buffer);
-		XML_ParserFree(mParser);
+	//--------------------------------------------------------------------
+	bool ExpatSaxParser::parseFileReadAhead( FILE* file )
+	{
+#if defined(GENERATEDSAXPARSER_EXPAT_READAHEAD)
+		ReadAheadReader reader(file, mBufferSize, mReadAheadBufferCount);
+		if ( !reader.start() )
+			return parseFileSynchronous(file);
 
+		XML_Status status = XML_STATUS_OK;
+		bool isFinal = false;
+		off_t parsePosition = 0;
+		while ( !isFinal && (status != XML_STATUS_ERROR) )
+		{
+			// read directly into the buffer of expat, the data has already been read into the file 
+			// system cache by the reader thread
+			void* buffer = XML_GetBuffer(mParser, (int)mBufferSize);
+			if ( !buffer )
+				return false;
+			size_t length = fread(buffer, 1,  mBufferSize, file);
+			if ( ferror(file) )
+				return false;
+			isFinal = (feof(file) != 0);
+			parsePosition += (off_t)length;
+			reader.setParsePosition(parsePosition);
+			status = XML_ParseBuffer(mParser, (int)length, isFinal);
+		}
 		return status != XML_STATUS_ERROR;
+#else
+		return parseFileSynchronous(file);
+#endif
 	}
 
 	//--------------------------------------------------------------------
@@ -132,6 +363,15 @@ namespace GeneratedSaxParser
 		return (size_t) XML_GetCurrentColumnNumber(mParser);
 	}
 
+	//--------------------------------------------------------------------
+	size_t ExpatSaxParser::getByteOffset() const
+	{
+		XML_Index byteIndex = XML_GetCurrentByteIndex(mParser);
+		if ( byteIndex < 0 )
+			return 0;
+		return (size_t)byteIndex + (size_t)XML_GetCurrentByteCount(mParser);
+	}
+
 	//--------------------------------------------------------------------
 	void ExpatSaxParser::abortParsing()
 	{
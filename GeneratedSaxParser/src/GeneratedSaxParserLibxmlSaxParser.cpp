@@ -212,6 +212,14 @@ namespace GeneratedSaxParser
 		return (size_t)xmlSAX2GetColumnNumber(mParserContext);
 	}
 
+	size_t LibxmlSaxParser::getByteOffset() const
+	{
+		if ( !mParserContext )
+			return 0;
+		long byteOffset = xmlByteConsumed(mParserContext);
+		return byteOffset > 0 ? (size_t)byteOffset : 0;
+	}
+
 	void LibxmlSaxParser::errorFunction( void *userData, const char *msg, ... )
 	{
         // if msg is just one string, get it. Otherwise ignore it.
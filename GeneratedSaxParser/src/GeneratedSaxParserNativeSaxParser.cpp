@@ -0,0 +1,1037 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of GeneratedSaxParser.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "GeneratedSaxParserNativeSaxParser.h"
+#include "GeneratedSaxParserParser.h"
+#include "GeneratedSaxParserIErrorHandler.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(COLLADABU_OS_WIN)
+#	include <windows.h>
+#else
+#	include <sys/types.h>
+#	include <sys/stat.h>
+#	include <sys/mman.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+
+namespace GeneratedSaxParser
+{
+
+	/** Characters that end a run of plain text: '\n', '\r', '&' and '<'.*/
+	static const unsigned char TEXT_STOP_CHARACTERS[256] =
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+	};
+
+	/** The maximum length of a reference between '&' and ';'.*/
+	static const size_t MAX_REFERENCE_LENGTH = 12;
+
+	//--------------------------------------------------------------------
+	static inline bool isWhiteSpace( ParserChar c )
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	//--------------------------------------------------------------------
+	static inline bool isNameEnd( ParserChar c )
+	{
+		return isWhiteSpace(c) || c == '=' || c == '/' || c == '>' || c == '<';
+	}
+
+	//--------------------------------------------------------------------
+	static bool equalsIgnoreCase( const ParserChar* string, size_t length, const char* compare )
+	{
+		size_t i = 0;
+		for ( ; i < length && compare[i]; ++i )
+		{
+			ParserChar c = string[i];
+			if ( c >= 'a' && c <= 'z' )
+				c = c - 'a' + 'A';
+			if ( c != compare[i] )
+				return false;
+		}
+		return i == length && !compare[i];
+	}
+
+	//--------------------------------------------------------------------
+	/** Returns false, if the xml declaration in [@a begin, @a end) declares an encoding other than UTF-8.*/
+	static bool isSupportedEncoding( const ParserChar* begin, const ParserChar* end )
+	{
+		static const char ENCODING[] = "encoding";
+		static const size_t ENCODING_LENGTH = sizeof(ENCODING) - 1;
+
+		const ParserChar* position = begin;
+		while ( position + ENCODING_LENGTH <= end && memcmp(position, ENCODING, ENCODING_LENGTH) != 0 )
+			++position;
+		if ( position + ENCODING_LENGTH > end )
+			return true;
+
+		position += ENCODING_LENGTH;
+		while ( position < end && (isWhiteSpace(*position) || *position == '=') )
+			++position;
+		if ( position == end || (*position != '"' && *position != '\'') )
+			return true;
+
+		ParserChar quote = *position++;
+		const ParserChar* valueBegin = position;
+		while ( position < end && *position != quote )
+			++position;
+		size_t valueLength = position - valueBegin;
+
+		return equalsIgnoreCase(valueBegin, valueLength, "UTF-8")
+			|| equalsIgnoreCase(valueBegin, valueLength, "UTF8")
+			|| equalsIgnoreCase(valueBegin, valueLength, "US-ASCII")
+			|| equalsIgnoreCase(valueBegin, valueLength, "ASCII");
+	}
+
+
+	//--------------------------------------------------------------------
+	NativeSaxParser::NativeSaxParser( Parser* parser )
+		: SaxParser(parser)
+		, mBuffer(0)
+		, mBufferEnd(0)
+		, mBufferIsMapped(false)
+#if defined(COLLADABU_OS_WIN)
+		, mFileMapping(0)
+#endif
+		, mLineNumber(0)
+		, mLineBegin(0)
+		, mPosition(0)
+	{
+	}
+
+	//--------------------------------------------------------------------
+	NativeSaxParser::~NativeSaxParser()
+	{
+		releaseBuffer();
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::parseFile( const char* fileName )
+	{
+		if ( !mapFile(fileName) )
+		{
+			ParserError error(ParserError::SEVERITY_CRITICAL,
+							  ParserError::ERROR_COULD_NOT_OPEN_FILE,
+							  0,
+							  0,
+							  0,
+							  0,
+							  fileName);
+			IErrorHandler* errorHandler = getParser()->getErrorHandler();
+			if ( errorHandler )
+			{
+				errorHandler->handleError(error);
+			}
+			return false;
+		}
+
+		bool success = parseDocument();
+		releaseBuffer();
+		return success;
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::parseBuffer( const char* uri, const char* buffer, int length )
+	{
+		// The buffer is modified while it is parsed.
+		size_t bufferLength = length > 0 ? (size_t)length : 0;
+		mBuffer = (ParserChar*)malloc(bufferLength + 1);
+		if ( !mBuffer )
+			return false;
+		memcpy(mBuffer, buffer, bufferLength);
+		mBufferEnd = mBuffer + bufferLength;
+		mBufferIsMapped = false;
+
+		bool success = parseDocument();
+		releaseBuffer();
+		return success;
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::mapFile( const char* fileName )
+	{
+#if defined(COLLADABU_OS_WIN)
+		HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+		if ( file == INVALID_HANDLE_VALUE )
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if ( GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 )
+		{
+			mFileMapping = CreateFileMappingA(file, 0, PAGE_WRITECOPY, 0, 0, 0);
+			if ( mFileMapping )
+			{
+				mBuffer = (ParserChar*)MapViewOfFile(mFileMapping, FILE_MAP_COPY, 0, 0, 0);
+				if ( mBuffer )
+				{
+					mBufferEnd = mBuffer + (size_t)fileSize.QuadPart;
+					mBufferIsMapped = true;
+				}
+				else
+				{
+					CloseHandle(mFileMapping);
+					mFileMapping = 0;
+				}
+			}
+		}
+		CloseHandle(file);
+#else
+		int file = open(fileName, O_RDONLY);
+		if ( file < 0 )
+			return false;
+
+		struct stat fileStatus;
+		if ( fstat(file, &fileStatus) == 0 && fileStatus.st_size > 0 )
+		{
+			void* mapping = mmap(0, (size_t)fileStatus.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+			if ( mapping != MAP_FAILED )
+			{
+				mBuffer = (ParserChar*)mapping;
+				mBufferEnd = mBuffer + (size_t)fileStatus.st_size;
+				mBufferIsMapped = true;
+			}
+		}
+		close(file);
+#endif
+
+		if ( mBufferIsMapped )
+			return true;
+
+		// The file is empty or could not be mapped. Read it instead.
+		FILE* stream = fopen(fileName, "rb");
+		if ( !stream )
+			return false;
+
+		size_t capacity = 64 * 1024;
+		size_t length = 0;
+		mBuffer = (ParserChar*)malloc(capacity);
+		while ( mBuffer )
+		{
+			length += fread(mBuffer + length, 1, capacity - length, stream);
+			if ( length < capacity )
+				break;
+			capacity *= 2;
+			ParserChar* buffer = (ParserChar*)realloc(mBuffer, capacity);
+			if ( !buffer )
+			{
+				free(mBuffer);
+			}
+			mBuffer = buffer;
+		}
+		fclose(stream);
+
+		if ( !mBuffer )
+			return false;
+		mBufferEnd = mBuffer + length;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	void NativeSaxParser::releaseBuffer()
+	{
+		if ( !mBuffer )
+			return;
+
+		if ( mBufferIsMapped )
+		{
+#if defined(COLLADABU_OS_WIN)
+			UnmapViewOfFile(mBuffer);
+			CloseHandle(mFileMapping);
+			mFileMapping = 0;
+#else
+			munmap(mBuffer, mBufferEnd - mBuffer);
+#endif
+		}
+		else
+		{
+			free(mBuffer);
+		}
+
+		mBuffer = 0;
+		mBufferEnd = 0;
+		mBufferIsMapped = false;
+		mPosition = 0;
+		mLineBegin = 0;
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::parseDocument()
+	{
+		mPosition = mBuffer;
+		mLineNumber = 1;
+		mLineBegin = mBuffer;
+		mElementNames.clear();
+
+		// Skip the UTF-8 byte order mark
+		if ( mBufferEnd - mPosition >= 3 && memcmp(mPosition, "\xEF\xBB\xBF", 3) == 0 )
+			mPosition += 3;
+
+		bool rootElementFound = false;
+		while ( true )
+		{
+			if ( !parseText() )
+				return false;
+
+			if ( mPosition == mBufferEnd )
+				break;
+
+			if ( mPosition + 1 < mBufferEnd && mPosition[1] == '/' )
+			{
+				if ( !parseEndTag() )
+					return false;
+			}
+			else
+			{
+				if ( rootElementFound && mElementNames.empty() )
+				{
+					handleError("Extra content at the end of the document");
+					return false;
+				}
+				rootElementFound = true;
+				if ( !parseStartTag() )
+					return false;
+			}
+		}
+
+		if ( !rootElementFound )
+		{
+			handleError("Document is empty");
+			return false;
+		}
+		if ( !mElementNames.empty() )
+		{
+			handleError("Premature end of data");
+			return false;
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::parseText()
+	{
+		// The text is moved to the front, if references have to be replaced or comments or CDATA
+		// sections have to be removed.
+		ParserChar* textBegin = mPosition;
+		ParserChar* textEnd = textBegin;
+
+		bool textComplete = false;
+		while ( !textComplete )
+		{
+			// Most text does not contain references or carriage returns. Find its end and count its
+			// lines at once.
+			ParserChar* position = (ParserChar*)memchr(mPosition, '<', mBufferEnd - mPosition);
+			if ( !position )
+				position = mBufferEnd;
+			size_t length = position - mPosition;
+			if ( !memchr(mPosition, '&', length) && !memchr(mPosition, '\r', length) )
+			{
+				size_t lineCount = 0;
+				for ( const ParserChar* c = mPosition; c < position; ++c )
+					lineCount += (*c == '\n');
+				if ( lineCount > 0 )
+				{
+					mLineNumber += lineCount;
+					const ParserChar* lastLineEnd = position - 1;
+					while ( *lastLineEnd != '\n' )
+						--lastLineEnd;
+					mLineBegin = lastLineEnd + 1;
+				}
+			}
+			else
+			{
+				position = mPosition;
+				while ( position < mBufferEnd && !TEXT_STOP_CHARACTERS[(unsigned char)*position] )
+					++position;
+			}
+
+			size_t runLength = position - mPosition;
+			if ( textEnd != mPosition )
+				memmove(textEnd, mPosition, runLength);
+			textEnd += runLength;
+			mPosition = position;
+
+			if ( mPosition == mBufferEnd )
+				break;
+
+			switch ( *mPosition )
+			{
+			case '\n':
+				++mLineNumber;
+				*textEnd++ = '\n';
+				++mPosition;
+				mLineBegin = mPosition;
+				break;
+			case '\r':
+				// "\r\n" and "\r" are normalized to "\n"
+				if ( mPosition + 1 < mBufferEnd && mPosition[1] == '\n' )
+				{
+					++mPosition;
+				}
+				else
+				{
+					++mLineNumber;
+					*textEnd++ = '\n';
+					++mPosition;
+					mLineBegin = mPosition;
+				}
+				break;
+			case '&':
+				textEnd = replaceReference(textEnd);
+				if ( !textEnd )
+					return false;
+				break;
+			default:
+				{
+					// '<'
+					size_t remaining = mBufferEnd - mPosition;
+					if ( remaining >= 4 && memcmp(mPosition, "<!--", 4) == 0 )
+					{
+						if ( !skipComment() )
+							return false;
+					}
+					else if ( remaining >= 9 && memcmp(mPosition, "<![CDATA[", 9) == 0 )
+					{
+						textEnd = moveCDataSection(textEnd);
+						if ( !textEnd )
+							return false;
+					}
+					else if ( remaining >= 2 && mPosition[1] == '!' )
+					{
+						if ( !skipDocumentTypeDeclaration() )
+							return false;
+					}
+					else if ( remaining >= 2 && mPosition[1] == '?' )
+					{
+						if ( !skipProcessingInstruction() )
+							return false;
+					}
+					else
+					{
+						// start or end tag
+						textComplete = true;
+					}
+				}
+			}
+		}
+
+		size_t textLength = textEnd - textBegin;
+		if ( textLength == 0 )
+			return true;
+
+		if ( mElementNames.empty() )
+		{
+			for ( const ParserChar* c = textBegin; c < textEnd; ++c )
+			{
+				if ( !isWhiteSpace(*c) )
+				{
+					handleError("Text outside of the root element");
+					return false;
+				}
+			}
+			return true;
+		}
+
+		return getParser()->textData(textBegin, textLength);
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::parseStartTag()
+	{
+		// skip '<'
+		++mPosition;
+
+		ParserChar next = 0;
+		const ParserChar* elementName = readName(next);
+		if ( !elementName )
+			return false;
+
+		mAttributes.clear();
+		bool isEmptyElement = false;
+		while ( true )
+		{
+			if ( isWhiteSpace(next) )
+			{
+				skipWhiteSpaces();
+				if ( mPosition == mBufferEnd )
+				{
+					handleError("Premature end of data in tag");
+					return false;
+				}
+				next = *mPosition++;
+			}
+
+			if ( next == '>' )
+				break;
+
+			if ( next == '/' )
+			{
+				if ( mPosition == mBufferEnd || *mPosition != '>' )
+				{
+					handleError("Expected '>'");
+					return false;
+				}
+				++mPosition;
+				isEmptyElement = true;
+				break;
+			}
+
+			// attribute name
+			--mPosition;
+			const ParserChar* attributeName = readName(next);
+			if ( !attributeName )
+				return false;
+
+			if ( isWhiteSpace(next) )
+			{
+				skipWhiteSpaces();
+				next = mPosition < mBufferEnd ? *mPosition++ : 0;
+			}
+			if ( next != '=' )
+			{
+				handleError("Expected '=' after attribute name");
+				return false;
+			}
+
+			skipWhiteSpaces();
+			if ( mPosition == mBufferEnd || (*mPosition != '"' && *mPosition != '\'') )
+			{
+				handleError("Expected '\"' or '''");
+				return false;
+			}
+			ParserChar quote = *mPosition++;
+
+			// attribute value, unescaped and normalized in place
+			ParserChar* attributeValue = mPosition;
+			ParserChar* valueEnd = attributeValue;
+			while ( true )
+			{
+				if ( mPosition == mBufferEnd )
+				{
+					handleError("Unterminated attribute value");
+					return false;
+				}
+
+				ParserChar c = *mPosition;
+				if ( c == quote )
+				{
+					*valueEnd = 0;
+					++mPosition;
+					break;
+				}
+
+				switch ( c )
+				{
+				case '&':
+					valueEnd = replaceReference(valueEnd);
+					if ( !valueEnd )
+						return false;
+					break;
+				case '<':
+					handleError("Unescaped '<' in attribute value");
+					return false;
+				case '\r':
+					// "\r\n" is normalized to one space
+					if ( mPosition + 1 < mBufferEnd && mPosition[1] == '\n' )
+					{
+						++mPosition;
+						break;
+					}
+					// fall through
+				case '\n':
+					++mLineNumber;
+					*valueEnd++ = ' ';
+					++mPosition;
+					mLineBegin = mPosition;
+					break;
+				case '\t':
+					*valueEnd++ = ' ';
+					++mPosition;
+					break;
+				default:
+					*valueEnd++ = c;
+					++mPosition;
+				}
+			}
+
+			mAttributes.push_back(attributeName);
+			mAttributes.push_back(attributeValue);
+
+			if ( mPosition == mBufferEnd )
+			{
+				handleError("Premature end of data in tag");
+				return false;
+			}
+			next = *mPosition++;
+			if ( !isWhiteSpace(next) && next != '>' && next != '/' )
+			{
+				handleError("Attributes must be separated by white spaces");
+				return false;
+			}
+		}
+
+		const xmlChar** attributes = 0;
+		if ( !mAttributes.empty() )
+		{
+			mAttributes.push_back(0);
+			attributes = &mAttributes[0];
+		}
+
+		Parser* parser = getParser();
+		if ( !parser->elementBegin(elementName, attributes) )
+			return false;
+
+		if ( isEmptyElement )
+			return parser->elementEnd(elementName);
+
+		if ( parser->rawContentsRequested() )
+			return parseRawContents(elementName);
+
+		mElementNames.push_back(elementName);
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::parseRawContents( const ParserChar* elementName )
+	{
+		const ParserChar* contentsBegin = mPosition;
+		size_t depth = 1;
+		while ( true )
+		{
+			ParserChar* position = (ParserChar*)memchr(mPosition, '<', mBufferEnd - mPosition);
+			if ( !position )
+			{
+				mPosition = mBufferEnd;
+				handleError("Premature end of data");
+				return false;
+			}
+			for ( ; mPosition < position; ++mPosition )
+			{
+				if ( *mPosition == '\n' )
+				{
+					++mLineNumber;
+					mLineBegin = mPosition + 1;
+				}
+			}
+
+			size_t remaining = mBufferEnd - mPosition;
+			if ( remaining >= 4 && memcmp(mPosition, "<!--", 4) == 0 )
+			{
+				if ( !skipComment() )
+					return false;
+			}
+			else if ( remaining >= 9 && memcmp(mPosition, "<![CDATA[", 9) == 0 )
+			{
+				mPosition += 9;
+				if ( !skipTo("]]>") )
+				{
+					handleError("CDATA section not terminated");
+					return false;
+				}
+				mPosition += 3;
+			}
+			else if ( remaining >= 2 && mPosition[1] == '?' )
+			{
+				if ( !skipProcessingInstruction() )
+					return false;
+			}
+			else if ( remaining >= 2 && mPosition[1] == '/' )
+			{
+				if ( --depth == 0 )
+					break;
+				++mPosition;
+			}
+			else
+			{
+				// start tag. Attribute values might contain '>'.
+				ParserChar quote = 0;
+				ParserChar previous = 0;
+				while ( true )
+				{
+					if ( ++mPosition == mBufferEnd )
+					{
+						handleError("Premature end of data in tag");
+						return false;
+					}
+					ParserChar c = *mPosition;
+					if ( c == '\n' )
+					{
+						++mLineNumber;
+						mLineBegin = mPosition + 1;
+					}
+					if ( quote )
+					{
+						if ( c == quote )
+							quote = 0;
+					}
+					else if ( c == '"' || c == '\'' )
+					{
+						quote = c;
+					}
+					else if ( c == '>' )
+					{
+						break;
+					}
+					previous = c;
+				}
+				++mPosition;
+				if ( previous != '/' )
+					++depth;
+			}
+		}
+
+		Parser* parser = getParser();
+		if ( !parser->rawContents(contentsBegin, mPosition - contentsBegin) )
+			return false;
+
+		// the end tag is parsed as usual
+		mElementNames.push_back(elementName);
+		return parseEndTag();
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::parseEndTag()
+	{
+		// skip "</"
+		mPosition += 2;
+
+		ParserChar next = 0;
+		const ParserChar* elementName = readName(next);
+		if ( !elementName )
+			return false;
+
+		if ( isWhiteSpace(next) )
+		{
+			skipWhiteSpaces();
+			next = mPosition < mBufferEnd ? *mPosition++ : 0;
+		}
+		if ( next != '>' )
+		{
+			handleError("Expected '>'");
+			return false;
+		}
+
+		if ( mElementNames.empty() || strcmp(mElementNames.back(), elementName) != 0 )
+		{
+			handleError("Opening and ending tag mismatch");
+			return false;
+		}
+		mElementNames.pop_back();
+
+		return getParser()->elementEnd(elementName);
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::skipComment()
+	{
+		mPosition += 4;
+		if ( !skipTo("-->") )
+		{
+			handleError("Comment not terminated");
+			return false;
+		}
+		mPosition += 3;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::skipProcessingInstruction()
+	{
+		const ParserChar* begin = mPosition;
+		mPosition += 2;
+		if ( !skipTo("?>") )
+		{
+			handleError("Processing instruction not terminated");
+			return false;
+		}
+
+		if ( mPosition - begin >= 6 && memcmp(begin, "<?xml", 5) == 0 && isWhiteSpace(begin[5])
+			&& !isSupportedEncoding(begin, mPosition) )
+		{
+			handleError("Unsupported encoding. Only UTF-8 encoded documents can be parsed");
+			return false;
+		}
+
+		mPosition += 2;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::skipDocumentTypeDeclaration()
+	{
+		if ( mBufferEnd - mPosition < 9 || memcmp(mPosition, "<!DOCTYPE", 9) != 0 )
+		{
+			handleError("Invalid markup declaration");
+			return false;
+		}
+		mPosition += 9;
+
+		// The internal subset might contain '>'. Quoted strings are skipped as a whole.
+		bool inInternalSubset = false;
+		while ( mPosition < mBufferEnd )
+		{
+			ParserChar c = *mPosition++;
+			switch ( c )
+			{
+			case '\n':
+				++mLineNumber;
+				mLineBegin = mPosition;
+				break;
+			case '[':
+				inInternalSubset = true;
+				break;
+			case ']':
+				inInternalSubset = false;
+				break;
+			case '"':
+			case '\'':
+				{
+					const char terminator[2] = { c, 0 };
+					if ( !skipTo(terminator) )
+						break;
+					++mPosition;
+				}
+				break;
+			case '>':
+				if ( !inInternalSubset )
+					return true;
+				break;
+			}
+		}
+
+		handleError("Document type declaration not terminated");
+		return false;
+	}
+
+	//--------------------------------------------------------------------
+	ParserChar* NativeSaxParser::moveCDataSection( ParserChar* textEnd )
+	{
+		mPosition += 9;
+		const ParserChar* dataBegin = mPosition;
+		if ( !skipTo("]]>") )
+		{
+			handleError("CDATA section not terminated");
+			return 0;
+		}
+
+		size_t dataLength = mPosition - dataBegin;
+		memmove(textEnd, dataBegin, dataLength);
+		mPosition += 3;
+		return textEnd + dataLength;
+	}
+
+	//--------------------------------------------------------------------
+	ParserChar* NativeSaxParser::replaceReference( ParserChar* output )
+	{
+		const ParserChar* referenceBegin = mPosition + 1;
+		ParserChar* referenceEnd = mPosition + 1;
+		while ( referenceEnd < mBufferEnd && *referenceEnd != ';' && (size_t)(referenceEnd - referenceBegin) < MAX_REFERENCE_LENGTH )
+			++referenceEnd;
+		if ( referenceEnd == mBufferEnd || *referenceEnd != ';' )
+		{
+			handleError("Invalid reference");
+			return 0;
+		}
+		size_t referenceLength = referenceEnd - referenceBegin;
+
+		if ( referenceLength > 1 && *referenceBegin == '#' )
+		{
+			// character reference
+			unsigned long codePoint = 0;
+			const ParserChar* digit = referenceBegin + 1;
+			bool isHex = *digit == 'x';
+			if ( isHex )
+				++digit;
+			if ( digit == referenceEnd )
+			{
+				handleError("Invalid character reference");
+				return 0;
+			}
+			for ( ; digit < referenceEnd; ++digit )
+			{
+				ParserChar c = *digit;
+				unsigned long value;
+				if ( c >= '0' && c <= '9' )
+					value = c - '0';
+				else if ( isHex && c >= 'a' && c <= 'f' )
+					value = c - 'a' + 10;
+				else if ( isHex && c >= 'A' && c <= 'F' )
+					value = c - 'A' + 10;
+				else
+				{
+					handleError("Invalid character reference");
+					return 0;
+				}
+				codePoint = codePoint * (isHex ? 16 : 10) + value;
+			}
+			if ( codePoint == 0 || codePoint > 0x10FFFF )
+			{
+				handleError("Invalid character reference");
+				return 0;
+			}
+
+			// Encode as UTF-8. The encoding is never longer than the reference.
+			if ( codePoint < 0x80 )
+			{
+				*output++ = (ParserChar)codePoint;
+			}
+			else if ( codePoint < 0x800 )
+			{
+				*output++ = (ParserChar)(0xC0 | (codePoint >> 6));
+				*output++ = (ParserChar)(0x80 | (codePoint & 0x3F));
+			}
+			else if ( codePoint < 0x10000 )
+			{
+				*output++ = (ParserChar)(0xE0 | (codePoint >> 12));
+				*output++ = (ParserChar)(0x80 | ((codePoint >> 6) & 0x3F));
+				*output++ = (ParserChar)(0x80 | (codePoint & 0x3F));
+			}
+			else
+			{
+				*output++ = (ParserChar)(0xF0 | (codePoint >> 18));
+				*output++ = (ParserChar)(0x80 | ((codePoint >> 12) & 0x3F));
+				*output++ = (ParserChar)(0x80 | ((codePoint >> 6) & 0x3F));
+				*output++ = (ParserChar)(0x80 | (codePoint & 0x3F));
+			}
+		}
+		else if ( referenceLength == 2 && memcmp(referenceBegin, "lt", 2) == 0 )
+			*output++ = '<';
+		else if ( referenceLength == 2 && memcmp(referenceBegin, "gt", 2) == 0 )
+			*output++ = '>';
+		else if ( referenceLength == 3 && memcmp(referenceBegin, "amp", 3) == 0 )
+			*output++ = '&';
+		else if ( referenceLength == 4 && memcmp(referenceBegin, "quot", 4) == 0 )
+			*output++ = '"';
+		else if ( referenceLength == 4 && memcmp(referenceBegin, "apos", 4) == 0 )
+			*output++ = '\'';
+		else
+		{
+			handleError("Entity not defined");
+			return 0;
+		}
+
+		mPosition = referenceEnd + 1;
+		return output;
+	}
+
+	//--------------------------------------------------------------------
+	void NativeSaxParser::skipWhiteSpaces()
+	{
+		while ( mPosition < mBufferEnd && isWhiteSpace(*mPosition) )
+		{
+			if ( *mPosition++ == '\n' )
+			{
+				++mLineNumber;
+				mLineBegin = mPosition;
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------
+	bool NativeSaxParser::skipTo( const char* terminator )
+	{
+		size_t terminatorLength = strlen(terminator);
+		while ( mPosition + terminatorLength <= mBufferEnd )
+		{
+			if ( *mPosition == *terminator && memcmp(mPosition, terminator, terminatorLength) == 0 )
+				return true;
+			if ( *mPosition++ == '\n' )
+			{
+				++mLineNumber;
+				mLineBegin = mPosition;
+			}
+		}
+		mPosition = mBufferEnd;
+		return false;
+	}
+
+	//--------------------------------------------------------------------
+	const ParserChar* NativeSaxParser::readName( ParserChar& nameEnd )
+	{
+		ParserChar* name = mPosition;
+		while ( mPosition < mBufferEnd && !isNameEnd(*mPosition) )
+			++mPosition;
+
+		if ( mPosition == mBufferEnd )
+		{
+			handleError("Premature end of data in tag");
+			return 0;
+		}
+		if ( mPosition == name )
+		{
+			handleError("Expected a name");
+			return 0;
+		}
+
+		nameEnd = *mPosition;
+		*mPosition++ = 0;
+		if ( nameEnd == '\n' )
+		{
+			++mLineNumber;
+			mLineBegin = mPosition;
+		}
+		return name;
+	}
+
+	//--------------------------------------------------------------------
+	size_t NativeSaxParser::getLineNumer() const
+	{
+		return mLineNumber;
+	}
+
+	//--------------------------------------------------------------------
+	size_t NativeSaxParser::getColumnNumer() const
+	{
+		return mPosition ? (size_t)(mPosition - mLineBegin) + 1 : 0;
+	}
+
+	//--------------------------------------------------------------------
+	size_t NativeSaxParser::getByteOffset() const
+	{
+		return mPosition ? (size_t)(mPosition - mBuffer) : 0;
+	}
+
+	//--------------------------------------------------------------------
+	void NativeSaxParser::handleError( const char* message )
+	{
+		ParserError error(ParserError::SEVERITY_CRITICAL,
+						  ParserError::ERROR_XML_PARSER_ERROR,
+						  0,
+						  0,
+						  getLineNumer(),
+						  getColumnNumer(),
+						  message);
+		IErrorHandler* errorHandler = getParser()->getErrorHandler();
+		if ( errorHandler )
+			errorHandler->handleError(error);
+	}
+
+} // namespace GeneratedSaxParser
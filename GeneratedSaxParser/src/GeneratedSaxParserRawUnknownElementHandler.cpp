@@ -16,6 +16,7 @@ namespace GeneratedSaxParser
 {
 	//--------------------------------------------------------------------
 	RawUnknownElementHandler::RawUnknownElementHandler()
+		: mCaptureRawContents( false )
 	{
 	}
 	
@@ -110,4 +111,16 @@ namespace GeneratedSaxParser
 		return true;
 	}
 
+	//--------------------------------------------------------------------
+	bool RawUnknownElementHandler::rawContents( const ParserChar* contents, size_t length )
+	{
+		if ( length == 0 )
+			return true;
+
+		prepareToAddContents();
+		mRawData.append( contents, length );
+		mOpenTags.top().mHasText = true;
+		return true;
+	}
+
 } // namespace GeneratedSaxParser
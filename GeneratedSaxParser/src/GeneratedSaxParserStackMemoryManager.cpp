@@ -17,16 +17,14 @@ namespace GeneratedSaxParser
 	StackMemoryManager::StackMemoryManager(size_t stackSize)
 		: mActiveFrame(0)
     {
-        mFrames = new StackFrame[ MAX_NUM_OF_FRAMES ];
-		mFrames[ mActiveFrame ] = StackFrame(stackSize, new char[stackSize]);
+		mFrames.push_back( StackFrame(stackSize, new char[stackSize]) );
 	}
 	
 	//--------------------------------------------------------------------
 	StackMemoryManager::~StackMemoryManager()
 	{
-        for (size_t i=mActiveFrame+1; i>0; --i)
+        for (size_t i=mFrames.size(); i>0; --i)
 			delete[] mFrames[ i-1 ].mMemoryBlob;
-        delete[] mFrames;
 	}
 
 	//--------------------------------------------------------------------
@@ -59,10 +57,11 @@ namespace GeneratedSaxParser
 	void StackMemoryManager::deleteObject()
 	{
         mFrames[ mActiveFrame ].mCurrentPosition -= ( getTopObjectSize() + sizeof(mFrames[ mActiveFrame ].mCurrentPosition) );
-        while ( mFrames[ mActiveFrame ].mCurrentPosition == 0 && mActiveFrame != 0 )
+        if ( mFrames[ mActiveFrame ].mCurrentPosition == 0 && mActiveFrame != 0 )
         {
-            delete[] mFrames[ mActiveFrame ].mMemoryBlob;
-            mFrames[ mActiveFrame-- ].mMemoryBlob = 0;
+            while ( mFrames[ mActiveFrame ].mCurrentPosition == 0 && mActiveFrame != 0 )
+                mActiveFrame--;
+            releaseSpareFrames();
         }
 	}
 
@@ -118,14 +117,29 @@ namespace GeneratedSaxParser
     //-----------------------------------------------------------------
     bool StackMemoryManager::allocateMoreMemory()
     {
-        if ( mActiveFrame == MAX_NUM_OF_FRAMES-1 )
-            return false;
+        if ( mActiveFrame+1 < mFrames.size() )
+        {
+            // reuse spare frame
+            mFrames[ ++mActiveFrame ].mCurrentPosition = 0;
+            return true;
+        }
         size_t sizeOfNewBlob = mFrames[ mActiveFrame ].mMaxMemoryBlob * SIZE_OF_NEW_FRAME_FACTOR;
         char* newMem = new char[sizeOfNewBlob];
         if (!newMem)
             return false;
-        mFrames[ ++mActiveFrame ] = StackFrame(sizeOfNewBlob, newMem);
+        mFrames.push_back( StackFrame(sizeOfNewBlob, newMem) );
+        ++mActiveFrame;
         return true;
     }
 
+    //-----------------------------------------------------------------
+    void StackMemoryManager::releaseSpareFrames()
+    {
+        while ( mFrames.size() > mActiveFrame+2 )
+        {
+            delete[] mFrames.back().mMemoryBlob;
+            mFrames.pop_back();
+        }
+    }
+
 } // namespace GeneratedSaxParser
@@ -0,0 +1,110 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of GeneratedSaxParser.
+
+    Licensed under the MIT Open Source License, 
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "GeneratedSaxParserStringTable.h"
+#include "GeneratedSaxParserUtils.h"
+
+#include <string.h>
+
+
+namespace GeneratedSaxParser
+{
+
+	const StringTable::SymbolId StringTable::INVALID_SYMBOL = (StringTable::SymbolId)-1;
+
+	/** The number of buckets of a new string table. Must be a power of two.*/
+	static const size_t INITIAL_BUCKET_COUNT = 256;
+
+	//--------------------------------------------------------------------
+	StringTable::StringTable()
+		: mBuckets(INITIAL_BUCKET_COUNT, 0)
+	{
+	}
+
+	//--------------------------------------------------------------------
+	StringTable::~StringTable()
+	{
+	}
+
+	//--------------------------------------------------------------------
+	size_t StringTable::findBucket( const ParserChar* str, size_t length, StringHash hash ) const
+	{
+		const size_t mask = mBuckets.size() - 1;
+		size_t bucket = hash & mask;
+		while ( true )
+		{
+			SymbolId entry = mBuckets[bucket];
+			if ( entry == 0 )
+				return bucket;
+
+			SymbolId symbolId = entry - 1;
+			if ( mHashes[symbolId] == hash )
+			{
+				const String& string = mStrings[symbolId];
+				if ( (string.length() == length) && (memcmp(string.data(), str, length) == 0) )
+					return bucket;
+			}
+			bucket = (bucket + 1) & mask;
+		}
+	}
+
+	//--------------------------------------------------------------------
+	StringTable::SymbolId StringTable::intern( const ParserChar* str, size_t length )
+	{
+		StringHash hash = Utils::calculateStringHash(str, length);
+		size_t bucket = findBucket(str, length, hash);
+		SymbolId entry = mBuckets[bucket];
+		if ( entry != 0 )
+			return entry - 1;
+
+		SymbolId symbolId = (SymbolId)mStrings.size();
+		mStrings.push_back(String(str, length));
+		mHashes.push_back(hash);
+		mBuckets[bucket] = symbolId + 1;
+
+		// keep the load factor below one half
+		if ( 2 * mStrings.size() > mBuckets.size() )
+			grow();
+
+		return symbolId;
+	}
+
+	//--------------------------------------------------------------------
+	StringTable::SymbolId StringTable::find( const ParserChar* str, size_t length ) const
+	{
+		StringHash hash = Utils::calculateStringHash(str, length);
+		SymbolId entry = mBuckets[findBucket(str, length, hash)];
+		return entry == 0 ? INVALID_SYMBOL : entry - 1;
+	}
+
+	//--------------------------------------------------------------------
+	void StringTable::grow()
+	{
+		BucketList buckets(2 * mBuckets.size(), 0);
+		const size_t mask = buckets.size() - 1;
+		for ( size_t symbolId = 0, count = mStrings.size(); symbolId < count; ++symbolId )
+		{
+			size_t bucket = mHashes[symbolId] & mask;
+			while ( buckets[bucket] != 0 )
+				bucket = (bucket + 1) & mask;
+			buckets[bucket] = (SymbolId)symbolId + 1;
+		}
+		mBuckets.swap(buckets);
+	}
+
+	//--------------------------------------------------------------------
+	void StringTable::clear()
+	{
+		StringList().swap(mStrings);
+		StringHashList().swap(mHashes);
+		BucketList(INITIAL_BUCKET_COUNT, 0).swap(mBuckets);
+	}
+
+} // namespace GeneratedSaxParser
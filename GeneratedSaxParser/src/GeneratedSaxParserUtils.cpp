@@ -1520,6 +1520,95 @@ namespace GeneratedSaxParser
         return false;
     }
 
+	/** Maps each character to its value as hexadecimal digit. White spaces are mapped to HEX_WHITE_SPACE,
+	all other characters to HEX_INVALID. Both have the high bit set, which allows to check a run of
+	characters by or-ing their values.*/
+	static const unsigned char HEX_WHITE_SPACE = 0x40;
+	static const unsigned char HEX_INVALID = 0x80;
+	static const unsigned char HEX_DIGIT_VALUES[256] =
+	{
+		/* 0x00 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x40, 0x80, 0x80, 0x40, 0x80, 0x80,
+		/* 0x10 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0x20 */ 0x40, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0x30 */ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0x40 */ 0x80, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0x50 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0x60 */ 0x80, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0x70 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0x80 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0x90 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0xa0 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0xb0 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0xc0 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0xd0 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0xe0 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+		/* 0xf0 */ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+	};
+
+	//--------------------------------------------------------------------
+	size_t Utils::hexBinaryToBytes( const ParserChar** buffer, const ParserChar* bufferEnd, uint8* output, size_t outputSize, int& pendingDigit, bool& failed )
+	{
+		const unsigned char* s = (const unsigned char*)*buffer;
+		const unsigned char* end = (const unsigned char*)bufferEnd;
+		uint8* out = output;
+		uint8* outEnd = output + outputSize;
+		failed = false;
+
+		while ( (s != end) && (out != outEnd) )
+		{
+			// Fast path: decode 16 digits at once, if none of them is a white space or invalid
+			if ( (pendingDigit < 0) && (end - s >= 16) && (outEnd - out >= 8) )
+			{
+				unsigned char v[16];
+				unsigned char flags = 0;
+				for ( int i = 0; i < 16; ++i )
+				{
+					v[i] = HEX_DIGIT_VALUES[s[i]];
+					flags |= v[i];
+				}
+				if ( (flags & (HEX_WHITE_SPACE | HEX_INVALID)) == 0 )
+				{
+					for ( int i = 0; i < 8; ++i )
+						out[i] = (uint8)((v[2 * i] << 4) | v[2 * i + 1]);
+					s += 16;
+					out += 8;
+					continue;
+				}
+			}
+
+			// Slow path: decode the next at most 16 characters one by one
+			const unsigned char* blockEnd = (end - s > 16) ? s + 16 : end;
+			while ( (s != blockEnd) && (out != outEnd) )
+			{
+				unsigned char value = HEX_DIGIT_VALUES[*s];
+				if ( value == HEX_WHITE_SPACE )
+				{
+					++s;
+					continue;
+				}
+				if ( value == HEX_INVALID )
+				{
+					failed = true;
+					*buffer = (const ParserChar*)s;
+					return out - output;
+				}
+				++s;
+				if ( pendingDigit < 0 )
+				{
+					pendingDigit = value;
+				}
+				else
+				{
+					*out++ = (uint8)((pendingDigit << 4) | value);
+					pendingDigit = -1;
+				}
+			}
+		}
+
+		*buffer = (const ParserChar*)s;
+		return out - output;
+	}
+
     //--------------------------------------------------------------------
     template<typename T>
     bool GeneratedSaxParser::Utils::isInf( T value )
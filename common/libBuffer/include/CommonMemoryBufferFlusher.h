@@ -0,0 +1,79 @@
+/*
+    Copyright (c) 2009 NetAllied Systems GmbH
+
+    This file is part of Common libBuffer.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __COMMON_MEMORYBUFFERFLUSHER_H__
+#define __COMMON_MEMORYBUFFERFLUSHER_H__
+
+#include "CommonIBufferFlusher.h"
+
+#include <vector>
+#include <map>
+
+namespace Common
+{
+	/** Flusher that collects all received data in memory, e.g. to copy it into another buffer later on.*/
+	class MemoryBufferFlusher : public IBufferFlusher
+	{
+	private:
+		typedef std::map<MarkId, size_t> MarkIdToPos;
+
+	private:
+		/** The data received so far.*/
+		std::vector<char> mData;
+
+		/** The position the next received data is written to. Equals the size of mData, unless we
+		jumped to a mark.*/
+		size_t mCurrentPos;
+
+		MarkId mLastMarkId;
+
+		MarkIdToPos mMarkIds;
+
+	public:
+		/** Constructor.
+		@param reserveSize The number of bytes to reserve memory for in advance.*/
+		MemoryBufferFlusher( size_t reserveSize = 0 );
+		virtual ~MemoryBufferFlusher();
+
+		/** There are no errors, besides running out of memory.*/
+		int getError() const { return 0; }
+
+		/** Receives and handles @a length bytes starting at @a buffer.
+		@return True on success, false otherwise.*/
+		virtual bool receiveData( const char* buffer, size_t length);
+
+		/** Does nothing, the data is already in memory.*/
+		virtual bool flush();
+
+		void startMark();
+
+		IBufferFlusher::MarkId endMark();
+
+		bool jumpToMark(IBufferFlusher::MarkId markId, bool keepMarkId = false);
+
+		/** The data received so far. Only valid until the next call of receiveData.*/
+		const char* getData() const { return mData.empty() ? 0 : &mData[0]; }
+
+		/** The number of bytes received so far.*/
+		size_t getDataSize() const { return mData.size(); }
+
+		/** Discards all received data and marks.*/
+		void clear();
+
+	private:
+        /** Disable default copy ctor. */
+		MemoryBufferFlusher( const MemoryBufferFlusher& pre );
+        /** Disable default assignment operator. */
+		const MemoryBufferFlusher& operator= ( const MemoryBufferFlusher& pre );
+
+	};
+} // namespace COMMON
+
+#endif // __COMMON_MEMORYBUFFERFLUSHER_H__
@@ -0,0 +1,100 @@
+/*
+    Copyright (c) 2009 NetAllied Systems GmbH
+
+    This file is part of Common libBuffer.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "CommonMemoryBufferFlusher.h"
+
+#include <string.h>
+
+namespace Common
+{
+	//--------------------------------------------------------------------
+	MemoryBufferFlusher::MemoryBufferFlusher( size_t reserveSize /*= 0*/ )
+		: mData()
+		, mCurrentPos(0)
+		, mLastMarkId(END_OF_STREAM)
+		, mMarkIds()
+	{
+		mData.reserve( reserveSize );
+	}
+
+	//--------------------------------------------------------------------
+	MemoryBufferFlusher::~MemoryBufferFlusher()
+	{
+	}
+
+	//--------------------------------------------------------------------
+	bool MemoryBufferFlusher::receiveData( const char* buffer, size_t length )
+	{
+		if ( length == 0 )
+		{
+			return true;
+		}
+
+		size_t endPos = mCurrentPos + length;
+		if ( endPos > mData.size() )
+		{
+			mData.resize( endPos );
+		}
+		memcpy( &mData[mCurrentPos], buffer, length );
+		mCurrentPos = endPos;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	bool MemoryBufferFlusher::flush()
+	{
+		return true;
+	}
+
+	//------------------------------
+	void MemoryBufferFlusher::startMark()
+	{
+		mLastMarkId++;
+		mMarkIds.insert(std::make_pair(mLastMarkId, mCurrentPos));
+	}
+
+	//------------------------------
+	IBufferFlusher::MarkId MemoryBufferFlusher::endMark()
+	{
+		return mLastMarkId;
+	}
+
+	//------------------------------
+	bool MemoryBufferFlusher::jumpToMark( IBufferFlusher::MarkId markId, bool keepMarkId /*= false*/ )
+	{
+		if ( markId == END_OF_STREAM )
+		{
+			mCurrentPos = mData.size();
+			return true;
+		}
+
+		MarkIdToPos::iterator markIdIt = mMarkIds.find(markId);
+		if ( markIdIt == mMarkIds.end() )
+		{
+			return false;
+		}
+
+		mCurrentPos = markIdIt->second;
+		if ( !keepMarkId )
+		{
+			mMarkIds.erase(markIdIt);
+		}
+		return true;
+	}
+
+	//------------------------------
+	void MemoryBufferFlusher::clear()
+	{
+		mData.clear();
+		mCurrentPos = 0;
+		mMarkIds.clear();
+	}
+
+} // namespace Common
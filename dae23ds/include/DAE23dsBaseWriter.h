@@ -80,6 +80,14 @@ namespace DAE23ds
 
 		const Writer::MeshData& getMeshData( const COLLADAFW::UniqueId& meshUniqueId ) const;
 
+		/** Stores the blocks @a meshBlocks the mesh with unique id @a meshUniqueId has been split into. The
+		writer takes ownership of @a meshBlocks.*/
+		void addMeshBlocks( const COLLADAFW::UniqueId& meshUniqueId, MeshBlocks* meshBlocks );
+
+		/** Returns the blocks stored by addMeshBlocks() for the mesh with unique id @a meshUniqueId and removes them
+		from the writer. The caller takes ownership. Null is returned, if the mesh has not been split.*/
+		MeshBlocks* releaseMeshBlocks( const COLLADAFW::UniqueId& meshUniqueId );
+
 		Writer::UniqueIdNodeMap& getUniqueIdNodeMap() { return mWriter->getUniqueIdNodeMap(); }
 
 		/** The Object Id of the next object that will be exported.*/
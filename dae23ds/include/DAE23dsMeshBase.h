@@ -24,19 +24,10 @@ namespace DAE23ds
 	class MeshBase : public BaseWriter
 	{
 	protected:
-		/** Used */
-		struct ObjectBlockData
-		{
-			//			ChunkLength verticesCount;	
-			CountType trianglesCount;
-			size_t firstTriangleIndex;
-		};
-
 		struct WriteMeshIntoMultipleObjectsData
 		{
+			/** The length of all the objects the mesh is written into.*/
 			ChunkLength editObjectLength;
-			ChunkLength fullBlocksCount;
-			ChunkLength remainingTriangles;
 		};
 
 
@@ -68,8 +59,6 @@ namespace DAE23ds
 
 		/** handles the mesh.*/
 		bool handle();
-
-		static void calculateBlockCountAndRemainingTriangles( size_t trianglesCount, ChunkLength& remainingTriangles, ChunkLength& blockCount, ChunkLength& fullBlockCount);
 	
 	private:
 
@@ -106,14 +95,11 @@ namespace DAE23ds
 		/** Calculates the length of the vertices for a mesh with  (verticesCount_times3 / 3) vertices.*/
 		ChunkLength calculateVerticesLength(ChunkLength verticesCount_times3);
 
-		/** Calculates the length of all the vertices of the current mesh, if written into multiple objects.*/
-		ChunkLength calculateTotalVerticesLengthMultiObject(size_t trianglesCount, ChunkLength blockCount );
-
 		/** Calculates the length of the object of the current mesh given the length of the triangular mesh.*/
 		ChunkLength calculateObjectLength(ChunkLength triangularMeshLength);
 
-		/** Calculates the length of all the object of the current mesh given the length of the triangular mesh.*/
-		ChunkLength calculateTotalObjectLengthMultiObject(ChunkLength triangularMeshLength, ChunkLength blockCount);
+		/** Calculates the lengths of an object with @a verticesCount vertices and @a trianglesCount triangles.*/
+		void calculateObjectLengths(CountType verticesCount, CountType trianglesCount, const COLLADAFW::MaterialBindingArray& materialBindings, WriteMeshIntoOneObject& data);
 
 		/** Calculates the number of triangles in the mesh.*/
 		size_t calculateTrianglesCount();
@@ -127,9 +113,6 @@ namespace DAE23ds
 		/** Calculates the length of the faces description, given the number of triangles.*/
 		ChunkLength calculateFacesDescriptionLength(CountType trianglesCount, ChunkLength facesMaterialsLength);
 
-		/** Calculates the length of the faces description, given the number of triangles and blocks. The calculated size is for all object blocks.*/
-		ChunkLength calculateFacesDescriptionLengthMultiObject(size_t trianglesCount, ChunkLength blockCount, ChunkLength facesMaterialsLength, ChunkLength remainderFacesMaterialsLength, ChunkLength fullBlocksCount);
-
 		bool splitMeshInChunks();
 		
 //		ChunkLength calculateMaterialNameLengthFromMaterialBinding( const COLLADAFW::InstanceGeometry::MaterialBinding& materialBinding);
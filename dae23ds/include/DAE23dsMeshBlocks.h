@@ -0,0 +1,113 @@
+/*
+    Copyright (c) 2009 NetAllied Systems GmbH
+
+    This file is part of dae23ds.
+	
+    Licensed under the MIT Open Source License, 
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __DAE23DS_MESHBLOCKS_H__
+#define __DAE23DS_MESHBLOCKS_H__
+
+#include "DAE23dsPrerequisites.h"
+#include "DAE23dsWriter.h"
+#include "DAE23dsTriangle.h"
+
+#include <vector>
+
+
+namespace DAE23ds
+{
+	class MeshAccessor;
+
+	/** The blocks a mesh is split into, to write it into multiple objects, if it has too many vertices or 
+	triangles to be addressed with the 16 bit indices of .3ds files. It is filled by MeshSpliter as its
+	triangle handler.*/
+	class MeshBlocks 	
+	{
+	public:
+		typedef Triangle<IndexType> TriangleType;
+
+		/** A block of the mesh.*/
+		struct Block
+		{
+			/** Index of the first vertex of the block in the vertices of all blocks.*/
+			size_t firstVertex;
+
+			/** Number of vertices of the block.*/
+			CountType verticesCount;
+
+			/** Index of the first triangle of the block in the triangles of all blocks.*/
+			size_t firstTriangle;
+
+			/** Number of triangles of the block.*/
+			CountType trianglesCount;
+		};
+
+		typedef std::vector<Block> BlockList;
+
+	private:
+
+		/** The blocks.*/
+		BlockList mBlocks;
+
+		/** The indices of the positions of the mesh of the vertices of all blocks, block by block.*/
+		std::vector<unsigned int> mVertexIndices;
+
+		/** The triangles of all blocks, block by block. Their indices refer to the vertices of their block.*/
+		std::vector<TriangleType> mTriangles;
+	
+	public:
+
+        /** Constructor. */
+		MeshBlocks();
+
+        /** Destructor. */
+		virtual ~MeshBlocks();
+
+		/** Returns true, if a mesh with @a verticesCount vertices and @a trianglesCount triangles
+		has to be split into multiple objects.*/
+		static bool isSplittingRequired( size_t verticesCount, size_t trianglesCount );
+
+		/** Splits the mesh accessed by @a meshAccessor into blocks, that fit into one object each.*/
+		bool split( const MeshAccessor& meshAccessor );
+
+		/** Appends the sizes of all blocks to @a blockSizes.*/
+		void getBlockSizes( Writer::BlockSizeList& blockSizes ) const;
+
+		/** Returns the number of blocks.*/
+		size_t getBlocksCount() const { return mBlocks.size(); }
+
+		/** Returns the @a index'th block.*/
+		const Block& getBlock( size_t index ) const { return mBlocks[index]; }
+
+		/** Returns the index of the position of the @a n'th vertex of all blocks.*/
+		unsigned int getVertexIndex( size_t n ) const { return mVertexIndices[n]; }
+
+		/** Returns the @a n'th triangle of all blocks.*/
+		const TriangleType& getTriangle( size_t n ) const { return mTriangles[n]; }
+
+		/** Called by the MeshSpliter, when a new block starts.*/
+		void handleNewBlock();
+
+		/** Called by the MeshSpliter, when the vertex with position index @a index is added to the current block.*/
+		void handleVertex( unsigned int index );
+
+		/** Called by the MeshSpliter, when @a triangle is added to the current block.*/
+		void handleTriangle( const TriangleType& triangle );
+
+	private:
+
+        /** Disable default copy ctor. */
+		MeshBlocks( const MeshBlocks& pre );
+
+        /** Disable default assignment operator. */
+		const MeshBlocks& operator= ( const MeshBlocks& pre );
+
+	};
+
+} // namespace DAE23ds
+
+#endif // __DAE23DS_MESHBLOCKS_H__
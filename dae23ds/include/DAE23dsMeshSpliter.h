@@ -13,6 +13,9 @@
 
 #include "DAE23dsPrerequisites.h"
 #include "DAE23dsBitSet.h"
+#include "DAE23dsTriangle.h"
+
+#include <vector>
 
 namespace COLLADAFW
 {
@@ -22,6 +25,23 @@ namespace COLLADAFW
 namespace DAE23ds
 {
 
+	/** Splits a mesh into blocks, whose vertices can be addressed with indices of type @a _HandlerIndexType,
+	e.g. 16 bit indices as required by .3ds files.
+	The blocks are grown from a seed triangle by adding all the remaining triangles of the vertices of the block,
+	in the order the vertices have been added to the block. This keeps the blocks compact, such that most of
+	their vertices are shared by multiple triangles and only the vertices on the borders between blocks are
+	duplicated. Each triangle, each vertex, and each entry in the adjacency of the vertices is visited a 
+	constant number of times, i.e. the splitting runs in linear time.
+	The spliter does not use any shared state, different meshes can be split in parallel.
+
+	@a MeshAccessor must provide getTrianglesCount(), getTriangle() and getNextTriangle() like DAE23ds::MeshAccessor.
+	@a TriangleHandler must provide the following methods, which are called in this order for each block:
+	- handleNewBlock(): A new block starts.
+	- handleVertex( AccessorIndexType index ): The vertex @a index of the mesh is added to the block. Its index
+	  in the block is the number of calls of handleVertex() since the last call of handleNewBlock().
+	- handleTriangle( const HandlerTriangle& triangle ): The triangle is added to the block. Its indices are 
+	  the indices in the block.
+	Calls of handleVertex() and handleTriangle() are interleaved. The vertices of a triangle are passed before the triangle.*/
 	template<class MeshAccessor, class _AccessorIndexType, class TriangleHandler, class _HandlerIndexType>
 	class MeshSpliter 	
 	{
@@ -31,6 +51,9 @@ namespace DAE23ds
 
 		typedef Triangle<AccessorIndexType> AccessorTriangle; 
 		typedef Triangle<HandlerIndexType> HandlerTriangle; 
+
+		typedef std::vector<AccessorTriangle> AccessorTriangleList;
+
 	private:
 
 		/** The mesh accessor of the mesh to split. */
@@ -45,12 +68,18 @@ namespace DAE23ds
 		/** bitset to store which triangle has already been handled true = "is exported"*/
 		BitSet mHandledTriangles;
 
+		/** Maximal number of vertices per block.*/
+		size_t mMaxVerticesPerBlock;
+
 		/** Maximal number of tringles per block.*/
 		size_t mMaxTrianglesPerBlock;
 	
 	public:
-        /** Constructor. */
-		MeshSpliter( const MeshAccessor& meshAccessor, TriangleHandler& triangleHandler);
+        /** Constructor. 
+		@param maxVerticesPerBlock The maximal number of vertices per block. Must not exceed the number of values
+		of HandlerIndexType.
+		@param maxTrianglesPerBlock The maximal number of triangles per block.*/
+		MeshSpliter( const MeshAccessor& meshAccessor, TriangleHandler& triangleHandler, size_t maxVerticesPerBlock, size_t maxTrianglesPerBlock );
 
         /** Destructor. */
 		virtual ~MeshSpliter();
@@ -58,7 +87,8 @@ namespace DAE23ds
 		/** Performances the splitting of the mesh.*/
 		bool split();
 
-		/** Performances the splitting of the mesh.*/
+		/** Passes the triangles of the mesh in the original order to the triangle handler, in one block, without
+		splitting.*/
 		bool splitTest();
 
 	private:
@@ -69,6 +99,9 @@ namespace DAE23ds
         /** Disable default assignment operator. */
 		const MeshSpliter& operator= ( const MeshSpliter& pre );
 
+		/** Reads all triangles of the mesh into @a triangles and returns the number of vertices referenced by them.*/
+		size_t readTriangles( AccessorTriangleList& triangles );
+
 	};
 
 } // namespace DAE23ds
@@ -19,13 +19,16 @@ namespace DAE23ds
 
 	//------------------------------
 	template<class MeshAccessor, class _AccessorIndexType, class TriangleHandler, class _HandlerIndexType>
-	MeshSpliter<MeshAccessor, _AccessorIndexType, TriangleHandler, _HandlerIndexType>::MeshSpliter( const MeshAccessor& meshAccessor, TriangleHandler& triangleHandler)
+	MeshSpliter<MeshAccessor, _AccessorIndexType, TriangleHandler, _HandlerIndexType>::MeshSpliter( const MeshAccessor& meshAccessor, TriangleHandler& triangleHandler, size_t maxVerticesPerBlock, size_t maxTrianglesPerBlock )
 		: mMeshAccessor(meshAccessor)
 		, mTriangleHandler(triangleHandler)
-		, mTrianglesCount( mMeshAccessor.getTrianglesCount())
+		, mTrianglesCount( (AccessorIndexType)mMeshAccessor.getTrianglesCount())
 		, mHandledTriangles( mTrianglesCount, false )
+		, mMaxVerticesPerBlock( maxVerticesPerBlock )
+		, mMaxTrianglesPerBlock( maxTrianglesPerBlock )
 	{
-
+		assert( mMaxVerticesPerBlock >= 3 );
+		assert( mMaxTrianglesPerBlock >= 1 );
 	}
 
 
@@ -41,13 +44,17 @@ namespace DAE23ds
 	bool 
 		DAE23ds::MeshSpliter<MeshAccessor, _AccessorIndexType, TriangleHandler, _HandlerIndexType>::splitTest()
 	{
+		if ( mTrianglesCount == 0 )
+			return true;
 
 		//testing
-		AccessorIndexType count = mMeshAccessor.getTrianglesCount();
+		mTriangleHandler.handleNewBlock();
+		AccessorIndexType count = mTrianglesCount;
 		AccessorTriangle triAccessor = mMeshAccessor.getTriangle( 0 );
 		HandlerTriangle triHandler((HandlerIndexType)triAccessor.indices[0], 
 			(HandlerIndexType)triAccessor.indices[1], 
-			(HandlerIndexType)triAccessor.indices[2]);
+			(HandlerIndexType)triAccessor.indices[2],
+			triAccessor.materialId);
 		mTriangleHandler.handleTriangle(triHandler);
 
 
@@ -56,18 +63,165 @@ namespace DAE23ds
 			AccessorTriangle triAccessor = mMeshAccessor.getNextTriangle( );
 			HandlerTriangle triHandler((HandlerIndexType)triAccessor.indices[0], 
 				(HandlerIndexType)triAccessor.indices[1], 
-				(HandlerIndexType)triAccessor.indices[2]);
+				(HandlerIndexType)triAccessor.indices[2],
+				triAccessor.materialId);
 			mTriangleHandler.handleTriangle(triHandler);
 		}
 		return true;
 	}
 
+	//------------------------------
+	template<class MeshAccessor, class _AccessorIndexType, class TriangleHandler, class _HandlerIndexType>
+	size_t 
+		DAE23ds::MeshSpliter<MeshAccessor, _AccessorIndexType, TriangleHandler, _HandlerIndexType>::readTriangles( AccessorTriangleList& triangles )
+	{
+		triangles.reserve( mTrianglesCount );
+		size_t verticesCount = 0;
+		for ( AccessorIndexType i = 0; i < mTrianglesCount; ++i)
+		{
+			triangles.push_back( (i == 0) ? mMeshAccessor.getTriangle( 0 ) : mMeshAccessor.getNextTriangle() );
+			const AccessorTriangle& triangle = triangles.back();
+			for ( size_t j = 0; j < 3; ++j )
+			{
+				if ( (size_t)triangle.indices[j] >= verticesCount )
+					verticesCount = (size_t)triangle.indices[j] + 1;
+			}
+		}
+		return verticesCount;
+	}
+
 	//------------------------------
 	template<class MeshAccessor, class _AccessorIndexType, class TriangleHandler, class _HandlerIndexType>
 	bool 
 		DAE23ds::MeshSpliter<MeshAccessor, _AccessorIndexType, TriangleHandler, _HandlerIndexType>::split()
 	{
+		if ( mTrianglesCount == 0 )
+			return true;
+
+		AccessorTriangleList triangles;
+		const size_t verticesCount = readTriangles( triangles );
 
+		// the triangles that use a vertex v are stored at adjacency[adjacencyOffsets[v]...adjacencyOffsets[v+1]-1]
+		std::vector<AccessorIndexType> adjacencyOffsets( verticesCount + 1, 0 );
+		for ( AccessorIndexType i = 0; i < mTrianglesCount; ++i)
+		{
+			const AccessorTriangle& triangle = triangles[i];
+			++adjacencyOffsets[triangle.indices[0] + 1];
+			++adjacencyOffsets[triangle.indices[1] + 1];
+			++adjacencyOffsets[triangle.indices[2] + 1];
+		}
+		for ( size_t i = 0; i < verticesCount; ++i)
+		{
+			adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+		}
+
+		std::vector<AccessorIndexType> adjacency( 3 * (size_t)mTrianglesCount );
+		// the next entry in the adjacency of each vertex, that might not have been handled yet
+		std::vector<AccessorIndexType> adjacencyCursors( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+		for ( AccessorIndexType i = 0; i < mTrianglesCount; ++i)
+		{
+			const AccessorTriangle& triangle = triangles[i];
+			adjacency[adjacencyCursors[triangle.indices[0]]++] = i;
+			adjacency[adjacencyCursors[triangle.indices[1]]++] = i;
+			adjacency[adjacencyCursors[triangle.indices[2]]++] = i;
+		}
+		adjacencyCursors.assign( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+
+		// the block each vertex has been added to last and its index in that block
+		const size_t NO_BLOCK = (size_t)-1;
+		std::vector<size_t> vertexBlocks( verticesCount, NO_BLOCK );
+		std::vector<HandlerIndexType> vertexIndicesInBlock( verticesCount );
+
+		// the vertices of the current block, in the order they have been added
+		std::vector<AccessorIndexType> blockVertices;
+		blockVertices.reserve( mMaxVerticesPerBlock );
+		size_t nextBlockVertex = 0;
+
+		size_t blockIndex = 0;
+		size_t blockTrianglesCount = 0;
+		AccessorIndexType nextSeedTriangle = 0;
+
+		mTriangleHandler.handleNewBlock();
+
+		for ( AccessorIndexType handledTrianglesCount = 0; handledTrianglesCount < mTrianglesCount; ++handledTrianglesCount )
+		{
+			// find the next triangle, that uses a vertex of the current block
+			AccessorIndexType triangleIndex = 0;
+			bool triangleFound = false;
+			while ( !triangleFound && (nextBlockVertex < blockVertices.size()) )
+			{
+				AccessorIndexType vertex = blockVertices[nextBlockVertex];
+				AccessorIndexType& cursor = adjacencyCursors[vertex];
+				AccessorIndexType adjacencyEnd = adjacencyOffsets[vertex + 1];
+				while ( (cursor < adjacencyEnd) && mHandledTriangles.getBit( adjacency[cursor] ) )
+				{
+					++cursor;
+				}
+				if ( cursor < adjacencyEnd )
+				{
+					triangleIndex = adjacency[cursor];
+					triangleFound = true;
+				}
+				else
+				{
+					++nextBlockVertex;
+				}
+			}
+
+			// none found, continue with the first remaining triangle of the mesh
+			if ( !triangleFound )
+			{
+				while ( mHandledTriangles.getBit( nextSeedTriangle ) )
+				{
+					++nextSeedTriangle;
+				}
+				triangleIndex = nextSeedTriangle;
+			}
+
+			const AccessorTriangle& triangle = triangles[triangleIndex];
+
+			// count the vertices of the triangle, that are not in the block yet
+			size_t newVerticesCount = 0;
+			for ( size_t j = 0; j < 3; ++j )
+			{
+				AccessorIndexType vertex = triangle.indices[j];
+				if ( (vertexBlocks[vertex] != blockIndex) 
+					&& ((j < 1) || (vertex != triangle.indices[0]))
+					&& ((j < 2) || (vertex != triangle.indices[1])) )
+				{
+					++newVerticesCount;
+				}
+			}
+
+			// start a new block with this triangle, if it does not fit into the current one
+			if ( (blockTrianglesCount > 0) && 
+				 ( (blockTrianglesCount >= mMaxTrianglesPerBlock) || (blockVertices.size() + newVerticesCount > mMaxVerticesPerBlock) ) )
+			{
+				++blockIndex;
+				blockTrianglesCount = 0;
+				blockVertices.clear();
+				nextBlockVertex = 0;
+				mTriangleHandler.handleNewBlock();
+			}
+
+			HandlerIndexType indicesInBlock[3];
+			for ( size_t j = 0; j < 3; ++j )
+			{
+				AccessorIndexType vertex = triangle.indices[j];
+				if ( vertexBlocks[vertex] != blockIndex )
+				{
+					vertexBlocks[vertex] = blockIndex;
+					vertexIndicesInBlock[vertex] = (HandlerIndexType)blockVertices.size();
+					blockVertices.push_back( vertex );
+					mTriangleHandler.handleVertex( vertex );
+				}
+				indicesInBlock[j] = vertexIndicesInBlock[vertex];
+			}
+
+			mTriangleHandler.handleTriangle( HandlerTriangle( indicesInBlock[0], indicesInBlock[1], indicesInBlock[2], triangle.materialId ) );
+			mHandledTriangles.setBit( triangleIndex, true );
+			++blockTrianglesCount;
+		}
 
 		return true;
 	}
@@ -13,6 +13,7 @@
 
 #include "DAE23dsPrerequisites.h"
 #include "DAE23dsMeshBase.h"
+#include "DAE23dsMeshBlocks.h"
 
 #include "DAE23dsChunkIDs.h"
 
@@ -33,11 +34,12 @@ namespace DAE23ds
 
 		Common::Buffer& mBuffer;
 
-		// material ids of the triangles in the last block written
-		COLLADAFW::MaterialId mMaterialIds[MAX_TRIANGLES_PER_BLOCK];
-
 		MeshAccessor mMeshAccessor;
 
+		/** The blocks the mesh has been split into by the MeshHandler, if it is written into multiple objects.
+		Null otherwise. Owned by the mesh writer.*/
+		MeshBlocks* mMeshBlocks;
+
 		const COLLADAFW::MeshVertexData& mMeshPositions;
 		const COLLADAFW::MeshVertexData& mMeshNormals;
 		const COLLADAFW::MeshVertexData& mMeshUVCoordinates;
@@ -61,27 +63,27 @@ namespace DAE23ds
 		/** Writes the mesh using @a materialBindings to assign materials.*/
 		bool writeMeshIntoObject( const Writer::InstanceGeometryInfo& instanceGeometryInfo);
 
-		/** Writes the mesh using @a materialBindings to assign materials and data provided in @a blockData.*/
-		bool writeMeshIntoObject( const Writer::InstanceGeometryInfo& instanceGeometryInfo, const ObjectBlockData& blockData);
+		/** Writes the @a blockIndex'th block of the mesh into an object.*/
+		bool writeMeshIntoObject( const Writer::InstanceGeometryInfo& instanceGeometryInfo, size_t blockIndex);
 
 		/** Writes the vertices/position as floats into @a buffer.*/
 		bool writeVertices(const COLLADABU::Math::Matrix4& worldMatrix);
 
-		/** Writes the positions for @a trianglesCount triangles, starting at @a firstTriangleIndex.*/
-		bool writeVerticesForMultipleObjects(size_t firstTriangleIndex, CountType trianglesCount, const COLLADABU::Math::Matrix4& worldMatrix);
+		/** Writes the positions of the vertices of @a block.*/
+		bool writeVerticesForMultipleObjects(const MeshBlocks::Block& block, const COLLADABU::Math::Matrix4& worldMatrix);
 
 		/** Writes all the triangles/fans/strips into @a buffer.*/
 		bool writeTriangles();
 
 
-		/** Writes the numbers 0...@a trianglesCount into @a buffer.*/
-		bool writeTrianglesForMultipleObjects(CountType trianglesCount);
+		/** Writes the triangles of @a block.*/
+		bool writeTrianglesForMultipleObjects(const MeshBlocks::Block& block);
 
 		/** writes the faces materials.*/
 		bool writeFaceMaterials(const COLLADAFW::MaterialBindingArray& materialBindings);
 
-		/** */
-		bool writeFaceMaterialsForMultipleObjects(const COLLADAFW::MaterialBindingArray& materialBindings, const ObjectBlockData& blockData);
+		/** writes the faces materials of the triangles of @a block.*/
+		bool writeFaceMaterialsForMultipleObjects(const COLLADAFW::MaterialBindingArray& materialBindings, const MeshBlocks::Block& block);
 
 		/** Writes the mesh matrix of the tri object.*/
 		bool writeMeshMatrix(const COLLADABU::Math::Matrix4& worldMatrix);
@@ -28,6 +28,7 @@
 #include <stack>
 #include <list>
 #include <map>
+#include <vector>
 
 
 namespace Common
@@ -38,6 +39,7 @@ namespace Common
 
 namespace DAE23ds
 {
+	class MeshBlocks;
 
 	typedef unsigned int ChunkLength;
 	typedef unsigned short CountType;
@@ -58,8 +60,6 @@ namespace DAE23ds
 	static const IndexType MAX_INDEX_COUNT = 65535;
 //	static const IndexType MAX_INDEX_COUNT = 5;
 
-	static const IndexType MAX_TRIANGLES_PER_BLOCK = MAX_INDEX_COUNT/3;
-
 	// the flags used for faces
 	static const CountType FACES_FLAGS = 6;
 
@@ -196,16 +196,31 @@ namespace DAE23ds
 			_SEVERITY_ERROR
 		};
 
+		/** The size of a block of a mesh, that is written into multiple objects.*/
+		struct BlockSize
+		{
+			CountType verticesCount;
+			CountType trianglesCount;
+		};
+
+		typedef std::vector<BlockSize> BlockSizeList;
+
 		struct MeshData
 		{
 			COLLADAFW::UniqueId meshUniqueId;
 			size_t trianglesCount;
 			size_t positionsCount;
 			String name;
+
+			/** The sizes of the blocks the mesh is split into. Empty, if the mesh is written into one object.*/
+			BlockSizeList blockSizes;
 		};
 
 		typedef std::map< COLLADAFW::UniqueId, MeshData > MeshDataMap;
 
+		/** Maps the unique ids of the meshes, that are written into multiple objects, to the blocks they are split into.*/
+		typedef std::map< COLLADAFW::UniqueId, MeshBlocks* > MeshBlocksMap;
+
 		typedef std::map<COLLADAFW::UniqueId, COLLADAFW::Node*> UniqueIdNodeMap;
 
 		typedef std::map< COLLADAFW::UniqueId, MaterialNumber> UniqueMaterialNumberMap;
@@ -249,6 +264,9 @@ namespace DAE23ds
 		/** The mesh data of all the meshes parsed at the first run.*/
 		MeshDataMap mMeshDataMap;
 
+		/** The blocks of the meshes split at the first run. They are passed to the MeshWriter at the second run.*/
+		MeshBlocksMap mMeshBlocksMap;
+
 		/** The Object Id of the next object that will be exported.*/
 		ObjectId mNextObjectId;
 
@@ -404,6 +422,9 @@ namespace DAE23ds
 		/** The mesh data of all the meshes parsed at the first run.*/
 		MeshDataMap& getMeshDataMap() { return mMeshDataMap; }
 
+		/** The blocks of the meshes split at the first run, that have not been written yet.*/
+		MeshBlocksMap& getMeshBlocksMap() { return mMeshBlocksMap; }
+
 		/** Calculates the length of all meshes.*/
 		void calculateMeshesLength();
 
@@ -174,6 +174,24 @@ namespace DAE23ds
 		return mWriter->getMeshDataMap()[meshUniqueId];
 	}
 
+	//------------------------------
+	void BaseWriter::addMeshBlocks( const COLLADAFW::UniqueId& meshUniqueId, MeshBlocks* meshBlocks )
+	{
+		mWriter->getMeshBlocksMap().insert( std::make_pair( meshUniqueId, meshBlocks ) );
+	}
+
+	//------------------------------
+	MeshBlocks* BaseWriter::releaseMeshBlocks( const COLLADAFW::UniqueId& meshUniqueId )
+	{
+		Writer::MeshBlocksMap& meshBlocksMap = mWriter->getMeshBlocksMap();
+		Writer::MeshBlocksMap::iterator it = meshBlocksMap.find( meshUniqueId );
+		if ( it == meshBlocksMap.end() )
+			return 0;
+		MeshBlocks* meshBlocks = it->second;
+		meshBlocksMap.erase( it );
+		return meshBlocks;
+	}
+
 	//------------------------------
 	Writer::ObjectId BaseWriter::getAndIncreaseNextObjectId() const
 	{
@@ -62,10 +62,10 @@ namespace DAE23ds
 	}
 
 	//------------------------------
-	bool BitSet::setBit( size_t n )
+	bool BitSet::getBit( size_t n ) const
 	{
 		assert( n < mBitCount );
-		char& c = mBuffer[ n / sizeof(char) ];
+		const char& c = mBuffer[ n / sizeof(char) ];
 		char bitInByte = (char)(n % sizeof(char));
 		char bitMask = 1 << bitInByte;
 		return (c & bitMask) == bitMask;
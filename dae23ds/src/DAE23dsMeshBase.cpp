@@ -79,11 +79,10 @@ namespace DAE23ds
 			alreadyUsingInstance = (*it).fwInstanceGeometry;
 		}
 
-		size_t verticesCount = mMeshData.positionsCount / 3;
-		if ( verticesCount > MAX_INDEX_COUNT )
+		// the mesh has been split, if it is too large for one object
+		if ( !mMeshData.blockSizes.empty() )
 		{
-
-			return handleMeshIntoMultipleObjects(instanceGeometryInfo, alreadyUsingInstance );;
+			return handleMeshIntoMultipleObjects(instanceGeometryInfo, alreadyUsingInstance );
 		}
 		else
 		{
@@ -91,61 +90,24 @@ namespace DAE23ds
 		}
 	}
 
-	void MeshBase::calculateBlockCountAndRemainingTriangles( size_t trianglesCount, ChunkLength&  remainingTriangles, ChunkLength& blockCount, ChunkLength& fullBlockCount)
-	{
-		fullBlockCount = (ChunkLength)(trianglesCount / MAX_TRIANGLES_PER_BLOCK);
-		remainingTriangles = (ChunkLength)(trianglesCount - fullBlockCount*MAX_TRIANGLES_PER_BLOCK);
-
-		blockCount = fullBlockCount + (remainingTriangles == 0 ? 0 : 1);
-	}
-
 	//------------------------------
 	bool MeshBase::handleMeshIntoMultipleObjects( const Writer::InstanceGeometryInfo& instanceGeometryInfo, const COLLADAFW::InstanceGeometry* alreadyUsingInstance)
 	{
 		const COLLADAFW::InstanceGeometry* instanceGeometry = instanceGeometryInfo.fwInstanceGeometry;
 		const COLLADAFW::MaterialBindingArray& materialBindings = instanceGeometry->getMaterialBindings();
 
-		size_t trianglesCount = calculateTrianglesCount();
-
-		ChunkLength remainingTriangles;
-		ChunkLength blockCount;
-		ChunkLength fullBlockCount;
-
-		calculateBlockCountAndRemainingTriangles( trianglesCount, remainingTriangles, blockCount, fullBlockCount );
-
-		ChunkLength verticesLength = calculateTotalVerticesLengthMultiObject(trianglesCount, blockCount);
-
-//		ChunkLength materialNamesLength = calculateMaterialNamesLength(materialBindings);
-
-		ChunkLength facesMaterialsLength = calculateFacesMaterialsLength(MAX_TRIANGLES_PER_BLOCK, materialBindings);
-
-		ChunkLength remainderFacesMaterialsLength = calculateFacesMaterialsLength(remainingTriangles, materialBindings);
-
-
-		ChunkLength facesDescriptionLength = calculateFacesDescriptionLengthMultiObject(trianglesCount, blockCount, facesMaterialsLength, remainderFacesMaterialsLength, fullBlockCount);
-
-		// vertices  and faces description plus empty chunk for each block
-		ChunkLength triangularMeshesLength = verticesLength + facesDescriptionLength+ (EMPTY_CHUNK_LENGTH + TRI_LOCAL_LENGTH)*blockCount;
-
-		ChunkLength editObjectLength = calculateTotalObjectLengthMultiObject(triangularMeshesLength, blockCount);
-
-		// triangle mesh 
-		//plus plus empty chunk
-		ChunkLength edit3DSLength = editObjectLength + EMPTY_CHUNK_LENGTH;
-
-		// add mesh version size
-		edit3DSLength += MESH_VERSION_CHUNK_LENGTH;
-
-		// edit 3ds plus plus empty chunk
-		ChunkLength mainLength = edit3DSLength + EMPTY_CHUNK_LENGTH;
-
-		// add M3D3DS_VERSION version size
-		mainLength += M3D_VERSION_CHUNK_LENGTH;
+		// each block is written into its own object
+		ChunkLength editObjectLength = 0;
+		for ( size_t i = 0, count = mMeshData.blockSizes.size(); i < count; ++i )
+		{
+			const Writer::BlockSize& blockSize = mMeshData.blockSizes[i];
+			WriteMeshIntoOneObject blockData;
+			calculateObjectLengths( blockSize.verticesCount, blockSize.trianglesCount, materialBindings, blockData );
+			editObjectLength += blockData.editObjectLength;
+		}
 
 		WriteMeshIntoMultipleObjectsData data;
 		data.editObjectLength = editObjectLength;
-		data.fullBlocksCount = fullBlockCount;
-		data.remainingTriangles = remainingTriangles;
 
 		return writeMeshIntoMultipleObjects( instanceGeometryInfo, data, alreadyUsingInstance );
 	}
@@ -156,11 +118,16 @@ namespace DAE23ds
 		const COLLADAFW::InstanceGeometry* instanceGeometry = instanceGeometryInfo.fwInstanceGeometry;
 		const COLLADAFW::MaterialBindingArray& materialBindings = instanceGeometry->getMaterialBindings();
 
-		CountType trianglesCount = (CountType)calculateTrianglesCount();
+		WriteMeshIntoOneObject data;
+		calculateObjectLengths( (CountType)(mMeshData.positionsCount / 3), (CountType)calculateTrianglesCount(), materialBindings, data );
 
-		ChunkLength verticesLength = calculateVerticesLength();
+		return writeMeshIntoOneObject( instanceGeometryInfo, data, alreadyUsingInstance );
+	}
 
-//		ChunkLength materialNamesLength = calculateMaterialNamesLength(materialBindings);
+	//------------------------------
+	void MeshBase::calculateObjectLengths( CountType verticesCount, CountType trianglesCount, const COLLADAFW::MaterialBindingArray& materialBindings, WriteMeshIntoOneObject& data )
+	{
+		ChunkLength verticesLength = calculateVerticesLength( 3 * (ChunkLength)verticesCount );
 
 		ChunkLength facesMaterialsLength = calculateFacesMaterialsLength(trianglesCount, materialBindings);
 
@@ -169,16 +136,11 @@ namespace DAE23ds
 		// vertices  and faces description plus empty chunk
 		ChunkLength triangularMeshLength = verticesLength + facesDescriptionLength+ EMPTY_CHUNK_LENGTH + TRI_LOCAL_LENGTH;
 
-		ChunkLength editObjectLength = calculateObjectLength(triangularMeshLength);
-
-		WriteMeshIntoOneObject data;
-		data.editObjectLength = editObjectLength;
+		data.editObjectLength = calculateObjectLength(triangularMeshLength);
 		data.facesDescriptionLength = facesDescriptionLength;
 		data.trianglesCount = trianglesCount;
 		data.triangularMeshLength = triangularMeshLength;
 		data.verticesLength = verticesLength;
-
-		return writeMeshIntoOneObject( instanceGeometryInfo, data, alreadyUsingInstance );
 	}
 
 	//------------------------------
@@ -197,16 +159,6 @@ namespace DAE23ds
 		return EMPTY_CHUNK_LENGTH + sizeof(CountType) + verticesCount_times3 * (ChunkLength)sizeof(float);
 	}
 
-	//------------------------------
-	ChunkLength MeshBase::calculateTotalVerticesLengthMultiObject( size_t trianglesCount, ChunkLength blockCount )
-	{
-
-		// size of empty chunk for each vertices chunk
-		// size of the vertex count for each vertices chunk
-		// size of the floats
-		return (EMPTY_CHUNK_LENGTH + sizeof(CountType)) * blockCount + (ChunkLength)(3 * 3 * trianglesCount * sizeof(float));
-	}
-
 	//------------------------------
 	ChunkLength MeshBase::calculateObjectLength(ChunkLength triangularMeshLength)
 	{
@@ -216,15 +168,6 @@ namespace DAE23ds
 		return EMPTY_CHUNK_LENGTH + (ChunkLength)(OBJECT_NAME_LENGTH) + triangularMeshLength;
 	}
 
-	//------------------------------
-	ChunkLength MeshBase::calculateTotalObjectLengthMultiObject(ChunkLength triangularMeshesLength, ChunkLength blockCount)
-	{
-		// size of empty chunk for each block
-		// name of the object/mesh with null termination for each block
-		// triangle meshes sizes
-		return blockCount*(EMPTY_CHUNK_LENGTH + (ChunkLength)(OBJECT_NAME_LENGTH)) + triangularMeshesLength;
-	}
-
 	//------------------------------
 	size_t MeshBase::calculateTrianglesCount()
 	{
@@ -288,19 +231,6 @@ namespace DAE23ds
 		return EMPTY_CHUNK_LENGTH + sizeof(CountType) + sizeof(CountType) * 4 * trianglesCount + facesMaterialsLength; 
 	}
 
-	//------------------------------
-	ChunkLength MeshBase::calculateFacesDescriptionLengthMultiObject(size_t trianglesCount, ChunkLength blockCount, ChunkLength facesMaterialsLength, ChunkLength remainderFacesMaterialsLength, ChunkLength fullBlocksCount)
-	{
-		// size of empty chunk for each block
-		// faces count for each block
-		// triangles indices + flag
-		// faces materials for each block
-		return   (EMPTY_CHUNK_LENGTH + sizeof(CountType))*blockCount 
-			+ facesMaterialsLength * fullBlocksCount + remainderFacesMaterialsLength
-			+ sizeof(CountType) * 4 * trianglesCount; 
-	}
-
-
 // 	ChunkLength MeshBase::calculateMaterialNameLengthFromMaterialBinding( const COLLADAFW::InstanceGeometry::MaterialBinding& materialBinding)
 // 	{
 // 		COLLADAFW::MaterialId materialId = materialBinding.getMaterialId();
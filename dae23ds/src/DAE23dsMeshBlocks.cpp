@@ -0,0 +1,86 @@
+/*
+    Copyright (c) 2009 NetAllied Systems GmbH
+
+    This file is part of dae23ds.
+	
+    Licensed under the MIT Open Source License, 
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "DAE23dsStableHeaders.h"
+#include "DAE23dsMeshBlocks.h"
+#include "DAE23dsMeshAccessor.h"
+#include "DAE23dsMeshSpliter.h"
+
+
+namespace DAE23ds
+{
+
+    //------------------------------
+	MeshBlocks::MeshBlocks()
+	{
+	}
+	
+    //------------------------------
+	MeshBlocks::~MeshBlocks()
+	{
+	}
+
+	//------------------------------
+	bool MeshBlocks::isSplittingRequired( size_t verticesCount, size_t trianglesCount )
+	{
+		return (verticesCount > MAX_INDEX_COUNT) || (trianglesCount > MAX_INDEX_COUNT);
+	}
+
+	//------------------------------
+	bool MeshBlocks::split( const MeshAccessor& meshAccessor )
+	{
+		mBlocks.clear();
+		mVertexIndices.clear();
+		mTriangles.clear();
+		mTriangles.reserve( meshAccessor.getTrianglesCount() );
+
+		// the vertices of a block are indexed by IndexType, the number of faces is stored as CountType
+		MeshSpliter<MeshAccessor, unsigned int, MeshBlocks, IndexType> meshSpliter( meshAccessor, *this, MAX_INDEX_COUNT, MAX_INDEX_COUNT );
+		return meshSpliter.split();
+	}
+
+	//------------------------------
+	void MeshBlocks::getBlockSizes( Writer::BlockSizeList& blockSizes ) const
+	{
+		for ( size_t i = 0, count = mBlocks.size(); i < count; ++i )
+		{
+			Writer::BlockSize blockSize;
+			blockSize.verticesCount = mBlocks[i].verticesCount;
+			blockSize.trianglesCount = mBlocks[i].trianglesCount;
+			blockSizes.push_back( blockSize );
+		}
+	}
+
+	//------------------------------
+	void MeshBlocks::handleNewBlock()
+	{
+		Block block;
+		block.firstVertex = mVertexIndices.size();
+		block.verticesCount = 0;
+		block.firstTriangle = mTriangles.size();
+		block.trianglesCount = 0;
+		mBlocks.push_back( block );
+	}
+
+	//------------------------------
+	void MeshBlocks::handleVertex( unsigned int index )
+	{
+		mVertexIndices.push_back( index );
+		mBlocks.back().verticesCount++;
+	}
+
+	//------------------------------
+	void MeshBlocks::handleTriangle( const TriangleType& triangle )
+	{
+		mTriangles.push_back( triangle );
+		mBlocks.back().trianglesCount++;
+	}
+
+} // namespace DAE23ds
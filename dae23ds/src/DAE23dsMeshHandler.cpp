@@ -11,6 +11,7 @@
 #include "dae23dsStableHeaders.h"
 #include "DAE23dsMeshHandler.h"
 #include "DAE23dsMeshAccessor.h"
+#include "DAE23dsMeshBlocks.h"
 
 namespace DAE23ds
 {
@@ -36,6 +37,16 @@ namespace DAE23ds
 		meshData.trianglesCount = meshAccessor.getTrianglesCount();
 		meshData.positionsCount = mMesh->getPositions().getValuesCount();
 		meshData.name = mMesh->getName();
+
+		// the lengths of the objects depend on the blocks the mesh is split into. The blocks are kept for
+		// the MeshWriter, such that the mesh is only split once.
+		if ( MeshBlocks::isSplittingRequired( meshData.positionsCount / 3, meshData.trianglesCount ) )
+		{
+			MeshBlocks* meshBlocks = new MeshBlocks();
+			meshBlocks->split( meshAccessor );
+			meshBlocks->getBlockSizes( meshData.blockSizes );
+			addMeshBlocks( meshData.meshUniqueId, meshBlocks );
+		}
 		addMeshData( meshData );
 		return true;
 	}
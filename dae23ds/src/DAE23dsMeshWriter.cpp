@@ -30,6 +30,7 @@ namespace DAE23ds
 		, mMesh(mesh)
 		, mBuffer(getBuffer())
 		, mMeshAccessor(mesh)
+		, mMeshBlocks(0)
 		, mMeshPositions( mesh->getPositions() )
 		, mMeshNormals( mesh->getNormals() )
 		, mMeshUVCoordinates( mesh->getUVCoords() )
@@ -40,12 +41,18 @@ namespace DAE23ds
 		meshData.trianglesCount = mMeshAccessor.getTrianglesCount();
 		meshData.positionsCount = mMeshPositions.getValuesCount();
 		meshData.name = mesh->getName();
+
+		// the mesh has been split at the first run already, if it is too large for one object
+		mMeshBlocks = releaseMeshBlocks( meshData.meshUniqueId );
+		if ( mMeshBlocks )
+			mMeshBlocks->getBlockSizes( meshData.blockSizes );
 		setMeshData(meshData);
 	}
 
 	//------------------------------
 	MeshWriter::~MeshWriter()
 	{
+		delete mMeshBlocks;
 	}
 
 	//------------------------------
@@ -70,47 +77,28 @@ namespace DAE23ds
 
 //			writeMaterialBlocks(materialBindings);
 
-			ObjectBlockData blockData;
-			blockData.trianglesCount = MAX_TRIANGLES_PER_BLOCK;
-			blockData.firstTriangleIndex = 0;
-			//		blockData.verticesCount = MAX_INDEX_COUNT;
-
 			// loop here over all blocks
-			for ( ChunkLength i = 0; i  < data.fullBlocksCount; ++i )
-			{
-				writeMeshIntoObject( instanceGeometryInfo, blockData);
-				blockData.firstTriangleIndex += blockData.trianglesCount;
-			}
-
-			// write the remaining triangles
-			if ( data.remainingTriangles > 0)
+			for ( size_t i = 0, count = mMeshBlocks->getBlocksCount(); i < count; ++i )
 			{
-				blockData.trianglesCount = data.remainingTriangles;
-				writeMeshIntoObject( instanceGeometryInfo, blockData);
+				writeMeshIntoObject( instanceGeometryInfo, i);
 			}
 		}
 		return true;
 	}
 
 	//------------------------------
-	bool MeshWriter::writeMeshIntoObject( const Writer::InstanceGeometryInfo& instanceGeometryInfo, const ObjectBlockData& blockData)
+	bool MeshWriter::writeMeshIntoObject( const Writer::InstanceGeometryInfo& instanceGeometryInfo, size_t blockIndex)
 	{
 		const COLLADAFW::InstanceGeometry* instanceGeometry = instanceGeometryInfo.fwInstanceGeometry;
 		const COLLADAFW::MaterialBindingArray& materialBindings = instanceGeometry->getMaterialBindings();
-		ChunkLength verticesLength = calculateVerticesLength(blockData.trianglesCount*3*3);
-
-		ChunkLength facesMaterialsLength = calculateFacesMaterialsLength(blockData.trianglesCount, materialBindings);
+		const MeshBlocks::Block& block = mMeshBlocks->getBlock(blockIndex);
 
-		ChunkLength facesDescriptionLength = calculateFacesDescriptionLength(blockData.trianglesCount, facesMaterialsLength);
-
-		// vertices  and faces description plus empty chunk
-		ChunkLength triangularMeshLength = verticesLength + facesDescriptionLength+ EMPTY_CHUNK_LENGTH+TRI_LOCAL_LENGTH;
-
-		ChunkLength editObjectLength = calculateObjectLength(triangularMeshLength);
+		WriteMeshIntoOneObject data;
+		calculateObjectLengths(block.verticesCount, block.trianglesCount, materialBindings, data);
 
 		// object chunk
 		mBuffer.copyToBuffer(EDIT_OBJECT);
-		mBuffer.copyToBuffer(editObjectLength);
+		mBuffer.copyToBuffer(data.editObjectLength);
 
 		Writer::ObjectId objectId = getAndIncreaseNextObjectId();
 		const char* meshName3ds = Writer::calculateObjectNameFromObjectId( objectId );
@@ -119,21 +107,21 @@ namespace DAE23ds
 
 		// triangular mesh
 		mBuffer.copyToBuffer(OBJ_TRIMESH);
-		mBuffer.copyToBuffer(triangularMeshLength);
+		mBuffer.copyToBuffer(data.triangularMeshLength);
 
 		// vertices list mesh
 		mBuffer.copyToBuffer(TRI_VERTEXL);
-		mBuffer.copyToBuffer(verticesLength);
-		mBuffer.copyToBuffer((CountType)(blockData.trianglesCount*3));
-		writeVerticesForMultipleObjects(blockData.firstTriangleIndex, blockData.trianglesCount,instanceGeometryInfo.worldMatrix);
+		mBuffer.copyToBuffer(data.verticesLength);
+		mBuffer.copyToBuffer(block.verticesCount);
+		writeVerticesForMultipleObjects(block, instanceGeometryInfo.worldMatrix);
 
 		// faces description
 		mBuffer.copyToBuffer(TRI_FACEL1);
-		mBuffer.copyToBuffer(facesDescriptionLength);
-		mBuffer.copyToBuffer((CountType)(blockData.trianglesCount));
-		writeTrianglesForMultipleObjects(blockData.trianglesCount);
+		mBuffer.copyToBuffer(data.facesDescriptionLength);
+		mBuffer.copyToBuffer(block.trianglesCount);
+		writeTrianglesForMultipleObjects(block);
 
-		writeFaceMaterialsForMultipleObjects(materialBindings, blockData);
+		writeFaceMaterialsForMultipleObjects(materialBindings, block);
 
 		writeMeshMatrix(instanceGeometryInfo.worldMatrix);
 		return true;
@@ -297,11 +285,13 @@ namespace DAE23ds
 	}
 
 	//------------------------------
-	bool MeshWriter::writeVerticesForMultipleObjects(size_t firstTriangleIndex, CountType trianglesCount, const COLLADABU::Math::Matrix4& worldMatrix)
+	bool MeshWriter::writeVerticesForMultipleObjects(const MeshBlocks::Block& block, const COLLADABU::Math::Matrix4& worldMatrix)
 	{
+		size_t firstVertex = block.firstVertex;
+		size_t lastVertex = block.firstVertex + block.verticesCount;
+
 		if ( mMeshPositions.getType() == COLLADAFW::FloatOrDoubleArray::DATA_TYPE_FLOAT )
 		{
-			MeshAccessor::TriangleType triangle = mMeshAccessor.getTriangle(firstTriangleIndex);
 			const COLLADAFW::FloatArray* floatArray = mMeshPositions.getFloatValues();
 			if ( getApplyTransformationsToMeshes() && multiplyMeshes )
 			{
@@ -320,81 +310,42 @@ namespace DAE23ds
 				wm[2][2] = (float)worldMatrix.getElement(2,2);
 				wm[2][3] = (float)worldMatrix.getElement(2,3);
 
-				for ( IndexType i = 0; ; ++i)
+				for ( size_t i = firstVertex; i < lastVertex; ++i)
 				{
 					// apply transformation
-					transformAndWriteVertex( *floatArray, wm, 3*triangle.indices[0]);
-					transformAndWriteVertex( *floatArray, wm, 3*triangle.indices[1]);
-					transformAndWriteVertex( *floatArray, wm, 3*triangle.indices[2]);
-
-					mMaterialIds[i] = triangle.materialId;
-					if ( i >= trianglesCount - 1)
-						break;
-					triangle = mMeshAccessor.getNextTriangle();
+					transformAndWriteVertex( *floatArray, wm, 3*mMeshBlocks->getVertexIndex(i));
 				}
 			}
 			else
 			{
-				for ( IndexType i = 0; ; ++i)
+				for ( size_t i = firstVertex; i < lastVertex; ++i)
 				{
 					// we can write the vertices directly to the mBuffer
-					mBuffer.copyToBuffer(floatArray->getData() + 3*triangle.indices[0], 3);
-					mBuffer.copyToBuffer(floatArray->getData() + 3*triangle.indices[1], 3);
-					mBuffer.copyToBuffer(floatArray->getData() + 3*triangle.indices[2], 3);
-					mMaterialIds[i] = triangle.materialId;
-					if ( i >= trianglesCount - 1)
-						break;
-					triangle = mMeshAccessor.getNextTriangle();
+					mBuffer.copyToBuffer(floatArray->getData() + 3*mMeshBlocks->getVertexIndex(i), 3);
 				}
 			}
 		}
 		else if ( mMeshPositions.getType() == COLLADAFW::FloatOrDoubleArray::DATA_TYPE_DOUBLE )
 		{
-			// we need to cast the values from double to float
 			const COLLADAFW::DoubleArray* doubleArray = mMeshPositions.getDoubleValues();
 
-			MeshAccessor::TriangleType triangle = mMeshAccessor.getTriangle(firstTriangleIndex);
-
 			if ( getApplyTransformationsToMeshes() && multiplyMeshes )
 			{
-				for ( IndexType i = 0; ; ++i)
+				for ( size_t i = firstVertex; i < lastVertex; ++i)
 				{
 					// apply transformation
-					transformAndWriteVertex( *doubleArray, worldMatrix, 3*triangle.indices[0]);
-					transformAndWriteVertex( *doubleArray, worldMatrix, 3*triangle.indices[1]);
-					transformAndWriteVertex( *doubleArray, worldMatrix, 3*triangle.indices[2]);
-
-					mMaterialIds[i] = triangle.materialId;
-					if ( i < trianglesCount - 1)
-						break;
-
-					triangle = mMeshAccessor.getNextTriangle();
+					transformAndWriteVertex( *doubleArray, worldMatrix, 3*mMeshBlocks->getVertexIndex(i));
 				}
 			}
 			else
 			{
-				for ( IndexType i = 0; ; ++i)
+				for ( size_t i = firstVertex; i < lastVertex; ++i)
 				{
 					// we need to cast the values from double to float
-					IndexType index = 3*triangle.indices[0];
-					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
-					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
-					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
-
-					index = 3*triangle.indices[1];
+					size_t index = 3*mMeshBlocks->getVertexIndex(i);
 					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
 					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
 					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
-
-					index = 3*triangle.indices[2];
-					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
-					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
-					mBuffer.copyToBuffer((float)((*doubleArray)[index++]));
-					mMaterialIds[i] = triangle.materialId;
-					if ( i < trianglesCount - 1)
-						break;
-
-					triangle = mMeshAccessor.getNextTriangle();
 				}
 			}
 		}
@@ -488,7 +439,7 @@ namespace DAE23ds
 	}
 
 	//------------------------------
-	bool MeshWriter::writeFaceMaterialsForMultipleObjects(const COLLADAFW::MaterialBindingArray& materialBindings, const ObjectBlockData& blockData)
+	bool MeshWriter::writeFaceMaterialsForMultipleObjects(const COLLADAFW::MaterialBindingArray& materialBindings, const MeshBlocks::Block& block)
 	{
 		for ( size_t i = 0, count = materialBindings.getCount(); i < count; ++i)
 		{
@@ -500,9 +451,9 @@ namespace DAE23ds
 			// calculate number of faces that use this material
 			CountType faceCount = 0;
 
-			for ( size_t j = 0; j < blockData.trianglesCount; ++j)
+			for ( size_t j = 0; j < block.trianglesCount; ++j)
 			{
-				COLLADAFW::MaterialId triangleMaterialId = mMaterialIds[j];
+				COLLADAFW::MaterialId triangleMaterialId = mMeshBlocks->getTriangle(block.firstTriangle + j).materialId;
 				if ( triangleMaterialId != materialId)
 				{
 					// we are not interested in that primitive right now
@@ -535,10 +486,10 @@ namespace DAE23ds
 
 			// we need to iterate over the primitives again to fill the facenuum array
 			IndexType faceIndex = 0;
-			for ( size_t j = 0; j < blockData.trianglesCount; ++j)
+			for ( size_t j = 0; j < block.trianglesCount; ++j)
 			{
 				
-				COLLADAFW::MaterialId triangleMaterialId = mMaterialIds[j];
+				COLLADAFW::MaterialId triangleMaterialId = mMeshBlocks->getTriangle(block.firstTriangle + j).materialId;
 				if ( triangleMaterialId == materialId)
 				{
 					mBuffer.copyToBuffer((IndexType)j);
@@ -644,14 +595,15 @@ namespace DAE23ds
 	}
 
 	//------------------------------
-	bool MeshWriter::writeTrianglesForMultipleObjects(CountType trianglesCount)
+	bool MeshWriter::writeTrianglesForMultipleObjects(const MeshBlocks::Block& block)
 	{
-		// we simply need to write the numbers 0...trianglesCount
-		for ( IndexType i = 0, index = 0; i < trianglesCount; ++i)
+		// the indices of the triangles refer to the vertices of the block
+		for ( size_t i = block.firstTriangle, lastTriangle = block.firstTriangle + block.trianglesCount; i < lastTriangle; ++i)
 		{
-			mBuffer.copyToBuffer(index++);
-			mBuffer.copyToBuffer(index++);
-			mBuffer.copyToBuffer(index++);
+			const MeshBlocks::TriangleType& triangle = mMeshBlocks->getTriangle(i);
+			mBuffer.copyToBuffer(triangle.indices[0]);
+			mBuffer.copyToBuffer(triangle.indices[1]);
+			mBuffer.copyToBuffer(triangle.indices[2]);
 			mBuffer.copyToBuffer( FACES_FLAGS );
 		}
 		return true;
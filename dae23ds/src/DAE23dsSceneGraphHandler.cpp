@@ -91,15 +91,13 @@ namespace DAE23ds
 			const Writer::MeshData& meshdata = getMeshData( meshUniqueId );
 
 
-			ChunkLength fullBlockCount = 1;
 			ChunkLength nameLength = 0;
-			ChunkLength remainingTriangles;
-			ChunkLength blockCount = 1;
 			ChunkLength objectNameLength = OBJECT_NAME_LENGTH;
 
-			if ( meshdata.positionsCount > MAX_INDEX_COUNT )
+			// one object per block, if the mesh has been split
+			ChunkLength blockCount = meshdata.blockSizes.empty() ? 1 : (ChunkLength)meshdata.blockSizes.size();
+			if ( blockCount > 1 )
 			{
-				MeshBase::calculateBlockCountAndRemainingTriangles( meshdata.trianglesCount, remainingTriangles, blockCount, fullBlockCount );
 //				nameLength = (ChunkLength)(min(meshdata.name.length() + 4, MAX_OBJECT_NAME_LENGTH) + 1);
 			}
 			else
@@ -107,7 +105,7 @@ namespace DAE23ds
 //				nameLength = (ChunkLength)(min(meshdata.name.length(), MAX_OBJECT_NAME_LENGTH) + 1);
 			}
 
-//			addNodeLength( nameLength, fullBlockCount, COLLADABU::Math::Matrix4::IDENTITY );
+//			addNodeLength( nameLength, blockCount, COLLADABU::Math::Matrix4::IDENTITY );
 			addNodeLength( objectNameLength, blockCount, COLLADABU::Math::Matrix4::IDENTITY );
 
  			addInstanceGeometryInstanceGeometryInfoPair(instanceGeometry->getInstanciatedObjectId(), instanceGeometryInfo);
@@ -12,6 +12,7 @@
 #include "DAE23dsWriter.h"
 #include "DAE23dsMeshWriter.h"
 #include "DAE23dsMeshHandler.h"
+#include "DAE23dsMeshBlocks.h"
 #include "DAE23dsMeshLengthCalculator.h"
 #include "DAE23dsSceneGraphWriter.h"
 #include "DAE23dsSceneGraphHandler.h"
@@ -21,6 +22,7 @@
 #include "COLLADASaxFWLLoader.h"
 
 #include "COLLADAFWRoot.h"
+#include "COLLADAFWRecordingWriter.h"
 #include "COLLADAFWGeometry.h"
 #include "COLLADAFWNode.h"
 #include "COLLADAFWVisualScene.h"
@@ -86,6 +88,8 @@ namespace DAE23ds
 	Writer::~Writer()
 	{
 		delete mVisualScene;
+		for ( MeshBlocksMap::iterator it = mMeshBlocksMap.begin(); it != mMeshBlocksMap.end(); ++it )
+			delete it->second;
 	}
 
 	//--------------------------------------------------------------------
@@ -113,7 +117,9 @@ namespace DAE23ds
 	bool Writer::write()
 	{
 		COLLADASaxFWL::Loader loader;
-		COLLADAFW::Root root(&loader, this);
+		// the document is loaded once, both runs replay the recorded objects
+		COLLADAFW::RecordingWriter recordingWriter;
+		COLLADAFW::Root root(&loader, &recordingWriter);
 
 		Common::FWriteBufferFlusher bufferFlusher( getOutputFile().toNativePath().c_str(), FLUSHERBUFFERSIZE );
 		Common::Buffer buffer( BUFFERSIZE, &bufferFlusher);
@@ -128,7 +134,7 @@ namespace DAE23ds
 							   | COLLADASaxFWL::Loader::VISUAL_SCENES_FLAG
 							   | COLLADASaxFWL::Loader::SCENE_FLAG
 							   | COLLADASaxFWL::Loader::GEOMETRY_FLAG);
-		if ( !root.loadDocument(mInputFile.toNativePath()) )
+		if ( !root.loadDocument(mInputFile.toNativePath()) || !recordingWriter.replay(this) )
 			return false;
 
 		createUniqueIdNodeMap();
@@ -144,7 +150,7 @@ namespace DAE23ds
 
 		// load and write geometries
 		mCurrentRun = GEOMETRY_RUN;
-		if ( !root.loadDocument(mInputFile.toNativePath()) )
+		if ( !recordingWriter.replay(this) )
 			return false;
 
 		SceneGraphWriter sceneGraphWriter(this, mVisualScene, mLibraryNodesList);
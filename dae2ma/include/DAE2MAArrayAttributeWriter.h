@@ -0,0 +1,122 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of DAE2MA.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#ifndef __DAE2MA_ARRAYATTRIBUTEWRITER_H__
+#define __DAE2MA_ARRAYATTRIBUTEWRITER_H__
+
+#include "DAE2MAPrerequisites.h"
+
+#include "CommonCharacterBuffer.h"
+#include "CommonIBufferFlusher.h"
+
+#include <stdio.h>
+
+
+namespace DAE2MA
+{
+
+    /**
+     * Writes the values of large array attributes, like the vertex positions, normals and uv
+     * coordinates of a mesh, into the maya ascii file. Instead of calling fprintf for every
+     * value, as the MayaDataModel does, the values are converted with the libftoa converters
+     * into a buffer, which is passed to the file once per attribute statement.
+     * Nothing else must be written to the file between startAttribute() and endAttribute().
+     */
+    class ArrayAttributeWriter
+    {
+    private:
+
+        /** Passes the data of the buffer to the file. Marks are not supported. */
+        class FileFlusher : public Common::IBufferFlusher
+        {
+        private:
+            FILE* mFile;
+
+        public:
+            FileFlusher ( FILE* file ) : mFile ( file ) {}
+            virtual ~FileFlusher () {}
+
+            virtual bool receiveData ( const char* buffer, size_t length );
+            virtual bool flush () { return true; }
+            virtual void startMark () {}
+            virtual MarkId endMark () { return INVALID_ID; }
+            virtual bool jumpToMark ( MarkId markId, bool keepMarkId = false ) { return false; }
+            virtual int getError () const { return 0; }
+        };
+
+    public:
+
+        /** The size of the buffer the values are converted into. */
+        static const size_t BUFFERSIZE;
+
+    private:
+
+        /** The flusher of mBuffer. */
+        FileFlusher mFlusher;
+
+        /** The buffer the statements are written to. */
+        Common::CharacterBuffer mBuffer;
+
+    public:
+
+        /** Constructor.
+        @param file The maya ascii file to write to. */
+        ArrayAttributeWriter ( FILE* file );
+
+        /** Destructor. */
+        virtual ~ArrayAttributeWriter ();
+
+        /**
+         * Starts the statement, that sets the elements @a startIndex to @a endIndex of the
+         * array attribute @a attribute, e.g. ".vt" for the vertices of a mesh.
+         */
+        void startAttribute ( const char* attribute, size_t startIndex, size_t endIndex );
+
+        /**
+         * Starts the statement, that sets the elements @a startIndex to @a endIndex of the
+         * array attribute @a attribute of the element @a parentIndex of the array attribute
+         * @a parentAttribute, e.g. ".uvst" and ".uvsp" for the points of a uv set of a mesh.
+         */
+        void startAttribute (
+            const char* parentAttribute,
+            size_t parentIndex,
+            const char* attribute,
+            size_t startIndex,
+            size_t endIndex );
+
+        /** Appends @a value to the values of the current attribute. */
+        void appendValue ( float value );
+
+        /** Appends the @a count values starting at @a values to the values of the current attribute. */
+        void appendValues ( const float* values, size_t count );
+
+        /** Appends the @a count values starting at @a values to the values of the current attribute.
+        The values are written with float precision, as the maya data model does. */
+        void appendValues ( const double* values, size_t count );
+
+        /** Ends the statement of the current attribute and passes it to the file. */
+        void endAttribute ();
+
+    private:
+
+        /** Writes "[startIndex:endIndex]\"" to the buffer. */
+        void writeIndexRange ( size_t startIndex, size_t endIndex );
+
+        /** Disable default copy ctor. */
+        ArrayAttributeWriter ( const ArrayAttributeWriter& pre );
+
+        /** Disable default assignment operator. */
+        const ArrayAttributeWriter& operator= ( const ArrayAttributeWriter& pre );
+
+    };
+
+} // namespace DAE2MA
+
+#endif // __DAE2MA_ARRAYATTRIBUTEWRITER_H__
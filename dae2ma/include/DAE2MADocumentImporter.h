@@ -23,6 +23,7 @@
 #include "DAE2MAExtraDataCallbackHandler.h"
 
 #include "COLLADAFWIWriter.h"
+#include "COLLADAFWRecordingWriter.h"
 #include "COLLADAFWFileInfo.h"
 #include "COLLADAFWInstanceVisualScene.h"
 #include "COLLADAFWFormula.h"
@@ -139,6 +140,10 @@ namespace DAE2MA
         /** The callback handler to parse the extra data elements. */
         ExtraDataCallbackHandler mMayaIdCallbackHandler;
 
+        /** Records the objects of the document, which is loaded only once. Every parsing step 
+        replays the recorded objects. */
+        COLLADAFW::RecordingWriter mRecordingWriter;
+
         /** The URI of the visual scene to use. */
         COLLADAFW::InstanceVisualScene* mInstanceVisualScene;
 
@@ -428,6 +433,12 @@ namespace DAE2MA
          */
         static String frameworkNameToMayaName ( const String& name );
 
+        /** Returns true, if @a c is allowed in a maya name, except at its beginning.*/
+        static bool isMayaNameChar ( char c )
+        {
+            return COLLADABU::Utils::isAsciiAlphaChar ( c ) || COLLADABU::Utils::isDigit ( c ) || c == '_';
+        }
+
         /**
         * The list of all unique ids of maya nodes (dag nodes and depend nodes). 
         * A list of names which are either used up to multiple times for dag nodes in the scene 
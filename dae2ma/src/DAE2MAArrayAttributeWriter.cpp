@@ -0,0 +1,109 @@
+/*
+    Copyright (c) 2008-2009 NetAllied Systems GmbH
+
+    This file is part of DAE2MA.
+
+    Licensed under the MIT Open Source License,
+    for details please see LICENSE file or the website
+    http://www.opensource.org/licenses/mit-license.php
+*/
+
+#include "DAE2MAStableHeaders.h"
+#include "DAE2MAArrayAttributeWriter.h"
+
+
+namespace DAE2MA
+{
+
+    // Large enough to hold a whole statement of MAYA_BLOCK_SIZE values.
+    const size_t ArrayAttributeWriter::BUFFERSIZE = 64*1024;
+
+    //------------------------------
+    bool ArrayAttributeWriter::FileFlusher::receiveData ( const char* buffer, size_t length )
+    {
+        return fwrite ( buffer, 1, length, mFile ) == length;
+    }
+
+    //------------------------------
+    ArrayAttributeWriter::ArrayAttributeWriter ( FILE* file )
+        : mFlusher ( file )
+        , mBuffer ( BUFFERSIZE, &mFlusher )
+    {
+    }
+
+    //------------------------------
+    ArrayAttributeWriter::~ArrayAttributeWriter ()
+    {
+        mBuffer.flushBuffer ();
+    }
+
+    //------------------------------
+    void ArrayAttributeWriter::startAttribute ( const char* attribute, size_t startIndex, size_t endIndex )
+    {
+        mBuffer.copyToBuffer ( "\tsetAttr \"" );
+        mBuffer.copyToBuffer ( attribute );
+        writeIndexRange ( startIndex, endIndex );
+    }
+
+    //------------------------------
+    void ArrayAttributeWriter::startAttribute (
+        const char* parentAttribute,
+        size_t parentIndex,
+        const char* attribute,
+        size_t startIndex,
+        size_t endIndex )
+    {
+        mBuffer.copyToBuffer ( "\tsetAttr \"" );
+        mBuffer.copyToBuffer ( parentAttribute );
+        mBuffer.copyToBuffer ( '[' );
+        mBuffer.copyToBufferAsChar ( (unsigned int)parentIndex );
+        mBuffer.copyToBuffer ( ']' );
+        mBuffer.copyToBuffer ( attribute );
+        writeIndexRange ( startIndex, endIndex );
+    }
+
+    //------------------------------
+    void ArrayAttributeWriter::writeIndexRange ( size_t startIndex, size_t endIndex )
+    {
+        mBuffer.copyToBuffer ( '[' );
+        mBuffer.copyToBufferAsChar ( (unsigned int)startIndex );
+        mBuffer.copyToBuffer ( ':' );
+        mBuffer.copyToBufferAsChar ( (unsigned int)endIndex );
+        mBuffer.copyToBuffer ( "]\"" );
+    }
+
+    //------------------------------
+    void ArrayAttributeWriter::appendValue ( float value )
+    {
+        mBuffer.copyToBuffer ( ' ' );
+        mBuffer.copyToBufferAsChar ( value );
+    }
+
+    //------------------------------
+    void ArrayAttributeWriter::appendValues ( const float* values, size_t count )
+    {
+        for ( size_t i=0; i<count; ++i )
+        {
+            mBuffer.copyToBuffer ( ' ' );
+            mBuffer.copyToBufferAsChar ( values[i] );
+        }
+    }
+
+    //------------------------------
+    void ArrayAttributeWriter::appendValues ( const double* values, size_t count )
+    {
+        for ( size_t i=0; i<count; ++i )
+        {
+            mBuffer.copyToBuffer ( ' ' );
+            mBuffer.copyToBufferAsChar ( (float)values[i] );
+        }
+    }
+
+    //------------------------------
+    void ArrayAttributeWriter::endAttribute ()
+    {
+        mBuffer.copyToBuffer ( ";\n" );
+        mBuffer.flushBuffer ();
+    }
+
+} // namespace DAE2MA
@@ -461,44 +461,60 @@ namespace DAE2MA
     //-----------------------------
     void DocumentImporter::readColladaDocument ()
     {
-        // See revision 511 (generate new loader object without setting object flags).
-        COLLADASaxFWL::Loader saxLoader ( &mSaxParserErrorHandler );
-
-        if ( mParseStep == FIRST_PARSING )
+        // The document is loaded only once. The recorded objects are passed to this 
+        // importer in every parsing step.
+        if ( !mRecordingWriter.isFinished () )
+        {
+            // See revision 511 (generate new loader object without setting object flags).
+            COLLADASaxFWL::Loader saxLoader ( &mSaxParserErrorHandler );
             saxLoader.registerExtraDataCallbackHandler ( &mMayaIdCallbackHandler );
 
-        // TODO
-        COLLADAFW::Root root ( &saxLoader, this );
-//        COLLADAFW::Root root ( &mSaxLoader, this );
-        String filename = getColladaFilename ();
-        String fileUriString = URI::nativePathToUri ( filename );
+            // TODO
+            COLLADAFW::Root root ( &saxLoader, &mRecordingWriter );
+//            COLLADAFW::Root root ( &mSaxLoader, this );
+            String filename = getColladaFilename ();
+            String fileUriString = URI::nativePathToUri ( filename );
+
+            root.loadDocument ( fileUriString );
+        }
 
         ++mNumDocumentParses;
-        root.loadDocument ( fileUriString );
+        mRecordingWriter.replay ( this );
     }
 
     //-----------------------------
     String DocumentImporter::frameworkNameToMayaName ( const String& name )
     {
         // Replace offending characters by some that are supported within maya:
-        // ':', '|', '-', '!' are replaced by '_'.
-
-        const char* c = name.c_str ();
+        // Maya names consist of letters, digits and '_' and start with a letter. All other 
+        // characters, e.g. ':', '|', '-', '.', are replaced by '_', as is a leading non letter.
+        // Names that are valid already are returned without building a new string.
         size_t length = name.length();
-        char* tmp = new char[length + 1];
-
-        for ( size_t i = 0; i <= length; i++ )
+        size_t pos = 0;
+        if ( length > 0 && COLLADABU::Utils::isAsciiAlphaChar ( name[0] ) )
         {
-            char d = c[i];
-            if ( d == '.' || d == '-' || d == '|' || d == ':' || d == '/' || d == '\\' || d == '(' || d == ')' || d == '[' || d == ']' )
+            for ( pos = 1; pos < length; ++pos )
             {
-                d =  '_';
+                if ( !isMayaNameChar ( name[pos] ) )
+                    break;
             }
-            tmp[i] = d;
+            if ( pos == length )
+                return name;
         }
 
-        String newName = COLLADABU::Utils::checkNCName ( tmp );
-        delete[] tmp;
+        String newName;
+        newName.reserve ( length > 0 ? length : 1 );
+        newName.assign ( name, 0, pos );
+        if ( pos == 0 )
+        {
+            newName.append ( 1, '_' );
+            pos = 1;
+        }
+        for ( ; pos < length; ++pos )
+        {
+            char c = name[pos];
+            newName.append ( 1, isMayaNameChar ( c ) ? c : '_' );
+        }
         return newName;
     }
 
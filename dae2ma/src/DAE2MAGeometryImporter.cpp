@@ -19,6 +19,7 @@
 #include "DAE2MAImportOptions.h"
 #include "DAE2MAControllerImporter.h"
 #include "DAE2MAMaterialImporter.h"
+#include "DAE2MAArrayAttributeWriter.h"
 
 #pragma warning(disable:4172)
 
@@ -659,6 +660,9 @@ namespace DAE2MA
         const COLLADAFW::MeshVertexData& normals = mesh->getNormals ();
         size_t stride = 3; // x, y, z
 
+        // Write the values directly into the maya file, the meshNode doesn't buffer them.
+        ArrayAttributeWriter attributeWriter ( getDocumentImporter ()->getFile () );
+
         // We have to go through every mesh primitive and append every element. 
         const COLLADAFW::MeshPrimitiveArray& meshPrimitives = mesh->getMeshPrimitives ();
         size_t count = meshPrimitives.getCount ();
@@ -711,7 +715,7 @@ namespace DAE2MA
                                 {
                                     endPosition = index+blockSize-1;
                                     if ( endPosition > numNormals-1 ) endPosition = numNormals-1;
-                                    meshNode.startNormals ( index, endPosition ); 
+                                    attributeWriter.startAttribute ( ".n", index, endPosition ); 
                                 }
 
                                 // Get the position in the values list to read.
@@ -724,17 +728,13 @@ namespace DAE2MA
                                 case COLLADAFW::MeshVertexData::DATA_TYPE_FLOAT:
                                     {
                                         const COLLADAFW::ArrayPrimitiveType<float>* values = normals.getFloatValues ();
-                                        meshNode.appendNormals ( (*values)[pos] );
-                                        meshNode.appendNormals ( (*values)[pos+1] );
-                                        meshNode.appendNormals ( (*values)[pos+2] );
+                                        attributeWriter.appendValues ( &(*values)[pos], 3 );
                                     }
                                     break;
                                 case COLLADAFW::MeshVertexData::DATA_TYPE_DOUBLE:
                                     {
                                         const COLLADAFW::ArrayPrimitiveType<double>* values = normals.getDoubleValues ();
-                                        meshNode.appendNormals ( (float)(*values)[pos] );
-                                        meshNode.appendNormals ( (float)(*values)[pos+1] );
-                                        meshNode.appendNormals ( (float)(*values)[pos+2] );
+                                        attributeWriter.appendValues ( &(*values)[pos], 3 );
                                     }
                                     break;
                                 default:
@@ -744,7 +744,7 @@ namespace DAE2MA
 
                                 // End the block if necessary.
                                 if ( index == endPosition ) 
-                                    meshNode.endNormals (); 
+                                    attributeWriter.endAttribute (); 
                             }                        
                         }
 
@@ -800,7 +800,7 @@ namespace DAE2MA
                                 {
                                     endPosition = index+blockSize-1;
                                     if ( endPosition > numNormals-1 ) endPosition = numNormals-1;
-                                    meshNode.startNormals ( index, endPosition ); 
+                                    attributeWriter.startAttribute ( ".n", index, endPosition ); 
                                 }
 
                                 // Get the position in the values list to read.
@@ -813,17 +813,13 @@ namespace DAE2MA
                                 case COLLADAFW::MeshVertexData::DATA_TYPE_FLOAT:
                                     {
                                         const COLLADAFW::ArrayPrimitiveType<float>* values = normals.getFloatValues ();
-                                        meshNode.appendNormals ( (*values)[pos] );
-                                        meshNode.appendNormals ( (*values)[pos+1] );
-                                        meshNode.appendNormals ( (*values)[pos+2] );
+                                        attributeWriter.appendValues ( &(*values)[pos], 3 );
                                     }
                                     break;
                                 case COLLADAFW::MeshVertexData::DATA_TYPE_DOUBLE:
                                     {
                                         const COLLADAFW::ArrayPrimitiveType<double>* values = normals.getDoubleValues ();
-                                        meshNode.appendNormals ( (float)(*values)[pos] );
-                                        meshNode.appendNormals ( (float)(*values)[pos+1] );
-                                        meshNode.appendNormals ( (float)(*values)[pos+2] );
+                                        attributeWriter.appendValues ( &(*values)[pos], 3 );
                                     }
                                     break;
                                 default:
@@ -832,7 +828,7 @@ namespace DAE2MA
 
                                 // End the block if necessary.
                                 if ( index == endPosition ) 
-                                    meshNode.endNormals (); 
+                                    attributeWriter.endAttribute (); 
                             }                        
                         }
 
@@ -860,7 +856,7 @@ namespace DAE2MA
                         {
                             endPosition = index+blockSize-1;
                             if ( endPosition > numNormals-1 ) endPosition = numNormals-1;
-                            meshNode.startNormals ( index, endPosition ); 
+                            attributeWriter.startAttribute ( ".n", index, endPosition ); 
                         }
 
                         // Write the normal values on the index values.
@@ -870,17 +866,13 @@ namespace DAE2MA
                         case COLLADAFW::MeshVertexData::DATA_TYPE_FLOAT:
                             {
                                 const COLLADAFW::ArrayPrimitiveType<float>* values = normals.getFloatValues ();
-                                meshNode.appendNormals ( (*values)[pos] );
-                                meshNode.appendNormals ( (*values)[pos+1] );
-                                meshNode.appendNormals ( (*values)[pos+2] );
+                                attributeWriter.appendValues ( &(*values)[pos], 3 );
                             }
                             break;
                         case COLLADAFW::MeshVertexData::DATA_TYPE_DOUBLE:
                             {
                                 const COLLADAFW::ArrayPrimitiveType<double>* values = normals.getDoubleValues ();
-                                meshNode.appendNormals ( (float)(*values)[pos] );
-                                meshNode.appendNormals ( (float)(*values)[pos+1] );
-                                meshNode.appendNormals ( (float)(*values)[pos+2] );
+                                attributeWriter.appendValues ( &(*values)[pos], 3 );
                             }
                             break;
                         default:
@@ -890,7 +882,7 @@ namespace DAE2MA
 
                         // End the block if necessary.
                         if ( index == endPosition ) 
-                            meshNode.endNormals (); 
+                            attributeWriter.endAttribute (); 
                     }
                 }
                 break;
@@ -1292,6 +1284,9 @@ namespace DAE2MA
 
         COLLADABU::Math::Vector3 converted;
 
+        // Write the values directly into the maya file, the meshNode doesn't buffer them.
+        ArrayAttributeWriter attributeWriter ( getDocumentImporter ()->getFile () );
+
         for ( size_t i=0, index=0; i<count; i+=stride, ++index )
         {
             // Start the block if necessary.
@@ -1299,7 +1294,7 @@ namespace DAE2MA
             {
                 endPosition = index+blockSize-1;
                 if ( endPosition > numVertices ) endPosition = numVertices;
-                meshNode.startVrts ( index, endPosition ); 
+                attributeWriter.startAttribute ( ".vt", index, endPosition ); 
             }
 
             const COLLADAFW::MeshVertexData::DataType type = positions.getType ();
@@ -1322,13 +1317,13 @@ namespace DAE2MA
                 continue;
             }
 
-            meshNode.appendVrts ( (float)converted[0] );
-            meshNode.appendVrts ( (float)converted[1] );
-            meshNode.appendVrts ( (float)converted[2] );
+            attributeWriter.appendValue ( (float)converted[0] );
+            attributeWriter.appendValue ( (float)converted[1] );
+            attributeWriter.appendValue ( (float)converted[2] );
 
             // End the block if necessary.
             if ( index == endPosition ) 
-                meshNode.endVrts (); 
+                attributeWriter.endAttribute (); 
         }
     }
 
@@ -1353,6 +1348,9 @@ namespace DAE2MA
         // Initialise the initial index.
         size_t initialIndex = 0;
 
+        // Write the values directly into the maya file, the meshNode doesn't buffer them.
+        ArrayAttributeWriter attributeWriter ( getDocumentImporter ()->getFile () );
+
         // Go through the uv sets.
         for ( size_t i=0; i<numUVSets; ++i )
         {
@@ -1383,7 +1381,7 @@ namespace DAE2MA
                     {
                         endPosition = index+blockSize-1;
                         if ( endPosition > numUvSetPoints ) endPosition = numUvSetPoints;
-                        meshNode.startUvSetPoints ( i, index, endPosition ); 
+                        attributeWriter.startAttribute ( ".uvst", i, ".uvsp", index, endPosition ); 
                     }
 
                     // Write the values 
@@ -1393,15 +1391,15 @@ namespace DAE2MA
                     case COLLADAFW::MeshVertexData::DATA_TYPE_FLOAT:
                         {
                             const COLLADAFW::ArrayPrimitiveType<float>* values = uvCoords.getFloatValues ();
-                            meshNode.appendUvSetPoints ( toLinearUnit ((*values)[initialIndex+j]) );
-                            meshNode.appendUvSetPoints ( toLinearUnit ((*values)[initialIndex+j+1]) );
+                            attributeWriter.appendValue ( toLinearUnit ((*values)[initialIndex+j]) );
+                            attributeWriter.appendValue ( toLinearUnit ((*values)[initialIndex+j+1]) );
                         }
                         break;
                     case COLLADAFW::MeshVertexData::DATA_TYPE_DOUBLE:
                         {
                             const COLLADAFW::ArrayPrimitiveType<double>* values = uvCoords.getDoubleValues ();
-                            meshNode.appendUvSetPoints ( (float) toLinearUnit ((*values)[initialIndex+j]) );
-                            meshNode.appendUvSetPoints ( (float) toLinearUnit ((*values)[initialIndex+j+1]) );
+                            attributeWriter.appendValue ( (float) toLinearUnit ((*values)[initialIndex+j]) );
+                            attributeWriter.appendValue ( (float) toLinearUnit ((*values)[initialIndex+j+1]) );
                         }
                         break;
                     default:
@@ -1411,7 +1409,7 @@ namespace DAE2MA
 
                     // End the block if necessary.
                     if ( index == endPosition ) 
-                        meshNode.endUvSetPoints (); 
+                        attributeWriter.endAttribute (); 
                 }
 
                 initialIndex += indicesCount;
@@ -76,6 +76,9 @@ namespace DAE2Ogre
 		COLLADABU::URI mOutputFile;
 		Runs mCurrentRun;
 
+		/** If true, the meshes are optimized for the vertex cache before they are written.*/
+		bool mOptimizeMeshes;
+
 		const COLLADAFW::VisualScene* mVisualScene;
 		LibraryNodesList mLibrayNodesList;
 
@@ -96,6 +99,9 @@ namespace DAE2Ogre
 
 		bool write();
 
+		/** Sets if the meshes are optimized for the vertex cache before they are written.*/
+		void setOptimizeMeshes( bool optimizeMeshes ) { mOptimizeMeshes = optimizeMeshes; }
+
 		/** Deletes the entire scene.
 		@param errorMessage A message containing informations about the error that occurred.
 		*/
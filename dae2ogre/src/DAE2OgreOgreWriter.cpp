@@ -16,13 +16,17 @@ http://www.opensource.org/licenses/mit-license.php
 #include "COLLADASaxFWLLoader.h"
 
 #include "COLLADAFWRoot.h"
+#include "COLLADAFWRecordingWriter.h"
 #include "COLLADAFWGeometry.h"
 #include "COLLADAFWNode.h"
 #include "COLLADAFWVisualScene.h"
 #include "COLLADAFWInstanceGeometry.h"
+#include "COLLADAFWMesh.h"
+#include "COLLADAFWMeshOptimizer.h"
 
 
 #include <iostream>
+#include <sstream>
 
 
 namespace DAE2Ogre
@@ -34,6 +38,7 @@ namespace DAE2Ogre
 		: mInputFile(inputFile)
 		, mOutputFile(outputFile)
 		, mCurrentRun(SCENEGRAPH_RUN)
+		, mOptimizeMeshes(false)
 	, mVisualScene(0)
 	{
 	}
@@ -69,10 +74,12 @@ namespace DAE2Ogre
 	bool OgreWriter::write()
 	{
 		COLLADASaxFWL::Loader loader;
-		COLLADAFW::Root root(&loader, this);
+		// the document is loaded once, both runs replay the recorded objects
+		COLLADAFW::RecordingWriter recordingWriter;
+		COLLADAFW::Root root(&loader, &recordingWriter);
 
 		// Load scene graph 
-		if ( !root.loadDocument(mInputFile.toNativePath()) )
+		if ( !root.loadDocument(mInputFile.toNativePath()) || !recordingWriter.replay(this) )
 			return false;
 
 		// if there is no visual scene in the COLLADA file, nothing to export here
@@ -84,7 +91,7 @@ namespace DAE2Ogre
 
 		// load and write geometries
 		mCurrentRun = GEOMETRY_RUN;
-		if ( !root.loadDocument(mInputFile.toNativePath()) )
+		if ( !recordingWriter.replay(this) )
 			return false;
 
 		return true;
@@ -149,8 +156,23 @@ namespace DAE2Ogre
 			return true;
 		if ( geometry->getType() != COLLADAFW::Geometry::GEO_TYPE_MESH )
 			return true;
-	
-		MeshWriter meshWriter( this, (COLLADAFW::Mesh*)geometry );
+
+		COLLADAFW::Mesh* mesh = (COLLADAFW::Mesh*)geometry;
+		if ( mOptimizeMeshes )
+		{
+			// The MeshWriter already orders the vertices by their first use.
+			COLLADAFW::MeshOptimizer meshOptimizer( COLLADAFW::MeshOptimizer::OPTIMIZE_VERTEX_CACHE );
+			meshOptimizer.optimize( mesh );
+
+			const COLLADAFW::MeshOptimizer::Statistics& before = meshOptimizer.getStatisticsBefore();
+			const COLLADAFW::MeshOptimizer::Statistics& after = meshOptimizer.getStatisticsAfter();
+			std::ostringstream message;
+			message << "Mesh \"" << mesh->getOriginalId() << "\" optimized: ACMR " << before.getACMR() << " -> " << after.getACMR()
+					<< ", ATVR " << before.getATVR() << " -> " << after.getATVR();
+			reportError( "", message.str(), SEVERITY_INFORMATION );
+		}
+
+		MeshWriter meshWriter( this, mesh );
 		return meshWriter.write();
 	}
 
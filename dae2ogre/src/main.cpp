@@ -32,6 +32,8 @@ int main(int argc, char* argv[])
 		DAE2Ogre::String outputFile = argv[2];
 
 		DAE2Ogre::OgreWriter writer( COLLADABU::URI::nativePathToUri(inputFile), COLLADABU::URI::nativePathToUri(outputFile));
+		if ( argc > 3 && DAE2Ogre::String(argv[3]) == "-optimize" )
+			writer.setOptimizeMeshes(true);
 		writer.write();
 
 	
@@ -40,6 +42,6 @@ int main(int argc, char* argv[])
 	{
 		std::cout << "You must specify an input and output file name" << std::endl;
 
-		std::cout << "Usage: dae2ogre <inputfilename> <outputfilename>" << std::endl;
+		std::cout << "Usage: dae2ogre <inputfilename> <outputfilename> [-optimize]" << std::endl;
 	}
 }
\ No newline at end of file
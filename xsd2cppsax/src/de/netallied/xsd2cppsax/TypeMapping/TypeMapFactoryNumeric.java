@@ -677,6 +677,13 @@ public abstract class TypeMapFactoryNumeric implements ITypeMapFactory {
     public TypeMap createDefaultTypeMapHexBinary() {
         TypeMap typeMap = createAbstractUINT8();
         typeMap.setXsdType("hexBinary");
+        // character data is decoded to bytes, not parsed as list of decimal numbers
+        typeMap.setDataListEnd("return hexBinaryDataEnd( &#className#::#dataMethod# );");
+        typeMap
+                .setDataListEndValidation("bool returnValue = hexBinaryDataEnd( &#className#::#dataMethod#, #stv_function_name_stream_end#, #stv_get_count_struct_member#, #stv_item_type_vali_func# );");
+        typeMap.setDataListTypeConversion("return characterData2HexBinaryData" + "#tm_default_data_list_xsd2cpp_lhs#");
+        typeMap.setDataListTypeConversionValidation("return characterData2HexBinaryData"
+                + "#tm_default_data_list_xsd2cpp_validation_lhs#");
         return typeMap;
     }
 